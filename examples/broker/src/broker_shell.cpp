@@ -23,6 +23,7 @@
 #include <cstring>
 #include "etcpal/netint.h"
 #include "etcpal/cpp/thread.h"
+#include "etcpal/cpp/timer.h"
 #include "rdmnet/cpp/common.h"
 #include "rdmnet/version.h"
 
@@ -77,6 +78,15 @@ int BrokerShell::Run(etcpal::Logger& log)
   broker_settings.dns.model = "RDMnet Broker Example App";
   broker_settings.listen_port = initial_data_.port;
   broker_settings.listen_interfaces = initial_data_.netints;
+  // Drain client backlogs with fewer, larger socket sends.
+  broker_settings.max_send_batch_size = 16384;
+  // Report reconnect storms to controllers in a few large client list updates.
+  broker_settings.client_list_update_window_ms = 50;
+  // Drop clients which can't keep up with broadcast traffic.
+  broker_settings.slow_client_disconnect_ms = 10000;
+  // Keep dynamic UIDs stable across restarts, and forget those of components gone for 30 days.
+  broker_settings.uid_reservation_file = initial_data_.uid_reservation_file;
+  broker_settings.uid_reservation_max_age_s = 30 * 24 * 60 * 60;
 
   rdmnet::Broker broker;
 
@@ -87,6 +97,8 @@ int BrokerShell::Run(etcpal::Logger& log)
     return 1;
   }
 
+  etcpal::Timer statistics_timer(kStatisticsIntervalMs);
+
   // We want this to run forever in a console
   while (true)
   {
@@ -101,6 +113,11 @@ int BrokerShell::Run(etcpal::Logger& log)
       broker.Shutdown();
       broker.Startup(broker_settings, log_, this);
     }
+    else if (statistics_timer.IsExpired())
+    {
+      LogStatistics(broker.GetStatistics());
+      statistics_timer.Reset();
+    }
 
     etcpal::Thread::Sleep(300);
   }
@@ -110,6 +127,36 @@ int BrokerShell::Run(etcpal::Logger& log)
   return 0;
 }
 
+// Logs a one-line summary of the broker's state, plus the client with the most messages waiting to
+// be sent, which is usually the one holding up the others.
+void BrokerShell::LogStatistics(const rdmnet::Broker::Statistics& stats)
+{
+  if (!log_)
+    return;
+
+  log_->Info(
+      "Broker statistics: %zu clients (%zu controllers, %zu devices); routed %.1f requests/s, %.1f notifications/s, "
+      "%.1f status/s; %llu messages rejected due to full queues, %llu broadcasts dropped",
+      stats.num_clients, stats.num_controllers, stats.num_devices, stats.rpt_requests_per_second,
+      stats.rpt_notifications_per_second, stats.rpt_status_per_second,
+      static_cast<unsigned long long>(stats.queue_full_count),
+      static_cast<unsigned long long>(stats.broadcast_drop_count));
+
+  const rdmnet::Broker::ClientStatistics* slowest = nullptr;
+  for (const auto& client : stats.clients)
+  {
+    if (!slowest || client.queue_depth > slowest->queue_depth)
+      slowest = &client;
+  }
+  if (slowest && slowest->queue_depth > 0)
+  {
+    log_->Info("Deepest client queue: %s (%s, UID %s): %zu messages queued, high water mark %zu, %llu rejected",
+               slowest->cid.ToString().c_str(), slowest->addr.ToString().c_str(), slowest->uid.ToString().c_str(),
+               slowest->queue_depth, slowest->queue_high_water_mark,
+               static_cast<unsigned long long>(slowest->queue_full_count));
+  }
+}
+
 void BrokerShell::PrintVersion()
 {
   std::cout << "ETC Example RDMnet Broker\n";
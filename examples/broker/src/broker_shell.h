@@ -43,6 +43,7 @@ public:
   void SetInitialScope(const std::string& scope) { initial_data_.scope = scope; }
   void SetInitialNetintList(const std::vector<std::string>& netints) { initial_data_.netints = netints; }
   void SetInitialPort(uint16_t port) { initial_data_.port = port; }
+  void SetInitialUidReservationFile(const std::string& path) { initial_data_.uid_reservation_file = path; }
 
   void NetworkChanged();
   void AsyncShutdown();
@@ -50,6 +51,7 @@ public:
 private:
   void HandleScopeChanged(const std::string& new_scope) override;
   void PrintWarningMessage();
+  void LogStatistics(const rdmnet::Broker::Statistics& stats);
 
   void ApplySettingsChanges(rdmnet::Broker::Settings& settings);
 
@@ -58,8 +60,12 @@ private:
     std::string              scope{E133_DEFAULT_SCOPE};
     std::vector<std::string> netints;
     uint16_t                 port{0};
+    std::string              uid_reservation_file;
   } initial_data_;
 
+  // How often a summary of the broker's statistics is logged.
+  static constexpr uint32_t kStatisticsIntervalMs = 30000;
+
   etcpal::Logger*   log_{nullptr};
   std::atomic<bool> restart_requested_{false};
   bool              shutdown_requested_{false};
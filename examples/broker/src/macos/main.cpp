@@ -48,6 +48,8 @@ void PrintHelp(const char* app_name)
   std::cout << "                        interfaces are used.\n";
   std::cout << "  --port=PORT           The port that this broker instance should use. By\n";
   std::cout << "                        default, an ephemeral port is used.\n";
+  std::cout << "  --uid-file=FILE       Keep the dynamic UIDs assigned to components in FILE, so\n";
+  std::cout << "                        that they stay the same when the broker restarts.\n";
   std::cout << "  --log-level=LOG_LEVEL Set the logging output level mask, using standard syslog\n";
   std::cout << "                        names from EMERG to DEBUG. Default is INFO.\n";
   std::cout << "  --help                Display this help and exit.\n";
@@ -117,6 +119,17 @@ bool ParseAndSetPort(const char* port_str, BrokerShell& broker_shell)
   return false;
 }
 
+// Parse the --uid-file=FILE command line option and transfer it to the BrokerShell instance.
+bool ParseAndSetUidFile(const char* uid_file_str, BrokerShell& broker_shell)
+{
+  if (strlen(uid_file_str) != 0)
+  {
+    broker_shell.SetInitialUidReservationFile(uid_file_str);
+    return true;
+  }
+  return false;
+}
+
 // clang-format off
 static const std::map<std::string, int> log_levels = {
   {"EMERG", ETCPAL_LOG_UPTO(ETCPAL_LOG_EMERG)},
@@ -173,6 +186,11 @@ ParseResult ParseArgs(int argc, char* argv[], BrokerShell& broker_shell, int& lo
         if (!ParseAndSetPort(argv[i] + 7, broker_shell))
           return ParseResult::kParseErr;
       }
+      else if (strncmp(argv[i], "--uid-file=", 11) == 0)
+      {
+        if (!ParseAndSetUidFile(argv[i] + 11, broker_shell))
+          return ParseResult::kParseErr;
+      }
       else if (strncmp(argv[i], "--log-level=", 12) == 0)
       {
         if (!ParseAndSetLogLevel(argv[i] + 12, log_mask))
@@ -46,6 +46,8 @@ void PrintHelp(wchar_t* app_name)
   std::cout << "                        By default, all available interfaces are used.\n";
   std::cout << "  --port=PORT           The port that this broker instance should use. By\n";
   std::cout << "                        default, an ephemeral port is used.\n";
+  std::cout << "  --uid-file=FILE       Keep the dynamic UIDs assigned to components in FILE, so\n";
+  std::cout << "                        that they stay the same when the broker restarts.\n";
   std::cout << "  --log-level=LOG_LEVEL Set the logging output level mask, using standard syslog\n";
   std::cout << "                        names from EMERG to DEBUG. Default is INFO.\n";
   std::cout << "  --help                Display this help and exit.\n";
@@ -133,6 +135,22 @@ bool ParseAndSetPort(const LPWSTR port_str, BrokerShell& broker_shell)
   return false;
 }
 
+// Parse the --uid-file=FILE command line option and transfer it to the BrokerShell instance.
+bool ParseAndSetUidFile(const LPWSTR uid_file_str, BrokerShell& broker_shell)
+{
+  if (wcslen(uid_file_str) != 0)
+  {
+    // The broker opens the file with the ANSI file APIs.
+    char val_ansi[MAX_PATH];
+    if (0 != WideCharToMultiByte(CP_ACP, 0, uid_file_str, -1, val_ansi, MAX_PATH, NULL, NULL))
+    {
+      broker_shell.SetInitialUidReservationFile(val_ansi);
+      return true;
+    }
+  }
+  return false;
+}
+
 // clang-format off
 static const std::map<std::wstring, int> log_levels = {
   {L"EMERG", ETCPAL_LOG_UPTO(ETCPAL_LOG_EMERG)},
@@ -189,6 +207,11 @@ ParseResult ParseArgs(int argc, wchar_t* argv[], BrokerShell& broker_shell, int&
         if (!ParseAndSetPort(argv[i] + 7, broker_shell))
           return ParseResult::kParseErr;
       }
+      else if (_wcsnicmp(argv[i], L"--uid-file=", 11) == 0)
+      {
+        if (!ParseAndSetUidFile(argv[i] + 11, broker_shell))
+          return ParseResult::kParseErr;
+      }
       else if (_wcsnicmp(argv[i], L"--log-level=", 12) == 0)
       {
         if (!ParseAndSetLogLevel(argv[i] + 12, log_mask))
@@ -19,6 +19,7 @@
 
 #include "manager.h"
 
+#include <atomic>
 #include <cstring>
 #include <cstdio>
 #include <memory>
@@ -917,6 +918,14 @@ void LlrpManagerExample::HandleLlrpRdmResponse(llrp::Manager::Handle handle, con
     active_response_handler_(resp);
 }
 
+void LlrpManagerExample::HandleLlrpRdmCommandTimedOut(llrp::Manager::Handle        handle,
+                                                      const llrp::DestinationAddr& /*destination*/,
+                                                      uint32_t                     seq_num)
+{
+  if (handle == active_manager_ && active_timeout_handler_)
+    active_timeout_handler_(seq_num);
+}
+
 std::vector<uint8_t> LlrpManagerExample::GetDataFromTarget(llrp::Manager&                manager,
                                                            const llrp::DiscoveredTarget& target,
                                                            uint16_t                      param_id,
@@ -928,16 +937,19 @@ std::vector<uint8_t> LlrpManagerExample::GetDataFromTarget(llrp::Manager&
   llrp::SavedRdmResponse response;
   active_response_handler_ = [&](const llrp::RdmResponse& resp) { response = resp.Save(); };
 
-  auto seq_num = manager.SendGetCommand(target.address(), param_id, data, data_len);
+  std::atomic<bool>          timed_out{false};
+  etcpal::Expected<uint32_t> seq_num = kEtcPalErrNotInit;
+  active_timeout_handler_ = [&](uint32_t timed_out_seq_num) {
+    if (seq_num && timed_out_seq_num == *seq_num)
+      timed_out = true;
+  };
+
+  seq_num = manager.SendGetCommand(target.address(), param_id, data, data_len);
   if (seq_num)
   {
-    etcpal::Timer resp_timer(LLRP_TIMEOUT_MS);
-    while (!resp_timer.IsExpired())
-    {
-      if (response.IsValid())
-        break;
+    // The library retransmits the command until it receives a response or gives up.
+    while (!response.IsValid() && !timed_out)
       etcpal::Thread::Sleep(100);
-    }
 
     if (response.IsValid())
     {
@@ -978,16 +990,19 @@ bool LlrpManagerExample::SetDataOnTarget(llrp::Manager&                manager,
   llrp::SavedRdmResponse response;
   active_response_handler_ = [&](const llrp::RdmResponse& resp) { response = resp.Save(); };
 
-  auto seq_num = manager.SendSetCommand(target.address(), param_id, data, data_len);
+  std::atomic<bool>          timed_out{false};
+  etcpal::Expected<uint32_t> seq_num = kEtcPalErrNotInit;
+  active_timeout_handler_ = [&](uint32_t timed_out_seq_num) {
+    if (seq_num && timed_out_seq_num == *seq_num)
+      timed_out = true;
+  };
+
+  seq_num = manager.SendSetCommand(target.address(), param_id, data, data_len);
   if (seq_num)
   {
-    etcpal::Timer resp_timer(LLRP_TIMEOUT_MS);
-    while (!resp_timer.IsExpired())
-    {
-      if (response.IsValid())
-        break;
+    // The library retransmits the command until it receives a response or gives up.
+    while (!response.IsValid() && !timed_out)
       etcpal::Thread::Sleep(100);
-    }
 
     if (response.IsValid())
     {
@@ -84,9 +84,13 @@ public:
   void HandleLlrpTargetDiscovered(llrp::Manager::Handle handle, const llrp::DiscoveredTarget& target) override;
   void HandleLlrpDiscoveryFinished(llrp::Manager::Handle handle) override;
   void HandleLlrpRdmResponse(llrp::Manager::Handle handle, const llrp::RdmResponse& resp) override;
+  void HandleLlrpRdmCommandTimedOut(llrp::Manager::Handle         handle,
+                                    const llrp::DestinationAddr& destination,
+                                    uint32_t                     seq_num) override;
 
 private:
   using RdmResponseHandler = std::function<void(const llrp::RdmResponse&)>;
+  using RdmTimeoutHandler = std::function<void(uint32_t)>;
 
   std::vector<uint8_t> GetDataFromTarget(llrp::Manager&                manager,
                                          const llrp::DiscoveredTarget& target,
@@ -104,6 +108,7 @@ private:
   std::map<int, TargetInfo> targets_;
   llrp::Manager::Handle     active_manager_;
   RdmResponseHandler        active_response_handler_;
+  RdmTimeoutHandler         active_timeout_handler_;
 
   bool discovery_active_{false};
 };
@@ -148,6 +148,20 @@ typedef void (*RdmnetControllerResponderIdsReceivedCallback)(rdmnet_controller_t
                                                              const RdmnetDynamicUidAssignmentList* list,
                                                              void*                                 context);
 
+/**
+ * @brief A scope's connection has room for more outgoing data again.
+ *
+ * Called after a send function has returned #kEtcPalErrWouldBlock for this scope, once the data
+ * waiting to be sent to the broker has drained. The send that was refused can now be retried.
+ *
+ * @param[in] controller_handle Handle to the controller which can send again.
+ * @param[in] scope_handle Handle to the scope on which data can be sent again.
+ * @param[in] context Context pointer that was given at the creation of the controller instance.
+ */
+typedef void (*RdmnetControllerSendReadyCallback)(rdmnet_controller_t   controller_handle,
+                                                  rdmnet_client_scope_t scope_handle,
+                                                  void*                 context);
+
 /** A set of notification callbacks received about a controller. */
 typedef struct RdmnetControllerCallbacks
 {
@@ -159,6 +173,8 @@ typedef struct RdmnetControllerCallbacks
   RdmnetControllerStatusReceivedCallback           status_received;             /**< Required. */
   RdmnetControllerResponderIdsReceivedCallback     responder_ids_received;      /**< Optional. */
   void* context; /**< (optional) Pointer to opaque data passed back with each callback. */
+  /** (optional) A send previously refused with #kEtcPalErrWouldBlock can be retried. */
+  RdmnetControllerSendReadyCallback send_ready;
 } RdmnetControllerCallbacks;
 
 /**
@@ -330,7 +346,7 @@ typedef struct RdmnetControllerConfig
  */
 #define RDMNET_CONTROLLER_CONFIG_DEFAULT_INIT(manu_id)                                         \
   {                                                                                            \
-    {{0}}, {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL}, {NULL, NULL, NULL, NULL},         \
+    {{0}}, {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL}, {NULL, NULL, NULL, NULL},   \
         RDMNET_CONTROLLER_RDM_DATA_DEFAULT_INIT, {(0x8000 | manu_id), 0}, NULL, false, NULL, 0 \
   }
 
@@ -349,6 +365,8 @@ void rdmnet_controller_set_rdm_cmd_callbacks(RdmnetControllerConfig*
                                              RdmnetControllerLlrpRdmCommandReceivedCallback llrp_rdm_command_received,
                                              uint8_t*                                       response_buf,
                                              void*                                          context);
+void rdmnet_controller_set_send_ready_callback(RdmnetControllerConfig*           config,
+                                               RdmnetControllerSendReadyCallback send_ready);
 
 etcpal_error_t rdmnet_controller_create(const RdmnetControllerConfig* config, rdmnet_controller_t* handle);
 etcpal_error_t rdmnet_controller_destroy(rdmnet_controller_t controller_handle, rdmnet_disconnect_reason_t reason);
@@ -23,6 +23,7 @@
 #ifndef RDMNET_CPP_BROKER_H_
 #define RDMNET_CPP_BROKER_H_
 
+#include <array>
 #include <cstdint>
 #include <cstring>
 #include <memory>
@@ -38,6 +39,7 @@
 #include "rdm/cpp/uid.h"
 #include "rdmnet/common.h"
 #include "rdmnet/defs.h"
+#include "rdmnet/message.h"
 
 class BrokerCore;
 
@@ -180,6 +182,52 @@ public:
     /// a GUID.
     std::vector<std::string> listen_interfaces;
 
+    /// @brief The maximum number of bytes of queued messages to combine into a single send on a
+    ///        client connection.
+    ///
+    /// Combining queued messages reduces the number of socket calls needed to drain a backlog of
+    /// messages to a client. 0 means each queued message is sent with a separate call.
+    size_t max_send_batch_size{0};
+
+    /// @brief The number of threads the broker uses to read from client connections.
+    ///
+    /// 0 means the number is chosen based on the number of processors in the system. Used on Linux
+    /// and Windows; on macOS, client connections are always read by a single thread.
+    unsigned int socket_reader_threads{0};
+
+    /// @brief The time in milliseconds over which client connections and disconnections are
+    ///        collected before controllers are notified of them.
+    ///
+    /// Collected changes are sent in as few client add and client remove messages as possible, and
+    /// a client which connects and disconnects within the window is not reported at all, unless a
+    /// controller fetched the client list in between. The changes
+    /// go out on the first pass of the broker's send threads after the window ends. 0 means changes
+    /// are sent on the next pass without waiting to collect more.
+    unsigned int client_list_update_window_ms{0};
+    /// The number of collected client list changes which causes an update to be sent before
+    /// client_list_update_window_ms has elapsed. 0 means no limit.
+    size_t client_list_update_max_entries{0};
+
+    /// @brief The time in milliseconds for which an RPT client's queue can stay too full to take
+    ///        broadcast messages before the broker disconnects it.
+    ///
+    /// Broadcasts are delivered to every client with room in its queue, and dropped for clients
+    /// whose queues are full, so that a slow client does not delay broadcasts to the others. A
+    /// client which has room in its queue again is no longer considered slow. 0 means slow clients
+    /// are never disconnected.
+    unsigned int slow_client_disconnect_ms{0};
+
+    /// @brief The path of a file in which the broker keeps the dynamic UIDs it has assigned.
+    ///
+    /// A component which requests a dynamic UID is given the same one each time it reconnects. The
+    /// file lets this continue across restarts of the broker, so that controllers do not need to
+    /// rediscover every component under a new UID. The file is created if it does not exist. Empty
+    /// means dynamic UIDs are only remembered while the broker is running.
+    std::string uid_reservation_file;
+    /// The time in seconds after a component disconnects for which its dynamic UID stays reserved
+    /// for it. 0 means dynamic UIDs stay reserved indefinitely.
+    unsigned int uid_reservation_max_age_s{0};
+
     Settings() = default;
     Settings(const etcpal::Uuid& cid_in, const rdm::Uid& static_uid_in);
     Settings(const etcpal::Uuid& cid_in, uint16_t rdm_manu_id_in);
@@ -204,6 +252,71 @@ public:
     virtual void HandleScopeChanged(const std::string& new_scope) { ETCPAL_UNUSED_ARG(new_scope); }
   };
 
+  /// @brief The number of buckets in a send latency histogram.
+  ///
+  /// Bucket 0 counts messages sent less than 1 ms after they were queued. Bucket n, from 1 to 10,
+  /// counts messages sent between 2^(n-1) and 2^n - 1 ms after they were queued. The last bucket
+  /// counts messages which waited 1024 ms or more.
+  static constexpr size_t kNumLatencyBuckets = 12;
+
+  /// @ingroup rdmnet_broker
+  /// @brief Statistics about a single client connection.
+  struct ClientStatistics
+  {
+    int               handle{-1};                        ///< The broker's handle for the connection.
+    etcpal::Uuid      cid;                               ///< The client's CID.
+    etcpal::SockAddr  addr;                              ///< The client's address.
+    bool              is_rpt{false};                     ///< Whether this is an RPT client.
+    rdm::Uid          uid;                               ///< The client's UID, if it is an RPT client.
+    rpt_client_type_t rpt_type{kRPTClientTypeUnknown};   ///< The RPT client type, if it is an RPT client.
+
+    size_t   queue_depth{0};            ///< The number of messages currently queued to the client.
+    size_t   queue_high_water_mark{0};  ///< The most messages that have been queued to the client at once.
+    uint64_t queue_full_count{0};       ///< Messages which couldn't be queued because the queue was full.
+    uint64_t broadcast_drop_count{0};   ///< Broadcasts not delivered to the client because its queue was full.
+    uint64_t messages_sent{0};          ///< Messages sent to the client.
+    uint64_t bytes_sent{0};             ///< Bytes sent to the client.
+    uint64_t messages_received{0};      ///< Messages received from the client.
+  };
+
+  /// @ingroup rdmnet_broker
+  /// @brief A snapshot of the broker's runtime statistics, returned by Broker::GetStatistics().
+  ///
+  /// Totals cover all clients since Startup(), including clients which have since disconnected.
+  struct Statistics
+  {
+    size_t num_clients{0};      ///< The number of connected clients.
+    size_t num_controllers{0};  ///< The number of connected RPT controllers.
+    size_t num_devices{0};      ///< The number of connected RPT devices.
+
+    uint64_t messages_received{0};     ///< Messages received from all clients.
+    uint64_t bytes_received{0};        ///< Bytes received from all clients.
+    uint64_t messages_sent{0};         ///< Messages sent to all clients.
+    uint64_t bytes_sent{0};            ///< Bytes sent to all clients.
+    uint64_t queue_full_count{0};      ///< Messages which couldn't be queued because a client's queue was full.
+    uint64_t broadcast_drop_count{0};  ///< Broadcasts not delivered to a client because its queue was full.
+
+    uint64_t rpt_requests_routed{0};       ///< RPT Request messages routed.
+    uint64_t rpt_notifications_routed{0};  ///< RPT Notification messages routed.
+    uint64_t rpt_status_routed{0};         ///< RPT Status messages routed.
+
+    /// @name Routing rates
+    /// Messages routed per second, measured since the previous call to GetStatistics() (or since
+    /// Startup(), for the first call).
+    /// @{
+    double rpt_requests_per_second{0.0};
+    double rpt_notifications_per_second{0.0};
+    double rpt_status_per_second{0.0};
+    /// @}
+
+    /// A histogram of the time messages spent queued to clients before being sent. See
+    /// kNumLatencyBuckets for the bucket boundaries.
+    std::array<uint64_t, kNumLatencyBuckets> send_latency_histogram{};
+
+    /// Statistics for each connected client.
+    std::vector<ClientStatistics> clients;
+  };
+
   Broker();
   virtual ~Broker();
 
@@ -221,6 +334,7 @@ public:
   etcpal::Error ChangeScope(const std::string& new_scope, rdmnet_disconnect_reason_t disconnect_reason);
 
   const Settings& settings() const;
+  Statistics      GetStatistics() const;
 
 private:
   std::unique_ptr<BrokerCore> core_;
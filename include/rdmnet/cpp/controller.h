@@ -143,6 +143,15 @@ public:
       ETCPAL_UNUSED_ARG(scope_handle);
       ETCPAL_UNUSED_ARG(list);
     }
+
+    /// @brief A scope which refused a send with kEtcPalErrWouldBlock can accept data again.
+    /// @param controller_handle Handle to controller instance which can send again.
+    /// @param scope_handle Handle to the scope on which data can be sent again.
+    virtual void HandleSendReady(Handle controller_handle, ScopeHandle scope_handle)
+    {
+      ETCPAL_UNUSED_ARG(controller_handle);
+      ETCPAL_UNUSED_ARG(scope_handle);
+    }
   };
 
   /// @ingroup rdmnet_controller_cpp
@@ -411,6 +420,17 @@ extern "C" inline void ControllerLibCbResponderIdsReceived(rdmnet_controller_t
   }
 }
 
+extern "C" inline void ControllerLibCbSendReady(rdmnet_controller_t   controller_handle,
+                                                rdmnet_client_scope_t scope_handle,
+                                                void*                 context)
+{
+  if (context)
+  {
+    static_cast<Controller::NotifyHandler*>(context)->HandleSendReady(Controller::Handle(controller_handle),
+                                                                      ScopeHandle(scope_handle));
+  }
+}
+
 extern "C" inline void ControllerLibCbRdmCommandReceived(rdmnet_controller_t     controller_handle,
                                                          rdmnet_client_scope_t   scope_handle,
                                                          const RdmnetRdmCommand* cmd,
@@ -534,7 +554,8 @@ inline etcpal::Error Controller::Startup(NotifyHandler&  notify_handler,
       internal::ControllerLibCbRdmResponseReceived,
       internal::ControllerLibCbStatusReceived,
       internal::ControllerLibCbResponderIdsReceived,
-      &notify_handler               // Context
+      &notify_handler,              // Context
+      internal::ControllerLibCbSendReady
     },
     {                               // RDM command callback shims
       nullptr, nullptr, nullptr, nullptr
@@ -608,7 +629,8 @@ inline etcpal::Error Controller::Startup(NotifyHandler&     notify_handler,
       internal::ControllerLibCbRdmResponseReceived,
       internal::ControllerLibCbStatusReceived,
       internal::ControllerLibCbResponderIdsReceived,
-      &notify_handler               // Context
+      &notify_handler,              // Context
+      internal::ControllerLibCbSendReady
     },
     {                               // RDM command callback shims
       internal::ControllerLibCbRdmCommandReceived,
@@ -376,6 +376,10 @@ public:
       ETCPAL_UNUSED_ARG(handle);
       ETCPAL_UNUSED_ARG(list);
     }
+
+    /// @brief A device which refused a send with kEtcPalErrWouldBlock can accept data again.
+    /// @param handle Handle to device instance which can send again.
+    virtual void HandleSendReady(Handle handle) { ETCPAL_UNUSED_ARG(handle); }
   };
 
   /// @ingroup rdmnet_device_cpp
@@ -568,6 +572,14 @@ extern "C" inline void DeviceLibCbDynamicUidStatus(rdmnet_device_t
   }
 }
 
+extern "C" inline void DeviceLibCbSendReady(rdmnet_device_t handle, void* context)
+{
+  if (context)
+  {
+    static_cast<Device::NotifyHandler*>(context)->HandleSendReady(Device::Handle(handle));
+  }
+}
+
 };  // namespace internal
 
 /// @endcond
@@ -1335,7 +1347,8 @@ inline Device::TranslatedConfig::TranslatedConfig(const Settings&         settin
         ::rdmnet::internal::DeviceLibCbRdmCommandReceived,
         ::rdmnet::internal::DeviceLibCbLlrpRdmCommandReceived,
         ::rdmnet::internal::DeviceLibCbDynamicUidStatus,
-        &notify_handler
+        &notify_handler,
+        ::rdmnet::internal::DeviceLibCbSendReady
       },
       settings.response_buf,
       {
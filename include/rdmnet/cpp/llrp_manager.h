@@ -168,6 +168,17 @@ public:
     /// @brief The previously-started LLRP discovery process has finished.
     /// @param handle Handle to LLRP manager instance which has finished discovery.
     virtual void HandleLlrpDiscoveryFinished(Handle handle) { ETCPAL_UNUSED_ARG(handle); }
+
+    /// @brief No response was received to an RDM command, including its retransmissions.
+    /// @param handle Handle to LLRP manager instance which sent the command.
+    /// @param destination The address to which the command was sent.
+    /// @param seq_num The sequence number of the command.
+    virtual void HandleLlrpRdmCommandTimedOut(Handle handle, const DestinationAddr& destination, uint32_t seq_num)
+    {
+      ETCPAL_UNUSED_ARG(handle);
+      ETCPAL_UNUSED_ARG(destination);
+      ETCPAL_UNUSED_ARG(seq_num);
+    }
   };
 
   Manager() = default;
@@ -239,6 +250,19 @@ extern "C" inline void LlrpManagerLibCbDiscoveryFinished(llrp_manager_t handle,
     static_cast<Manager::NotifyHandler*>(context)->HandleLlrpDiscoveryFinished(Manager::Handle(handle));
   }
 }
+
+extern "C" inline void LlrpManagerLibCbRdmCommandTimedOut(llrp_manager_t             handle,
+                                                          const LlrpDestinationAddr* destination,
+                                                          uint32_t                   seq_num,
+                                                          void*                      context)
+{
+  if (destination && context)
+  {
+    static_cast<Manager::NotifyHandler*>(context)->HandleLlrpRdmCommandTimedOut(
+        Manager::Handle(handle), DestinationAddr(destination->dest_cid, destination->dest_uid, destination->subdevice),
+        seq_num);
+  }
+}
 };  // namespace internal
 
 /// @endcond
@@ -271,7 +295,8 @@ inline etcpal::Error Manager::Startup(NotifyHandler&      notify_handler,
       internal::LlrpManagerLibCbTargetDiscovered,
       internal::LlrpManagerLibCbRdmResponseReceived,
       internal::LlrpManagerLibCbDiscoveryFinished,
-      &notify_handler
+      &notify_handler,
+      internal::LlrpManagerLibCbRdmCommandTimedOut
     }
   };
   // clang-format on
@@ -318,7 +343,9 @@ inline etcpal::Error Manager::StopDiscovery()
 
 /// @brief Send an RDM command from an LLRP manager.
 ///
-/// The response will be delivered via the NotifyHandler::HandleLlrpRdmResponse() callback.
+/// The response will be delivered via the NotifyHandler::HandleLlrpRdmResponse() callback. If no
+/// response is received after retransmitting the command, NotifyHandler::HandleLlrpRdmCommandTimedOut()
+/// is called instead.
 ///
 /// @param destination The destination addressing information for the RDM command.
 /// @param command_class The command's RDM command class (GET or SET).
@@ -341,7 +368,9 @@ inline etcpal::Expected<uint32_t> Manager::SendRdmCommand(const DestinationAddr&
 
 /// @brief Send an RDM GET command from an LLRP manager.
 ///
-/// The response will be delivered via the NotifyHandler::HandleLlrpRdmResponse() callback.
+/// The response will be delivered via the NotifyHandler::HandleLlrpRdmResponse() callback. If no
+/// response is received after retransmitting the command, NotifyHandler::HandleLlrpRdmCommandTimedOut()
+/// is called instead.
 ///
 /// @param destination The destination addressing information for the RDM command.
 /// @param param_id The command's RDM parameter ID.
@@ -362,7 +391,9 @@ inline etcpal::Expected<uint32_t> Manager::SendGetCommand(const DestinationAddr&
 
 /// @brief Send an RDM SET command from an LLRP manager.
 ///
-/// The response will be delivered via the NotifyHandler::HandleLlrpRdmResponse() callback.
+/// The response will be delivered via the NotifyHandler::HandleLlrpRdmResponse() callback. If no
+/// response is received after retransmitting the command, NotifyHandler::HandleLlrpRdmCommandTimedOut()
+/// is called instead.
 ///
 /// @param destination The destination addressing information for the RDM command.
 /// @param param_id The command's RDM parameter ID.
@@ -126,6 +126,17 @@ typedef void (*RdmnetDeviceDynamicUidStatusCallback)(rdmnet_device_t
                                                      const RdmnetDynamicUidAssignmentList* list,
                                                      void*                                 context);
 
+/**
+ * @brief The device's broker connection has room for more outgoing data again.
+ *
+ * Called after a send function has returned #kEtcPalErrWouldBlock, once the data waiting to be
+ * sent to the broker has drained. The send that was refused can now be retried.
+ *
+ * @param[in] handle Handle to the device which can send again.
+ * @param[in] context Context pointer that was given at the creation of the device instance.
+ */
+typedef void (*RdmnetDeviceSendReadyCallback)(rdmnet_device_t handle, void* context);
+
 /** A set of notification callbacks received about a device. */
 typedef struct RdmnetDeviceCallbacks
 {
@@ -136,6 +147,8 @@ typedef struct RdmnetDeviceCallbacks
   RdmnetDeviceLlrpRdmCommandReceivedCallback llrp_rdm_command_received;   /**< Required. */
   RdmnetDeviceDynamicUidStatusCallback       dynamic_uid_status_received; /**< Optional. */
   void* context; /**< (optional) Pointer to opaque data passed back with each callback. */
+  /** (optional) A send previously refused with #kEtcPalErrWouldBlock can be retried. */
+  RdmnetDeviceSendReadyCallback send_ready;
 } RdmnetDeviceCallbacks;
 
 /**
@@ -295,10 +308,10 @@ typedef struct RdmnetDeviceConfig
  *
  * @param manu_id Your ESTA manufacturer ID.
  */
-#define RDMNET_DEVICE_CONFIG_DEFAULT_INIT(manu_id)                                             \
-  {                                                                                            \
-    {{0}}, {NULL, NULL, NULL, NULL, NULL, NULL, NULL}, NULL, RDMNET_SCOPE_CONFIG_DEFAULT_INIT, \
-        {(0x8000 | manu_id), 0}, NULL, NULL, 0, NULL, 0, NULL, 0                               \
+#define RDMNET_DEVICE_CONFIG_DEFAULT_INIT(manu_id)                                                   \
+  {                                                                                                  \
+    {{0}}, {NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL}, NULL, RDMNET_SCOPE_CONFIG_DEFAULT_INIT, \
+        {(0x8000 | manu_id), 0}, NULL, NULL, 0, NULL, 0, NULL, 0                                     \
   }
 
 void rdmnet_device_config_init(RdmnetDeviceConfig* config, uint16_t manufacturer_id);
@@ -310,6 +323,7 @@ void rdmnet_device_set_callbacks(RdmnetDeviceConfig*                        conf
                                  RdmnetDeviceLlrpRdmCommandReceivedCallback llrp_rdm_command_received,
                                  RdmnetDeviceDynamicUidStatusCallback       dynamic_uid_status_received,
                                  void*                                      context);
+void rdmnet_device_set_send_ready_callback(RdmnetDeviceConfig* config, RdmnetDeviceSendReadyCallback send_ready);
 
 etcpal_error_t rdmnet_device_create(const RdmnetDeviceConfig* config, rdmnet_device_t* handle);
 etcpal_error_t rdmnet_device_destroy(rdmnet_device_t handle, rdmnet_disconnect_reason_t disconnect_reason);
@@ -79,6 +79,22 @@ typedef void (*LlrpManagerRdmResponseReceivedCallback)(llrp_manager_t         ha
  */
 typedef void (*LlrpManagerDiscoveryFinishedCallback)(llrp_manager_t handle, void* context);
 
+/**
+ * @brief No response was received to an RDM command sent by an LLRP manager.
+ *
+ * The command has been retransmitted #RDMNET_LLRP_MANAGER_RDM_COMMAND_RETRIES times without a
+ * response. A response which arrives after this is discarded.
+ *
+ * @param handle Handle to the LLRP manager which sent the command.
+ * @param destination The address to which the command was sent.
+ * @param seq_num The sequence number of the command.
+ * @param context Context pointer that was given at the creation of the LLRP manager instance.
+ */
+typedef void (*LlrpManagerRdmCommandTimedOutCallback)(llrp_manager_t             handle,
+                                                      const LlrpDestinationAddr* destination,
+                                                      uint32_t                   seq_num,
+                                                      void*                      context);
+
 /** A set of notification callbacks received about an LLRP manager. */
 typedef struct LlrpManagerCallbacks
 {
@@ -86,6 +102,8 @@ typedef struct LlrpManagerCallbacks
   LlrpManagerRdmResponseReceivedCallback rdm_response_received; /**< An LLRP RDM response has been received. */
   LlrpManagerDiscoveryFinishedCallback   discovery_finished;    /**< LLRP discovery is finished. */
   void* context; /**< (optional) Pointer to opaque data passed back with each callback. */
+  /** (optional) An RDM command has not received a response. */
+  LlrpManagerRdmCommandTimedOutCallback rdm_command_timed_out;
 } LlrpManagerCallbacks;
 
 /** A set of information that defines the startup parameters of an LLRP Manager. */
@@ -97,7 +115,10 @@ typedef struct LlrpManagerConfig
 
   /** The manager's CID. */
   EtcPalUuid cid;
-  /** The network interface that this manager operates on. */
+  /**
+   * The network interface that this manager operates on. If the IP type is kEtcPalIpTypeInvalid,
+   * the manager operates on all of the network interfaces that RDMnet is using for multicast.
+   */
   EtcPalMcastNetintId netint;
   /** The manager's ESTA manufacturer ID. */
   uint16_t manu_id;
@@ -114,9 +135,9 @@ typedef struct LlrpManagerConfig
  * // Now fill in the required portions as necessary with your data...
  * @endcode
  */
-#define LLRP_MANAGER_CONFIG_DEFAULT_INIT                            \
-  {                                                                 \
-    {{0}}, {kEtcPalIpTypeInvalid, 0}, 0, { NULL, NULL, NULL, NULL } \
+#define LLRP_MANAGER_CONFIG_DEFAULT_INIT                                  \
+  {                                                                       \
+    {{0}}, {kEtcPalIpTypeInvalid, 0}, 0, { NULL, NULL, NULL, NULL, NULL } \
   }
 
 void llrp_manager_config_init(LlrpManagerConfig* config, uint16_t manufacturer_id);
@@ -125,6 +146,8 @@ void llrp_manager_config_set_callbacks(LlrpManagerConfig*                     co
                                        LlrpManagerRdmResponseReceivedCallback rdm_response_received,
                                        LlrpManagerDiscoveryFinishedCallback   discovery_finished,
                                        void*                                  context);
+void llrp_manager_config_set_rdm_command_timed_out_callback(
+    LlrpManagerConfig* config, LlrpManagerRdmCommandTimedOutCallback rdm_command_timed_out);
 
 etcpal_error_t llrp_manager_create(const LlrpManagerConfig* config, llrp_manager_t* handle);
 etcpal_error_t llrp_manager_destroy(llrp_manager_t handle);
@@ -51,7 +51,8 @@ rdmnet::Broker::~Broker()
 /// @return Other codes translated from system error codes are possible.
 etcpal::Error rdmnet::Broker::Startup(const Settings& settings, etcpal::Logger* logger, NotifyHandler* notify)
 {
-  return core_->Startup(settings, notify, logger);
+  return core_->Startup(settings, notify, logger,
+                        BrokerComponents(CreateBrokerSocketManager(settings.socket_reader_threads)));
 }
 
 /// @brief Shut down all broker functionality and threads.
@@ -92,3 +93,13 @@ const rdmnet::Broker::Settings& rdmnet::Broker::settings() const
 {
   return core_->settings();
 }
+
+/// @brief Get a snapshot of the broker's runtime statistics.
+///
+/// The counters behind the statistics are updated without locking as messages are handled, so the
+/// totals are not guaranteed to be exactly consistent with each other. Intended to be called
+/// periodically, e.g. to find a client which is slow to consume its messages.
+rdmnet::Broker::Statistics rdmnet::Broker::GetStatistics() const
+{
+  return core_->GetStatistics();
+}
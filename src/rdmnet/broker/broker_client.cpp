@@ -25,35 +25,246 @@
 #include "rdmnet/core/connection.h"
 #include "rdmnet/core/opts.h"
 
-bool BrokerClient::HasRoomToPush()
+MessageRef PackRptMessage(const etcpal::Uuid& sender_cid, const RptMessage& msg)
 {
-  return (max_q_size_ == kLimitlessQueueSize) || (broker_msgs_.size() < max_q_size_);
+  switch (msg.vector)
+  {
+    case VECTOR_RPT_REQUEST: {
+      size_t     bufsize = rc_rpt_get_request_buffer_size(RPT_GET_RDM_BUF_LIST(&msg)->rdm_buffers);
+      MessageRef packed(bufsize);
+      if (packed.data)
+      {
+        packed.size = rc_rpt_pack_request(packed.data.get(), bufsize, &sender_cid.get(), &msg.header,
+                                          RPT_GET_RDM_BUF_LIST(&msg)->rdm_buffers);
+      }
+      return packed;
+    }
+
+    case VECTOR_RPT_STATUS: {
+      size_t     bufsize = rc_rpt_get_status_buffer_size(RPT_GET_STATUS_MSG(&msg));
+      MessageRef packed(bufsize);
+      if (packed.data)
+      {
+        packed.size =
+            rc_rpt_pack_status(packed.data.get(), bufsize, &sender_cid.get(), &msg.header, RPT_GET_STATUS_MSG(&msg));
+      }
+      return packed;
+    }
+
+    case VECTOR_RPT_NOTIFICATION: {
+      const RdmBuffer* buffers = RPT_GET_RDM_BUF_LIST(&msg)->rdm_buffers;
+      const size_t     num_buffers = RPT_GET_RDM_BUF_LIST(&msg)->num_rdm_buffers;
+
+      size_t     bufsize = rc_rpt_get_notification_buffer_size(buffers, num_buffers);
+      MessageRef packed(bufsize);
+      if (packed.data)
+      {
+        packed.size =
+            rc_rpt_pack_notification(packed.data.get(), bufsize, &sender_cid.get(), &msg.header, buffers, num_buffers);
+      }
+      return packed;
+    }
+
+    default:
+      return MessageRef{};
+  }
+}
+
+bool BrokerClient::HasRoomToPush() const
+{
+  return (max_q_size_ == kLimitlessQueueSize) || (queued_msg_count_.load(std::memory_order_relaxed) < max_q_size_);
+}
+
+// Atomically claim room for one message in the client's queues. Does not need the client's lock.
+bool BrokerClient::ReserveQueueSpace()
+{
+  if (TryReserveQueueSpace())
+    return true;
+
+  counters_.queue_full_count.fetch_add(1, std::memory_order_relaxed);
+  return false;
+}
+
+// Like ReserveQueueSpace(), but for a broadcast. A broadcast which doesn't fit is dropped for this
+// client only, so it is counted as a dropped broadcast rather than a rejected message. Does not need
+// the client's lock.
+bool BrokerClient::ReserveBroadcastQueueSpace()
+{
+  if (TryReserveQueueSpace())
+    return true;
+
+  RecordBroadcastDropped();
+  return false;
+}
+
+bool BrokerClient::TryReserveQueueSpace()
+{
+  size_t count = queued_msg_count_.load(std::memory_order_relaxed);
+  do
+  {
+    if (max_q_size_ != kLimitlessQueueSize && count >= max_q_size_)
+      return false;
+  } while (!queued_msg_count_.compare_exchange_weak(count, count + 1, std::memory_order_relaxed));
+
+  size_t high_water_mark = counters_.queue_high_water_mark.load(std::memory_order_relaxed);
+  while (count + 1 > high_water_mark &&
+         !counters_.queue_high_water_mark.compare_exchange_weak(high_water_mark, count + 1, std::memory_order_relaxed))
+  {
+  }
+  return true;
+}
+
+void BrokerClient::RecordBroadcastDropped()
+{
+  counters_.broadcasts_dropped.fetch_add(1, std::memory_order_relaxed);
+  if (!broadcast_lagging_.load(std::memory_order_acquire))
+  {
+    broadcast_lag_start_ms_.store(etcpal_getms(), std::memory_order_relaxed);
+    broadcast_lagging_.store(true, std::memory_order_release);
+  }
+}
+
+// Whether the client has been dropping broadcasts for at least timeout_ms without its queue making
+// room. Needs the client's lock.
+bool BrokerClient::BroadcastLagExpired(uint32_t timeout_ms)
+{
+  if (!broadcast_lagging_.load(std::memory_order_acquire))
+    return false;
+
+  if (HasRoomToPush())
+  {
+    broadcast_lagging_.store(false, std::memory_order_relaxed);
+    return false;
+  }
+  return (etcpal_getms() - broadcast_lag_start_ms_.load(std::memory_order_relaxed)) >= timeout_ms;
+}
+
+// Called when the last byte of a queued message has been sent.
+void BrokerClient::RecordMessageSent(const MessageRef& msg)
+{
+  counters_.messages_sent.fetch_add(1, std::memory_order_relaxed);
+
+  // Bucket 0 is under 1 ms; bucket n covers [2^(n-1), 2^n) ms; the last bucket takes the rest.
+  uint32_t latency_ms = etcpal_getms() - msg.queued_time_ms;
+  size_t   bucket = 0;
+  while (latency_ms > 0 && bucket < rdmnet::Broker::kNumLatencyBuckets - 1)
+  {
+    latency_ms >>= 1;
+    ++bucket;
+  }
+  counters_.send_latency[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+void BrokerClient::ReleaseQueueSpace(size_t num_msgs)
+{
+  queued_msg_count_.fetch_sub(num_msgs, std::memory_order_relaxed);
 }
 
 ClientPushResult BrokerClient::Push(const etcpal::Uuid& sender_cid, const BrokerMessage& msg)
 {
   if (marked_for_destruction_)
     return ClientPushResult::Error;
-  if (!HasRoomToPush())
+  if (!ReserveQueueSpace())
     return ClientPushResult::QueueFull;
 
-  return PushPostSizeCheck(sender_cid, msg);
+  ClientPushResult res = PushPostSizeCheck(sender_cid, msg);
+  if (res != ClientPushResult::Ok)
+    ReleaseQueueSpace();
+  return res;
+}
+
+// Queues a connected client list to be sent in chunks of at most kClientListChunkSize entries. Each
+// chunk is only packed when everything queued ahead of it has been sent, so a very large list is
+// never packed all at once. The first chunk is sent as a Connected Client List and the rest as Client
+// Adds, so the receiver replaces its list once and then adds to it.
+ClientPushResult BrokerClient::PushRptClientList(const etcpal::Uuid&                 sender_cid,
+                                                 std::vector<RdmnetRptClientEntry>&& entries)
+{
+  if (marked_for_destruction_)
+    return ClientPushResult::Error;
+  if (entries.empty())
+    return ClientPushResult::Ok;
+  if (!ReserveQueueSpace())
+    return ClientPushResult::QueueFull;
+
+  client_lists_.push_back(ClientListSnapshot{sender_cid, std::move(entries), 0});
+  broker_msgs_.emplace_back();
+  NotifyDataQueued();
+  return ClientPushResult::Ok;
+}
+
+// If the next broker message is the place held by a client list, packs the list's next chunk in front
+// of it. The last chunk takes over the place and its queue space.
+void BrokerClient::PackNextClientListChunk()
+{
+  if (broker_msgs_.empty() || broker_msgs_.front().data || client_lists_.empty())
+    return;
+
+  ClientListSnapshot& list = client_lists_.front();
+  size_t              num_entries = list.entries.size() - list.next_entry;
+  if (num_entries > kClientListChunkSize)
+    num_entries = kClientListChunkSize;
+  uint16_t vector = (list.next_entry == 0 ? VECTOR_BROKER_CONNECTED_CLIENT_LIST : VECTOR_BROKER_CLIENT_ADD);
+
+  size_t     bufsize = rc_broker_get_rpt_client_list_buffer_size(num_entries);
+  MessageRef chunk(bufsize);
+  chunk.size = rc_broker_pack_rpt_client_list(chunk.data.get(), bufsize, &list.sender_cid.get(), vector,
+                                              &list.entries[list.next_entry], num_entries);
+  list.next_entry += num_entries;
+
+  if (!chunk.size)
+  {
+    // Drop the rest of the list along with its place in the queue.
+    broker_msgs_.pop_front();
+    ReleaseQueueSpace();
+    client_lists_.pop_front();
+  }
+  else if (list.next_entry >= list.entries.size())
+  {
+    broker_msgs_.front() = std::move(chunk);
+    client_lists_.pop_front();
+  }
+  else
+  {
+    broker_msgs_.push_front(std::move(chunk));
+    queued_msg_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+bool BrokerClient::HasDataToSend() const
+{
+  return queued_msg_count_.load(std::memory_order_relaxed) > 0;
+}
+
+// Called by the client service thread before servicing the client. Anything queued after this
+// notifies the broker again.
+void BrokerClient::ClearServiceRequest()
+{
+  service_requested_.exchange(false, std::memory_order_acq_rel);
 }
 
 bool BrokerClient::Send(const etcpal::Uuid& broker_cid)
 {
+  if (max_send_batch_size_ != kNoSendBatching)
+    return SendBatched(broker_cid);
+
+  PackNextClientListChunk();
+
   // Try to send the next broker protocol message.
   if (!broker_msgs_.empty())
   {
     MessageRef& msg = broker_msgs_.front();
-    int         res = rc_send(socket_, &msg.data.get()[msg.size_sent], msg.size - msg.size_sent, 0);
+    int         res = SendOnSocket(&msg.data.get()[msg.size_sent], msg.size - msg.size_sent);
     if (res >= 0)
     {
+      counters_.bytes_sent.fetch_add(static_cast<uint64_t>(res), std::memory_order_relaxed);
       msg.size_sent += res;
       if (msg.size_sent >= msg.size)
       {
         // We are done with this message.
+        RecordMessageSent(msg);
         broker_msgs_.pop_front();
+        ReleaseQueueSpace();
       }
       return true;
     }
@@ -75,6 +286,9 @@ void BrokerClient::MarkForDestruction(const etcpal::Uuid&        broker_cid,
 {
   // Clear out the existing queue
   ClearAllQueues();
+  client_lists_.clear();
+  ReleaseQueueSpace(send_batch_.size());
+  send_batch_.clear();
   ApplyDestroyAction(broker_cid, broker_uid, destroy_action);
   marked_for_destruction_ = true;
 }
@@ -98,6 +312,7 @@ ClientPushResult BrokerClient::PushPostSizeCheck(const etcpal::Uuid& sender_cid,
         {
           broker_msgs_.push_back(std::move(to_push));
           res = ClientPushResult::Ok;
+          NotifyDataQueued();
         }
       }
     }
@@ -119,6 +334,7 @@ ClientPushResult BrokerClient::PushPostSizeCheck(const etcpal::Uuid& sender_cid,
           {
             broker_msgs_.push_back(std::move(to_push));
             res = ClientPushResult::Ok;
+            NotifyDataQueued();
           }
         }
       }
@@ -135,6 +351,7 @@ ClientPushResult BrokerClient::PushPostSizeCheck(const etcpal::Uuid& sender_cid,
         {
           broker_msgs_.push_back(std::move(to_push));
           res = ClientPushResult::Ok;
+          NotifyDataQueued();
         }
       }
     }
@@ -145,11 +362,127 @@ ClientPushResult BrokerClient::PushPostSizeCheck(const etcpal::Uuid& sender_cid,
   return res;
 }
 
+// Only called when nothing else is queued.
 bool BrokerClient::SendNull(const etcpal::Uuid& broker_cid)
 {
-  auto   send_buf = std::unique_ptr<uint8_t[]>(new uint8_t[BROKER_NULL_FULL_MSG_SIZE]);
-  size_t send_size = rc_broker_pack_null(send_buf.get(), BROKER_NULL_FULL_MSG_SIZE, &broker_cid.get());
-  return (rc_send(socket_, send_buf.get(), send_size, 0) >= 0);
+  MessageRef null_msg(BROKER_NULL_FULL_MSG_SIZE);
+  null_msg.size = rc_broker_pack_null(null_msg.data.get(), BROKER_NULL_FULL_MSG_SIZE, &broker_cid.get());
+
+  int res = SendOnSocket(null_msg.data.get(), null_msg.size);
+  if (res < 0)
+    return false;
+
+  if (static_cast<size_t>(res) < null_msg.size)
+  {
+    // The rest of the message must be sent before anything else is.
+    null_msg.size_sent = static_cast<size_t>(res);
+    broker_msgs_.push_front(std::move(null_msg));
+    queued_msg_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+  return true;
+}
+
+// Sends without blocking, so that a client which isn't reading can't hold up the thread servicing
+// the other clients.
+int BrokerClient::SendOnSocket(const void* data, size_t size)
+{
+  int res = etcpal_send(socket_, data, size, 0);
+  send_blocked_ = (res == kEtcPalErrWouldBlock);
+  return res;
+}
+
+// Moves queued messages into the send batch until it holds max_send_batch_size_ bytes, then sends
+// as much of the batch as the socket will accept with a single call. Messages are sent in the same
+// order as they would be by the unbatched Send(), and hold their queue space until they have been
+// completely sent.
+bool BrokerClient::SendBatched(const etcpal::Uuid& broker_cid)
+{
+  size_t batch_size = 0;
+  for (const auto& batched : send_batch_)
+    batch_size += batched.msg.size - batched.msg.size_sent;
+
+  BatchedMessage next;
+  while (batch_size < max_send_batch_size_)
+  {
+    PackNextClientListChunk();
+    if (!PopNextMessage(next))
+      break;
+    batch_size += next.msg.size - next.msg.size_sent;
+    send_batch_.push_back(std::move(next));
+  }
+
+  if (send_batch_.empty())
+  {
+    if (send_timer_.IsExpired() && SendNull(broker_cid))
+    {
+      send_timer_.Reset();
+      return true;
+    }
+    return false;
+  }
+
+  send_batch_buf_.clear();
+  for (const auto& batched : send_batch_)
+  {
+    const MessageRef& msg = batched.msg;
+    send_batch_buf_.insert(send_batch_buf_.end(), &msg.data.get()[msg.size_sent], &msg.data.get()[msg.size]);
+  }
+
+  int res = SendOnSocket(send_batch_buf_.data(), send_batch_buf_.size());
+  if (res < 0)
+  {
+    if (res != kEtcPalErrWouldBlock)
+      HandleBatchSendError();
+    return false;
+  }
+  counters_.bytes_sent.fetch_add(static_cast<uint64_t>(res), std::memory_order_relaxed);
+
+  // Advance through the batch by the number of bytes sent.
+  size_t bytes_remaining = static_cast<size_t>(res);
+  while (bytes_remaining > 0 && !send_batch_.empty())
+  {
+    MessageRef& msg = send_batch_.front().msg;
+    if (bytes_remaining >= msg.size - msg.size_sent)
+    {
+      bytes_remaining -= msg.size - msg.size_sent;
+      RecordMessageSent(msg);
+      send_batch_.pop_front();
+      ReleaseQueueSpace();
+    }
+    else
+    {
+      msg.size_sent += bytes_remaining;
+      bytes_remaining = 0;
+    }
+  }
+  send_timer_.Reset();
+  return true;
+}
+
+void BrokerClient::ClearAllQueues()
+{
+  ReleaseQueueSpace(broker_msgs_.size());
+  broker_msgs_.clear();
+}
+
+bool BrokerClient::PopNextMessage(BatchedMessage& next)
+{
+  if (broker_msgs_.empty())
+    return false;
+
+  next.msg = std::move(broker_msgs_.front());
+  next.rpt_controller = kInvalidHandle;
+  broker_msgs_.pop_front();
+  return true;
+}
+
+// Only the first message queued since the client was last serviced notifies the broker. The
+// exchange orders the message's push before the service thread's ClearServiceRequest(), so a push
+// which doesn't notify is always seen by the service pass which follows.
+void BrokerClient::NotifyDataQueued()
+{
+  if (notify_ && !service_requested_.exchange(true, std::memory_order_acq_rel))
+    notify_->HandleClientDataQueued(*this);
 }
 
 void BrokerClient::ApplyDestroyAction(const etcpal::Uuid&        broker_cid,
@@ -182,19 +515,44 @@ void BrokerClient::ApplyDestroyAction(const etcpal::Uuid&        broker_cid,
   }
 }
 
-bool RPTClient::HasRoomToPush()
+ClientPushResult RPTClient::Push(Handle from_conn, const etcpal::Uuid& sender_cid, const RptMessage& msg)
 {
-  return (broker_msgs_.size() + status_msgs_.size()) < max_q_size_;
+  if (marked_for_destruction_ || !AcceptsRoutedMessage(msg.vector))
+    return ClientPushResult::Error;
+  if (!ReserveQueueSpace())
+    return ClientPushResult::QueueFull;
+
+  return PushReserved(from_conn, msg.vector, PackRptMessage(sender_cid, msg));
 }
 
-ClientPushResult RPTClient::Push(const etcpal::Uuid& sender_cid, const BrokerMessage& msg)
+ClientPushResult RPTClient::PushPacked(Handle from_conn, uint32_t rpt_vector, const MessageRef& packed_msg)
 {
   if (marked_for_destruction_)
     return ClientPushResult::Error;
-  if (!HasRoomToPush())
+  if (!ReserveQueueSpace())
     return ClientPushResult::QueueFull;
 
-  return BrokerClient::PushPostSizeCheck(sender_cid, msg);
+  return PushReserved(from_conn, rpt_vector, packed_msg);
+}
+
+ClientPushResult RPTClient::PushReserved(Handle from_conn, uint32_t rpt_vector, const MessageRef& packed_msg)
+{
+  if (marked_for_destruction_ || !AcceptsRoutedMessage(rpt_vector) || !packed_msg.data || !packed_msg.size ||
+      !routed_msgs_.Push(RoutedMessage{from_conn, rpt_vector, packed_msg}))
+  {
+    ReleaseQueueSpace();
+    return ClientPushResult::Error;
+  }
+
+  NotifyDataQueued();
+  return ClientPushResult::Ok;
+}
+
+void RPTClient::DrainRoutedMessages()
+{
+  RoutedMessage routed;
+  while (routed_msgs_.Pop(routed))
+    QueueRoutedMessage(std::move(routed));
 }
 
 ClientPushResult RPTClient::PushPostSizeCheck(const etcpal::Uuid& sender_cid,
@@ -212,6 +570,7 @@ ClientPushResult RPTClient::PushPostSizeCheck(const etcpal::Uuid& sender_cid,
     {
       status_msgs_.push_back(std::move(to_push));
       res = ClientPushResult::Ok;
+      NotifyDataQueued();
     }
   }
   return res;
@@ -219,96 +578,47 @@ ClientPushResult RPTClient::PushPostSizeCheck(const etcpal::Uuid& sender_cid,
 
 void RPTClient::ClearAllQueues()
 {
+  DrainRoutedMessages();
+  ReleaseQueueSpace(broker_msgs_.size() + status_msgs_.size());
   broker_msgs_.clear();
   status_msgs_.clear();
 }
 
-bool RPTController::HasRoomToPush()
-{
-  return ((max_q_size_ == kLimitlessQueueSize) ||
-          (status_msgs_.size() + broker_msgs_.size() + rpt_msgs_.size()) < max_q_size_);
-}
-
-ClientPushResult RPTController::Push(BrokerClient::Handle /*from_client*/,
-                                     const etcpal::Uuid& sender_cid,
-                                     const RptMessage&   msg)
+ClientPushResult RPTController::Push(const etcpal::Uuid& sender_cid, const RptHeader& header, const RptStatusMsg& msg)
 {
   if (marked_for_destruction_)
     return ClientPushResult::Error;
-  if (!HasRoomToPush())
+  if (!ReserveQueueSpace())
     return ClientPushResult::QueueFull;
 
-  ClientPushResult res = ClientPushResult::Error;
-
-  switch (msg.vector)
-  {
-    case VECTOR_RPT_REQUEST: {
-      size_t     bufsize = rc_rpt_get_request_buffer_size(RPT_GET_RDM_BUF_LIST(&msg)->rdm_buffers);
-      MessageRef to_push(bufsize);
-      if (to_push.data)
-      {
-        to_push.size = rc_rpt_pack_request(to_push.data.get(), bufsize, &sender_cid.get(), &msg.header,
-                                           RPT_GET_RDM_BUF_LIST(&msg)->rdm_buffers);
-        if (to_push.size)
-        {
-          rpt_msgs_.push_back(std::move(to_push));
-          res = ClientPushResult::Ok;
-        }
-      }
-    }
-    break;
-
-    case VECTOR_RPT_STATUS:
-      res = RPTClient::PushPostSizeCheck(sender_cid, msg.header, *RPT_GET_STATUS_MSG(&msg));
-      break;
-
-    case VECTOR_RPT_NOTIFICATION: {
-      const RdmBuffer* buffers = RPT_GET_RDM_BUF_LIST(&msg)->rdm_buffers;
-      const size_t     num_buffers = RPT_GET_RDM_BUF_LIST(&msg)->num_rdm_buffers;
-
-      size_t     bufsize = rc_rpt_get_notification_buffer_size(buffers, num_buffers);
-      MessageRef to_push(bufsize);
-      if (to_push.data)
-      {
-        to_push.size =
-            rc_rpt_pack_notification(to_push.data.get(), bufsize, &sender_cid.get(), &msg.header, buffers, num_buffers);
-        if (to_push.size)
-        {
-          rpt_msgs_.push_back(std::move(to_push));
-          res = ClientPushResult::Ok;
-        }
-      }
-    }
-    break;
-
-    default:
-      break;
-  }
+  ClientPushResult res = PushPostSizeCheck(sender_cid, header, msg);
+  if (res != ClientPushResult::Ok)
+    ReleaseQueueSpace();
   return res;
 }
 
-ClientPushResult RPTController::Push(const etcpal::Uuid& sender_cid, const BrokerMessage& msg)
+bool RPTController::AcceptsRoutedMessage(uint32_t rpt_vector) const
 {
-  if (marked_for_destruction_)
-    return ClientPushResult::Error;
-  if (!HasRoomToPush())
-    return ClientPushResult::QueueFull;
-
-  return BrokerClient::PushPostSizeCheck(sender_cid, msg);
+  return (rpt_vector == VECTOR_RPT_REQUEST || rpt_vector == VECTOR_RPT_NOTIFICATION || rpt_vector == VECTOR_RPT_STATUS);
 }
 
-ClientPushResult RPTController::Push(const etcpal::Uuid& sender_cid, const RptHeader& header, const RptStatusMsg& msg)
+void RPTController::QueueRoutedMessage(RoutedMessage&& routed)
 {
-  if (marked_for_destruction_)
-    return ClientPushResult::Error;
-  if (!HasRoomToPush())
-    return ClientPushResult::QueueFull;
-
-  return PushPostSizeCheck(sender_cid, header, msg);
+  if (routed.rpt_vector == VECTOR_RPT_STATUS)
+    status_msgs_.push_back(std::move(routed.msg));
+  else
+    rpt_msgs_.push_back(std::move(routed.msg));
 }
 
 bool RPTController::Send(const etcpal::Uuid& broker_cid)
 {
+  DrainRoutedMessages();
+
+  if (max_send_batch_size_ != kNoSendBatching)
+    return SendBatched(broker_cid);
+
+  PackNextClientListChunk();
+
   MessageRef*             msg = nullptr;
   std::deque<MessageRef>* q = nullptr;
 
@@ -332,14 +642,17 @@ bool RPTController::Send(const etcpal::Uuid& broker_cid)
   // Try to send the message.
   if (msg && q)
   {
-    int res = rc_send(socket_, &msg->data.get()[msg->size_sent], msg->size - msg->size_sent, 0);
+    int res = SendOnSocket(&msg->data.get()[msg->size_sent], msg->size - msg->size_sent);
     if (res >= 0)
     {
+      counters_.bytes_sent.fetch_add(static_cast<uint64_t>(res), std::memory_order_relaxed);
       msg->size_sent += res;
       if (msg->size_sent >= msg->size)
       {
         // We are done with this message.
+        RecordMessageSent(*msg);
         q->pop_front();
+        ReleaseQueueSpace();
         send_timer_.Reset();
       }
       return true;
@@ -358,68 +671,55 @@ bool RPTController::Send(const etcpal::Uuid& broker_cid)
 
 void RPTController::ClearAllQueues()
 {
+  DrainRoutedMessages();
+  ReleaseQueueSpace(rpt_msgs_.size() + status_msgs_.size() + broker_msgs_.size());
   rpt_msgs_.clear();
   status_msgs_.clear();
   broker_msgs_.clear();
 }
 
-bool RPTDevice::HasRoomToPush()
-{
-  return ((max_q_size_ == kLimitlessQueueSize) ||
-          (status_msgs_.size() + broker_msgs_.size() + rpt_msgs_.size()) < max_q_size_);
-}
-
-ClientPushResult RPTDevice::Push(BrokerClient::Handle from_client,
-                                 const etcpal::Uuid&  sender_cid,
-                                 const RptMessage&    msg)
+bool RPTController::PopNextMessage(BatchedMessage& next)
 {
-  if (marked_for_destruction_)
-    return ClientPushResult::Error;
-  if (!HasRoomToPush())
-    return ClientPushResult::QueueFull;
-
-  ClientPushResult res = ClientPushResult::Error;
-
-  switch (msg.vector)
-  {
-    case VECTOR_RPT_STATUS:
-      res = RPTClient::PushPostSizeCheck(sender_cid, msg.header, *RPT_GET_STATUS_MSG(&msg));
-      break;
+  // Broker messages are first priority, then status messages, then RPT messages.
+  std::deque<MessageRef>* q = nullptr;
+  if (!broker_msgs_.empty())
+    q = &broker_msgs_;
+  else if (!status_msgs_.empty())
+    q = &status_msgs_;
+  else if (!rpt_msgs_.empty())
+    q = &rpt_msgs_;
 
-    case VECTOR_RPT_REQUEST: {
-      size_t     bufsize = rc_rpt_get_request_buffer_size(RPT_GET_RDM_BUF_LIST(&msg)->rdm_buffers);
-      MessageRef to_push(bufsize);
-      if (to_push.data)
-      {
-        to_push.size = rc_rpt_pack_request(to_push.data.get(), bufsize, &sender_cid.get(), &msg.header,
-                                           RPT_GET_RDM_BUF_LIST(&msg)->rdm_buffers);
-        if (to_push.size)
-        {
-          rpt_msgs_.push_back(from_client, std::move(to_push));
-          res = ClientPushResult::Ok;
-        }
-      }
-    }
-    break;
+  if (!q)
+    return false;
 
-    default:
-      break;
-  }
-  return res;
+  next.msg = std::move(q->front());
+  next.rpt_controller = kInvalidHandle;
+  q->pop_front();
+  return true;
 }
 
-ClientPushResult RPTDevice::Push(const etcpal::Uuid& sender_cid, const BrokerMessage& msg)
+bool RPTDevice::AcceptsRoutedMessage(uint32_t rpt_vector) const
 {
-  if (marked_for_destruction_)
-    return ClientPushResult::Error;
-  if (!HasRoomToPush())
-    return ClientPushResult::QueueFull;
+  return (rpt_vector == VECTOR_RPT_STATUS || rpt_vector == VECTOR_RPT_REQUEST);
+}
 
-  return BrokerClient::PushPostSizeCheck(sender_cid, msg);
+void RPTDevice::QueueRoutedMessage(RoutedMessage&& routed)
+{
+  if (routed.rpt_vector == VECTOR_RPT_STATUS)
+    status_msgs_.push_back(std::move(routed.msg));
+  else
+    rpt_msgs_.push_back(routed.from_conn, std::move(routed.msg));
 }
 
 bool RPTDevice::Send(const etcpal::Uuid& broker_cid)
 {
+  DrainRoutedMessages();
+
+  if (max_send_batch_size_ != kNoSendBatching)
+    return SendBatched(broker_cid);
+
+  PackNextClientListChunk();
+
   MessageRef* msg = nullptr;
   bool        is_rpt = false;
 
@@ -440,18 +740,21 @@ bool RPTDevice::Send(const etcpal::Uuid& broker_cid)
   // Try to send the message.
   if (msg)
   {
-    int res = rc_send(socket_, &msg->data.get()[msg->size_sent], msg->size - msg->size_sent, 0);
+    int res = SendOnSocket(&msg->data.get()[msg->size_sent], msg->size - msg->size_sent);
     if (res >= 0)
     {
+      counters_.bytes_sent.fetch_add(static_cast<uint64_t>(res), std::memory_order_relaxed);
       msg->size_sent += res;
       if (msg->size_sent >= msg->size)
       {
         // We are done with this message.
+        RecordMessageSent(*msg);
         send_timer_.Reset();
         if (is_rpt)
           rpt_msgs_.pop_front();
         else
           broker_msgs_.pop_front();
+        ReleaseQueueSpace();
       }
       return true;
     }
@@ -460,7 +763,7 @@ bool RPTDevice::Send(const etcpal::Uuid& broker_cid)
       // Error in sending. If this is an RPT message, delete the reference to this controller (and
       // clear out the queue)
       if (is_rpt)
-        rpt_msgs_.RemoveCurrentController();
+        ReleaseQueueSpace(rpt_msgs_.RemoveCurrentController());
     }
   }
   else if (send_timer_.IsExpired())
@@ -476,11 +779,59 @@ bool RPTDevice::Send(const etcpal::Uuid& broker_cid)
 
 void RPTDevice::ClearAllQueues()
 {
+  DrainRoutedMessages();
+  ReleaseQueueSpace(rpt_msgs_.size() + status_msgs_.size() + broker_msgs_.size());
   rpt_msgs_.clear();
   status_msgs_.clear();
   broker_msgs_.clear();
 }
 
+bool RPTDevice::PopNextMessage(BatchedMessage& next)
+{
+  // Broker messages are first priority, then RPT messages, taken from each controller in turn.
+  if (!broker_msgs_.empty())
+  {
+    next.msg = std::move(broker_msgs_.front());
+    next.rpt_controller = kInvalidHandle;
+    broker_msgs_.pop_front();
+    return true;
+  }
+
+  MessageRef* rpt_msg = rpt_msgs_.empty() ? nullptr : rpt_msgs_.front();
+  if (rpt_msg)
+  {
+    next.msg = std::move(*rpt_msg);
+    next.rpt_controller = rpt_msgs_.current_controller();
+    rpt_msgs_.pop_front();
+    return true;
+  }
+  return false;
+}
+
+// As in the unbatched Send(), an error sending an RPT message deletes the reference to the
+// controller it came from, including its messages which are already in the batch.
+void RPTDevice::HandleBatchSendError()
+{
+  Handle controller = send_batch_.front().rpt_controller;
+  if (controller == kInvalidHandle)
+    return;
+
+  size_t num_removed = rpt_msgs_.RemoveController(controller);
+  for (auto batched = send_batch_.begin(); batched != send_batch_.end();)
+  {
+    if (batched->rpt_controller == controller)
+    {
+      batched = send_batch_.erase(batched);
+      ++num_removed;
+    }
+    else
+    {
+      ++batched;
+    }
+  }
+  ReleaseQueueSpace(num_removed);
+}
+
 bool RPTDevice::RptMsgQ::empty() const
 {
   return total_msg_count_ == 0;
@@ -532,14 +883,17 @@ size_t RPTDevice::RptMsgQ::size() const
   return total_msg_count_;
 }
 
-void RPTDevice::RptMsgQ::RemoveCurrentController()
+size_t RPTDevice::RptMsgQ::RemoveController(Handle controller)
 {
-  auto controller_pair = rpt_msgs_.find(current_controller_);
+  size_t num_removed = 0;
+  auto   controller_pair = rpt_msgs_.find(controller);
   if (controller_pair != rpt_msgs_.end())
   {
-    total_msg_count_ -= controller_pair->second.size();
+    num_removed = controller_pair->second.size();
+    total_msg_count_ -= num_removed;
     rpt_msgs_.erase(controller_pair);
   }
+  return num_removed;
 }
 
 void RPTDevice::RptMsgQ::clear()
@@ -22,11 +22,15 @@
 #ifndef BROKER_CLIENT_H_
 #define BROKER_CLIENT_H_
 
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <memory>
 #include <map>
 #include <deque>
+#include <new>
 #include <stdexcept>
+#include <vector>
 #include "etcpal/cpp/error.h"
 #include "etcpal/cpp/inet.h"
 #include "etcpal/cpp/rwlock.h"
@@ -37,18 +41,114 @@
 #include "rdm/message.h"
 #include "rdmnet/core/message.h"
 #include "rdmnet/core/rpt_prot.h"
+#include "rdmnet/cpp/broker.h"
 #include "rdmnet/defs.h"
 
+// A reference to a packed message in a client's send queue. The packed data is not modified after
+// it is queued, so it can be shared between the queues of many clients (e.g. for broadcasts); each
+// reference tracks its own send progress.
 struct MessageRef
 {
   MessageRef() = default;
-  MessageRef(size_t alloc_size) : data(new uint8_t[alloc_size]) {}
+  MessageRef(size_t alloc_size)
+      : data(new uint8_t[alloc_size], std::default_delete<uint8_t[]>()), queued_time_ms(etcpal_getms())
+  {
+  }
+
+  std::shared_ptr<uint8_t> data;
+  size_t                   size{0};
+  size_t                   size_sent{0};
+  // When the message was packed to be queued, for measuring how long it waits to be sent.
+  uint32_t queued_time_ms{0};
+};
+
+// Counters kept for rdmnet::Broker::GetStatistics(). They are updated with relaxed atomic operations
+// so that they can be read without the client's lock.
+struct BrokerClientCounters
+{
+  std::atomic<size_t>   queue_high_water_mark{0};
+  std::atomic<uint64_t> queue_full_count{0};
+  std::atomic<uint64_t> broadcasts_dropped{0};
+  std::atomic<uint64_t> messages_sent{0};
+  std::atomic<uint64_t> bytes_sent{0};
+  std::atomic<uint64_t> messages_received{0};
+
+  std::array<std::atomic<uint64_t>, rdmnet::Broker::kNumLatencyBuckets> send_latency{};
+};
+
+// Pack an RPT message into a new MessageRef which can then be pushed to any number of clients
+// using RPTClient::PushPacked(). Returns a MessageRef with null data on failure.
+MessageRef PackRptMessage(const etcpal::Uuid& sender_cid, const RptMessage& msg);
+
+// An unbounded multi-producer, single-consumer queue. Push() is lock-free and may be called from any
+// number of threads at once; Pop() must only be called by one thread at a time. Bounds are enforced
+// by the user of the queue.
+template <typename T>
+class MpscQueue
+{
+public:
+  MpscQueue() = default;
+  MpscQueue(const MpscQueue&) = delete;
+  MpscQueue& operator=(const MpscQueue&) = delete;
+  ~MpscQueue();
+
+  bool Push(T&& value);
+  bool Pop(T& value);
+
+private:
+  struct Node
+  {
+    Node() = default;
+    explicit Node(T&& new_value) : value(std::move(new_value)) {}
 
-  std::unique_ptr<uint8_t[]> data;
-  size_t                     size{0};
-  size_t                     size_sent{0};
+    std::atomic<Node*> next{nullptr};
+    T                  value{};
+  };
+
+  // Producers append at head_; the consumer removes from tail_. tail_ always points to a node whose
+  // value has already been consumed (initially stub_).
+  Node               stub_;
+  std::atomic<Node*> head_{&stub_};
+  Node*              tail_{&stub_};
 };
 
+template <typename T>
+MpscQueue<T>::~MpscQueue()
+{
+  T discard;
+  while (Pop(discard))
+    ;
+  if (tail_ != &stub_)
+    delete tail_;
+}
+
+template <typename T>
+bool MpscQueue<T>::Push(T&& value)
+{
+  Node* node = new (std::nothrow) Node(std::move(value));
+  if (!node)
+    return false;
+
+  Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+  prev->next.store(node, std::memory_order_release);
+  return true;
+}
+
+// Returns false if the queue is empty, or if the only pushes in progress have not yet completed.
+template <typename T>
+bool MpscQueue<T>::Pop(T& value)
+{
+  Node* next = tail_->next.load(std::memory_order_acquire);
+  if (!next)
+    return false;
+
+  value = std::move(next->value);
+  if (tail_ != &stub_)
+    delete tail_;
+  tail_ = next;
+  return true;
+}
+
 // RPT RDM messages are two sets of data, the RPT header and the RDM message.
 struct RPTMessageRef
 {
@@ -128,6 +228,18 @@ enum class ClientPushResult
   Error       // Other classes of error, e.g. could not allocate memory
 };
 
+class BrokerClient;
+
+// The interface for notifications from broker clients.
+class BrokerClientNotify
+{
+public:
+  // A message was queued to be sent to a client which wasn't already waiting to be serviced. This may
+  // be called with the client's lock held, or from a routing thread that does not hold it, so it
+  // should only record that the client needs servicing.
+  virtual void HandleClientDataQueued(BrokerClient& client) = 0;
+};
+
 // A generic client.
 // Each component that connects to a broker is a client. The broker uses the common functionality
 // defined in this class to handle each client to which it is connected.
@@ -141,6 +253,9 @@ public:
 
   static constexpr Handle kInvalidHandle = -1;
   static constexpr size_t kLimitlessQueueSize = 0u;
+  static constexpr size_t kNoSendBatching = 0u;
+  // The maximum number of entries packed into each message when sending a client list.
+  static constexpr size_t kClientListChunkSize = 256u;
 
   BrokerClient(Handle new_handle, etcpal_socket_t new_socket, size_t new_max_q_size = 0)
       : handle_(new_handle), socket_(new_socket), max_q_size_(new_max_q_size)
@@ -154,19 +269,39 @@ public:
       , handle_(other.handle_)
       , socket_(other.socket_)
       , max_q_size_(other.max_q_size_)
+      , max_send_batch_size_(other.max_send_batch_size_)
+      , notify_(other.notify_)
   {
   }
   virtual ~BrokerClient() = default;
 
-  virtual bool             HasRoomToPush();
+  bool                     HasRoomToPush() const;
+  bool                     ReserveQueueSpace();
+  bool                     ReserveBroadcastQueueSpace();
+  void                     ReleaseQueueSpace(size_t num_msgs = 1);
+  bool                     BroadcastLagExpired(uint32_t timeout_ms);
+  bool                     HasDataToSend() const;
+  bool                     SendBlocked() const { return send_blocked_; }
+  void                     ClearServiceRequest();
   virtual ClientPushResult Push(const etcpal::Uuid& sender_cid, const BrokerMessage& msg);
+  ClientPushResult         PushRptClientList(const etcpal::Uuid&                 sender_cid,
+                                             std::vector<RdmnetRptClientEntry>&& entries);
   virtual bool             Send(const etcpal::Uuid& broker_cid);
   void                     MarkForDestruction(const etcpal::Uuid&        broker_cid,
                                               const rdm::Uid&            broker_uid,
                                               const ClientDestroyAction& destroy_action);
 
   bool TcpConnExpired() const { return heartbeat_timer_.IsExpired(); }
-  void MessageReceived() { heartbeat_timer_.Reset(); }
+  // A message which is to be retried later is not counted until the retry handles it.
+  void MessageReceived(bool handled)
+  {
+    heartbeat_timer_.Reset();
+    if (handled)
+      counters_.messages_received.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  size_t                      queue_depth() const { return queued_msg_count_.load(std::memory_order_relaxed); }
+  const BrokerClientCounters& counters() const { return counters_; }
 
   etcpal::Uuid           cid_{};
   client_protocol_t      client_protocol_{kClientProtocolUnknown};
@@ -175,18 +310,78 @@ public:
   mutable etcpal::RwLock lock_;
   etcpal_socket_t        socket_{ETCPAL_SOCKET_INVALID};
   size_t                 max_q_size_{kLimitlessQueueSize};
-  bool                   marked_for_destruction_{false};
+  size_t                 max_send_batch_size_{kNoSendBatching};
+  std::atomic<bool>      marked_for_destruction_{false};
+  BrokerClientNotify*    notify_{nullptr};
 
 protected:
   ClientPushResult PushPostSizeCheck(const etcpal::Uuid& sender_cid, const BrokerMessage& msg);
   bool             SendNull(const etcpal::Uuid& broker_cid);
+  int              SendOnSocket(const void* data, size_t size);
+  bool             TryReserveQueueSpace();
+  void             RecordBroadcastDropped();
+  bool             SendBatched(const etcpal::Uuid& broker_cid);
+  void             PackNextClientListChunk();
+  void             RecordMessageSent(const MessageRef& msg);
+  void             NotifyDataQueued();
   void             ApplyDestroyAction(const etcpal::Uuid&        broker_cid,
                                       const rdm::Uid&            broker_uid,
                                       const ClientDestroyAction& destroy_action);
 
-  virtual void ClearAllQueues() { broker_msgs_.clear(); }
+  // A message which has been removed from the queues to be sent as part of a batch. It keeps its
+  // queue space until it has been completely sent.
+  struct BatchedMessage
+  {
+    MessageRef msg;
+    // For RPT messages queued to a device, the controller which sent the message.
+    Handle rpt_controller{kInvalidHandle};
+  };
+
+  virtual void ClearAllQueues();
+  // Remove the next message to send from the client's queues, in priority order. Used when sends
+  // are batched.
+  virtual bool PopNextMessage(BatchedMessage& next);
+  // Called when sending a batch fails with an error other than kEtcPalErrWouldBlock.
+  virtual void HandleBatchSendError() {}
 
   std::deque<MessageRef> broker_msgs_;
+
+  // Client lists which are being sent in chunks. Each one holds its place in broker_msgs_ with an
+  // empty MessageRef, ahead of which its chunks are packed one at a time as the queue drains.
+  struct ClientListSnapshot
+  {
+    etcpal::Uuid                      sender_cid;
+    std::vector<RdmnetRptClientEntry> entries;
+    size_t                            next_entry;
+  };
+  std::deque<ClientListSnapshot> client_lists_;
+
+  // Set when a broadcast is dropped because the client's queue is full, and cleared once the queue
+  // has room again. Set and read without the client's lock.
+  std::atomic<bool>     broadcast_lagging_{false};
+  std::atomic<uint32_t> broadcast_lag_start_ms_{0};
+
+  // The number of messages in all of the client's queues, including routed messages which have not
+  // yet been moved into them. Updated atomically so that routing threads can reserve queue space
+  // without the client's lock.
+  std::atomic<size_t> queued_msg_count_{0};
+
+  // Set when data is queued to the client and the broker has been told it needs servicing, and
+  // cleared when the client service thread starts servicing it. Only the push which sets it notifies
+  // the broker, so a busy client doesn't take the broker's service lock for every message.
+  std::atomic<bool> service_requested_{false};
+
+  // Set when the last send on the socket failed with kEtcPalErrWouldBlock. Sends never block; the
+  // unsent data stays queued until the socket manager reports that the socket is writable again.
+  bool send_blocked_{false};
+
+  BrokerClientCounters counters_;
+
+  // Messages which have been removed from the queues to be sent as a batch, and the buffer into
+  // which they are gathered for sending.
+  std::deque<BatchedMessage> send_batch_;
+  std::vector<uint8_t>       send_batch_buf_;
+
   etcpal::Timer          send_timer_{std::chrono::seconds(E133_TCP_HEARTBEAT_INTERVAL_SEC)};
   etcpal::Timer          heartbeat_timer_{std::chrono::seconds(E133_HEARTBEAT_TIMEOUT_SEC)};
 };
@@ -223,23 +418,44 @@ public:
   }
   virtual ~RPTClient() {}
 
-  virtual ClientPushResult Push(Handle /*from_conn*/, const etcpal::Uuid& /*sender_cid*/, const RptMessage& /*msg*/)
-  {
-    return ClientPushResult::Error;
-  }
+  using BrokerClient::Push;
 
-  virtual bool             HasRoomToPush() override;
-  virtual ClientPushResult Push(const etcpal::Uuid& sender_cid, const BrokerMessage& msg) override;
+  // The functions for routing RPT messages to a client do not need the client's lock, so that
+  // routing does not contend with the thread sending the client's queued data.
+  ClientPushResult Push(Handle from_conn, const etcpal::Uuid& sender_cid, const RptMessage& msg);
+  // Push an RPT message previously packed with PackRptMessage(). The packed data is shared, not
+  // copied.
+  ClientPushResult PushPacked(Handle from_conn, uint32_t rpt_vector, const MessageRef& packed_msg);
+  // Push a packed RPT message for which queue space has already been reserved using
+  // ReserveQueueSpace() or ReserveBroadcastQueueSpace(). The reservation is released if the push
+  // fails.
+  ClientPushResult PushReserved(Handle from_conn, uint32_t rpt_vector, const MessageRef& packed_msg);
 
   RdmUid            uid_{};
   rpt_client_type_t client_type_{kRPTClientTypeUnknown};
   etcpal::Uuid      binding_cid_{};
 
 protected:
+  // An RPT message routed to this client which has not yet been moved into its queues.
+  struct RoutedMessage
+  {
+    Handle     from_conn{kInvalidHandle};
+    uint32_t   rpt_vector{0};
+    MessageRef msg;
+  };
+
   ClientPushResult PushPostSizeCheck(const etcpal::Uuid& sender_cid, const RptHeader& header, const RptStatusMsg& msg);
-  virtual void     ClearAllQueues();
+  virtual void     ClearAllQueues() override;
+
+  // Whether messages with the given RPT vector can be routed to this type of client.
+  virtual bool AcceptsRoutedMessage(uint32_t /*rpt_vector*/) const { return false; }
+  // Move a routed message into the client's queues. Called with the client's lock held.
+  virtual void QueueRoutedMessage(RoutedMessage&& /*routed*/) {}
+  // Move all routed messages into the client's queues. Called with the client's lock held.
+  void DrainRoutedMessages();
 
-  std::deque<MessageRef> status_msgs_;
+  std::deque<MessageRef>   status_msgs_;
+  MpscQueue<RoutedMessage> routed_msgs_;
 };
 
 struct EPTClient : public BrokerClient
@@ -257,14 +473,16 @@ public:
   }
   virtual ~RPTController() {}
 
-  virtual bool             HasRoomToPush() override;
-  virtual ClientPushResult Push(Handle from_conn, const etcpal::Uuid& sender_cid, const RptMessage& msg) override;
-  virtual ClientPushResult Push(const etcpal::Uuid& sender_cid, const BrokerMessage& msg) override;
+  using RPTClient::Push;
+
   virtual ClientPushResult Push(const etcpal::Uuid& sender_cid, const RptHeader& header, const RptStatusMsg& msg);
   virtual bool             Send(const etcpal::Uuid& broker_cid) override;
 
 protected:
-  virtual void ClearAllQueues();
+  virtual void ClearAllQueues() override;
+  virtual bool PopNextMessage(BatchedMessage& next) override;
+  virtual bool AcceptsRoutedMessage(uint32_t rpt_vector) const override;
+  virtual void QueueRoutedMessage(RoutedMessage&& routed) override;
 
   std::deque<MessageRef> rpt_msgs_;
 };
@@ -280,13 +498,14 @@ public:
   }
   virtual ~RPTDevice() {}
 
-  virtual bool             HasRoomToPush() override;
-  virtual ClientPushResult Push(Handle from_conn, const etcpal::Uuid& sender_cid, const RptMessage& msg) override;
-  virtual ClientPushResult Push(const etcpal::Uuid& sender_cid, const BrokerMessage& msg) override;
-  virtual bool             Send(const etcpal::Uuid& broker_cid) override;
+  virtual bool Send(const etcpal::Uuid& broker_cid) override;
 
 protected:
-  virtual void ClearAllQueues();
+  virtual void ClearAllQueues() override;
+  virtual bool PopNextMessage(BatchedMessage& next) override;
+  virtual void HandleBatchSendError() override;
+  virtual bool AcceptsRoutedMessage(uint32_t rpt_vector) const override;
+  virtual void QueueRoutedMessage(RoutedMessage&& routed) override;
 
   // A special queue-like class that organizes messages by source controller for fair scheduling.
   class RptMsgQ
@@ -299,7 +518,12 @@ protected:
     size_t      size() const;
     void        clear();
 
-    void RemoveCurrentController();
+    // The controller whose message was last returned by front().
+    Handle current_controller() const { return current_controller_; }
+
+    // Returns the number of messages removed.
+    size_t RemoveController(Handle controller);
+    size_t RemoveCurrentController() { return RemoveController(current_controller_); }
 
   private:
     size_t                                   total_msg_count_{0};
@@ -88,6 +88,17 @@ etcpal::Error BrokerCore::Startup(const rdmnet::Broker::Settings& settings,
     components_.handle_generator.SetValueInUseFunc(
         [&](BrokerClient::Handle handle) { return clients_.find(handle) != clients_.end(); });
 
+    // Statistics cover a single session.
+    bytes_received_ = 0;
+    rpt_requests_routed_ = 0;
+    rpt_notifications_routed_ = 0;
+    rpt_status_routed_ = 0;
+    destroyed_client_totals_ = rdmnet::Broker::Statistics();
+    last_stats_time_ms_ = etcpal_getms();
+    last_rpt_requests_routed_ = 0;
+    last_rpt_notifications_routed_ = 0;
+    last_rpt_status_routed_ = 0;
+
     // Generate IDs if necessary
     my_uid_ = settings.uid;
     if (settings.uid.IsDynamicUidRequest())
@@ -96,8 +107,21 @@ etcpal::Error BrokerCore::Startup(const rdmnet::Broker::Settings& settings,
       components_.uids.SetNextDeviceId(2);
     }
 
+    components_.uids.SetReservationMaxAge(settings_.uid_reservation_max_age_s);
+    if (!settings_.uid_reservation_file.empty())
+    {
+      auto res = components_.uids.OpenReservationFile(settings_.uid_reservation_file);
+      if (!res)
+      {
+        BROKER_LOG_ERR("Broker: Failed to open dynamic UID reservation file \"%s\" with error: %s.",
+                       settings_.uid_reservation_file.c_str(), res.ToCString());
+        return res;
+      }
+    }
+
     if (!components_.socket_mgr->Startup())
     {
+      components_.uids.CloseReservationFile();
       return kEtcPalErrSys;
     }
 
@@ -105,6 +129,7 @@ etcpal::Error BrokerCore::Startup(const rdmnet::Broker::Settings& settings,
     if (!err)
     {
       components_.socket_mgr->Shutdown();
+      components_.uids.CloseReservationFile();
       return err;
     }
 
@@ -137,6 +162,7 @@ void BrokerCore::Shutdown(rdmnet_disconnect_reason_t disconnect_reason)
     components_.disc->UnregisterBroker();
     StopBrokerServices(disconnect_reason);
     components_.socket_mgr->Shutdown();
+    components_.uids.CloseReservationFile();
 
     started_ = false;
   }
@@ -165,8 +191,7 @@ bool BrokerCore::IsValidControllerDestinationUID(const RdmUid& uid) const
     return true;
 
   // TODO this should only check devices
-  BrokerClient::Handle tmp;
-  return components_.uids.UidToHandle(uid, tmp);
+  return FindRptClient(uid) != nullptr;
 }
 
 bool BrokerCore::IsValidDeviceDestinationUID(const RdmUid& uid) const
@@ -175,8 +200,86 @@ bool BrokerCore::IsValidDeviceDestinationUID(const RdmUid& uid) const
     return true;
 
   // TODO this should only check controllers
-  BrokerClient::Handle tmp;
-  return components_.uids.UidToHandle(uid, tmp);
+  return FindRptClient(uid) != nullptr;
+}
+
+// Adds a client's counters to the broker-wide totals in stats.
+static void AddClientCounters(rdmnet::Broker::Statistics& stats, const BrokerClient& client)
+{
+  const BrokerClientCounters& counters = client.counters();
+  stats.messages_received += counters.messages_received.load(std::memory_order_relaxed);
+  stats.messages_sent += counters.messages_sent.load(std::memory_order_relaxed);
+  stats.bytes_sent += counters.bytes_sent.load(std::memory_order_relaxed);
+  stats.queue_full_count += counters.queue_full_count.load(std::memory_order_relaxed);
+  stats.broadcast_drop_count += counters.broadcasts_dropped.load(std::memory_order_relaxed);
+  for (size_t i = 0; i < rdmnet::Broker::kNumLatencyBuckets; ++i)
+    stats.send_latency_histogram[i] += counters.send_latency[i].load(std::memory_order_relaxed);
+}
+
+// This function grabs a read lock on client_lock_.
+rdmnet::Broker::Statistics BrokerCore::GetStatistics()
+{
+  rdmnet::Broker::Statistics stats;
+
+  {  // Client read lock scope
+    etcpal::ReadGuard clients_read(client_lock_);
+
+    stats = destroyed_client_totals_;
+    stats.num_clients = clients_.size();
+    stats.num_controllers = controllers_.size();
+    stats.num_devices = devices_.size();
+
+    stats.clients.reserve(clients_.size());
+    for (const auto& client_pair : clients_)
+    {
+      const BrokerClient&         client = *client_pair.second;
+      const BrokerClientCounters& counters = client.counters();
+      AddClientCounters(stats, client);
+
+      stats.clients.emplace_back();
+      rdmnet::Broker::ClientStatistics& client_stats = stats.clients.back();
+      client_stats.handle = client.handle_;
+      client_stats.cid = client.cid_;
+      client_stats.addr = client.addr_;
+      if (client.client_protocol_ == E133_CLIENT_PROTOCOL_RPT)
+      {
+        const RPTClient& rptcli = static_cast<const RPTClient&>(client);
+        client_stats.is_rpt = true;
+        client_stats.uid = rptcli.uid_;
+        client_stats.rpt_type = rptcli.client_type_;
+      }
+      client_stats.queue_depth = client.queue_depth();
+      client_stats.queue_high_water_mark = counters.queue_high_water_mark.load(std::memory_order_relaxed);
+      client_stats.queue_full_count = counters.queue_full_count.load(std::memory_order_relaxed);
+      client_stats.broadcast_drop_count = counters.broadcasts_dropped.load(std::memory_order_relaxed);
+      client_stats.messages_sent = counters.messages_sent.load(std::memory_order_relaxed);
+      client_stats.bytes_sent = counters.bytes_sent.load(std::memory_order_relaxed);
+      client_stats.messages_received = counters.messages_received.load(std::memory_order_relaxed);
+    }
+  }
+
+  stats.bytes_received = bytes_received_.load(std::memory_order_relaxed);
+  stats.rpt_requests_routed = rpt_requests_routed_.load(std::memory_order_relaxed);
+  stats.rpt_notifications_routed = rpt_notifications_routed_.load(std::memory_order_relaxed);
+  stats.rpt_status_routed = rpt_status_routed_.load(std::memory_order_relaxed);
+
+  etcpal::MutexGuard stats_guard(stats_lock_);
+  uint32_t           now = etcpal_getms();
+  uint32_t           interval_ms = now - last_stats_time_ms_;
+  if (interval_ms > 0)
+  {
+    double interval_sec = interval_ms / 1000.0;
+    stats.rpt_requests_per_second = (stats.rpt_requests_routed - last_rpt_requests_routed_) / interval_sec;
+    stats.rpt_notifications_per_second =
+        (stats.rpt_notifications_routed - last_rpt_notifications_routed_) / interval_sec;
+    stats.rpt_status_per_second = (stats.rpt_status_routed - last_rpt_status_routed_) / interval_sec;
+  }
+  last_stats_time_ms_ = now;
+  last_rpt_requests_routed_ = stats.rpt_requests_routed;
+  last_rpt_notifications_routed_ = stats.rpt_notifications_routed;
+  last_rpt_status_routed_ = stats.rpt_status_routed;
+
+  return stats;
 }
 
 size_t BrokerCore::GetNumClients() const
@@ -367,10 +470,14 @@ void BrokerCore::StopBrokerServices(rdmnet_disconnect_reason_t disconnect_reason
   {
     ClientWriteGuard client_write(*client_pair.second);
     MarkLockedClientForDestruction(*client_pair.second, ClientDestroyAction::SendDisconnect(disconnect_reason));
+    // Best effort; a client whose socket is full doesn't get the disconnect message.
     client_pair.second->Send(settings_.cid);
   }
 
   DestroyMarkedClientsLocked();
+
+  etcpal::MutexGuard list_guard(client_list_lock_);
+  client_list_deltas_ = ClientListDeltas();
 }
 
 bool BrokerCore::HandleNewConnection(etcpal_socket_t new_sock, const etcpal::SockAddr& addr)
@@ -405,6 +512,8 @@ bool BrokerCore::HandleNewConnection(etcpal_socket_t new_sock, const etcpal::Soc
       if (client)
       {
         client->addr_ = addr;
+        client->notify_ = this;
+        client->max_send_batch_size_ = settings_.max_send_batch_size;
         clients_.insert(std::make_pair(new_handle, std::move(client)));
         components_.socket_mgr->AddSocket(new_handle, new_sock);
         result = true;
@@ -424,35 +533,121 @@ bool BrokerCore::HandleNewConnection(etcpal_socket_t new_sock, const etcpal::Soc
   return result;
 }
 
-// Process each controller queue, sending out the next message from each queue if devices are
-// available. Also sends connect reply, error and status messages generated asynchronously to
-// devices.  Return false if no controllers messages were sent.
+// Process the queue of each client which has data to send, sending out the next message from each
+// queue. Every client is also visited periodically to send heartbeats and check for connection
+// timeouts. Sends never block; a client whose socket is full is serviced again when the socket
+// manager reports it writable. Return false if no messages were sent.
 bool BrokerCore::ServiceClients()
 {
   bool result = false;
 
+  // Queue any client list changes first, so that the controllers they go to are serviced on this pass.
+  SendClientListUpdates();
+
+  std::vector<BrokerClient::Handle> to_service;
+  std::vector<BrokerClient::Handle> send_blocked;
+  {  // Lock scope
+    etcpal::MutexGuard service_guard(service_lock_);
+    to_service.assign(clients_to_service_.begin(), clients_to_service_.end());
+    clients_to_service_.clear();
+  }
+
   {
     etcpal::ReadGuard clients_read(client_lock_);
 
-    for (auto& client : clients_)
+    if (client_housekeeping_timer_.IsExpired())
     {
-      ClientWriteGuard client_write(*client.second);
-      if (client.second->TcpConnExpired())
-        MarkLockedClientForDestruction(*client.second);
-      else
-        result |= client.second->Send(settings_.cid);
+      for (auto& client : clients_)
+        result |= ServiceClient(*client.second, send_blocked);
+      client_housekeeping_timer_.Reset();
+    }
+    else
+    {
+      for (auto handle : to_service)
+      {
+        auto client = clients_.find(handle);
+        if (client != clients_.end())
+          result |= ServiceClient(*client->second, send_blocked);
+      }
     }
   }
 
+  // The socket manager may be handling a message which needs a client lock, so write readiness is
+  // only requested once none are held.
+  for (auto handle : send_blocked)
+    components_.socket_mgr->RequestWritableNotification(handle);
+
+  bool clients_destroyed = false;
   if (client_destroy_timer_.IsExpired())
   {
     DestroyMarkedClients();
     client_destroy_timer_.Reset();
+    clients_destroyed = true;
+  }
+
+  // If sending or destroying clients may have made room in a full queue, let the socket manager retry
+  // the messages it has parked. The room is remembered until then, because a message rejected just
+  // before this pass may not have set retry_pending_ yet.
+  if (result || clients_destroyed)
+    room_made_ = true;
+  if (room_made_ && retry_pending_.exchange(false))
+  {
+    components_.socket_mgr->ResumeParkedSockets();
+    room_made_ = false;
   }
 
+  // UID reservation changes are written out here, where none of the client locks are held.
+  components_.uids.FlushReservationFile();
+
   return result;
 }
 
+// Needs read lock on client_lock_. Adds the client to send_blocked if its socket couldn't take any
+// more data.
+bool BrokerCore::ServiceClient(BrokerClient& client, std::vector<BrokerClient::Handle>& send_blocked)
+{
+  bool result = false;
+
+  ClientWriteGuard client_write(client);
+  if (client.TcpConnExpired())
+  {
+    MarkLockedClientForDestruction(client);
+  }
+  else if (settings_.slow_client_disconnect_ms != 0 && client.BroadcastLagExpired(settings_.slow_client_disconnect_ms))
+  {
+    BROKER_LOG_WARNING("Disconnecting Client %d: its queue has been too full to receive broadcast messages for %u ms.",
+                       client.handle_, settings_.slow_client_disconnect_ms);
+    MarkLockedClientForDestruction(client, ClientDestroyAction::SendDisconnect(kRdmnetDisconnectCapacityExhausted));
+  }
+  else
+  {
+    client.ClearServiceRequest();
+    result = client.Send(settings_.cid);
+
+    // Keep visiting the client until its queues are empty, except while its socket is full.
+    if (client.SendBlocked())
+    {
+      send_blocked.push_back(client.handle_);
+    }
+    else if (client.HasDataToSend())
+    {
+      etcpal::MutexGuard service_guard(service_lock_);
+      clients_to_service_.insert(client.handle_);
+    }
+  }
+  return result;
+}
+
+// May be called with the client's lock held, or from a routing thread without it.
+void BrokerCore::HandleClientDataQueued(BrokerClient& client)
+{
+  {  // Lock scope
+    etcpal::MutexGuard service_guard(service_lock_);
+    clients_to_service_.insert(client.handle_);
+  }
+  components_.threads->WakeClientServiceThreads();
+}
+
 void BrokerCore::HandleBrokerRegistered(const std::string& assigned_service_name)
 {
   service_registered_ = true;
@@ -571,7 +766,7 @@ void BrokerCore::MarkClientForDestruction(BrokerClient::Handle client_handle, co
 
 // This function marks a client for destruction when it is already write-locked.
 // Optionally sends a RDMnet-level message to the client before destroying it.
-// Also removes the client's UID from the BrokerUidManager and sends a client removed message, if it's an RPT client.
+// Also removes the client's UID from the BrokerUidManager and queues a client removed message, if it's an RPT client.
 bool BrokerCore::MarkLockedClientForDestruction(BrokerClient& client, const ClientDestroyAction& destroy_action)
 {
   client.MarkForDestruction(settings_.cid, my_uid_, destroy_action);
@@ -581,17 +776,16 @@ bool BrokerCore::MarkLockedClientForDestruction(BrokerClient& client, const Clie
     RPTClient* rptcli = static_cast<RPTClient*>(&client);
     components_.uids.RemoveUid(rptcli->uid_);
 
-    std::vector<RdmnetRptClientEntry> rpt_entries;
-    rpt_entries.emplace_back();
-    RdmnetRptClientEntry& entry = rpt_entries.back();
+    RdmnetRptClientEntry entry;
     entry.cid = rptcli->cid_.get();
     entry.uid = rptcli->uid_;
     entry.type = rptcli->client_type_;
     entry.binding_cid = rptcli->binding_cid_.get();
 
-    SendClientsRemoved(rpt_entries);
+    QueueClientRemoved(entry);
   }
 
+  etcpal::MutexGuard destroy_guard(destroy_lock_);
   return clients_to_destroy_.insert(client.handle_).second;
 }
 
@@ -604,9 +798,15 @@ void BrokerCore::DestroyMarkedClients()
 
 void BrokerCore::DestroyMarkedClientsLocked()
 {
-  if (!clients_to_destroy_.empty())
+  std::unordered_set<BrokerClient::Handle> to_destroy_now;
+  {
+    etcpal::MutexGuard destroy_guard(destroy_lock_);
+    to_destroy_now.swap(clients_to_destroy_);
+  }
+
+  if (!to_destroy_now.empty())
   {
-    for (auto to_destroy : clients_to_destroy_)
+    for (auto to_destroy : to_destroy_now)
     {
       auto client = clients_.find(to_destroy);
       if (client != clients_.end())
@@ -617,12 +817,14 @@ void BrokerCore::DestroyMarkedClientsLocked()
         if (client->second->client_protocol_ == E133_CLIENT_PROTOCOL_RPT)
         {
           RPTClient* rptcli = static_cast<RPTClient*>(client->second.get());
+          RemoveRptClientFromIndexes(*rptcli);
           rpt_clients_.erase(to_destroy);
           if (rptcli->client_type_ == kRPTClientTypeController)
             controllers_.erase(to_destroy);
           else if (rptcli->client_type_ == kRPTClientTypeDevice)
             devices_.erase(to_destroy);
         }
+        AddClientCounters(destroyed_client_totals_, *client->second);
         clients_.erase(client);
 
         BROKER_LOG_INFO("Removing client %d marked for destruction.", to_destroy);
@@ -630,7 +832,6 @@ void BrokerCore::DestroyMarkedClientsLocked()
                          devices_.size());
       }
     }
-    clients_to_destroy_.clear();
   }
 }
 
@@ -639,15 +840,27 @@ void BrokerCore::HandleSocketClosed(BrokerClient::Handle client_handle, bool /*g
   MarkClientForDestruction(client_handle, ClientDestroyAction::MarkSocketInvalid());
 }
 
+// Called from any socket manager thread, so it only records that the client needs servicing.
+void BrokerCore::HandleSocketWritable(BrokerClient::Handle client_handle)
+{
+  {  // Lock scope
+    etcpal::MutexGuard service_guard(service_lock_);
+    clients_to_service_.insert(client_handle);
+  }
+  components_.threads->WakeClientServiceThreads();
+}
+
+void BrokerCore::HandleSocketDataReceived(BrokerClient::Handle /*client_handle*/, size_t size)
+{
+  bytes_received_.fetch_add(size, std::memory_order_relaxed);
+}
+
 HandleMessageResult BrokerCore::HandleSocketMessageReceived(BrokerClient::Handle client_handle,
                                                             const RdmnetMessage& message)
 {
   // Assume the next message should be received by default. Only certain cases require retrying/throttling.
   HandleMessageResult result = HandleMessageResult::kGetNextMessage;
 
-  // Any well-formed Root Layer PDU message resets the heartbeat timer.
-  ResetClientHeartbeatTimer(client_handle);
-
   switch (message.vector)
   {
     case ACN_VECTOR_ROOT_BROKER: {
@@ -666,7 +879,7 @@ HandleMessageResult BrokerCore::HandleSocketMessageReceived(BrokerClient::Handle
                            rdmnet_disconnect_reason_to_string(BROKER_GET_DISCONNECT_MSG(bmsg)->disconnect_reason));
           MarkClientForDestruction(client_handle);
         case VECTOR_BROKER_NULL:
-          // Do nothing - the heartbeat timer is already reset
+          // Do nothing - the heartbeat timer is reset below
           break;
         default:
           BROKER_LOG_DEBUG("Received Broker PDU with unknown or unhandled vector %d", bmsg->vector);
@@ -684,6 +897,10 @@ HandleMessageResult BrokerCore::HandleSocketMessageReceived(BrokerClient::Handle
       break;
   }
 
+  // Any well-formed Root Layer PDU message resets the heartbeat timer. This is done after the message
+  // is processed so that a connect message is counted for the client it creates.
+  ResetClientHeartbeatTimer(client_handle, result != HandleMessageResult::kRetryLater);
+
   return result;
 }
 
@@ -756,6 +973,7 @@ bool BrokerCore::ProcessRPTConnectRequest(BrokerClient::Handle        client_han
           new_client = controller.get();
           controllers_.insert(std::make_pair(client_handle, controller.get()));
           rpt_clients_.insert(std::make_pair(client_handle, controller.get()));
+          AddRptClientToIndexes(*controller);
           clients_[client_handle] = std::move(controller);
         }
       }
@@ -779,6 +997,7 @@ bool BrokerCore::ProcessRPTConnectRequest(BrokerClient::Handle        client_han
           new_client = device.get();
           devices_.insert(std::make_pair(client_handle, device.get()));
           rpt_clients_.insert(std::make_pair(client_handle, device.get()));
+          AddRptClientToIndexes(*device);
           clients_[client_handle] = std::move(device);
         }
       }
@@ -805,9 +1024,7 @@ bool BrokerCore::ProcessRPTConnectRequest(BrokerClient::Handle        client_han
     }
 
     // Update everyone
-    std::vector<RdmnetRptClientEntry> entries;
-    entries.push_back(updated_client_entry);
-    SendClientsAdded(client_handle, entries);
+    QueueClientAdded(client_handle, updated_client_entry);
   }
   return continue_adding;
 }
@@ -871,8 +1088,6 @@ HandleMessageResult BrokerCore::ProcessRPTMessage(BrokerClient::Handle client_ha
   {
     ClientWriteGuard client_write(*client->second);
 
-    client->second->MessageReceived();
-
     if (client->second->client_protocol_ == E133_CLIENT_PROTOCOL_RPT)
     {
       RPTClient* rptcli = static_cast<RPTClient*>(client->second.get());
@@ -972,27 +1187,29 @@ HandleMessageResult BrokerCore::RouteRPTMessage(BrokerClient::Handle client_hand
   uint16_t          device_manu;
 
   ClientPushResult push_result = ClientPushResult::Error;
+  // A broadcast only counts as routed if it was queued to at least one client.
+  size_t num_queued = 1;
 
   if (RDMNET_UID_IS_CONTROLLER_BROADCAST(&rptmsg->header.dest_uid))
   {
     BROKER_LOG_DEBUG("Broadcasting RPT message from Device %04x:%08x to all Controllers",
                      rptmsg->header.source_uid.manu, rptmsg->header.source_uid.id);
 
-    push_result = PushToAllControllers(client_handle, msg);
+    push_result = PushToAllControllers(client_handle, msg, num_queued);
   }
   else if (RDMNET_UID_IS_DEVICE_BROADCAST(&rptmsg->header.dest_uid))
   {
     BROKER_LOG_DEBUG("Broadcasting RPT message from Controller %04x:%08x to all Devices",
                      rptmsg->header.source_uid.manu, rptmsg->header.source_uid.id);
 
-    push_result = PushToAllDevices(client_handle, msg);
+    push_result = PushToAllDevices(client_handle, msg, num_queued);
   }
   else if (IsDeviceManuBroadcastUID(rptmsg->header.dest_uid, device_manu))
   {
     BROKER_LOG_DEBUG("Broadcasting RPT message from Controller %04x:%08x to all Devices from manufacturer %04x",
                      rptmsg->header.source_uid.manu, rptmsg->header.source_uid.id, device_manu);
 
-    push_result = PushToManuSpecificDevices(client_handle, msg, device_manu);
+    push_result = PushToManuSpecificDevices(client_handle, msg, device_manu, num_queued);
   }
   else
   {
@@ -1005,104 +1222,119 @@ HandleMessageResult BrokerCore::RouteRPTMessage(BrokerClient::Handle client_hand
   }
 
   if (push_result == ClientPushResult::Ok)
+  {
+    if (num_queued > 0)
+      CountRoutedMessage(rptmsg->vector);
     return HandleMessageResult::kGetNextMessage;
+  }
 
   return HandleRPTClientBadPushResult(rptmsg->header, push_result);
 }
 
+void BrokerCore::CountRoutedMessage(uint32_t rpt_vector)
+{
+  switch (rpt_vector)
+  {
+    case VECTOR_RPT_REQUEST:
+      rpt_requests_routed_.fetch_add(1, std::memory_order_relaxed);
+      break;
+    case VECTOR_RPT_NOTIFICATION:
+      rpt_notifications_routed_.fetch_add(1, std::memory_order_relaxed);
+      break;
+    case VECTOR_RPT_STATUS:
+      rpt_status_routed_.fetch_add(1, std::memory_order_relaxed);
+      break;
+    default:
+      break;
+  }
+}
+
+// Broadcasts are admitted to each destination separately. The message is queued to every client
+// with room for it and dropped for any client whose queue is full, so that one slow client doesn't
+// hold up delivery to the others. Clients which keep dropping broadcasts can be disconnected; see
+// ServiceClient(). num_queued is set to the number of clients the message was queued to.
 template <class ClientMap, class FilterFunction>
 ClientPushResult PushToRptClients(BrokerClient::Handle sender_handle,
                                   const RdmnetMessage* msg,
                                   ClientMap&           dest_clients,
-                                  FilterFunction       dest_filter)
+                                  FilterFunction       dest_filter,
+                                  size_t&              num_queued)
 {
   ClientPushResult result = ClientPushResult::Ok;
+  num_queued = 0;
 
   const RptMessage* rptmsg = RDMNET_GET_RPT_MSG(msg);
 
-  // Lock all destination clients
-  int num_successful_locks = 0;
+  // Packed for the first destination with room, then shared by reference with the rest. Reserving
+  // queue space doesn't take the destination clients' locks, so routing doesn't wait on the threads
+  // sending to those clients.
+  MessageRef packed_msg;
   for (auto dest = dest_clients.begin(); dest != dest_clients.end(); ++dest)
   {
-    if (dest_filter(dest))
-    {
-      if (dest->second->lock_.WriteLock())
-      {
-        ++num_successful_locks;
-      }
-      else
-      {
-        result = ClientPushResult::Error;
-        break;
-      }
-    }
-  }
+    // Clients marked for destruction stay indexed until DestroyMarkedClients() runs, possibly
+    // alongside a new connection which has taken over their UID.
+    if (dest->second->marked_for_destruction_ || !dest_filter(dest))
+      continue;
 
-  // If all locks succeeded, check if any destination client queues are full
-  if (result == ClientPushResult::Ok)
-  {
-    for (auto dest = dest_clients.begin(); dest != dest_clients.end(); ++dest)
-    {
-      if (dest_filter(dest) && !dest->second->HasRoomToPush())
-        result = ClientPushResult::QueueFull;
-    }
-  }
+    if (!dest->second->ReserveBroadcastQueueSpace())
+      continue;
 
-  // If no queues are full, push to all queues
-  if (result == ClientPushResult::Ok)
-  {
-    for (auto dest = dest_clients.begin(); dest != dest_clients.end(); ++dest)
+    if (!packed_msg.data)
     {
-      if (dest_filter(dest))
+      packed_msg = PackRptMessage(msg->sender_cid, *rptmsg);
+      if (!packed_msg.data)
       {
-        auto push_res = dest->second->Push(sender_handle, msg->sender_cid, *rptmsg);
-
-        if (result == ClientPushResult::Ok)
-          result = push_res;
+        dest->second->ReleaseQueueSpace();
+        return ClientPushResult::Error;
       }
     }
-  }
 
-  // Unlock all destination clients that locked successfully
-  for (auto dest = dest_clients.begin(); dest != dest_clients.end(); ++dest)
-  {
-    if (num_successful_locks == 0)
-      break;
-
-    if (dest_filter(dest))
-    {
-      dest->second->lock_.WriteUnlock();
-      --num_successful_locks;
-    }
+    auto push_res = dest->second->PushReserved(sender_handle, rptmsg->vector, packed_msg);
+    if (push_res == ClientPushResult::Ok)
+      ++num_queued;
+    else if (result == ClientPushResult::Ok)
+      result = push_res;
   }
 
   return result;
 }
 
 // Needs read lock on client_lock_
-ClientPushResult BrokerCore::PushToAllControllers(BrokerClient::Handle sender_handle, const RdmnetMessage* msg)
+ClientPushResult BrokerCore::PushToAllControllers(BrokerClient::Handle sender_handle,
+                                                  const RdmnetMessage* msg,
+                                                  size_t&              num_queued)
 {
   // Push to every controller in controllers_
   auto dest_filter = [](const RptControllerMap::iterator& /*dest*/) { return true; };
-  return PushToRptClients(sender_handle, msg, controllers_, dest_filter);
+  return PushToRptClients(sender_handle, msg, controllers_, dest_filter, num_queued);
 }
 
 // Needs read lock on client_lock_
-ClientPushResult BrokerCore::PushToAllDevices(BrokerClient::Handle sender_handle, const RdmnetMessage* msg)
+ClientPushResult BrokerCore::PushToAllDevices(BrokerClient::Handle sender_handle,
+                                              const RdmnetMessage* msg,
+                                              size_t&              num_queued)
 {
   // Push to every device in devices_
   auto dest_filter = [](const RptDeviceMap::iterator& /*dest*/) { return true; };
-  return PushToRptClients(sender_handle, msg, devices_, dest_filter);
+  return PushToRptClients(sender_handle, msg, devices_, dest_filter, num_queued);
 }
 
 // Needs read lock on client_lock_
 ClientPushResult BrokerCore::PushToManuSpecificDevices(BrokerClient::Handle sender_handle,
                                                        const RdmnetMessage* msg,
-                                                       uint16_t             manu)
+                                                       uint16_t             manu,
+                                                       size_t&              num_queued)
 {
-  // Push to each device in devices_ that matches manu
-  auto dest_filter = [&](const RptDeviceMap::iterator& dest) { return ((dest->second->uid_.manu & 0x7fffu) == manu); };
-  return PushToRptClients(sender_handle, msg, devices_, dest_filter);
+  // Push to each device in the manufacturer's bucket of devices_by_manu_
+  auto manu_devices = devices_by_manu_.find(manu);
+  if (manu_devices == devices_by_manu_.end())
+  {
+    num_queued = 0;
+    return ClientPushResult::Ok;
+  }
+
+  auto dest_filter = [](const RptDeviceMap::iterator& /*dest*/) { return true; };
+  return PushToRptClients(sender_handle, msg, manu_devices->second, dest_filter, num_queued);
 }
 
 // Needs read lock on client_lock_
@@ -1110,25 +1342,56 @@ ClientPushResult BrokerCore::PushToSpecificRptClient(BrokerClient::Handle sender
 {
   const RptMessage* rptmsg = RDMNET_GET_RPT_MSG(msg);
 
-  auto dest_client = FindRptClient(rptmsg->header.dest_uid);
-  if (dest_client != rpt_clients_.end())
+  RPTClient* dest_client = FindRptClient(rptmsg->header.dest_uid);
+  if (dest_client)
   {
-    // For performance, since this is a single client, lock and call Push directly instead of calling PushToRptClients.
-    ClientWriteGuard client_write(*dest_client->second);
-    return dest_client->second->Push(sender_handle, msg->sender_cid, *rptmsg);
+    // For performance, since this is a single client, call Push directly instead of calling PushToRptClients.
+    return dest_client->Push(sender_handle, msg->sender_cid, *rptmsg);
   }
 
   return ClientPushResult::Error;
 }
 
 // Needs read lock on client_lock_
-BrokerCore::RptClientMap::iterator BrokerCore::FindRptClient(const RdmUid& uid)
+// Returns nullptr if no connected RPT client has the given UID. A client's UID is released as soon
+// as it is marked for destruction, so marked clients are not returned even though they stay indexed
+// until DestroyMarkedClients() runs.
+RPTClient* BrokerCore::FindRptClient(const RdmUid& uid) const
 {
-  BrokerClient::Handle handle;
-  if (components_.uids.UidToHandle(uid, handle))
-    return rpt_clients_.find(handle);
+  auto client = rpt_clients_by_uid_.find(uid);
+  if (client != rpt_clients_by_uid_.end() && !client->second->marked_for_destruction_)
+    return client->second;
+
+  return nullptr;
+}
 
-  return rpt_clients_.end();
+// Needs write lock on client_lock_
+void BrokerCore::AddRptClientToIndexes(RPTClient& client)
+{
+  // A client marked for destruction may still hold an entry for a UID that has since been handed
+  // out again; the new client replaces it.
+  rpt_clients_by_uid_[client.uid_] = &client;
+  if (client.client_type_ == kRPTClientTypeDevice)
+    devices_by_manu_[client.uid_.manu & 0x7fffu][client.handle_] = static_cast<RPTDevice*>(&client);
+}
+
+// Needs write lock on client_lock_
+void BrokerCore::RemoveRptClientFromIndexes(RPTClient& client)
+{
+  auto uid_entry = rpt_clients_by_uid_.find(client.uid_);
+  if (uid_entry != rpt_clients_by_uid_.end() && uid_entry->second == &client)
+    rpt_clients_by_uid_.erase(uid_entry);
+
+  if (client.client_type_ == kRPTClientTypeDevice)
+  {
+    auto manu_devices = devices_by_manu_.find(client.uid_.manu & 0x7fffu);
+    if (manu_devices != devices_by_manu_.end())
+    {
+      manu_devices->second.erase(client.handle_);
+      if (manu_devices->second.empty())
+        devices_by_manu_.erase(manu_devices);
+    }
+  }
 }
 
 // Needs read lock on client_lock_
@@ -1151,12 +1414,12 @@ HandleMessageResult BrokerCore::HandleRPTClientBadPushResult(const RptHeader& he
   }
   else
   {
-    auto dest_client = FindRptClient(header.dest_uid);
-    if (dest_client == rpt_clients_.end())
+    const RPTClient* dest_client = FindRptClient(header.dest_uid);
+    if (!dest_client)
       not_found = true;
-    else if (dest_client->second->client_type_ == kRPTClientTypeDevice)
+    else if (dest_client->client_type_ == kRPTClientTypeDevice)
       dest_type = "Device";
-    else if (dest_client->second->client_type_ == kRPTClientTypeController)
+    else if (dest_client->client_type_ == kRPTClientTypeController)
       dest_type = "Controller";
   }
 
@@ -1176,21 +1439,24 @@ HandleMessageResult BrokerCore::HandleRPTClientBadPushResult(const RptHeader& he
     BROKER_LOG_DEBUG("Couldn't send message to UID %04x:%08x (%s): one or more queues are full. Retrying later.",
                      header.dest_uid.manu, header.dest_uid.id, dest_type.c_str());
 
-    // Full queue, so delay processing of the message.
+    // Full queue, so delay processing of the message. The socket it came from will be parked until
+    // ServiceClients() makes room.
+    retry_pending_ = true;
     return HandleMessageResult::kRetryLater;
   }
 
   return HandleMessageResult::kGetNextMessage;
 }
 
-void BrokerCore::ResetClientHeartbeatTimer(BrokerClient::Handle client_handle)
+// handled is false if the message is to be retried later, in which case it isn't counted yet.
+void BrokerCore::ResetClientHeartbeatTimer(BrokerClient::Handle client_handle, bool handled)
 {
   etcpal::ReadGuard clients_read(client_lock_);
   auto              client = clients_.find(client_handle);
   if (client != clients_.end())
   {
     ClientWriteGuard client_write(*client->second);
-    client->second->MessageReceived();
+    client->second->MessageReceived(handled);
   }
 }
 
@@ -1203,6 +1469,7 @@ void BrokerCore::SendClientList(BrokerClient::Handle client_handle)
   auto              to_client = clients_.find(client_handle);
   if (to_client != clients_.end())
   {
+    ClientWriteGuard client_write(*to_client->second);
     if (to_client->second->client_protocol_ == E133_CLIENT_PROTOCOL_RPT)
       SendRptClientList(bmsg, static_cast<RPTClient&>(*to_client->second));
     else
@@ -1210,49 +1477,141 @@ void BrokerCore::SendClientList(BrokerClient::Handle client_handle)
   }
 }
 
-void BrokerCore::SendRptClientList(BrokerMessage& bmsg, RPTClient& to_cli)
+// Only a snapshot of the entries is taken here; the client packs the list in chunks as it is sent.
+// The snapshot is taken under client_list_lock_, so that the pending client list changes it reflects
+// are known to be sent later.
+void BrokerCore::SendRptClientList(BrokerMessage& /*bmsg*/, RPTClient& to_cli)
 {
   std::vector<RdmnetRptClientEntry> entries;
-  entries.reserve(rpt_clients_.size());
-  for (auto& client : rpt_clients_)
-  {
-    entries.emplace_back();
-    RdmnetRptClientEntry& rpt_entry = entries.back();
-    RPTClient&            rpt_cli = static_cast<RPTClient&>(*client.second);
+  {  // Lock scope
+    etcpal::MutexGuard list_guard(client_list_lock_);
+    client_list_deltas_.SnapshotTaken();
 
-    rpt_entry.cid = rpt_cli.cid_.get();
-    rpt_entry.uid = rpt_cli.uid_;
-    rpt_entry.type = rpt_cli.client_type_;
-    rpt_entry.binding_cid = rpt_cli.binding_cid_.get();
-  }
-  if (!entries.empty())
-  {
-    BROKER_GET_CLIENT_LIST(&bmsg)->client_protocol = kClientProtocolRPT;
-    BROKER_GET_RPT_CLIENT_LIST(BROKER_GET_CLIENT_LIST(&bmsg))->client_entries = entries.data();
-    BROKER_GET_RPT_CLIENT_LIST(BROKER_GET_CLIENT_LIST(&bmsg))->num_client_entries = entries.size();
-    to_cli.Push(settings_.cid, bmsg);
+    entries.reserve(rpt_clients_.size());
+    for (auto& client : rpt_clients_)
+    {
+      entries.emplace_back();
+      RdmnetRptClientEntry& rpt_entry = entries.back();
+      RPTClient&            rpt_cli = static_cast<RPTClient&>(*client.second);
+
+      rpt_entry.cid = rpt_cli.cid_.get();
+      rpt_entry.uid = rpt_cli.uid_;
+      rpt_entry.type = rpt_cli.client_type_;
+      rpt_entry.binding_cid = rpt_cli.binding_cid_.get();
+    }
   }
+  to_cli.PushRptClientList(settings_.cid, std::move(entries));
 }
 
 void BrokerCore::SendEptClientList(BrokerMessage& /*bmsg*/, EPTClient& /*to_cli*/)
 {
 }
 
-void BrokerCore::SendClientsAdded(BrokerClient::Handle handle_to_ignore, std::vector<RdmnetRptClientEntry>& entries)
+// Client list changes are collected and sent to controllers by SendClientListUpdates().
+void BrokerCore::QueueClientAdded(BrokerClient::Handle handle, const RdmnetRptClientEntry& entry)
 {
+  {  // Lock scope
+    etcpal::MutexGuard list_guard(client_list_lock_);
+    if (client_list_deltas_.empty())
+      client_list_update_timer_.Start(settings_.client_list_update_window_ms);
+    client_list_deltas_.AddClient(handle, entry);
+  }
+  components_.threads->WakeClientServiceThreads();
+}
+
+void BrokerCore::QueueClientRemoved(const RdmnetRptClientEntry& entry)
+{
+  {  // Lock scope
+    etcpal::MutexGuard list_guard(client_list_lock_);
+    if (client_list_deltas_.empty())
+      client_list_update_timer_.Start(settings_.client_list_update_window_ms);
+    client_list_deltas_.RemoveClient(entry);
+  }
+  components_.threads->WakeClientServiceThreads();
+}
+
+// This function grabs a read lock on client_lock_.
+// Sends the collected client list changes to all controllers, once the update window has elapsed or
+// enough changes have been collected.
+void BrokerCore::SendClientListUpdates()
+{
+  ClientListDeltas deltas;
+  {  // Lock scope
+    etcpal::MutexGuard list_guard(client_list_lock_);
+    if (client_list_deltas_.empty())
+      return;
+
+    bool max_entries_reached = (settings_.client_list_update_max_entries > 0) &&
+                               (client_list_deltas_.size() >= settings_.client_list_update_max_entries);
+    if (!max_entries_reached && !client_list_update_timer_.IsExpired())
+      return;
+
+    std::swap(deltas, client_list_deltas_);
+  }
+
+  etcpal::ReadGuard clients_read(client_lock_);
+
+  // Removes go first, so that a client which was replaced by a new entry with the same CID ends up
+  // with the new entry.
+  if (!deltas.removes().empty())
+  {
+    std::vector<RdmnetRptClientEntry> entries;
+    entries.reserve(deltas.removes().size());
+    for (const auto& removed : deltas.removes())
+      entries.push_back(removed.second.entry);
+    SendClientsRemoved(entries);
+  }
+
+  if (!deltas.adds().empty())
+    SendClientsAdded(deltas.adds());
+}
+
+// Needs read lock on client_lock_
+void BrokerCore::SendClientsAdded(const ClientListDeltas::AddMap& added)
+{
+  std::vector<RdmnetRptClientEntry> entries;
+  entries.reserve(added.size());
+  for (const auto& client : added)
+    entries.push_back(client.second.entry);
+
   BrokerMessage bmsg;
   bmsg.vector = VECTOR_BROKER_CLIENT_ADD;
   BROKER_GET_CLIENT_LIST(&bmsg)->client_protocol = kClientProtocolRPT;
   BROKER_GET_RPT_CLIENT_LIST(BROKER_GET_CLIENT_LIST(&bmsg))->client_entries = entries.data();
   BROKER_GET_RPT_CLIENT_LIST(BROKER_GET_CLIENT_LIST(&bmsg))->num_client_entries = entries.size();
 
+  std::vector<RdmnetRptClientEntry> entries_for_new_controller;
   for (const auto controller : controllers_)
   {
-    if (controller.first != handle_to_ignore)
+    ClientWriteGuard controller_write(*controller.second);
+
+    // A controller is not told about its own connection.
+    auto own_entry = added.find(controller.second->cid_);
+    if (own_entry == added.end() || own_entry->second.handle != controller.first)
+    {
       controller.second->Push(settings_.cid, bmsg);
+      continue;
+    }
+
+    entries_for_new_controller.clear();
+    for (const auto& client : added)
+    {
+      if (client.second.handle != controller.first)
+        entries_for_new_controller.push_back(client.second.entry);
+    }
+    if (!entries_for_new_controller.empty())
+    {
+      BrokerMessage new_controller_msg = bmsg;
+      BROKER_GET_RPT_CLIENT_LIST(BROKER_GET_CLIENT_LIST(&new_controller_msg))->client_entries =
+          entries_for_new_controller.data();
+      BROKER_GET_RPT_CLIENT_LIST(BROKER_GET_CLIENT_LIST(&new_controller_msg))->num_client_entries =
+          entries_for_new_controller.size();
+      controller.second->Push(settings_.cid, new_controller_msg);
+    }
   }
 }
 
+// Needs read lock on client_lock_
 void BrokerCore::SendClientsRemoved(std::vector<RdmnetRptClientEntry>& entries)
 {
   BrokerMessage bmsg;
@@ -1263,6 +1622,7 @@ void BrokerCore::SendClientsRemoved(std::vector<RdmnetRptClientEntry>& entries)
 
   for (const auto controller : controllers_)
   {
+    ClientWriteGuard controller_write(*controller.second);
     controller.second->Push(settings_.cid, bmsg);
   }
 }
@@ -20,6 +20,7 @@
 #ifndef BROKER_CORE_H_
 #define BROKER_CORE_H_
 
+#include <atomic>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -28,6 +29,7 @@
 #include <vector>
 #include "etcpal/cpp/error.h"
 #include "etcpal/cpp/inet.h"
+#include "etcpal/cpp/mutex.h"
 #include "etcpal/cpp/rwlock.h"
 #include "etcpal/cpp/timer.h"
 #include "etcpal/socket.h"
@@ -79,7 +81,7 @@ struct BrokerComponents final
   }
 };
 
-class BrokerCore final : public BrokerComponentNotify
+class BrokerCore final : public BrokerComponentNotify, public BrokerClientNotify
 {
 public:
   BrokerCore();
@@ -100,6 +102,8 @@ public:
   bool        IsValidControllerDestinationUID(const RdmUid& uid) const;
   bool        IsValidDeviceDestinationUID(const RdmUid& uid) const;
 
+  rdmnet::Broker::Statistics GetStatistics();
+
   // Test/debug
   size_t GetNumClients() const;
 
@@ -108,6 +112,8 @@ private:
   using RptClientMap = std::unordered_map<BrokerClient::Handle, RPTClient*>;
   using RptControllerMap = std::unordered_map<BrokerClient::Handle, RPTController*>;
   using RptDeviceMap = std::unordered_map<BrokerClient::Handle, RPTDevice*>;
+  using RptUidMap = std::unordered_map<RdmUid, RPTClient*, RdmUidHash>;
+  using RptManuDeviceMap = std::unordered_map<uint16_t, RptDeviceMap>;
 
   // These are never modified between startup and shutdown, so they don't need to be locked.
   bool started_{false};
@@ -131,6 +137,11 @@ private:
   static constexpr uint32_t kClientDestroyIntervalMs = 200;
   etcpal::Timer             client_destroy_timer_{kClientDestroyIntervalMs};
 
+  // Every client is visited at this interval to send heartbeats and check for timeouts. Otherwise,
+  // only clients with queued data are visited.
+  static constexpr uint32_t kClientHousekeepingIntervalMs = 500;
+  etcpal::Timer             client_housekeeping_timer_{kClientHousekeepingIntervalMs};
+
   // The list of connected clients, indexed by the connection handle
   BrokerClientMap clients_;
   // Protects the list of clients and uid lookup, but not the data in the clients themselves.
@@ -141,7 +152,48 @@ private:
   RptControllerMap controllers_;
   RptDeviceMap     devices_;
 
+  // Routing indexes over rpt_clients_ and devices_, by UID and by device manufacturer ID. Like the
+  // maps above, these are only modified with a write lock on client_lock_, so RPT messages can be
+  // routed with only the read lock held.
+  RptUidMap        rpt_clients_by_uid_;
+  RptManuDeviceMap devices_by_manu_;
+
+  // Clients are marked for destruction with only a read lock on client_lock_ held, from any socket
+  // manager thread, so this set has its own lock.
   std::unordered_set<BrokerClient::Handle> clients_to_destroy_;
+  etcpal::Mutex                            destroy_lock_;
+
+  // Clients which have data queued to send. A client whose socket can't take any more data is left
+  // out until the socket manager reports that the socket is writable.
+  std::unordered_set<BrokerClient::Handle> clients_to_service_;
+  etcpal::Mutex                            service_lock_;
+
+  // Client list changes which haven't been sent to controllers yet.
+  ClientListDeltas client_list_deltas_;
+  etcpal::Timer    client_list_update_timer_;
+  etcpal::Mutex    client_list_lock_;
+
+  // Counters for GetStatistics(). The totals of destroyed clients are kept in
+  // destroyed_client_totals_, which is protected by client_lock_.
+  std::atomic<uint64_t>      bytes_received_{0};
+  std::atomic<uint64_t>      rpt_requests_routed_{0};
+  std::atomic<uint64_t>      rpt_notifications_routed_{0};
+  std::atomic<uint64_t>      rpt_status_routed_{0};
+  rdmnet::Broker::Statistics destroyed_client_totals_;
+
+  // The routing totals at the previous call to GetStatistics(), for calculating routing rates.
+  etcpal::Mutex stats_lock_;
+  uint32_t      last_stats_time_ms_{0};
+  uint64_t      last_rpt_requests_routed_{0};
+  uint64_t      last_rpt_notifications_routed_{0};
+  uint64_t      last_rpt_status_routed_{0};
+
+  // Set when a message couldn't be routed due to a full queue, meaning the socket it was received on
+  // has been parked by the socket manager until queues drain.
+  std::atomic<bool> retry_pending_{false};
+  // Set when ServiceClients() may have made room in a full queue, and cleared when parked sockets are
+  // resumed. Only accessed from the client service thread.
+  bool room_made_{false};
 
   std::set<etcpal::IpAddr>          GetInterfaceAddrs(const std::vector<std::string>& interfaces);
   etcpal::Expected<etcpal_socket_t> StartListening(const etcpal::IpAddr& ip, uint16_t& port);
@@ -151,6 +203,10 @@ private:
   // BrokerThreadNotify messages
   virtual bool HandleNewConnection(etcpal_socket_t new_sock, const etcpal::SockAddr& addr) override;
   virtual bool ServiceClients() override;
+  bool         ServiceClient(BrokerClient& client, std::vector<BrokerClient::Handle>& send_blocked);
+
+  // BrokerClientNotify messages
+  virtual void HandleClientDataQueued(BrokerClient& client) override;
 
   // BrokerDiscoveryManagerNotify messages
   virtual void HandleBrokerRegistered(const std::string& assigned_service_name) override;
@@ -172,6 +228,8 @@ private:
 
   // BrokerSocketNotify messages
   virtual void                HandleSocketClosed(BrokerClient::Handle client_handle, bool graceful) override;
+  virtual void                HandleSocketDataReceived(BrokerClient::Handle client_handle, size_t size) override;
+  virtual void                HandleSocketWritable(BrokerClient::Handle client_handle) override;
   virtual HandleMessageResult HandleSocketMessageReceived(BrokerClient::Handle client_handle,
                                                           const RdmnetMessage& message) override;
 
@@ -185,15 +243,23 @@ private:
                                              rdmnet_connect_status_t& connect_status);
   HandleMessageResult    ProcessRPTMessage(BrokerClient::Handle client_handle, const RdmnetMessage* msg);
   HandleMessageResult    RouteRPTMessage(BrokerClient::Handle client_handle, const RdmnetMessage* msg);
-  ClientPushResult       PushToAllControllers(BrokerClient::Handle sender_handle, const RdmnetMessage* msg);
-  ClientPushResult       PushToAllDevices(BrokerClient::Handle sender_handle, const RdmnetMessage* msg);
+  ClientPushResult       PushToAllControllers(BrokerClient::Handle sender_handle,
+                                              const RdmnetMessage* msg,
+                                              size_t&              num_queued);
+  ClientPushResult       PushToAllDevices(BrokerClient::Handle sender_handle,
+                                          const RdmnetMessage* msg,
+                                          size_t&              num_queued);
   ClientPushResult       PushToManuSpecificDevices(BrokerClient::Handle sender_handle,
                                                    const RdmnetMessage* msg,
-                                                   uint16_t             manu);
+                                                   uint16_t             manu,
+                                                   size_t&              num_queued);
   ClientPushResult       PushToSpecificRptClient(BrokerClient::Handle sender_handle, const RdmnetMessage* msg);
-  RptClientMap::iterator FindRptClient(const RdmUid& uid);
+  RPTClient*             FindRptClient(const RdmUid& uid) const;
+  void                   AddRptClientToIndexes(RPTClient& client);
+  void                   RemoveRptClientFromIndexes(RPTClient& client);
   HandleMessageResult    HandleRPTClientBadPushResult(const RptHeader& header, ClientPushResult result);
-  void                   ResetClientHeartbeatTimer(BrokerClient::Handle client_handle);
+  void                   ResetClientHeartbeatTimer(BrokerClient::Handle client_handle, bool handled);
+  void                   CountRoutedMessage(uint32_t rpt_vector);
 
   void SendRDMBrokerResponse(BrokerClient::Handle client_handle,
                              const RPTMessageRef& msg,
@@ -205,7 +271,10 @@ private:
   void SendClientList(BrokerClient::Handle client_handle);
   void SendRptClientList(BrokerMessage& bmsg, RPTClient& to_cli);
   void SendEptClientList(BrokerMessage& bmsg, EPTClient& to_cli);
-  void SendClientsAdded(BrokerClient::Handle handle_to_ignore, std::vector<RdmnetRptClientEntry>& entries);
+  void QueueClientAdded(BrokerClient::Handle handle, const RdmnetRptClientEntry& entry);
+  void QueueClientRemoved(const RdmnetRptClientEntry& entry);
+  void SendClientListUpdates();
+  void SendClientsAdded(const ClientListDeltas::AddMap& added);
   void SendClientsRemoved(std::vector<RdmnetRptClientEntry>& entries);
   HandleMessageResult SendStatus(RPTController*     controller,
                                  const RptHeader&   header,
@@ -32,6 +32,8 @@
 ///
 /// This is used to determine if the worker thread should move on to the next message, or call
 /// HandleSocketMessageReceived with the same message later (potentially throttling the TCP connection).
+/// A socket whose message must be retried later is parked: the socket manager stops reading from it
+/// and holds onto the message until BrokerSocketManager::ResumeParkedSockets() is called.
 enum class HandleMessageResult
 {
   kRetryLater,
@@ -54,6 +56,12 @@ public:
   virtual HandleMessageResult HandleSocketMessageReceived(BrokerClient::Handle handle,
                                                           const RdmnetMessage& message) = 0;
 
+  /// @brief Data was received on a socket, before being parsed into messages.
+  ///
+  /// @param[in] handle The client handle on which data was received.
+  /// @param[in] size The number of bytes received.
+  virtual void HandleSocketDataReceived(BrokerClient::Handle handle, size_t size) = 0;
+
   /// @brief A socket was closed remotely.
   ///
   /// The socket is no longer valid after this callback finishes. Do not call
@@ -63,6 +71,14 @@ public:
   /// @param[in] handle The client handle for which the socket was closed.
   /// @param[in] graceful Whether the TCP connection was closed gracefully.
   virtual void HandleSocketClosed(BrokerClient::Handle handle, bool graceful) = 0;
+
+  /// @brief A socket whose send buffer was full can be sent on again.
+  ///
+  /// Follows a send on the socket which failed with kEtcPalErrWouldBlock. May be called from any
+  /// socket manager thread, with socket manager locks held.
+  ///
+  /// @param[in] handle The client handle whose socket is writable.
+  virtual void HandleSocketWritable(BrokerClient::Handle handle) = 0;
 };
 
 class BrokerSocketManager
@@ -77,8 +93,26 @@ public:
 
   virtual bool AddSocket(BrokerClient::Handle handle, etcpal_socket_t sock) = 0;
   virtual void RemoveSocket(BrokerClient::Handle handle) = 0;
+
+  /// @brief Retry the pending messages on all parked sockets.
+  ///
+  /// Called when there may be room in client queues that were previously full. Parked sockets whose
+  /// pending message can now be handled resume reading; others remain parked. The retry happens
+  /// asynchronously on the socket manager's worker threads, so this can be called with any locks
+  /// held.
+  virtual void ResumeParkedSockets() = 0;
+
+  /// @brief Call BrokerSocketNotify::HandleSocketWritable() once a socket's send buffer has room.
+  ///
+  /// Called after a send on the socket failed with kEtcPalErrWouldBlock. The notification is
+  /// delivered once per request. This must not be called with any client locks held, as it may
+  /// wait on a socket manager thread which is handling a message.
+  virtual void RequestWritableNotification(BrokerClient::Handle handle) = 0;
 };
 
-std::unique_ptr<BrokerSocketManager> CreateBrokerSocketManager();
+// Create the socket manager for the current platform. num_reader_threads is the number of threads
+// to read from client sockets with, where the platform supports choosing it. 0 means use the
+// platform's default.
+std::unique_ptr<BrokerSocketManager> CreateBrokerSocketManager(unsigned int num_reader_threads = 0);
 
 #endif  // BROKER_SOCKET_MANAGER_H_
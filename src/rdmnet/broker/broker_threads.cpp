@@ -121,10 +121,11 @@ void ClientServiceThread::Run()
 
   while (!terminated_)
   {
-    // As long as clients need to be processed, we won't sleep.
+    // As long as clients need to be processed, we won't wait. Sends don't block, and a client whose
+    // socket is full isn't processed again until the socket manager wakes us for it.
     while (notify_->ServiceClients())
       ;
-    etcpal::Thread::Sleep(kSleepMs);
+    wake_signal_.TryWait(kMaxIdleWaitMs);
   }
 }
 
@@ -133,6 +134,7 @@ ClientServiceThread::~ClientServiceThread()
   if (!terminated_)
   {
     terminated_ = true;
+    wake_signal_.Notify();
     thread_.Join();
   }
 }
@@ -150,7 +152,7 @@ etcpal::Error BrokerThreadManager::AddListenThread(etcpal_socket_t listen_sock)
 
 etcpal::Error BrokerThreadManager::AddClientServiceThread()
 {
-  std::unique_ptr<ClientServiceThread> new_thread(new ClientServiceThread(notify_));
+  std::unique_ptr<ClientServiceThread> new_thread(new ClientServiceThread(notify_, client_wake_signal_));
 
   auto start_res = new_thread->Start();
   if (start_res)
@@ -28,6 +28,7 @@
 #include <vector>
 
 #include "etcpal/cpp/error.h"
+#include "etcpal/cpp/signal.h"
 #include "etcpal/cpp/thread.h"
 #include "etcpal/inet.h"
 #include "etcpal/socket.h"
@@ -43,9 +44,9 @@ public:
   // immediately.
   virtual bool HandleNewConnection(etcpal_socket_t new_sock, const etcpal::SockAddr& remote_addr) = 0;
 
-  // A notification from a client service thread to process each client queue, sending out the next
-  // message from each queue if one is available. Return false if no messages or partial messages
-  // were sent.
+  // A notification from a client service thread to process each client queue which has data,
+  // sending out the next message from each queue. Return false if no messages or partial messages
+  // were sent, in which case the thread waits until it is woken or a maintenance interval passes.
   virtual bool ServiceClients() = 0;
 };
 
@@ -85,17 +86,25 @@ private:
   etcpal::Logger* log_{nullptr};
 };
 
+// Sends queued data to clients. The thread blocks on a signal while there is nothing to send, and is
+// woken through BrokerThreadInterface::WakeClientServiceThreads() when data is queued.
 class ClientServiceThread : public BrokerThread
 {
 public:
-  ClientServiceThread(BrokerThreadNotify* notify) : BrokerThread(notify) {}
+  ClientServiceThread(BrokerThreadNotify* notify, etcpal::Signal& wake_signal)
+      : BrokerThread(notify), wake_signal_(wake_signal)
+  {
+  }
   ~ClientServiceThread() override;
 
   etcpal::Error Start() override;
   void          Run() override;
 
 protected:
-  static constexpr int kSleepMs{1};
+  // The maximum time to wait while idle, so that heartbeats and client cleanup still happen.
+  static constexpr int kMaxIdleWaitMs{100};
+
+  etcpal::Signal& wake_signal_;
 };
 
 class BrokerThreadInterface
@@ -108,6 +117,7 @@ public:
   virtual etcpal::Error AddListenThread(etcpal_socket_t listen_sock) = 0;
 
   virtual etcpal::Error AddClientServiceThread() = 0;
+  virtual void          WakeClientServiceThreads() = 0;
 
   virtual void StopThreads() = 0;
 };
@@ -119,6 +129,7 @@ public:
 
   etcpal::Error AddListenThread(etcpal_socket_t listen_sock) override;
   etcpal::Error AddClientServiceThread() override;
+  void          WakeClientServiceThreads() override { client_wake_signal_.Notify(); }
 
   void StopThreads() override;
 
@@ -127,6 +138,8 @@ public:
 private:
   BrokerThreadNotify* notify_{nullptr};
 
+  // Declared before threads_ so that it outlives the threads that wait on it.
+  etcpal::Signal                             client_wake_signal_;
   std::vector<std::unique_ptr<BrokerThread>> threads_;
 
   etcpal::Logger* log_{nullptr};
@@ -19,6 +19,60 @@
 
 #include "broker_uid_manager.h"
 
+#include <ctime>
+#include <vector>
+
+namespace
+{
+etcpal::Error RewriteStore(BrokerUidStore& store, const std::vector<BrokerUidStore::Record>& records)
+{
+  auto next = records.cbegin();
+  return store.Rewrite([&](BrokerUidStore::Record& record) {
+    if (next == records.cend())
+      return false;
+    record = *next++;
+    return true;
+  });
+}
+}  // namespace
+
+BrokerUidManager::BrokerUidManager(BrokerUidManager&& other) noexcept
+{
+  *this = std::move(other);
+}
+
+// Only meant for handing over a manager which isn't in use yet, as the broker's components are when
+// it starts up.
+BrokerUidManager& BrokerUidManager::operator=(BrokerUidManager&& other) noexcept
+{
+  if (this != &other)
+  {
+    if (store_lock_)
+      CloseReservationFile();
+
+    uid_lookup_ = std::move(other.uid_lookup_);
+    reservations_ = std::move(other.reservations_);
+    store_ = std::move(other.store_);
+    pending_records_ = std::move(other.pending_records_);
+    has_pending_records_.store(other.has_pending_records_.load());
+    next_device_id_ = other.next_device_id_;
+    max_uid_capacity_ = other.max_uid_capacity_;
+    max_reservation_age_s_ = other.max_reservation_age_s_;
+    last_eviction_time_ = other.last_eviction_time_;
+    clock_ = std::move(other.clock_);
+    lock_ = std::move(other.lock_);
+    store_lock_ = std::move(other.store_lock_);
+  }
+  return *this;
+}
+
+BrokerUidManager::~BrokerUidManager()
+{
+  // A manager which has been moved from has no locks and nothing to close.
+  if (store_lock_)
+    CloseReservationFile();
+}
+
 BrokerUidManager::AddResult BrokerUidManager::AddStaticUid(BrokerClient::Handle client_handle, const RdmUid& static_uid)
 {
   etcpal::WriteGuard write_guard(*lock_);
@@ -42,6 +96,10 @@ BrokerUidManager::AddResult BrokerUidManager::AddDynamicUid(BrokerClient::Handle
   if (uid_lookup_.size() >= max_uid_capacity_)
     return AddResult::kCapacityExceeded;
 
+  uint32_t now = clock_();
+  if (max_reservation_age_s_ != 0 && now - last_eviction_time_ >= kEvictionIntervalS)
+    EvictStaleReservations(now);
+
   UidData new_uid_data(client_handle);
 
   auto reservation = reservations_.find(cid_or_rid);
@@ -55,7 +113,9 @@ BrokerUidManager::AddResult BrokerUidManager::AddDynamicUid(BrokerClient::Handle
     {
       new_dynamic_uid = reservation->second.assigned_uid;
       reservation->second.currently_connected = true;
-      new_uid_data.reservation = &reservation->second;
+      reservation->second.last_seen = now;
+      new_uid_data.reservation = &*reservation;
+      StoreReservation(*reservation);
     }
   }
   else
@@ -65,8 +125,9 @@ BrokerUidManager::AddResult BrokerUidManager::AddDynamicUid(BrokerClient::Handle
     {
       new_dynamic_uid.id = next_device_id_++;
     } while ((next_device_id_ == 1) || uid_lookup_.find(new_dynamic_uid) != uid_lookup_.end());
-    auto ins_res = reservations_.insert(std::make_pair(cid_or_rid, ReservationData(new_dynamic_uid)));
-    new_uid_data.reservation = &ins_res.first->second;
+    auto ins_res = reservations_.insert(std::make_pair(cid_or_rid, ReservationData(new_dynamic_uid, now)));
+    new_uid_data.reservation = &*ins_res.first;
+    StoreReservation(*ins_res.first);
   }
   uid_lookup_.insert(std::make_pair(new_dynamic_uid, new_uid_data));
   return AddResult::kOk;
@@ -75,13 +136,16 @@ BrokerUidManager::AddResult BrokerUidManager::AddDynamicUid(BrokerClient::Handle
 void BrokerUidManager::RemoveUid(const RdmUid& uid)
 {
   etcpal::WriteGuard write_guard(*lock_);
- 
+
   auto uid_data = uid_lookup_.find(uid);
   if (uid_data != uid_lookup_.end())
   {
     if (uid_data->second.reservation)
     {
-      uid_data->second.reservation->currently_connected = false;
+      // Record when the component disconnected, which is where its reservation starts to age.
+      uid_data->second.reservation->second.currently_connected = false;
+      uid_data->second.reservation->second.last_seen = clock_();
+      StoreReservation(*uid_data->second.reservation);
     }
     uid_lookup_.erase(uid_data);
   }
@@ -102,3 +166,258 @@ bool BrokerUidManager::UidToHandle(const RdmUid& uid, BrokerClient::Handle& clie
     return false;
   }
 }
+
+// Load the reservations from a reservation file, and record reservations in the file from now on.
+// The file is created if it does not exist.
+etcpal::Error BrokerUidManager::OpenReservationFile(const std::string& path)
+{
+  etcpal::MutexGuard store_guard(*store_lock_);
+  etcpal::WriteGuard write_guard(*lock_);
+
+  // The file is read in full before any of it is applied, so that a file which can't be read
+  // doesn't leave some of its reservations behind. A later record for a CID or RID replaces an
+  // earlier one.
+  std::unique_ptr<BrokerUidStore>                                     store(new BrokerUidStore);
+  std::unordered_map<etcpal::Uuid, BrokerUidStore::Record, UuidHash> loaded;
+  uint32_t                                                            max_device_id = 0;
+  uint32_t                                                            now = clock_();
+
+  auto res = store->Open(path, [&](const BrokerUidStore::Record& record) {
+    if (record.uid.id > max_device_id)
+      max_device_id = record.uid.id;
+    loaded[record.cid_or_rid] = record;
+  });
+  if (!res)
+    return res;
+
+  // The reservations replaced by the file, so that they can be put back if it can't be used.
+  std::vector<etcpal::Uuid>                               added;
+  std::vector<std::pair<etcpal::Uuid, ReservationData>> replaced;
+  uint32_t                                                prev_next_device_id = next_device_id_;
+
+  for (const auto& loaded_record : loaded)
+  {
+    const BrokerUidStore::Record& record = loaded_record.second;
+
+    // A component which was still connected when the broker stopped could have been connected up
+    // until then, so its reservation starts to age now.
+    uint32_t last_seen = (record.in_use ? now : record.last_seen);
+
+    auto reservation = reservations_.find(record.cid_or_rid);
+    if (reservation == reservations_.end())
+    {
+      if (!record.released)
+      {
+        ReservationData data(record.uid, last_seen);
+        data.currently_connected = false;
+        reservations_.insert(std::make_pair(record.cid_or_rid, data));
+        added.push_back(record.cid_or_rid);
+      }
+    }
+    else if (!reservation->second.currently_connected)
+    {
+      replaced.push_back(*reservation);
+      if (record.released)
+      {
+        reservations_.erase(reservation);
+      }
+      else
+      {
+        reservation->second.assigned_uid = record.uid;
+        reservation->second.last_seen = last_seen;
+      }
+    }
+  }
+
+  // Don't hand out any of the loaded UIDs to other components.
+  if (max_device_id >= next_device_id_)
+    next_device_id_ = max_device_id + 1;
+
+  store_ = std::move(store);
+  EvictStaleReservations(now);
+
+  // No clients are connected yet, so the file can be compacted with lock_ held.
+  if (StoreNeedsCompaction())
+  {
+    if (RewriteStore(*store_, GetReservationRecords()))
+    {
+      pending_records_.clear();
+      has_pending_records_ = false;
+    }
+    else if (store_->needs_rewrite())
+    {
+      store_.reset();
+      pending_records_.clear();
+      has_pending_records_ = false;
+
+      for (const auto& cid_or_rid : added)
+        reservations_.erase(cid_or_rid);
+      for (const auto& prev : replaced)
+      {
+        auto reservation = reservations_.find(prev.first);
+        if (reservation == reservations_.end())
+          reservations_.insert(prev);
+        else
+          reservation->second = prev.second;
+      }
+      next_device_id_ = prev_next_device_id;
+      return kEtcPalErrSys;
+    }
+  }
+  return kEtcPalErrOk;
+}
+
+void BrokerUidManager::CloseReservationFile()
+{
+  etcpal::MutexGuard store_guard(*store_lock_);
+  FlushLocked();
+
+  etcpal::WriteGuard write_guard(*lock_);
+  store_.reset();
+  pending_records_.clear();
+  has_pending_records_ = false;
+}
+
+// Write the reservation changes made since the last flush to the reservation file. Must be called
+// without any of the broker's client locks held, as it waits on file I/O.
+void BrokerUidManager::FlushReservationFile()
+{
+  // This is called on every pass of the client service thread, so don't take the locks when there
+  // is nothing to write.
+  if (!has_pending_records_.load(std::memory_order_acquire))
+    return;
+
+  etcpal::MutexGuard store_guard(*store_lock_);
+  FlushLocked();
+}
+
+void BrokerUidManager::SetReservationMaxAge(uint32_t max_age_s)
+{
+  etcpal::WriteGuard write_guard(*lock_);
+  max_reservation_age_s_ = max_age_s;
+}
+
+void BrokerUidManager::SetClock(const ClockFunc& clock)
+{
+  etcpal::WriteGuard write_guard(*lock_);
+  clock_ = clock;
+}
+
+size_t BrokerUidManager::GetNumReservations() const
+{
+  etcpal::ReadGuard read_guard(*lock_);
+  return reservations_.size();
+}
+
+uint32_t BrokerUidManager::DefaultClock()
+{
+  return static_cast<uint32_t>(std::time(nullptr));
+}
+
+// Discard the reservations of components which have been disconnected for longer than the maximum
+// reservation age.
+void BrokerUidManager::EvictStaleReservations(uint32_t now)
+{
+  last_eviction_time_ = now;
+  if (max_reservation_age_s_ == 0)
+    return;
+
+  std::vector<etcpal::Uuid> evicted;
+  for (auto reservation = reservations_.begin(); reservation != reservations_.end();)
+  {
+    const ReservationData& data = reservation->second;
+    if (!data.currently_connected && now > data.last_seen && now - data.last_seen > max_reservation_age_s_)
+    {
+      evicted.push_back(reservation->first);
+      reservation = reservations_.erase(reservation);
+    }
+    else
+    {
+      ++reservation;
+    }
+  }
+
+  if (store_)
+  {
+    BrokerUidStore::Record record;
+    record.last_seen = now;
+    record.released = true;
+    for (const auto& cid_or_rid : evicted)
+    {
+      record.cid_or_rid = cid_or_rid;
+      pending_records_.push_back(record);
+    }
+    if (!pending_records_.empty())
+      has_pending_records_.store(true, std::memory_order_release);
+  }
+}
+
+// Needs a write lock on lock_. Queues a reservation to be written by the next flush.
+void BrokerUidManager::StoreReservation(const ReservationMap::value_type& reservation)
+{
+  if (store_)
+  {
+    BrokerUidStore::Record record;
+    record.cid_or_rid = reservation.first;
+    record.uid = reservation.second.assigned_uid;
+    record.last_seen = reservation.second.last_seen;
+    record.in_use = reservation.second.currently_connected;
+    pending_records_.push_back(record);
+    has_pending_records_.store(true, std::memory_order_release);
+  }
+}
+
+// Needs store_lock_. The pending records are taken with lock_ held, but written without it, so that
+// adding and removing UIDs doesn't wait on the disk.
+//
+// Failures to write the reservation file are not fatal; the reservations are still honored for as
+// long as the broker is running.
+void BrokerUidManager::FlushLocked()
+{
+  std::vector<BrokerUidStore::Record> to_append;
+  std::vector<BrokerUidStore::Record> to_rewrite;
+  bool                                compact = false;
+  {  // Lock scope
+    etcpal::WriteGuard write_guard(*lock_);
+    if (!store_ || pending_records_.empty())
+      return;
+
+    // Rewrite the file with only the current reservations if outdated records would make up most of
+    // it. The pending records are kept in case the rewrite fails.
+    compact = StoreNeedsCompaction();
+    if (compact)
+      to_rewrite = GetReservationRecords();
+    to_append.swap(pending_records_);
+    has_pending_records_.store(false, std::memory_order_relaxed);
+  }
+
+  if (!compact || !RewriteStore(*store_, to_rewrite))
+  {
+    for (const auto& record : to_append)
+      store_->Append(record);
+  }
+}
+
+// Needs store_lock_ and lock_.
+bool BrokerUidManager::StoreNeedsCompaction() const
+{
+  size_t num_records = store_->record_count() + pending_records_.size();
+  return (store_->needs_rewrite() || (num_records >= kMinCompactionRecords && num_records > 2 * reservations_.size()));
+}
+
+// Needs lock_. Returns a record for each current reservation.
+std::vector<BrokerUidStore::Record> BrokerUidManager::GetReservationRecords() const
+{
+  std::vector<BrokerUidStore::Record> records;
+  records.reserve(reservations_.size());
+  for (const auto& reservation : reservations_)
+  {
+    BrokerUidStore::Record record;
+    record.cid_or_rid = reservation.first;
+    record.uid = reservation.second.assigned_uid;
+    record.last_seen = reservation.second.last_seen;
+    record.in_use = reservation.second.currently_connected;
+    records.push_back(record);
+  }
+  return records;
+}
@@ -20,22 +20,44 @@
 #ifndef BROKER_UID_MANAGER_H_
 #define BROKER_UID_MANAGER_H_
 
+#include <atomic>
+#include <functional>
 #include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "etcpal/cpp/error.h"
+#include "etcpal/cpp/mutex.h"
 #include "etcpal/cpp/uuid.h"
 #include "etcpal/cpp/rwlock.h"
 #include "rdm/uid.h"
 #include "broker_client.h"
+#include "broker_uid_store.h"
+#include "broker_util.h"
 
 /// @brief Keeps track of all UIDs tracked by this Broker, and generates new Dynamic UIDs upon
 ///        request.
 ///
 /// This class does very little validation of UIDs - that is expected to be done before this class
 /// is used.
+///
+/// Each dynamic UID is reserved for the CID or RID it was assigned to, so that the component gets
+/// the same UID back when it reconnects. Reservations are kept in memory, and can also be kept in a
+/// BrokerUidStore file so that they survive a restart. Changes to the reservations are written to
+/// the file by FlushReservationFile() rather than as they are made, because they are made while the
+/// broker's routing locks are held.
 class BrokerUidManager
 {
 public:
+  // Returns the current time in seconds since the Unix epoch.
+  using ClockFunc = std::function<uint32_t()>;
+
   BrokerUidManager() = default;
   explicit BrokerUidManager(size_t max_uid_capacity) : max_uid_capacity_(max_uid_capacity) {}
+  BrokerUidManager(BrokerUidManager&& other) noexcept;
+  BrokerUidManager& operator=(BrokerUidManager&& other) noexcept;
+  ~BrokerUidManager();
 
   static constexpr size_t kDefaultMaxUidCapacity = 1000000;
   enum class AddResult
@@ -58,32 +80,69 @@ public:
     next_device_id_ = next_device_id;
   }
 
+  etcpal::Error OpenReservationFile(const std::string& path);
+  void          CloseReservationFile();
+  void          FlushReservationFile();
+  void          SetReservationMaxAge(uint32_t max_age_s);
+  void          SetClock(const ClockFunc& clock);
+
+  size_t GetNumReservations() const;
+
+  // Reservations of disconnected components are checked for expiry at most this often.
+  static constexpr uint32_t kEvictionIntervalS = 60;
+  // The reservation file is not compacted until it holds at least this many records.
+  static constexpr size_t kMinCompactionRecords = 1024;
+
 private:
   struct ReservationData
   {
-    explicit ReservationData(const RdmUid& uid) : assigned_uid(uid) {}
+    ReservationData(const RdmUid& uid, uint32_t last_seen_in) : assigned_uid(uid), last_seen(last_seen_in) {}
 
-    RdmUid assigned_uid;
-    bool   currently_connected{true};
+    RdmUid   assigned_uid;
+    uint32_t last_seen;
+    bool     currently_connected{true};
   };
+  using ReservationMap = std::unordered_map<etcpal::Uuid, ReservationData, UuidHash>;
+
   struct UidData
   {
     explicit UidData(BrokerClient::Handle client_handle_in) : client_handle(client_handle_in) {}
 
-    BrokerClient::Handle client_handle;
-    ReservationData*     reservation{nullptr};
+    BrokerClient::Handle        client_handle;
+    ReservationMap::value_type* reservation{nullptr};
   };
 
   // The uid-keyed lookup table
   std::map<RdmUid, UidData> uid_lookup_;
   // We try to give the same components back their dynamic UIDs when they reconnect.
-  // TODO: scalability/flushing to disk.
-  std::map<etcpal::Uuid, ReservationData> reservations_;
+  ReservationMap reservations_;
+  // Persists reservations_, if a reservation file has been opened. store_ is only set or reset with
+  // both store_lock_ and lock_ held, and the file is only written with store_lock_ held.
+  std::unique_ptr<BrokerUidStore> store_;
+  // Changes to reservations_ which haven't been written to store_ yet. has_pending_records_ is only
+  // changed with lock_ held, but can be checked without it.
+  std::vector<BrokerUidStore::Record> pending_records_;
+  std::atomic<bool>                   has_pending_records_{false};
   // The next dynamic RDM Device ID that will be assigned
   uint32_t next_device_id_{1};
   size_t   max_uid_capacity_{kDefaultMaxUidCapacity};
+  // Reservations of components that have been disconnected for longer than this are discarded.
+  // 0 means reservations are kept forever.
+  uint32_t  max_reservation_age_s_{0};
+  uint32_t  last_eviction_time_{0};
+  ClockFunc clock_{DefaultClock};
   // Protects the members of BrokerUidManager
   mutable std::unique_ptr<etcpal::RwLock> lock_{new etcpal::RwLock};
+  // Serializes writes to store_. Taken before lock_ when both are needed.
+  std::unique_ptr<etcpal::Mutex> store_lock_{new etcpal::Mutex};
+
+  static uint32_t DefaultClock();
+
+  void                                EvictStaleReservations(uint32_t now);
+  void                                StoreReservation(const ReservationMap::value_type& reservation);
+  void                                FlushLocked();
+  bool                                StoreNeedsCompaction() const;
+  std::vector<BrokerUidStore::Record> GetReservationRecords() const;
 };
 
 #endif  // BROKER_UID_MANAGER_H_
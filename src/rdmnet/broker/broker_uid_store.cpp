@@ -0,0 +1,385 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+#include "broker_uid_store.h"
+
+#include <cerrno>
+#include <cstring>
+#include <vector>
+#include "etcpal/pack.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*************************** Private constants *******************************/
+
+namespace
+{
+const uint8_t      kFileMagic[8] = {'R', 'D', 'M', 'n', 'e', 't', 'U', 'R'};
+constexpr uint32_t kFileVersion = 1;
+
+constexpr uint8_t kRecordTypeReserve = 1;
+constexpr uint8_t kRecordTypeRelease = 2;
+
+constexpr uint8_t kRecordFlagInUse = 0x01;
+
+// The number of records collected before each write when rewriting the file.
+constexpr size_t kRewriteBatchRecords = 2048;
+
+/*************************** Record packing **********************************/
+
+// Record layout, all values big-endian:
+//   0: CID or RID (16 bytes)
+//  16: UID manufacturer ID (2 bytes)
+//  18: Record type (1 byte)
+//  19: Flags (1 byte)
+//  20: UID device ID (4 bytes)
+//  24: Last seen time, seconds since the Unix epoch (4 bytes)
+//  28: FNV-1a hash of the preceding 28 bytes, taken a 32-bit word at a time (4 bytes)
+uint32_t RecordCheckValue(const uint8_t* buf)
+{
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < BrokerUidStore::kRecordSize - 4; i += 4)
+  {
+    hash ^= etcpal_unpack_u32b(&buf[i]);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+void PackHeader(uint8_t* buf)
+{
+  memcpy(buf, kFileMagic, sizeof(kFileMagic));
+  etcpal_pack_u32b(&buf[8], kFileVersion);
+  etcpal_pack_u32b(&buf[12], static_cast<uint32_t>(BrokerUidStore::kRecordSize));
+}
+
+bool HeaderIsValid(const uint8_t* buf)
+{
+  return (memcmp(buf, kFileMagic, sizeof(kFileMagic)) == 0 && etcpal_unpack_u32b(&buf[8]) == kFileVersion &&
+          etcpal_unpack_u32b(&buf[12]) == BrokerUidStore::kRecordSize);
+}
+
+void PackRecord(uint8_t* buf, const BrokerUidStore::Record& record)
+{
+  memcpy(buf, record.cid_or_rid.get().data, ETCPAL_UUID_BYTES);
+  etcpal_pack_u16b(&buf[16], record.uid.manu);
+  buf[18] = record.released ? kRecordTypeRelease : kRecordTypeReserve;
+  buf[19] = record.in_use ? kRecordFlagInUse : 0;
+  etcpal_pack_u32b(&buf[20], record.uid.id);
+  etcpal_pack_u32b(&buf[24], record.last_seen);
+  etcpal_pack_u32b(&buf[28], RecordCheckValue(buf));
+}
+
+bool UnpackRecord(const uint8_t* buf, BrokerUidStore::Record& record)
+{
+  if (etcpal_unpack_u32b(&buf[28]) != RecordCheckValue(buf))
+    return false;
+  if (buf[18] != kRecordTypeReserve && buf[18] != kRecordTypeRelease)
+    return false;
+
+  EtcPalUuid cid_or_rid;
+  memcpy(cid_or_rid.data, buf, ETCPAL_UUID_BYTES);
+  record.cid_or_rid = cid_or_rid;
+  record.uid.manu = etcpal_unpack_u16b(&buf[16]);
+  record.released = (buf[18] == kRecordTypeRelease);
+  record.in_use = ((buf[19] & kRecordFlagInUse) != 0);
+  record.uid.id = etcpal_unpack_u32b(&buf[20]);
+  record.last_seen = etcpal_unpack_u32b(&buf[24]);
+  return true;
+}
+
+/*************************** Mapped file access ******************************/
+
+// A read-only mapping of the whole of a file. A file which does not exist maps as empty.
+class MappedFile
+{
+public:
+  MappedFile() = default;
+  ~MappedFile();
+  MappedFile(const MappedFile& other) = delete;
+  MappedFile& operator=(const MappedFile& other) = delete;
+
+  etcpal::Error Map(const std::string& path);
+
+  const uint8_t* data() const { return data_; }
+  size_t         size() const { return size_; }
+
+private:
+#ifdef _WIN32
+  HANDLE file_{INVALID_HANDLE_VALUE};
+  HANDLE mapping_{nullptr};
+#else
+  int fd_{-1};
+#endif
+  const uint8_t* data_{nullptr};
+  size_t         size_{0};
+};
+
+#ifdef _WIN32
+
+etcpal::Error MappedFile::Map(const std::string& path)
+{
+  file_ = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                      FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+  if (file_ == INVALID_HANDLE_VALUE)
+    return (GetLastError() == ERROR_FILE_NOT_FOUND ? kEtcPalErrOk : kEtcPalErrSys);
+
+  LARGE_INTEGER file_size;
+  if (!GetFileSizeEx(file_, &file_size))
+    return kEtcPalErrSys;
+  if (file_size.QuadPart == 0)
+    return kEtcPalErrOk;
+  if (static_cast<unsigned long long>(file_size.QuadPart) > SIZE_MAX)
+    return kEtcPalErrNoMem;
+
+  mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mapping_)
+    return kEtcPalErrSys;
+  data_ = static_cast<const uint8_t*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+  if (!data_)
+    return kEtcPalErrSys;
+  size_ = static_cast<size_t>(file_size.QuadPart);
+  return kEtcPalErrOk;
+}
+
+MappedFile::~MappedFile()
+{
+  if (data_)
+    UnmapViewOfFile(data_);
+  if (mapping_)
+    CloseHandle(mapping_);
+  if (file_ != INVALID_HANDLE_VALUE)
+    CloseHandle(file_);
+}
+
+bool SyncFile(FILE* file)
+{
+  return (std::fflush(file) == 0 && _commit(_fileno(file)) == 0);
+}
+
+bool MoveOverFile(const std::string& from, const std::string& to)
+{
+  return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+}
+
+#else  // _WIN32
+
+etcpal::Error MappedFile::Map(const std::string& path)
+{
+  fd_ = open(path.c_str(), O_RDONLY);
+  if (fd_ < 0)
+    return (errno == ENOENT ? kEtcPalErrOk : kEtcPalErrSys);
+
+  struct stat file_stat;
+  if (fstat(fd_, &file_stat) != 0)
+    return kEtcPalErrSys;
+  if (file_stat.st_size == 0)
+    return kEtcPalErrOk;
+  if (static_cast<unsigned long long>(file_stat.st_size) > SIZE_MAX)
+    return kEtcPalErrNoMem;
+
+  size_t size = static_cast<size_t>(file_stat.st_size);
+  void*  addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd_, 0);
+  if (addr == MAP_FAILED)
+    return kEtcPalErrSys;
+  madvise(addr, size, MADV_SEQUENTIAL);
+  data_ = static_cast<const uint8_t*>(addr);
+  size_ = size;
+  return kEtcPalErrOk;
+}
+
+MappedFile::~MappedFile()
+{
+  if (data_)
+    munmap(const_cast<uint8_t*>(data_), size_);
+  if (fd_ >= 0)
+    close(fd_);
+}
+
+bool SyncFile(FILE* file)
+{
+  return (std::fflush(file) == 0 && fsync(fileno(file)) == 0);
+}
+
+bool MoveOverFile(const std::string& from, const std::string& to)
+{
+  return std::rename(from.c_str(), to.c_str()) == 0;
+}
+
+#endif  // _WIN32
+
+}  // namespace
+
+/*************************** Function definitions ****************************/
+
+BrokerUidStore::~BrokerUidStore()
+{
+  Close();
+}
+
+etcpal::Error BrokerUidStore::Open(const std::string& path, const RecordFunc& record_func)
+{
+  Close();
+
+  record_count_ = 0;
+  needs_rewrite_ = false;
+  {  // Mapping scope
+    // The mapping must be gone before the file is opened for appending; on Windows, it holds the
+    // file open without write sharing.
+    MappedFile mapped;
+    auto       res = mapped.Map(path);
+    if (!res)
+      return res;
+
+    if (mapped.size() == 0)
+    {
+      // A new file; the header still needs to be written.
+      needs_rewrite_ = true;
+    }
+    else
+    {
+      // Don't overwrite a file that doesn't look like one of ours.
+      if (mapped.size() < kHeaderSize || !HeaderIsValid(mapped.data()))
+        return kEtcPalErrInvalid;
+
+      Record         record;
+      const uint8_t* cur_ptr = mapped.data() + kHeaderSize;
+      const uint8_t* end_ptr = mapped.data() + mapped.size();
+      for (; static_cast<size_t>(end_ptr - cur_ptr) >= kRecordSize; cur_ptr += kRecordSize)
+      {
+        // A damaged record only loses that one change; the records after it are still good.
+        if (!UnpackRecord(cur_ptr, record))
+        {
+          needs_rewrite_ = true;
+          continue;
+        }
+        record_func(record);
+        ++record_count_;
+      }
+      // A partial record at the end was left by an interrupted write. It and any damaged records
+      // must be removed before more records are appended.
+      if (cur_ptr != end_ptr)
+        needs_rewrite_ = true;
+    }
+  }
+
+  path_ = path;
+  if (!needs_rewrite_)
+  {
+    file_ = std::fopen(path_.c_str(), "ab");
+    if (!file_)
+      return kEtcPalErrSys;
+  }
+  return kEtcPalErrOk;
+}
+
+void BrokerUidStore::Close()
+{
+  if (file_)
+  {
+    std::fclose(file_);
+    file_ = nullptr;
+  }
+}
+
+etcpal::Error BrokerUidStore::Append(const Record& record)
+{
+  if (!file_)
+    return kEtcPalErrInvalid;
+
+  uint8_t buf[kRecordSize];
+  PackRecord(buf, record);
+  if (std::fwrite(buf, 1, sizeof(buf), file_) != sizeof(buf) || std::fflush(file_) != 0)
+    return kEtcPalErrSys;
+  ++record_count_;
+  return kEtcPalErrOk;
+}
+
+etcpal::Error BrokerUidStore::Rewrite(const std::function<bool(Record&)>& next_record)
+{
+  if (path_.empty())
+    return kEtcPalErrInvalid;
+
+  std::string tmp_path = path_ + ".tmp";
+  FILE*       tmp_file = std::fopen(tmp_path.c_str(), "wb");
+  if (!tmp_file)
+    return kEtcPalErrSys;
+
+  std::vector<uint8_t> buf(kHeaderSize + kRewriteBatchRecords * kRecordSize);
+  PackHeader(buf.data());
+  size_t buf_used = kHeaderSize;
+  size_t new_record_count = 0;
+  bool   write_ok = true;
+
+  Record record;
+  while (write_ok && next_record(record))
+  {
+    PackRecord(&buf[buf_used], record);
+    buf_used += kRecordSize;
+    ++new_record_count;
+    if (buf.size() - buf_used < kRecordSize)
+    {
+      write_ok = (std::fwrite(buf.data(), 1, buf_used, tmp_file) == buf_used);
+      buf_used = 0;
+    }
+  }
+  if (write_ok && buf_used != 0)
+    write_ok = (std::fwrite(buf.data(), 1, buf_used, tmp_file) == buf_used);
+  // The new contents must be on disk before they replace the old file, or a crash could leave
+  // neither of them.
+  if (write_ok)
+    write_ok = SyncFile(tmp_file);
+  if (std::fclose(tmp_file) != 0)
+    write_ok = false;
+
+  if (!write_ok)
+  {
+    std::remove(tmp_path.c_str());
+    return kEtcPalErrSys;
+  }
+
+  // Open handles prevent the file from being replaced on some platforms.
+  Close();
+  if (!MoveOverFile(tmp_path, path_))
+  {
+    std::remove(tmp_path.c_str());
+    if (!needs_rewrite_)
+      file_ = std::fopen(path_.c_str(), "ab");
+    return kEtcPalErrSys;
+  }
+
+  record_count_ = new_record_count;
+  needs_rewrite_ = false;
+  file_ = std::fopen(path_.c_str(), "ab");
+  return (file_ ? kEtcPalErrOk : kEtcPalErrSys);
+}
@@ -0,0 +1,88 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+#ifndef BROKER_UID_STORE_H_
+#define BROKER_UID_STORE_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include "etcpal/cpp/error.h"
+#include "etcpal/cpp/uuid.h"
+#include "rdm/uid.h"
+
+/// @brief A file which records the dynamic UIDs assigned to each CID or RID, so that the
+///        assignments survive a restart of the Broker.
+///
+/// The file is a short header followed by fixed-size records. Each record either reserves a UID
+/// for a CID/RID or releases the reservation; a later record for the same CID/RID replaces an
+/// earlier one. Changes are appended to the end of the file as they happen. Because that leaves
+/// outdated records behind, the owner rewrites the file with only the current reservations when
+/// the outdated records start to outnumber them. The file is memory-mapped to read it back, and a
+/// record which was only partially written is ignored.
+class BrokerUidStore
+{
+public:
+  struct Record
+  {
+    etcpal::Uuid cid_or_rid;
+    RdmUid       uid{};
+    // Seconds since the Unix epoch at which the reservation was last in use.
+    uint32_t last_seen{0};
+    // If true, this record releases the reservation for cid_or_rid.
+    bool released{false};
+    // If true, the component was connected when this record was written. If the broker stopped
+    // without recording the disconnect, the component may have been connected until then.
+    bool in_use{false};
+  };
+  using RecordFunc = std::function<void(const Record&)>;
+
+  static constexpr size_t kHeaderSize = 16;
+  static constexpr size_t kRecordSize = 32;
+
+  BrokerUidStore() = default;
+  ~BrokerUidStore();
+  BrokerUidStore(const BrokerUidStore& other) = delete;
+  BrokerUidStore& operator=(const BrokerUidStore& other) = delete;
+
+  // Opens the file at path, creating it if it does not exist, and calls record_func for each
+  // record in it in the order they were written. The file must be rewritten before appending to it
+  // if needs_rewrite() is true afterwards.
+  etcpal::Error Open(const std::string& path, const RecordFunc& record_func);
+  void          Close();
+  bool          IsOpen() const { return file_ != nullptr; }
+
+  etcpal::Error Append(const Record& record);
+  // Replaces the contents of the file with the records produced by calling next_record until it
+  // returns false.
+  etcpal::Error Rewrite(const std::function<bool(Record&)>& next_record);
+
+  // The number of records in the file, including outdated ones.
+  size_t record_count() const { return record_count_; }
+  bool   needs_rewrite() const { return needs_rewrite_; }
+
+private:
+  std::string path_;
+  FILE*       file_{nullptr};
+  size_t      record_count_{0};
+  bool        needs_rewrite_{false};
+};
+
+#endif  // BROKER_UID_STORE_H_
@@ -55,6 +55,52 @@ BrokerClient::Handle ClientHandleGenerator::GetClientHandle()
   return get_next_int_handle(&handle_mgr_);
 }
 
+static bool ClientEntriesEqual(const RdmnetRptClientEntry& a, const RdmnetRptClientEntry& b)
+{
+  return (ETCPAL_UUID_CMP(&a.cid, &b.cid) == 0) && (a.uid == b.uid) && (a.type == b.type) &&
+         (ETCPAL_UUID_CMP(&a.binding_cid, &b.binding_cid) == 0);
+}
+
+void ClientListDeltas::AddClient(BrokerClient::Handle handle, const RdmnetRptClientEntry& entry)
+{
+  // If the same entry was removed since the last update, controllers still have it - unless a
+  // client list was sent without it in the meantime.
+  auto removed = removes_.find(entry.cid);
+  if (removed != removes_.end() && !removed->second.in_snapshot && ClientEntriesEqual(removed->second.entry, entry))
+  {
+    removes_.erase(removed);
+    return;
+  }
+
+  adds_[entry.cid] = AddedClient{handle, entry, false};
+}
+
+void ClientListDeltas::RemoveClient(const RdmnetRptClientEntry& entry)
+{
+  // If the entry was added since the last update, controllers never learned about it - unless a
+  // client list was sent with it in the meantime.
+  auto added = adds_.find(entry.cid);
+  if (added != adds_.end() && ClientEntriesEqual(added->second.entry, entry))
+  {
+    bool in_snapshot = added->second.in_snapshot;
+    adds_.erase(added);
+    if (!in_snapshot)
+      return;
+  }
+
+  removes_[entry.cid] = RemovedClient{entry, false};
+}
+
+// Called when a full client list is taken. The list reflects every pending change, so none of them
+// can be cancelled out by a later change any more.
+void ClientListDeltas::SnapshotTaken()
+{
+  for (auto& added : adds_)
+    added.second.in_snapshot = true;
+  for (auto& removed : removes_)
+    removed.second.in_snapshot = true;
+}
+
 RptHeader SwapHeaderData(const RptHeader& source)
 {
   RptHeader swapped_header;
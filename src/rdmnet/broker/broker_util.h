@@ -22,8 +22,12 @@
 #ifndef BROKER_UTIL_H_
 #define BROKER_UTIL_H_
 
+#include <cstdint>
+#include <cstring>
 #include <functional>
+#include <map>
 #include "etcpal/common.h"
+#include "etcpal/cpp/uuid.h"
 #include "etcpal/handle_manager.h"
 #include "rdmnet/core/rpt_prot.h"
 #include "rdmnet/core/util.h"
@@ -49,6 +53,61 @@ private:
   IntHandleManager handle_mgr_;
 };
 
+// Collects changes to the RPT client list so that they can be sent to controllers in batches. A
+// client which is added and then removed before the changes are sent cancels out, as does a client
+// which is removed and then added again with an identical entry. Changes which were pending when a
+// full client list was taken no longer cancel out, since a controller may have received the list.
+class ClientListDeltas
+{
+public:
+  struct AddedClient
+  {
+    BrokerClient::Handle handle;
+    RdmnetRptClientEntry entry;
+    bool                 in_snapshot{false};
+  };
+  struct RemovedClient
+  {
+    RdmnetRptClientEntry entry;
+    bool                 in_snapshot{false};
+  };
+  using AddMap = std::map<etcpal::Uuid, AddedClient>;
+  using RemoveMap = std::map<etcpal::Uuid, RemovedClient>;
+
+  void AddClient(BrokerClient::Handle handle, const RdmnetRptClientEntry& entry);
+  void RemoveClient(const RdmnetRptClientEntry& entry);
+  void SnapshotTaken();
+
+  const AddMap&    adds() const { return adds_; }
+  const RemoveMap& removes() const { return removes_; }
+  size_t           size() const { return adds_.size() + removes_.size(); }
+  bool             empty() const { return adds_.empty() && removes_.empty(); }
+
+private:
+  AddMap    adds_;
+  RemoveMap removes_;
+};
+
+// Hashes an RdmUid for use as a key in unordered containers.
+struct RdmUidHash
+{
+  size_t operator()(const RdmUid& uid) const noexcept
+  {
+    return std::hash<uint64_t>()((static_cast<uint64_t>(uid.manu) << 32) | uid.id);
+  }
+};
+
+// Hashes a CID or RID for use as a key in unordered containers.
+struct UuidHash
+{
+  size_t operator()(const etcpal::Uuid& uuid) const noexcept
+  {
+    uint64_t halves[2];
+    std::memcpy(halves, uuid.get().data, sizeof(halves));
+    return std::hash<uint64_t>()(halves[0] ^ halves[1]);
+  }
+};
+
 // Utility functions for manipulating messages
 RptHeader SwapHeaderData(const RptHeader& source);
 
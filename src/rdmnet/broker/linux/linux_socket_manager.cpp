@@ -18,7 +18,21 @@
  *****************************************************************************/
 
 // epoll() is a scalabile mechanism for watching many file descriptors (including sockets) in the
-// Linux kernel. For this app, we use a single thread polling all of the currently-open sockets.
+// Linux kernel. For this app, we use a pool of reader threads, each polling its own epoll fd which
+// watches a shard of the currently-open sockets. A socket is assigned to a shard when it is added
+// and stays there until it is removed, so each shard's lock is only contended by its own reader
+// thread and by socket add/remove operations.
+//
+// When a received message can't be routed because a destination queue is full, the socket it came
+// from is parked: it is left registered with its shard's epoll fd but only watched for the peer
+// closing the connection, so no more data is read from it, and the message is kept in its receive
+// buffer. Other sockets in the
+// shard continue to be serviced normally. When the broker core signals that queues have drained,
+// each shard's reader thread is woken through an eventfd and retries the parked messages.
+//
+// Sends are made by the broker core without blocking. When a socket's send buffer fills, the core
+// asks for the socket to be watched for EPOLLOUT as well, and is notified from the reader thread
+// when it drains. EPOLLOUT is dropped again as soon as it has been reported.
 //
 // Further reading:
 // "man epoll" from a Linux distribution command line
@@ -27,7 +41,9 @@
 #include "linux_socket_manager.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <sys/epoll.h>
+#include <sys/eventfd.h>
 #include <sys/types.h>
 #include <sys/socket.h>
 #include <unistd.h>
@@ -36,29 +52,49 @@
 constexpr int kMaxEvents = 100;
 constexpr int kEpollTimeout = 200;
 
-// Function for the worker thread which does all the socket reading.
+// The epoll data value which identifies each shard's resume eventfd. Client handles are never
+// negative.
+constexpr int kResumeEventData = -1;
+
+// Function for the worker threads which do all the socket reading. Each thread services one shard.
 void* SocketWorkerThread(void* arg)
 {
-  LinuxBrokerSocketManager* sock_mgr = reinterpret_cast<LinuxBrokerSocketManager*>(arg);
-  if (!sock_mgr)
+  SocketShard* shard = reinterpret_cast<SocketShard*>(arg);
+  if (!shard || !shard->sock_mgr)
     return reinterpret_cast<void*>(1);
 
+  LinuxBrokerSocketManager*             sock_mgr = shard->sock_mgr;
   std::unique_ptr<struct epoll_event[]> events(new struct epoll_event[kMaxEvents]);
 
   while (sock_mgr->keep_running())
   {
-    int epoll_result = epoll_wait(sock_mgr->epoll_fd(), events.get(), kMaxEvents, kEpollTimeout);
+    int epoll_result = epoll_wait(shard->epoll_fd, events.get(), kMaxEvents, kEpollTimeout);
     for (int i = 0; i < epoll_result && sock_mgr->keep_running(); ++i)
     {
-      if (events[i].events & EPOLLERR)
+      if (events[i].data.fd == kResumeEventData)
       {
-        // Notify that this socket is bad
-        sock_mgr->WorkerNotifySocketBad(events[i].data.fd);
+        // Queues have drained; retry any parked sockets
+        sock_mgr->WorkerResumeParkedSockets(*shard);
       }
-      else if (events[i].events & EPOLLIN)
+      else if ((events[i].events & (EPOLLERR | EPOLLRDHUP)) ||
+               ((events[i].events & EPOLLHUP) && !(events[i].events & EPOLLIN)))
+      {
+        // Notify that this socket is bad. EPOLLRDHUP is only watched for on parked sockets, and a
+        // hangup without EPOLLIN means the socket is parked, so neither will be found through a read.
+        sock_mgr->WorkerNotifySocketBad(*shard, events[i].data.fd);
+      }
+      else
       {
-        // Do the read on the socket
-        sock_mgr->WorkerNotifySocketReadEvent(events[i].data.fd);
+        if (events[i].events & EPOLLOUT)
+        {
+          // The socket has room to send again
+          sock_mgr->WorkerNotifySocketWriteEvent(*shard, events[i].data.fd);
+        }
+        if (events[i].events & EPOLLIN)
+        {
+          // Do the read on the socket
+          sock_mgr->WorkerNotifySocketReadEvent(*shard, events[i].data.fd);
+        }
       }
     }
   }
@@ -67,66 +103,133 @@ void* SocketWorkerThread(void* arg)
 
 bool LinuxBrokerSocketManager::Startup()
 {
-  // Per the man page, the size argument is ignored but must be greater than zero. Random value was
-  // chosen
-  epoll_fd_ = epoll_create(42);
-  if (epoll_fd_ < 0)
-    return false;
+  unsigned int num_threads = num_threads_;
+  if (num_threads == 0)
+  {
+    long num_cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    num_threads = (num_cpus > 0 ? static_cast<unsigned int>(num_cpus) : 1u);
+  }
 
-  if (0 != pthread_create(&thread_handle_, NULL, SocketWorkerThread, this))
+  bool ok = true;
+  for (unsigned int i = 0; i < num_threads; ++i)
   {
-    close(epoll_fd_);
-    epoll_fd_ = -1;
-    return false;
+    std::unique_ptr<SocketShard> shard(new SocketShard);
+    shard->sock_mgr = this;
+
+    // Per the man page, the size argument is ignored but must be greater than zero. Random value
+    // was chosen
+    shard->epoll_fd = epoll_create(42);
+    if (shard->epoll_fd < 0)
+    {
+      ok = false;
+      break;
+    }
+
+    shard->resume_event_fd = eventfd(0, EFD_NONBLOCK);
+    if (shard->resume_event_fd >= 0)
+    {
+      struct epoll_event resume_event;
+      resume_event.events = EPOLLIN;
+      resume_event.data.fd = kResumeEventData;
+      if (0 != epoll_ctl(shard->epoll_fd, EPOLL_CTL_ADD, shard->resume_event_fd, &resume_event))
+      {
+        close(shard->resume_event_fd);
+        shard->resume_event_fd = -1;
+      }
+    }
+    if (shard->resume_event_fd < 0)
+    {
+      close(shard->epoll_fd);
+      ok = false;
+      break;
+    }
+
+    if (0 != pthread_create(&shard->thread_handle, NULL, SocketWorkerThread, shard.get()))
+    {
+      close(shard->resume_event_fd);
+      close(shard->epoll_fd);
+      ok = false;
+      break;
+    }
+    shard->thread_started = true;
+
+    shards_.push_back(std::move(shard));
   }
 
-  return true;
+  if (!ok)
+    Shutdown();
+  return ok;
 }
 
 bool LinuxBrokerSocketManager::Shutdown()
 {
   shutting_down_ = true;
 
-  if (epoll_fd_ >= 0)
-    close(epoll_fd_);
-
-  // Shutdown the worker thread
-  pthread_join(thread_handle_, NULL);
+  // Shutdown the worker threads
+  for (auto& shard : shards_)
+  {
+    if (shard->thread_started)
+      pthread_join(shard->thread_handle, NULL);
+    shard->thread_started = false;
+  }
 
-  etcpal::MutexGuard socket_guard(socket_lock_);
-  for (auto& sock_data : sockets_)
+  for (auto& shard : shards_)
   {
-    shutdown(sock_data.second->socket, SHUT_RDWR);
-    close(sock_data.second->socket);
+    if (shard->epoll_fd >= 0)
+      close(shard->epoll_fd);
+    shard->epoll_fd = -1;
+    if (shard->resume_event_fd >= 0)
+      close(shard->resume_event_fd);
+    shard->resume_event_fd = -1;
+
+    etcpal::MutexGuard socket_guard(shard->socket_lock);
+    for (auto& sock_data : shard->sockets)
+    {
+      shutdown(sock_data.second->socket, SHUT_RDWR);
+      close(sock_data.second->socket);
+    }
+    shard->sockets.clear();
+    shard->parked_sockets.clear();
   }
-  sockets_.clear();
+  shards_.clear();
 
   return true;
 }
 
+// Handles are allocated sequentially by the broker core, so distributing them by modulus spreads
+// sockets evenly across the shards without needing a separate handle-to-shard lookup.
+SocketShard& LinuxBrokerSocketManager::ShardForHandle(BrokerClient::Handle client_handle)
+{
+  return *shards_[static_cast<size_t>(client_handle) % shards_.size()];
+}
+
 bool LinuxBrokerSocketManager::AddSocket(BrokerClient::Handle client_handle, etcpal_socket_t socket)
 {
-  etcpal::MutexGuard socket_guard(socket_lock_);
+  if (shards_.empty() || client_handle < 0)
+    return false;
+
+  SocketShard&       shard = ShardForHandle(client_handle);
+  etcpal::MutexGuard socket_guard(shard.socket_lock);
 
   // Create the data structure for the new socket
   std::unique_ptr<SocketData> new_sock_data(new SocketData(client_handle, socket));
   if (new_sock_data)
   {
     // Add it to the socket map
-    auto result = sockets_.insert(std::make_pair(client_handle, std::move(new_sock_data)));
+    auto result = shard.sockets.insert(std::make_pair(client_handle, std::move(new_sock_data)));
     if (result.second)
     {
-      // Add the socket to our epoll fd
+      // Add the socket to the shard's epoll fd
       struct epoll_event new_event;
       new_event.events = EPOLLIN;
       new_event.data.fd = client_handle;
-      if (0 == epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, socket, &new_event))
+      if (0 == epoll_ctl(shard.epoll_fd, EPOLL_CTL_ADD, socket, &new_event))
       {
         return true;
       }
       else
       {
-        sockets_.erase(client_handle);
+        shard.sockets.erase(client_handle);
       }
     }
   }
@@ -135,28 +238,62 @@ bool LinuxBrokerSocketManager::AddSocket(BrokerClient::Handle client_handle, etc
 
 void LinuxBrokerSocketManager::RemoveSocket(BrokerClient::Handle client_handle)
 {
-  etcpal::MutexGuard socket_guard(socket_lock_);
+  if (shards_.empty() || client_handle < 0)
+    return;
+
+  SocketShard&       shard = ShardForHandle(client_handle);
+  etcpal::MutexGuard socket_guard(shard.socket_lock);
 
-  auto sock_data = sockets_.find(client_handle);
-  if (sock_data != sockets_.end())
+  auto sock_data = shard.sockets.find(client_handle);
+  if (sock_data != shard.sockets.end())
   {
     // Per the epoll man page, deregister is not necessary before closing the socket.
     shutdown(sock_data->second->socket, SHUT_RDWR);
     close(sock_data->second->socket);
-    sockets_.erase(sock_data);
+    shard.sockets.erase(sock_data);
   }
 }
 
-void LinuxBrokerSocketManager::WorkerNotifySocketBad(BrokerClient::Handle client_handle)
+void LinuxBrokerSocketManager::ResumeParkedSockets()
+{
+  // Just wake up each reader thread; the retries happen on the threads which own the sockets. A
+  // failed write means the eventfd is already signaled, which is fine.
+  for (auto& shard : shards_)
+  {
+    shard->resume_count.fetch_add(1);
+    uint64_t increment = 1;
+    if (write(shard->resume_event_fd, &increment, sizeof(increment)) < 0)
+      continue;
+  }
+}
+
+void LinuxBrokerSocketManager::RequestWritableNotification(BrokerClient::Handle client_handle)
+{
+  if (shards_.empty() || client_handle < 0)
+    return;
+
+  SocketShard&       shard = ShardForHandle(client_handle);
+  etcpal::MutexGuard socket_guard(shard.socket_lock);
+
+  auto sock_data = shard.sockets.find(client_handle);
+  if (sock_data != shard.sockets.end() && !sock_data->second->write_requested)
+  {
+    // If the socket is already writable again, epoll reports it right away.
+    sock_data->second->write_requested = true;
+    UpdateEvents(shard, *sock_data->second);
+  }
+}
+
+void LinuxBrokerSocketManager::WorkerNotifySocketBad(SocketShard& shard, BrokerClient::Handle client_handle)
 {
   {  // Lock scope
-    etcpal::MutexGuard socket_guard(socket_lock_);
+    etcpal::MutexGuard socket_guard(shard.socket_lock);
 
-    auto sock_data = sockets_.find(client_handle);
-    if (sock_data != sockets_.end())
+    auto sock_data = shard.sockets.find(client_handle);
+    if (sock_data != shard.sockets.end())
     {
       close(sock_data->second->socket);
-      sockets_.erase(sock_data);
+      shard.sockets.erase(sock_data);
     }
   }
 
@@ -164,51 +301,137 @@ void LinuxBrokerSocketManager::WorkerNotifySocketBad(BrokerClient::Handle client
     notify_->HandleSocketClosed(client_handle, false);
 }
 
-void LinuxBrokerSocketManager::WorkerNotifySocketReadEvent(BrokerClient::Handle client_handle)
+void LinuxBrokerSocketManager::WorkerNotifySocketReadEvent(SocketShard& shard, BrokerClient::Handle client_handle)
 {
-  etcpal::MutexGuard socket_guard(socket_lock_);
+  etcpal::MutexGuard socket_guard(shard.socket_lock);
 
-  auto sock_data_iter = sockets_.find(client_handle);
-  if (sock_data_iter != sockets_.end())
+  auto sock_data_iter = shard.sockets.find(client_handle);
+  if (sock_data_iter != shard.sockets.end())
   {
     SocketData* sock_data = sock_data_iter->second.get();
-    void*       recv_buf = &sock_data->recv_buf.buf[sock_data->recv_buf.cur_data_size];
-    size_t      recv_buf_size =
-        std::min<size_t>(RDMNET_RECV_DATA_MAX_SIZE, (RC_MSG_BUF_SIZE - sock_data->recv_buf.cur_data_size));
+    size_t      recv_buf_size = 0;
+    void*       recv_buf = rc_msg_buf_get_recv_space(&sock_data->recv_buf, &recv_buf_size);
+    recv_buf_size = std::min<size_t>(RDMNET_RECV_DATA_MAX_SIZE, recv_buf_size);
 
     ssize_t recv_result = recv(sock_data->socket, recv_buf, recv_buf_size, 0);
     if (recv_result <= 0)
     {
       // The socket was closed, either gracefully or ungracefully.
       close(sock_data->socket);
-      sockets_.erase(sock_data_iter);
+      shard.sockets.erase(sock_data_iter);
       if (notify_)
         notify_->HandleSocketClosed(client_handle, (recv_result == 0));
     }
     else
     {
-      sock_data->recv_buf.cur_data_size += recv_result;
-      etcpal_error_t res = rc_msg_buf_parse_data(&sock_data->recv_buf);
-      while (res == kEtcPalErrOk)
-      {
-        if (notify_)
-        {
-          while (notify_->HandleSocketMessageReceived(client_handle, sock_data->recv_buf.msg) ==
-                 HandleMessageResult::kRetryLater)
-          {
-            sleep(10);  // Sleep to avoid busy loop.
-          }
-        }
+      rc_msg_buf_commit_recv(&sock_data->recv_buf, static_cast<size_t>(recv_result));
+      if (notify_)
+        notify_->HandleSocketDataReceived(client_handle, static_cast<size_t>(recv_result));
+      ProcessReceivedMessages(shard, *sock_data);
+    }
+  }
+}
+
+void LinuxBrokerSocketManager::WorkerNotifySocketWriteEvent(SocketShard& shard, BrokerClient::Handle client_handle)
+{
+  {  // Lock scope
+    etcpal::MutexGuard socket_guard(shard.socket_lock);
+
+    auto sock_data = shard.sockets.find(client_handle);
+    if (sock_data == shard.sockets.end() || !sock_data->second->write_requested)
+      return;
+
+    // Each request is reported once; stop watching for EPOLLOUT so that it doesn't fire constantly.
+    sock_data->second->write_requested = false;
+    UpdateEvents(shard, *sock_data->second);
+  }
+
+  if (notify_)
+    notify_->HandleSocketWritable(client_handle);
+}
+
+void LinuxBrokerSocketManager::WorkerResumeParkedSockets(SocketShard& shard)
+{
+  // Reset the eventfd counter
+  uint64_t event_count;
+  if (read(shard.resume_event_fd, &event_count, sizeof(event_count)) < 0)
+    return;
+
+  etcpal::MutexGuard socket_guard(shard.socket_lock);
 
-        rc_free_message_resources(&sock_data->recv_buf.msg);
-        res = rc_msg_buf_parse_data(&sock_data->recv_buf);
+  std::vector<BrokerClient::Handle> to_resume;
+  to_resume.swap(shard.parked_sockets);
+  for (auto client_handle : to_resume)
+  {
+    auto sock_data_iter = shard.sockets.find(client_handle);
+    if (sock_data_iter != shard.sockets.end() && sock_data_iter->second->parked)
+    {
+      SocketData* sock_data = sock_data_iter->second.get();
+      if (ProcessReceivedMessages(shard, *sock_data))
+      {
+        // Everything buffered has been handled; start reading from the socket again.
+        UpdateEvents(shard, *sock_data);
       }
     }
   }
 }
 
+// Handles as many complete messages as possible from a socket's receive buffer, starting with its
+// parked message if it has one. Returns false if the socket was parked because a message could not
+// be handled yet.
+// Needs lock on shard.socket_lock
+bool LinuxBrokerSocketManager::ProcessReceivedMessages(SocketShard& shard, SocketData& sock_data)
+{
+  etcpal_error_t res = (sock_data.parked ? kEtcPalErrOk : rc_msg_buf_parse_data(&sock_data.recv_buf));
+  while (res == kEtcPalErrOk)
+  {
+    uint64_t resume_count = shard.resume_count.load();
+    if (notify_ && notify_->HandleSocketMessageReceived(sock_data.client_handle, sock_data.recv_buf.msg) ==
+                       HandleMessageResult::kRetryLater)
+    {
+      // Queues drained while this message was being handled, so retry it right away.
+      if (resume_count != shard.resume_count.load())
+        continue;
+
+      ParkSocket(shard, sock_data);
+      return false;
+    }
+
+    sock_data.parked = false;
+    rc_free_message_resources(&sock_data.recv_buf.msg);
+    res = rc_msg_buf_parse_data(&sock_data.recv_buf);
+  }
+  return true;
+}
+
+// Needs lock on shard.socket_lock
+void LinuxBrokerSocketManager::ParkSocket(SocketShard& shard, SocketData& sock_data)
+{
+  if (!sock_data.parked)
+  {
+    // Stop reading from the socket until the message can be retried. The socket stays registered
+    // so that errors are still reported, and is watched for the peer closing the connection.
+    sock_data.parked = true;
+    UpdateEvents(shard, sock_data);
+  }
+  shard.parked_sockets.push_back(sock_data.client_handle);
+}
+
+// Sets the events a socket is watched for from whether it is parked and whether the broker is
+// waiting for it to become writable.
+// Needs lock on shard.socket_lock
+void LinuxBrokerSocketManager::UpdateEvents(SocketShard& shard, const SocketData& sock_data)
+{
+  struct epoll_event event;
+  event.events = (sock_data.parked ? EPOLLRDHUP : EPOLLIN);
+  if (sock_data.write_requested)
+    event.events |= EPOLLOUT;
+  event.data.fd = sock_data.client_handle;
+  epoll_ctl(shard.epoll_fd, EPOLL_CTL_MOD, sock_data.socket, &event);
+}
+
 // Instantiate a LinuxBrokerSocketManager
-std::unique_ptr<BrokerSocketManager> CreateBrokerSocketManager()
+std::unique_ptr<BrokerSocketManager> CreateBrokerSocketManager(unsigned int num_reader_threads)
 {
-  return std::unique_ptr<BrokerSocketManager>(new LinuxBrokerSocketManager);
+  return std::unique_ptr<BrokerSocketManager>(new LinuxBrokerSocketManager(num_reader_threads));
 }
@@ -24,6 +24,8 @@
 #ifndef LINUX_SOCKET_MANAGER_H_
 #define LINUX_SOCKET_MANAGER_H_
 
+#include <atomic>
+#include <cstdint>
 #include <map>
 #include <vector>
 #include <memory>
@@ -66,24 +68,63 @@ struct SocketData
   {
     rc_msg_buf_init(&recv_buf);
   }
+  ~SocketData()
+  {
+    if (parked)
+      rc_free_message_resources(&recv_buf.msg);
+    rc_msg_buf_deinit(&recv_buf);
+  }
 
   BrokerClient::Handle client_handle{BrokerClient::kInvalidHandle};
   int                  socket{-1};
 
   // Receive buffer for socket recv operations
   RCMsgBuf recv_buf;
+  // recv_buf.msg couldn't be routed and is waiting to be retried; the socket is not being read.
+  bool parked{false};
+  // The broker is waiting for the socket to become writable; it is watched for EPOLLOUT.
+  bool write_requested{false};
+};
+
+class LinuxBrokerSocketManager;
+
+// A subset of the managed sockets, serviced by a single reader thread with its own epoll fd. Each
+// socket belongs to exactly one shard for its entire lifetime.
+struct SocketShard
+{
+  LinuxBrokerSocketManager* sock_mgr{nullptr};
+  pthread_t                 thread_handle;
+  bool                      thread_started{false};
+  int                       epoll_fd{-1};
+  // Signaled to wake the reader thread to retry its parked sockets.
+  int resume_event_fd{-1};
+  // Incremented each time the shard's parked sockets are asked to resume, so that a resume which
+  // races with parking a socket is not lost.
+  std::atomic<uint64_t> resume_count{0};
+
+  // The set of sockets in this shard.
+  std::map<BrokerClient::Handle, std::unique_ptr<SocketData>> sockets;
+  // Sockets in this shard which are parked with a message waiting to be retried.
+  std::vector<BrokerClient::Handle> parked_sockets;
+  etcpal::Mutex                     socket_lock;
 };
 
 // A class to manage RDMnet Broker sockets on Linux.
 // This handles receiving data on all RDMnet client connections, using epoll for maximum
-// performance. Sending on connections is done in the core Broker library through the EtcPal
+// performance. Sockets are distributed across a pool of reader threads, each of which owns an
+// epoll fd and the shard of sockets registered with it, so that inbound processing scales with the
+// number of cores. Sending on connections is done in the core Broker library through the EtcPal
 // interface. Other miscellaneous Broker socket operations like LLRP are also handled in the core
 // library.
 class LinuxBrokerSocketManager : public BrokerSocketManager
 {
 public:
-  LinuxBrokerSocketManager(/* LinuxThreadInterface* thread_interface = new DefaultLinuxThreads */)
-  //: thread_interface_(thread_interface)
+  // num_threads is the number of reader threads (and socket shards) to use. 0 means use one per
+  // online processor.
+  explicit LinuxBrokerSocketManager(unsigned int num_threads = 0
+                                    /*, LinuxThreadInterface* thread_interface = new DefaultLinuxThreads */)
+      : num_threads_(num_threads)
+  //, thread_interface_(thread_interface)
   {
   }
   virtual ~LinuxBrokerSocketManager() = default;
@@ -94,24 +135,31 @@ public:
   void SetNotify(BrokerSocketNotify* notify) override { notify_ = notify; }
   bool AddSocket(BrokerClient::Handle client_handle, etcpal_socket_t socket) override;
   void RemoveSocket(BrokerClient::Handle client_handle) override;
+  void ResumeParkedSockets() override;
+  void RequestWritableNotification(BrokerClient::Handle client_handle) override;
 
   // Callback functions called from worker threads
-  void WorkerNotifySocketReadEvent(BrokerClient::Handle client_handle);
-  void WorkerNotifySocketBad(BrokerClient::Handle client_handle);
+  void WorkerNotifySocketReadEvent(SocketShard& shard, BrokerClient::Handle client_handle);
+  void WorkerNotifySocketWriteEvent(SocketShard& shard, BrokerClient::Handle client_handle);
+  void WorkerNotifySocketBad(SocketShard& shard, BrokerClient::Handle client_handle);
+  void WorkerResumeParkedSockets(SocketShard& shard);
 
   // Accessors
-  bool keep_running() const { return !shutting_down_; }
-  int  epoll_fd() const { return epoll_fd_; }
+  bool   keep_running() const { return !shutting_down_; }
+  size_t num_shards() const { return shards_.size(); }
 
 private:
-  bool      shutting_down_{false};
-  pthread_t thread_handle_;
-  int       epoll_fd_{-1};
+  SocketShard& ShardForHandle(BrokerClient::Handle client_handle);
+  bool         ProcessReceivedMessages(SocketShard& shard, SocketData& sock_data);
+  void         ParkSocket(SocketShard& shard, SocketData& sock_data);
+  void         UpdateEvents(SocketShard& shard, const SocketData& sock_data);
+
+  std::atomic<bool> shutting_down_{false};
+  unsigned int      num_threads_{0};
   // std::unique_ptr<LinuxThreadInterface> thread_interface_;
 
-  // The set of sockets being managed.
-  std::map<BrokerClient::Handle, std::unique_ptr<SocketData>> sockets_;
-  etcpal::Mutex                                               socket_lock_;
+  // The socket shards, one per reader thread.
+  std::vector<std::unique_ptr<SocketShard>> shards_;
 
   // The callback instance
   BrokerSocketNotify* notify_{nullptr};
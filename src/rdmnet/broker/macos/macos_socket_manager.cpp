@@ -20,6 +20,7 @@
 #include "macos_socket_manager.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <memory>
 #include <sys/event.h>
 #include <sys/types.h>
@@ -30,6 +31,9 @@
 constexpr int kMaxEvents = 100;
 constexpr int kEventTimeout = 200;
 
+// The identifier of the user event used to wake the worker thread to retry parked sockets.
+constexpr uintptr_t kResumeEventIdent = 0;
+
 // Function for the worker thread which does all the socket reading.
 void* SocketWorkerThread(void* arg)
 {
@@ -48,7 +52,12 @@ void* SocketWorkerThread(void* arg)
     int kevent_result = kevent(sock_mgr->kqueue_fd(), NULL, 0, kevent_list.get(), kMaxEvents, &tv);
     for (int i = 0; i < kevent_result && sock_mgr->keep_running(); ++i)
     {
-      if (kevent_list[i].filter == EVFILT_READ)
+      if (kevent_list[i].filter == EVFILT_USER)
+      {
+        // Queues have drained; retry any parked sockets
+        sock_mgr->WorkerResumeParkedSockets();
+      }
+      else if (kevent_list[i].filter == EVFILT_READ)
       {
         if (kevent_list[i].data > 0)
         {
@@ -63,6 +72,12 @@ void* SocketWorkerThread(void* arg)
               static_cast<BrokerClient::Handle>(reinterpret_cast<intptr_t>(kevent_list[i].udata)));
         }
       }
+      else if (kevent_list[i].filter == EVFILT_WRITE)
+      {
+        // The socket has room to send again. A closed socket is reported through its read filter.
+        sock_mgr->WorkerNotifySocketWriteEvent(
+            static_cast<BrokerClient::Handle>(reinterpret_cast<intptr_t>(kevent_list[i].udata)));
+      }
     }
   }
   return reinterpret_cast<void*>(0);
@@ -74,6 +89,15 @@ bool MacBrokerSocketManager::Startup()
   if (kqueue_fd_ < 0)
     return false;
 
+  struct kevent resume_event;
+  EV_SET(&resume_event, kResumeEventIdent, EVFILT_USER, EV_ADD | EV_CLEAR, 0, 0, NULL);
+  if (0 != kevent(kqueue_fd_, &resume_event, 1, NULL, 0, NULL))
+  {
+    close(kqueue_fd_);
+    kqueue_fd_ = -1;
+    return false;
+  }
+
   if (0 != pthread_create(&thread_handle_, NULL, SocketWorkerThread, this))
   {
     close(kqueue_fd_);
@@ -156,6 +180,31 @@ void MacBrokerSocketManager::RemoveSocket(BrokerClient::Handle client_handle)
   }
 }
 
+void MacBrokerSocketManager::ResumeParkedSockets()
+{
+  // Just wake up the worker thread; the retries happen there.
+  resume_count_.fetch_add(1);
+  struct kevent resume_event;
+  EV_SET(&resume_event, kResumeEventIdent, EVFILT_USER, 0, NOTE_TRIGGER, 0, NULL);
+  kevent(kqueue_fd_, &resume_event, 1, NULL, 0, NULL);
+}
+
+void MacBrokerSocketManager::RequestWritableNotification(BrokerClient::Handle client_handle)
+{
+  etcpal::ReadGuard socket_read(socket_lock_);
+
+  auto sock_data = sockets_.find(client_handle);
+  if (sock_data != sockets_.end())
+  {
+    // A one-shot filter is removed once it fires, so each request is reported once. Adding it again
+    // while it is still pending just replaces it.
+    struct kevent write_event;
+    EV_SET(&write_event, sock_data->second->socket, EVFILT_WRITE, EV_ADD | EV_ONESHOT, 0, 0,
+           reinterpret_cast<void*>(client_handle));
+    kevent(kqueue_fd_, &write_event, 1, NULL, 0, NULL);
+  }
+}
+
 void MacBrokerSocketManager::WorkerNotifySocketBad(BrokerClient::Handle client_handle)
 {
   {  // Write lock scope
@@ -178,12 +227,14 @@ void MacBrokerSocketManager::WorkerNotifySocketReadEvent(BrokerClient::Handle cl
   etcpal::ReadGuard socket_read(socket_lock_);
 
   auto sock_data_iter = sockets_.find(client_handle);
-  if (sock_data_iter != sockets_.end())
+  // A parked socket's read filter only fires to report the connection closing; leave its data
+  // unread until the parked message has been handled.
+  if (sock_data_iter != sockets_.end() && !sock_data_iter->second->parked)
   {
     SocketData* sock_data = sock_data_iter->second.get();
-    void*       recv_buf = &sock_data->recv_buf.buf[sock_data->recv_buf.cur_data_size];
-    size_t      recv_buf_size =
-        std::min<size_t>(RDMNET_RECV_DATA_MAX_SIZE, (RC_MSG_BUF_SIZE - sock_data->recv_buf.cur_data_size));
+    size_t      recv_buf_size = 0;
+    void*       recv_buf = rc_msg_buf_get_recv_space(&sock_data->recv_buf, &recv_buf_size);
+    recv_buf_size = std::min<size_t>(RDMNET_RECV_DATA_MAX_SIZE, recv_buf_size);
 
     ssize_t recv_result = recv(sock_data->socket, recv_buf, recv_buf_size, 0);
     if (recv_result <= 0)
@@ -196,27 +247,103 @@ void MacBrokerSocketManager::WorkerNotifySocketReadEvent(BrokerClient::Handle cl
     }
     else
     {
-      sock_data->recv_buf.cur_data_size += recv_result;
-      etcpal_error_t res = rc_msg_buf_parse_data(&sock_data->recv_buf);
-      while (res == kEtcPalErrOk)
-      {
-        if (notify_)
-        {
-          while (notify_->HandleSocketMessageReceived(client_handle, sock_data->recv_buf.msg) ==
-                 HandleMessageResult::kRetryLater)
-          {
-            sleep(10);  // Sleep to avoid busy loop.
-          }
-        }
+      rc_msg_buf_commit_recv(&sock_data->recv_buf, static_cast<size_t>(recv_result));
+      if (notify_)
+        notify_->HandleSocketDataReceived(client_handle, static_cast<size_t>(recv_result));
+      ProcessReceivedMessages(*sock_data);
+    }
+  }
+}
+
+void MacBrokerSocketManager::WorkerNotifySocketWriteEvent(BrokerClient::Handle client_handle)
+{
+  {  // Read lock scope
+    etcpal::ReadGuard socket_read(socket_lock_);
+    if (sockets_.find(client_handle) == sockets_.end())
+      return;
+  }
+
+  if (notify_)
+    notify_->HandleSocketWritable(client_handle);
+}
+
+void MacBrokerSocketManager::WorkerResumeParkedSockets()
+{
+  etcpal::ReadGuard socket_read(socket_lock_);
 
-        rc_free_message_resources(&sock_data->recv_buf.msg);
-        res = rc_msg_buf_parse_data(&sock_data->recv_buf);
+  std::vector<BrokerClient::Handle> to_resume;
+  to_resume.swap(parked_sockets_);
+  for (auto client_handle : to_resume)
+  {
+    auto sock_data_iter = sockets_.find(client_handle);
+    if (sock_data_iter != sockets_.end() && sock_data_iter->second->parked)
+    {
+      SocketData* sock_data = sock_data_iter->second.get();
+      if (ProcessReceivedMessages(*sock_data))
+      {
+        // Everything buffered has been handled; start reading from the socket again.
+        SetReadFilter(*sock_data, false);
       }
     }
   }
 }
 
-std::unique_ptr<BrokerSocketManager> CreateBrokerSocketManager()
+// Handles as many complete messages as possible from a socket's receive buffer, starting with its
+// parked message if it has one. Returns false if the socket was parked because a message could not
+// be handled yet.
+// Needs read lock on socket_lock_
+bool MacBrokerSocketManager::ProcessReceivedMessages(SocketData& sock_data)
+{
+  etcpal_error_t res = (sock_data.parked ? kEtcPalErrOk : rc_msg_buf_parse_data(&sock_data.recv_buf));
+  while (res == kEtcPalErrOk)
+  {
+    uint64_t resume_count = resume_count_.load();
+    if (notify_ && notify_->HandleSocketMessageReceived(sock_data.client_handle, sock_data.recv_buf.msg) ==
+                       HandleMessageResult::kRetryLater)
+    {
+      // Queues drained while this message was being handled, so retry it right away.
+      if (resume_count != resume_count_.load())
+        continue;
+
+      ParkSocket(sock_data);
+      return false;
+    }
+
+    sock_data.parked = false;
+    rc_free_message_resources(&sock_data.recv_buf.msg);
+    res = rc_msg_buf_parse_data(&sock_data.recv_buf);
+  }
+  return true;
+}
+
+// Needs read lock on socket_lock_
+void MacBrokerSocketManager::ParkSocket(SocketData& sock_data)
+{
+  if (!sock_data.parked)
+  {
+    // Stop reading from the socket until the message can be retried.
+    SetReadFilter(sock_data, true);
+    sock_data.parked = true;
+  }
+  parked_sockets_.push_back(sock_data.client_handle);
+}
+
+// Re-registers a socket's read filter. A parked socket's filter is edge-triggered rather than
+// disabled: a disabled filter would not report EV_EOF either, so a client which disconnected while
+// parked would never be cleaned up. The filter is deleted first because EV_CLEAR can't be changed on
+// an existing filter.
+// Needs read lock on socket_lock_
+void MacBrokerSocketManager::SetReadFilter(const SocketData& sock_data, bool parked)
+{
+  struct kevent changes[2];
+  EV_SET(&changes[0], sock_data.socket, EVFILT_READ, EV_DELETE, 0, 0, NULL);
+  EV_SET(&changes[1], sock_data.socket, EVFILT_READ, (parked ? EV_ADD | EV_CLEAR : EV_ADD), 0, 0,
+         reinterpret_cast<void*>(sock_data.client_handle));
+  kevent(kqueue_fd_, changes, 2, NULL, 0, NULL);
+}
+
+// Sockets are always read on a single kqueue thread, so num_reader_threads is not used.
+std::unique_ptr<BrokerSocketManager> CreateBrokerSocketManager(unsigned int /*num_reader_threads*/)
 {
   return std::unique_ptr<BrokerSocketManager>(new MacBrokerSocketManager);
 }
@@ -24,6 +24,8 @@
 #ifndef MACOS_SOCKET_MANAGER_H_
 #define MACOS_SOCKET_MANAGER_H_
 
+#include <atomic>
+#include <cstdint>
 #include <map>
 #include <vector>
 #include <memory>
@@ -42,12 +44,20 @@ struct SocketData
   {
     rc_msg_buf_init(&recv_buf);
   }
+  ~SocketData()
+  {
+    if (parked)
+      rc_free_message_resources(&recv_buf.msg);
+    rc_msg_buf_deinit(&recv_buf);
+  }
 
   BrokerClient::Handle client_handle{BrokerClient::kInvalidHandle};
   int                  socket{-1};
 
   // Receive buffer for socket recv operations
   RCMsgBuf recv_buf;
+  // recv_buf.msg couldn't be routed and is waiting to be retried; the socket is not being read.
+  bool parked{false};
 };
 
 // A class to manage RDMnet Broker sockets on Mac.
@@ -66,26 +76,40 @@ public:
   void SetNotify(BrokerSocketNotify* notify) override { notify_ = notify; }
   bool AddSocket(BrokerClient::Handle client_handle, etcpal_socket_t socket) override;
   void RemoveSocket(BrokerClient::Handle client_handle) override;
+  void ResumeParkedSockets() override;
+  void RequestWritableNotification(BrokerClient::Handle client_handle) override;
 
   // Callback functions called from worker threads
   void WorkerNotifySocketReadEvent(BrokerClient::Handle client_handle);
+  void WorkerNotifySocketWriteEvent(BrokerClient::Handle client_handle);
   void WorkerNotifySocketBad(BrokerClient::Handle conn_handle);
+  void WorkerResumeParkedSockets();
 
   // Accessors
   bool keep_running() const { return !shutting_down_; }
   int  kqueue_fd() const { return kqueue_fd_; }
 
 private:
-  bool      shutting_down_{false};
-  pthread_t thread_handle_;
-  int       kqueue_fd_{-1};
+  std::atomic<bool> shutting_down_{false};
+  pthread_t         thread_handle_;
+  int               kqueue_fd_{-1};
 
   // The set of sockets being managed.
   std::map<BrokerClient::Handle, std::unique_ptr<SocketData>> sockets_;
   etcpal::RwLock                                              socket_lock_;
+  // Sockets which are parked with a message waiting to be retried. Only accessed from the worker
+  // thread.
+  std::vector<BrokerClient::Handle> parked_sockets_;
+  // Incremented each time parked sockets are asked to resume, so that a resume which races with
+  // parking a socket is not lost.
+  std::atomic<uint64_t> resume_count_{0};
 
   // The callback instance
   BrokerSocketNotify* notify_{nullptr};
+
+  bool ProcessReceivedMessages(SocketData& sock_data);
+  void ParkSocket(SocketData& sock_data);
+  void SetReadFilter(const SocketData& sock_data, bool parked);
 };
 
 #endif  // MACOS_SOCKET_MANAGER_H_
@@ -27,6 +27,16 @@
 // number to wait on the port. This is because more threads can run when one of the threads
 // processing data enters a waiting state for another reason, e.g. sleeping or waiting on a mutex.
 //
+// When a received message can't be routed because a destination queue is full, the socket it came
+// from is parked: no new overlapped receive is started on it, and the message is kept in its
+// receive buffer. When the broker core signals that queues have drained, a completion packet is
+// posted for each parked socket so that a worker thread retries the message and resumes receiving.
+//
+// Sends are made by the broker core without blocking. A completion port only reports the I/O
+// operations started on it, so a socket whose send buffer has filled is instead reported through
+// an FD_WRITE event, which Winsock signals when a send has failed with WSAEWOULDBLOCK and the buffer
+// has room again. Each socket's event is waited on from the system thread pool.
+//
 // Further reading:
 // https://docs.microsoft.com/en-us/windows/desktop/fileio/i-o-completion-ports
 // https://msdn.microsoft.com/en-us/library/windows/desktop/aa364986(v=vs.85).aspx
@@ -71,10 +81,25 @@ void SetThreadName(DWORD dwThreadID, const char* threadName)
 #pragma warning(pop)
 }
 
+// Called from the system thread pool when a socket's write event is signaled.
+VOID CALLBACK SocketWritableCallback(PVOID context, BOOLEAN /*timed_out*/)
+{
+  SocketData* sock_data = reinterpret_cast<SocketData*>(context);
+
+  // Resets the event, and tells us whether FD_WRITE is what signaled it.
+  WSANETWORKEVENTS events;
+  if (0 == WSAEnumNetworkEvents(sock_data->socket, sock_data->write_event, &events) &&
+      (events.lNetworkEvents & FD_WRITE))
+  {
+    sock_data->sock_mgr->WorkerNotifySocketWritable(sock_data->client_handle);
+  }
+}
+
 enum class MessageKey
 {
   kNormalRecv,
   kStartRecv,
+  kResumeRecv,
   kShutdown
 };
 
@@ -150,23 +175,32 @@ unsigned __stdcall SocketWorkerThread(void* arg)
               sock_mgr->WorkerNotifySocketBad(sock_data->client_handle, true);
               break;
             }
-            else
+            else if (!sock_mgr->WorkerNotifyRecvData(sock_data->client_handle, bytes_read))
             {
-              sock_mgr->WorkerNotifyRecvData(sock_data->client_handle, bytes_read);
-              // Intentional fallthrough to start an overlapped receive operation again
+              // The socket was parked. Receiving will start again when it is resumed.
+              break;
             }
+            // Intentional fallthrough to start an overlapped receive operation again
           }
+        case MessageKey::kResumeRecv:
+          if (static_cast<MessageKey>(cmd) == MessageKey::kResumeRecv &&
+              (!sock_data || !sock_mgr->WorkerResumeParkedSocket(sock_data->client_handle)))
+          {
+            // The socket is still parked or has been closed.
+            break;
+          }
+          // Intentional fallthrough to start an overlapped receive operation again
         case MessageKey::kStartRecv:
           if (sock_data)
           {
             // Begin a new overlapped receive operation
             DWORD recv_flags = 0;
 
+            size_t recv_space = 0;
             sock_data->ws_recv_buf.buf =
-                reinterpret_cast<char*>(&sock_data->recv_buf.buf[sock_data->recv_buf.cur_data_size]);
+                reinterpret_cast<char*>(rc_msg_buf_get_recv_space(&sock_data->recv_buf, &recv_space));
             sock_data->ws_recv_buf.len =
-                std::min(static_cast<ULONG>(RDMNET_RECV_DATA_MAX_SIZE),
-                         static_cast<ULONG>(RC_MSG_BUF_SIZE - sock_data->recv_buf.cur_data_size));
+                std::min(static_cast<ULONG>(RDMNET_RECV_DATA_MAX_SIZE), static_cast<ULONG>(recv_space));
 
             int recv_result = WSARecv(sock_data->socket, &sock_data->ws_recv_buf, 1, nullptr, &recv_flags,
                                       &sock_data->overlapped, nullptr);
@@ -204,12 +238,17 @@ bool WinBrokerSocketManager::Startup()
 
   if (ok)
   {
-    SYSTEM_INFO info;
-    GetSystemInfo(&info);
+    // Unless configured otherwise, start up a number of worker threads equal to double the number of
+    // processors on the system. This is the recommended number from the Microsoft docs.
+    DWORD num_threads = num_threads_;
+    if (num_threads == 0)
+    {
+      SYSTEM_INFO info;
+      GetSystemInfo(&info);
+      num_threads = info.dwNumberOfProcessors * 2;
+    }
 
-    // Start up a number of worker threads equal to double the number of processors on the system.
-    // This is the recommended number from the Microsoft docs.
-    for (DWORD i = 0; i < info.dwNumberOfProcessors * 2; ++i)
+    for (DWORD i = 0; i < num_threads; ++i)
     {
       HANDLE thread_handle = thread_interface_->StartThread(SocketWorkerThread, this);
       if (thread_handle != nullptr)
@@ -260,6 +299,11 @@ bool WinBrokerSocketManager::Shutdown()
     sockets_.clear();
   }
 
+  {  // Lock scope
+    etcpal::MutexGuard parked_guard(parked_lock_);
+    parked_sockets_.clear();
+  }
+
   CloseHandle(iocp_);
   iocp_ = NULL;
   WSACleanup();
@@ -280,7 +324,8 @@ bool WinBrokerSocketManager::AddSocket(BrokerClient::Handle client_handle, etcpa
     if (result.second)
     {
       // Add the socket to our I/O completion port
-      if (NULL != CreateIoCompletionPort((HANDLE)socket, iocp_, static_cast<ULONG_PTR>(MessageKey::kNormalRecv), 0))
+      if (NULL != CreateIoCompletionPort((HANDLE)socket, iocp_, static_cast<ULONG_PTR>(MessageKey::kNormalRecv), 0) &&
+          StartWriteNotifications(*result.first->second))
       {
         // Notify a worker thread to begin a receive operation
         if (PostQueuedCompletionStatus(iocp_, 0, static_cast<ULONG_PTR>(MessageKey::kStartRecv),
@@ -316,10 +361,53 @@ void WinBrokerSocketManager::RemoveSocket(BrokerClient::Handle client_handle)
       // triggering the rest of the destruction.
       shutdown(sock_data->second->socket, SD_BOTH);
       closesocket(sock_data->second->socket);
+
+      // A parked socket has no receive operation pending to report the close, so hand it to a
+      // worker directly.
+      if (UnparkSocket(client_handle))
+      {
+        PostQueuedCompletionStatus(iocp_, 0, static_cast<ULONG_PTR>(MessageKey::kResumeRecv),
+                                   &sock_data->second->overlapped);
+      }
+    }
+  }
+}
+
+void WinBrokerSocketManager::ResumeParkedSockets()
+{
+  std::vector<BrokerClient::Handle> to_resume;
+
+  {  // Lock scope
+    etcpal::MutexGuard parked_guard(parked_lock_);
+    ++resume_count_;
+    to_resume.swap(parked_sockets_);
+  }
+
+  etcpal::ReadGuard socket_read(socket_lock_);
+  for (auto client_handle : to_resume)
+  {
+    auto sock_data = sockets_.find(client_handle);
+    if (sock_data != sockets_.end())
+    {
+      // The socket has no receive operation pending, so its overlapped structure is free to use.
+      PostQueuedCompletionStatus(iocp_, 0, static_cast<ULONG_PTR>(MessageKey::kResumeRecv),
+                                 &sock_data->second->overlapped);
     }
   }
 }
 
+// FD_WRITE is signaled by Winsock whenever a send has failed with WSAEWOULDBLOCK and the socket
+// becomes writable, so the notification is already set up for every socket when it is added.
+void WinBrokerSocketManager::RequestWritableNotification(BrokerClient::Handle /*client_handle*/)
+{
+}
+
+void WinBrokerSocketManager::WorkerNotifySocketWritable(BrokerClient::Handle client_handle)
+{
+  if (notify_ && !shutting_down_)
+    notify_->HandleSocketWritable(client_handle);
+}
+
 void WinBrokerSocketManager::WorkerNotifySocketBad(BrokerClient::Handle client_handle, bool graceful)
 {
   bool notify_socket_closed = false;
@@ -343,33 +431,119 @@ void WinBrokerSocketManager::WorkerNotifySocketBad(BrokerClient::Handle client_h
     notify_->HandleSocketClosed(client_handle, graceful);
 }
 
-void WinBrokerSocketManager::WorkerNotifyRecvData(BrokerClient::Handle client_handle, size_t size)
+// Returns false if the socket was parked because a message could not be handled yet.
+bool WinBrokerSocketManager::WorkerNotifyRecvData(BrokerClient::Handle client_handle, size_t size)
 {
   etcpal::ReadGuard socket_read(socket_lock_);
 
   auto sock_data = sockets_.find(client_handle);
   if (sock_data != sockets_.end())
   {
-    sock_data->second->recv_buf.cur_data_size += size;
-    etcpal_error_t res = rc_msg_buf_parse_data(&sock_data->second->recv_buf);
-    while (res == kEtcPalErrOk)
+    rc_msg_buf_commit_recv(&sock_data->second->recv_buf, size);
+    if (notify_)
+      notify_->HandleSocketDataReceived(client_handle, size);
+    return ProcessReceivedMessages(*sock_data->second);
+  }
+  return true;
+}
+
+// Returns true if the socket's parked message was handled and receiving should start again.
+bool WinBrokerSocketManager::WorkerResumeParkedSocket(BrokerClient::Handle client_handle)
+{
+  {  // Read lock scope
+    etcpal::ReadGuard socket_read(socket_lock_);
+
+    auto sock_data = sockets_.find(client_handle);
+    if (sock_data == sockets_.end())
+      return false;
+    if (!sock_data->second->close_requested)
+      return ProcessReceivedMessages(*sock_data->second);
+  }
+
+  // The socket was removed while parked, so finish cleaning it up here.
+  WorkerNotifySocketBad(client_handle, false);
+  return false;
+}
+
+// Handles as many complete messages as possible from a socket's receive buffer, starting with its
+// parked message if it has one. Returns false if the socket was parked because a message could not
+// be handled yet.
+// Needs read lock on socket_lock_
+bool WinBrokerSocketManager::ProcessReceivedMessages(SocketData& sock_data)
+{
+  etcpal_error_t res = (sock_data.parked ? kEtcPalErrOk : rc_msg_buf_parse_data(&sock_data.recv_buf));
+  while (res == kEtcPalErrOk)
+  {
+    if (!sock_data.close_requested && notify_)
     {
-      if (!sock_data->second->close_requested && notify_)
-      {
-        while (notify_->HandleSocketMessageReceived(client_handle, sock_data->second->recv_buf.msg) ==
-               HandleMessageResult::kRetryLater)
-        {
-          Sleep(10);  // Sleep to avoid busy loop.
-        }
+      uint64_t resume_count;
+      {  // Lock scope
+        etcpal::MutexGuard parked_guard(parked_lock_);
+        resume_count = resume_count_;
       }
 
-      rc_free_message_resources(&sock_data->second->recv_buf.msg);
-      res = rc_msg_buf_parse_data(&sock_data->second->recv_buf);
+      if (notify_->HandleSocketMessageReceived(sock_data.client_handle, sock_data.recv_buf.msg) ==
+          HandleMessageResult::kRetryLater)
+      {
+        if (ParkSocket(sock_data, resume_count))
+          return false;
+
+        // Queues drained while this message was being handled, so retry it right away.
+        continue;
+      }
     }
+
+    sock_data.parked = false;
+    rc_free_message_resources(&sock_data.recv_buf.msg);
+    res = rc_msg_buf_parse_data(&sock_data.recv_buf);
   }
+  return true;
+}
+
+// Parks a socket unless a resume was requested since resume_count was sampled. Returns whether the
+// socket was parked.
+bool WinBrokerSocketManager::ParkSocket(SocketData& sock_data, uint64_t resume_count)
+{
+  etcpal::MutexGuard parked_guard(parked_lock_);
+  if (resume_count != resume_count_)
+    return false;
+
+  sock_data.parked = true;
+  parked_sockets_.push_back(sock_data.client_handle);
+  return true;
+}
+
+// Removes a socket from the parked list. Returns whether it was parked.
+bool WinBrokerSocketManager::UnparkSocket(BrokerClient::Handle client_handle)
+{
+  etcpal::MutexGuard parked_guard(parked_lock_);
+
+  auto parked = std::find(parked_sockets_.begin(), parked_sockets_.end(), client_handle);
+  if (parked != parked_sockets_.end())
+  {
+    parked_sockets_.erase(parked);
+    return true;
+  }
+  return false;
+}
+
+// Associates an FD_WRITE event with a socket and starts waiting for it on the thread pool. Overlapped
+// receives on the socket are not affected by the event association.
+bool WinBrokerSocketManager::StartWriteNotifications(SocketData& sock_data)
+{
+  sock_data.sock_mgr = this;
+  sock_data.write_event = WSACreateEvent();
+  if (sock_data.write_event == WSA_INVALID_EVENT)
+    return false;
+
+  if (0 != WSAEventSelect(sock_data.socket, sock_data.write_event, FD_WRITE))
+    return false;
+
+  return (RegisterWaitForSingleObject(&sock_data.write_wait, sock_data.write_event, SocketWritableCallback,
+                                      &sock_data, INFINITE, WT_EXECUTEDEFAULT) != FALSE);
 }
 
-std::unique_ptr<BrokerSocketManager> CreateBrokerSocketManager()
+std::unique_ptr<BrokerSocketManager> CreateBrokerSocketManager(unsigned int num_reader_threads)
 {
-  return std::unique_ptr<BrokerSocketManager>(new WinBrokerSocketManager);
+  return std::unique_ptr<BrokerSocketManager>(new WinBrokerSocketManager(num_reader_threads));
 }
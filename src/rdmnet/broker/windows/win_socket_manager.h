@@ -32,10 +32,12 @@
 #include <windows.h>
 #include <process.h>
 
+#include <cstdint>
 #include <map>
 #include <vector>
 #include <memory>
 
+#include "etcpal/cpp/mutex.h"
 #include "etcpal/cpp/rwlock.h"
 #include "rdmnet/core/msg_buf.h"
 #include "broker_socket_manager.h"
@@ -65,6 +67,8 @@ public:
   virtual BOOL CleanupThread(HANDLE thread_handle) override { return CloseHandle(thread_handle); }
 };
 
+class WinBrokerSocketManager;
+
 // The set of data allocated per-socket.
 struct SocketData
 {
@@ -75,16 +79,35 @@ struct SocketData
     ws_recv_buf.buf = reinterpret_cast<char*>(recv_buf.buf);
     ws_recv_buf.len = RDMNET_RECV_DATA_MAX_SIZE;
   }
+  ~SocketData()
+  {
+    // Waits for a write notification which is in progress to finish.
+    if (write_wait)
+      UnregisterWaitEx(write_wait, INVALID_HANDLE_VALUE);
+    if (write_event != WSA_INVALID_EVENT)
+      WSACloseEvent(write_event);
+    if (parked)
+      rc_free_message_resources(&recv_buf.msg);
+    rc_msg_buf_deinit(&recv_buf);
+  }
 
   BrokerClient::Handle client_handle{BrokerClient::kInvalidHandle};
   WSAOVERLAPPED        overlapped{};
   SOCKET               socket{INVALID_SOCKET};
   bool                 close_requested{false};
 
+  // Signaled by Winsock when the socket can be sent on again after a send failed with
+  // WSAEWOULDBLOCK, and waited on from the system thread pool.
+  WinBrokerSocketManager* sock_mgr{nullptr};
+  WSAEVENT                write_event{WSA_INVALID_EVENT};
+  HANDLE                  write_wait{nullptr};
+
   // Socket receive data
   WSABUF ws_recv_buf;  // The variable Winsock uses for receive buffers
   // Receive buffer for socket recv operations
   RCMsgBuf recv_buf;
+  // recv_buf.msg couldn't be routed and is waiting to be retried; no receive operation is pending.
+  bool parked{false};
 };
 
 // A class to manage RDMnet Broker sockets on Windows.
@@ -95,8 +118,10 @@ struct SocketData
 class WinBrokerSocketManager : public BrokerSocketManager
 {
 public:
-  WinBrokerSocketManager(WindowsThreadInterface* thread_interface = new DefaultWindowsThreads)
-      : thread_interface_(thread_interface)
+  // num_threads is the number of worker threads to use. 0 means use two per processor.
+  explicit WinBrokerSocketManager(unsigned int            num_threads = 0,
+                                  WindowsThreadInterface* thread_interface = new DefaultWindowsThreads)
+      : num_threads_(num_threads), thread_interface_(thread_interface)
   {
   }
   virtual ~WinBrokerSocketManager() = default;
@@ -107,10 +132,14 @@ public:
   void SetNotify(BrokerSocketNotify* notify) override { notify_ = notify; }
   bool AddSocket(BrokerClient::Handle client_handle, etcpal_socket_t socket) override;
   void RemoveSocket(BrokerClient::Handle client_handle) override;
+  void ResumeParkedSockets() override;
+  void RequestWritableNotification(BrokerClient::Handle client_handle) override;
 
   // Callback functions called from worker threads
-  void WorkerNotifyRecvData(BrokerClient::Handle client_handle, size_t size);
+  bool WorkerNotifyRecvData(BrokerClient::Handle client_handle, size_t size);
+  void WorkerNotifySocketWritable(BrokerClient::Handle client_handle);
   void WorkerNotifySocketBad(BrokerClient::Handle client_handle, bool graceful);
+  bool WorkerResumeParkedSocket(BrokerClient::Handle client_handle);
 
   // Accessors
   HANDLE iocp() const { return iocp_; }
@@ -119,6 +148,7 @@ private:
   bool shutting_down_{false};
 
   // Thread pool management
+  unsigned int                            num_threads_{0};
   HANDLE                                  iocp_{nullptr};
   std::vector<HANDLE>                     worker_threads_;
   std::unique_ptr<WindowsThreadInterface> thread_interface_;
@@ -127,8 +157,19 @@ private:
   std::map<BrokerClient::Handle, std::unique_ptr<SocketData>> sockets_;
   etcpal::RwLock                                              socket_lock_;
 
+  // Sockets which are parked with a message waiting to be retried, and a count of resume requests
+  // used to detect a resume which races with a socket being parked.
+  std::vector<BrokerClient::Handle> parked_sockets_;
+  uint64_t                          resume_count_{0};
+  etcpal::Mutex                     parked_lock_;
+
   // The callback instance
   BrokerSocketNotify* notify_{nullptr};
+
+  bool ProcessReceivedMessages(SocketData& sock_data);
+  bool ParkSocket(SocketData& sock_data, uint64_t resume_count);
+  bool UnparkSocket(BrokerClient::Handle client_handle);
+  bool StartWriteNotifications(SocketData& sock_data);
 };
 
 #endif  // WIN_SOCKET_MANAGER_H_
@@ -59,6 +59,7 @@ static void client_disconnected(RCClient*                           client,
                                 const RdmnetClientDisconnectedInfo* info);
 static void client_broker_msg_received(RCClient* client, rdmnet_client_scope_t scope_handle, const BrokerMessage* msg);
 static void client_destroyed(RCClient* client);
+static void client_send_ready(RCClient* client, rdmnet_client_scope_t scope_handle);
 static void client_llrp_msg_received(RCClient*              client,
                                      const LlrpRdmCommand*  cmd,
                                      RdmnetSyncRdmResponse* response,
@@ -104,7 +105,8 @@ static const RCClientCommonCallbacks client_callbacks = {
   client_connect_failed,
   client_disconnected,
   client_broker_msg_received,
-  client_destroyed
+  client_destroyed,
+  client_send_ready
 };
 
 static const RCRptClientCallbacks rpt_client_callbacks = {
@@ -231,6 +233,25 @@ void rdmnet_controller_set_rdm_cmd_callbacks(RdmnetControllerConfig*
   }
 }
 
+/**
+ * @brief Set the optional send-ready callback in an RDMnet controller configuration structure.
+ *
+ * The callback is passed the same context pointer as the callbacks set by
+ * rdmnet_controller_set_callbacks().
+ *
+ * @param[out] config Config struct in which to set the callback.
+ * @param[in] send_ready Callback called when a scope which refused a send with
+ *                       #kEtcPalErrWouldBlock can accept data again.
+ */
+void rdmnet_controller_set_send_ready_callback(RdmnetControllerConfig*           config,
+                                               RdmnetControllerSendReadyCallback send_ready)
+{
+  if (config)
+  {
+    config->callbacks.send_ready = send_ready;
+  }
+}
+
 /**
  * @brief Create a new instance of RDMnet controller functionality.
  *
@@ -498,6 +519,8 @@ etcpal_error_t rdmnet_controller_change_search_domain(rdmnet_controller_t
  * @return #kEtcPalErrNotInit: Module not initialized.
  * @return #kEtcPalErrNotFound: controller_handle is not associated with a valid controller instance,
  *                              or scope_handle is not associated with a valid scope instance.
+ * @return #kEtcPalErrWouldBlock: The connection to the broker has too much data waiting to be
+ *                               sent; try again after the send_ready callback.
  * @return #kEtcPalErrSys: An internal library or system call error occurred.
  */
 etcpal_error_t rdmnet_controller_request_client_list(rdmnet_controller_t   controller_handle,
@@ -527,6 +550,8 @@ etcpal_error_t rdmnet_controller_request_client_list(rdmnet_controller_t   contr
  * @return #kEtcPalErrNotInit: Module not initialized.
  * @return #kEtcPalErrNotFound: controller_handle is not associated with a valid controller instance,
  *                              or scope_handle is not associated with a valid scope instance.
+ * @return #kEtcPalErrWouldBlock: The connection to the broker has too much data waiting to be
+ *                               sent; try again after the send_ready callback.
  * @return #kEtcPalErrSys: An internal library or system call error occurred.
  */
 etcpal_error_t rdmnet_controller_request_responder_ids(rdmnet_controller_t   controller_handle,
@@ -565,6 +590,8 @@ etcpal_error_t rdmnet_controller_request_responder_ids(rdmnet_controller_t   con
  * @return #kEtcPalErrNotInit: Module not initialized.
  * @return #kEtcPalErrNotFound: controller_handle is not associated with a valid controller instance,
  *                              or scope_handle is not associated with a valid scope instance.
+ * @return #kEtcPalErrWouldBlock: The connection to the broker has too much data waiting to be
+ *                               sent; try again after the send_ready callback.
  * @return #kEtcPalErrSys: An internal library or system call error occurred.
  */
 etcpal_error_t rdmnet_controller_send_rdm_command(rdmnet_controller_t          controller_handle,
@@ -607,6 +634,8 @@ etcpal_error_t rdmnet_controller_send_rdm_command(rdmnet_controller_t          c
  * @return #kEtcPalErrNotInit: Module not initialized.
  * @return #kEtcPalErrNotFound: controller_handle is not associated with a valid controller instance,
  *                              or scope_handle is not associated with a valid scope instance.
+ * @return #kEtcPalErrWouldBlock: The connection to the broker has too much data waiting to be
+ *                               sent; try again after the send_ready callback.
  * @return #kEtcPalErrSys: An internal library or system call error occurred.
  */
 etcpal_error_t rdmnet_controller_send_get_command(rdmnet_controller_t          controller_handle,
@@ -648,6 +677,8 @@ etcpal_error_t rdmnet_controller_send_get_command(rdmnet_controller_t          c
  * @return #kEtcPalErrNotInit: Module not initialized.
  * @return #kEtcPalErrNotFound: controller_handle is not associated with a valid controller instance,
  *                              or scope_handle is not associated with a valid scope instance.
+ * @return #kEtcPalErrWouldBlock: The connection to the broker has too much data waiting to be
+ *                               sent; try again after the send_ready callback.
  * @return #kEtcPalErrSys: An internal library or system call error occurred.
  */
 etcpal_error_t rdmnet_controller_send_set_command(rdmnet_controller_t          controller_handle,
@@ -685,6 +716,8 @@ etcpal_error_t rdmnet_controller_send_set_command(rdmnet_controller_t          c
  * @return #kEtcPalErrNotInit: Module not initialized.
  * @return #kEtcPalErrNotFound: controller_handle is not associated with a valid controller instance,
  *                              or scope_handle is not associated with a valid scope instance.
+ * @return #kEtcPalErrWouldBlock: The connection to the broker has too much data waiting to be
+ *                               sent; try again after the send_ready callback.
  * @return #kEtcPalErrSys: An internal library or system call error occurred.
  */
 etcpal_error_t rdmnet_controller_send_rdm_ack(rdmnet_controller_t          controller_handle,
@@ -718,6 +751,8 @@ etcpal_error_t rdmnet_controller_send_rdm_ack(rdmnet_controller_t          contr
  * @return #kEtcPalErrNotInit: Module not initialized.
  * @return #kEtcPalErrNotFound: controller_handle is not associated with a valid controller instance,
  *                              or scope_handle is not associated with a valid scope instance.
+ * @return #kEtcPalErrWouldBlock: The connection to the broker has too much data waiting to be
+ *                               sent; try again after the send_ready callback.
  * @return #kEtcPalErrSys: An internal library or system call error occurred.
  */
 etcpal_error_t rdmnet_controller_send_rdm_nack(rdmnet_controller_t          controller_handle,
@@ -753,6 +788,8 @@ etcpal_error_t rdmnet_controller_send_rdm_nack(rdmnet_controller_t          cont
  * @return #kEtcPalErrNotInit: Module not initialized.
  * @return #kEtcPalErrNotFound: controller_handle is not associated with a valid controller instance,
  *                              or scope_handle is not associated with a valid scope instance.
+ * @return #kEtcPalErrWouldBlock: The connection to the broker has too much data waiting to be
+ *                               sent; try again after the send_ready callback.
  * @return #kEtcPalErrSys: An internal library or system call error occurred.
  */
 etcpal_error_t rdmnet_controller_send_rdm_update(rdmnet_controller_t   controller_handle,
@@ -1001,6 +1038,14 @@ void client_destroyed(RCClient* client)
   rdmnet_free_struct_instance(controller);
 }
 
+void client_send_ready(RCClient* client, rdmnet_client_scope_t scope_handle)
+{
+  RDMNET_ASSERT(client);
+  RdmnetController* controller = GET_CONTROLLER_FROM_CLIENT(client);
+  if (controller->callbacks.send_ready)
+    controller->callbacks.send_ready(controller->id.handle, scope_handle, controller->callbacks.context);
+}
+
 void client_llrp_msg_received(RCClient*              client,
                               const LlrpRdmCommand*  cmd,
                               RdmnetSyncRdmResponse* response,
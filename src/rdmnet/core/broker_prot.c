@@ -52,13 +52,16 @@
 
 /*********************** Private function prototypes *************************/
 
-static size_t calc_client_connect_len(const BrokerClientConnectMsg* data);
-static size_t pack_broker_header_with_rlp(const AcnRootLayerPdu* rlp, uint8_t* buf, size_t buflen, uint16_t vector);
-static etcpal_error_t send_broker_header(RCConnection*          conn,
-                                         const AcnRootLayerPdu* rlp,
-                                         uint8_t*               buf,
-                                         size_t                 buflen,
-                                         uint16_t               vector);
+static size_t         calc_client_connect_len(const BrokerClientConnectMsg* data);
+static size_t         pack_broker_header_with_rlp(const AcnRootLayerPdu* rlp,
+                                                  uint8_t*               buf,
+                                                  size_t                 buflen,
+                                                  uint16_t               vector);
+static size_t         pack_client_connect(uint8_t*                      buf,
+                                          size_t                        buflen,
+                                          const EtcPalUuid*             local_cid,
+                                          const BrokerClientConnectMsg* data);
+static etcpal_error_t send_broker_message(RCConnection* conn, uint8_t* buf, size_t message_size);
 
 /*************************** Function definitions ****************************/
 
@@ -89,39 +92,12 @@ size_t pack_broker_header_with_rlp(const AcnRootLayerPdu* rlp, uint8_t* buf, siz
   return (size_t)(cur_ptr - buf);
 }
 
-etcpal_error_t send_broker_header(RCConnection*          conn,
-                                  const AcnRootLayerPdu* rlp,
-                                  uint8_t*               buf,
-                                  size_t                 buflen,
-                                  uint16_t               vector)
+// Send a message packed into a buffer from rc_conn_get_send_buf(), then release the buffer.
+etcpal_error_t send_broker_message(RCConnection* conn, uint8_t* buf, size_t message_size)
 {
-  size_t data_size = acn_root_layer_buf_size(rlp, 1);
-  if (data_size == 0)
-    return kEtcPalErrProtocol;
-
-  // Pack and send the TCP preamble.
-  data_size = acn_pack_tcp_preamble(buf, buflen, data_size);
-  if (data_size == 0)
-    return kEtcPalErrProtocol;
-  int send_res = rc_send(conn->sock, buf, data_size, 0);
-  if (send_res < 0)
-    return (etcpal_error_t)send_res;
-
-  // Pack and send the Root Layer PDU header.
-  data_size = acn_pack_root_layer_header(buf, buflen, rlp);
-  if (data_size == 0)
-    return kEtcPalErrProtocol;
-  send_res = rc_send(conn->sock, buf, data_size, 0);
-  if (send_res < 0)
-    return (etcpal_error_t)send_res;
-
-  // Pack and send the Broker PDU header
-  PACK_BROKER_HEADER(rlp->data_len, vector, buf);
-  send_res = rc_send(conn->sock, buf, BROKER_PDU_HEADER_SIZE, 0);
-  if (send_res < 0)
-    return (etcpal_error_t)send_res;
-
-  return kEtcPalErrOk;
+  etcpal_error_t res = (message_size != 0 ? rc_conn_send_message(conn, buf, message_size) : kEtcPalErrProtocol);
+  rc_conn_release_send_buf(conn, buf);
+  return res;
 }
 
 /******************************* Client Connect ******************************/
@@ -147,25 +123,23 @@ size_t calc_client_connect_len(const BrokerClientConnectMsg* data)
   }
 }
 
-etcpal_error_t rc_broker_send_client_connect(RCConnection* conn, const BrokerClientConnectMsg* data)
+size_t pack_client_connect(uint8_t*                      buf,
+                           size_t                        buflen,
+                           const EtcPalUuid*             local_cid,
+                           const BrokerClientConnectMsg* data)
 {
-  if (!(IS_RPT_CLIENT_ENTRY(&data->client_entry) || IS_EPT_CLIENT_ENTRY(&data->client_entry)))
-  {
-    return kEtcPalErrProtocol;
-  }
-
-  uint8_t         buf[CLIENT_CONNECT_COMMON_FIELD_SIZE];
   AcnRootLayerPdu rlp;
-  rlp.sender_cid = conn->local_cid;
+  rlp.sender_cid = *local_cid;
   rlp.vector = ACN_VECTOR_ROOT_BROKER;
   rlp.data_len = calc_client_connect_len(data);
 
-  etcpal_error_t res = send_broker_header(conn, &rlp, buf, CLIENT_CONNECT_COMMON_FIELD_SIZE, VECTOR_BROKER_CONNECT);
-  if (res != kEtcPalErrOk)
-    return res;
-
-  // Pack and send the common fields for the Client Connect message
   uint8_t* cur_ptr = buf;
+  size_t   data_size = pack_broker_header_with_rlp(&rlp, buf, buflen, VECTOR_BROKER_CONNECT);
+  if (data_size == 0)
+    return 0;
+  cur_ptr += data_size;
+
+  // Pack the common fields for the Client Connect message
   rdmnet_safe_strncpy((char*)cur_ptr, data->scope, E133_SCOPE_STRING_PADDED_LENGTH);
   cur_ptr += E133_SCOPE_STRING_PADDED_LENGTH;
   etcpal_pack_u16b(cur_ptr, data->e133_version);
@@ -173,23 +147,19 @@ etcpal_error_t rc_broker_send_client_connect(RCConnection* conn, const BrokerCli
   rdmnet_safe_strncpy((char*)cur_ptr, data->search_domain, E133_DOMAIN_STRING_PADDED_LENGTH);
   cur_ptr += E133_DOMAIN_STRING_PADDED_LENGTH;
   *cur_ptr++ = data->connect_flags;
-  int send_res = rc_send(conn->sock, buf, (size_t)(cur_ptr - buf), 0);
-  if (send_res < 0)
-    return (etcpal_error_t)send_res;
 
-  // Pack and send the beginning of the Client Entry PDU
+  // Pack the beginning of the Client Entry PDU
   const EtcPalUuid* cid =
       (IS_RPT_CLIENT_ENTRY(&data->client_entry) ? &(GET_RPT_CLIENT_ENTRY(&data->client_entry)->cid)
                                                 : &(GET_EPT_CLIENT_ENTRY(&data->client_entry)->cid));
   PACK_CLIENT_ENTRY_HEADER(rlp.data_len - (BROKER_PDU_HEADER_SIZE + CLIENT_CONNECT_COMMON_FIELD_SIZE),
-                           data->client_entry.client_protocol, cid, buf);
-  send_res = rc_send(conn->sock, buf, CLIENT_ENTRY_HEADER_SIZE, 0);
+                           data->client_entry.client_protocol, cid, cur_ptr);
+  cur_ptr += CLIENT_ENTRY_HEADER_SIZE;
 
   if (IS_RPT_CLIENT_ENTRY(&data->client_entry))
   {
-    // Pack and send the RPT client entry
+    // Pack the RPT client entry
     const RdmnetRptClientEntry* rpt_entry = GET_RPT_CLIENT_ENTRY(&data->client_entry);
-    cur_ptr = buf;
     etcpal_pack_u16b(cur_ptr, rpt_entry->uid.manu);
     cur_ptr += 2;
     etcpal_pack_u32b(cur_ptr, rpt_entry->uid.id);
@@ -197,31 +167,42 @@ etcpal_error_t rc_broker_send_client_connect(RCConnection* conn, const BrokerCli
     *cur_ptr++ = (uint8_t)(rpt_entry->type);
     memcpy(cur_ptr, rpt_entry->binding_cid.data, ETCPAL_UUID_BYTES);
     cur_ptr += ETCPAL_UUID_BYTES;
-    send_res = rc_send(conn->sock, buf, RPT_CLIENT_ENTRY_DATA_SIZE, 0);
-    if (send_res < 0)
-      return (etcpal_error_t)send_res;
   }
   else  // is EPT client entry
   {
-    // Pack and send the EPT client entry
+    // Pack the EPT client entry
     const RdmnetEptClientEntry* ept_entry = GET_EPT_CLIENT_ENTRY(&data->client_entry);
     for (const RdmnetEptSubProtocol* prot = ept_entry->protocols;
          prot < ept_entry->protocols + ept_entry->num_protocols; ++prot)
     {
-      cur_ptr = buf;
       etcpal_pack_u16b(cur_ptr, prot->manufacturer_id);
       cur_ptr += 2;
       etcpal_pack_u16b(cur_ptr, prot->protocol_id);
       cur_ptr += 2;
       rdmnet_safe_strncpy((char*)cur_ptr, prot->protocol_string, EPT_PROTOCOL_STRING_PADDED_LENGTH);
       cur_ptr += EPT_PROTOCOL_STRING_PADDED_LENGTH;
-      send_res = rc_send(conn->sock, buf, EPT_PROTOCOL_ENTRY_SIZE, 0);
-      if (send_res < 0)
-        return (etcpal_error_t)send_res;
     }
   }
-  etcpal_timer_reset(&conn->send_timer);
-  return kEtcPalErrOk;
+  return (size_t)(cur_ptr - buf);
+}
+
+etcpal_error_t rc_broker_send_client_connect(RCConnection* conn, const BrokerClientConnectMsg* data)
+{
+  if (!(IS_RPT_CLIENT_ENTRY(&data->client_entry) || IS_EPT_CLIENT_ENTRY(&data->client_entry)))
+  {
+    return kEtcPalErrProtocol;
+  }
+
+  size_t   message_size = ACN_TCP_PREAMBLE_SIZE + ACN_RLP_HEADER_SIZE_EXT_LEN + calc_client_connect_len(data);
+  uint8_t* buf = rc_conn_get_send_buf(conn, message_size);
+  if (!buf)
+    return kEtcPalErrMsgSize;
+
+  etcpal_error_t res =
+      send_broker_message(conn, buf, pack_client_connect(buf, message_size, &conn->local_cid, data));
+  if (res == kEtcPalErrOk)
+    etcpal_timer_reset(&conn->send_timer);
+  return res;
 }
 
 /******************************* Connect Reply *******************************/
@@ -292,11 +273,13 @@ etcpal_error_t rc_broker_send_fetch_client_list(RCConnection* conn, const EtcPal
   rlp.vector = ACN_VECTOR_ROOT_BROKER;
   rlp.data_len = BROKER_PDU_HEADER_SIZE;
 
-  uint8_t        buf[ACN_RLP_HEADER_SIZE_EXT_LEN];
-  etcpal_error_t res =
-      send_broker_header(conn, &rlp, buf, ACN_RLP_HEADER_SIZE_EXT_LEN, VECTOR_BROKER_FETCH_CLIENT_LIST);
+  uint8_t buf[BROKER_PDU_FULL_HEADER_SIZE];
+  size_t  message_size =
+      pack_broker_header_with_rlp(&rlp, buf, BROKER_PDU_FULL_HEADER_SIZE, VECTOR_BROKER_FETCH_CLIENT_LIST);
+  if (message_size == 0)
+    return kEtcPalErrProtocol;
 
-  return res;
+  return rc_conn_send_message(conn, buf, message_size);
 }
 
 /**************************** Client List Messages ***************************/
@@ -443,27 +426,27 @@ etcpal_error_t rc_broker_send_request_dynamic_uids(RCConnection*     conn,
   rlp.vector = ACN_VECTOR_ROOT_BROKER;
   rlp.data_len = BROKER_PDU_HEADER_SIZE + REQUEST_DYNAMIC_UIDS_DATA_SIZE(num_rids);
 
-  uint8_t        buf[ACN_RLP_HEADER_SIZE_EXT_LEN];
-  etcpal_error_t res =
-      send_broker_header(conn, &rlp, buf, ACN_RLP_HEADER_SIZE_EXT_LEN, VECTOR_BROKER_REQUEST_DYNAMIC_UIDS);
-  if (res != kEtcPalErrOk)
-    return res;
+  size_t   message_size = ACN_TCP_PREAMBLE_SIZE + ACN_RLP_HEADER_SIZE_EXT_LEN + rlp.data_len;
+  uint8_t* buf = rc_conn_get_send_buf(conn, message_size);
+  if (!buf)
+    return kEtcPalErrMsgSize;
 
-  // Pack and send each Dynamic UID Request Pair in turn
+  uint8_t* cur_ptr = buf;
+  size_t   data_size = pack_broker_header_with_rlp(&rlp, buf, message_size, VECTOR_BROKER_REQUEST_DYNAMIC_UIDS);
+  if (data_size == 0)
+    return send_broker_message(conn, buf, 0);
+  cur_ptr += data_size;
+
+  // Pack each Dynamic UID Request Pair in turn
   for (const EtcPalUuid* cur_rid = rids; cur_rid < rids + num_rids; ++cur_rid)
   {
-    // Pack the Dynamic UID Request Pair
-    etcpal_pack_u16b(&buf[0], (manufacturer_id | 0x8000));
-    etcpal_pack_u32b(&buf[2], 0);
-    memcpy(&buf[6], cur_rid->data, ETCPAL_UUID_BYTES);
-
-    // Send the segment
-    int send_res = rc_send(conn->sock, buf, DYNAMIC_UID_REQUEST_PAIR_SIZE, 0);
-    if (send_res < 0)
-      return (etcpal_error_t)send_res;
+    etcpal_pack_u16b(&cur_ptr[0], (manufacturer_id | 0x8000));
+    etcpal_pack_u32b(&cur_ptr[2], 0);
+    memcpy(&cur_ptr[6], cur_rid->data, ETCPAL_UUID_BYTES);
+    cur_ptr += DYNAMIC_UID_REQUEST_PAIR_SIZE;
   }
 
-  return kEtcPalErrOk;
+  return send_broker_message(conn, buf, (size_t)(cur_ptr - buf));
 }
 
 /************************ Dynamic UID Assignment List ************************/
@@ -560,26 +543,26 @@ etcpal_error_t rc_broker_send_fetch_uid_assignment_list(RCConnection*     conn,
   rlp.vector = ACN_VECTOR_ROOT_BROKER;
   rlp.data_len = BROKER_PDU_HEADER_SIZE + FETCH_UID_ASSIGNMENT_LIST_DATA_SIZE(num_uids);
 
-  uint8_t        buf[ACN_RLP_HEADER_SIZE_EXT_LEN];
-  etcpal_error_t res =
-      send_broker_header(conn, &rlp, buf, ACN_RLP_HEADER_SIZE_EXT_LEN, VECTOR_BROKER_FETCH_DYNAMIC_UID_LIST);
-  if (res != kEtcPalErrOk)
-    return res;
+  size_t   message_size = ACN_TCP_PREAMBLE_SIZE + ACN_RLP_HEADER_SIZE_EXT_LEN + rlp.data_len;
+  uint8_t* buf = rc_conn_get_send_buf(conn, message_size);
+  if (!buf)
+    return kEtcPalErrMsgSize;
+
+  uint8_t* cur_ptr = buf;
+  size_t   data_size = pack_broker_header_with_rlp(&rlp, buf, message_size, VECTOR_BROKER_FETCH_DYNAMIC_UID_LIST);
+  if (data_size == 0)
+    return send_broker_message(conn, buf, 0);
+  cur_ptr += data_size;
 
-  // Pack and send each Dynamic UID Request Pair in turn
+  // Pack each Requested UID in turn
   for (const RdmUid* cur_uid = uids; cur_uid < uids + num_uids; ++cur_uid)
   {
-    // Pack the Requested UID
-    etcpal_pack_u16b(&buf[0], cur_uid->manu);
-    etcpal_pack_u32b(&buf[2], cur_uid->id);
-
-    // Send the segment
-    int send_res = rc_send(conn->sock, buf, 6, 0);
-    if (send_res < 0)
-      return (etcpal_error_t)send_res;
+    etcpal_pack_u16b(&cur_ptr[0], cur_uid->manu);
+    etcpal_pack_u32b(&cur_ptr[2], cur_uid->id);
+    cur_ptr += 6;
   }
 
-  return kEtcPalErrOk;
+  return send_broker_message(conn, buf, (size_t)(cur_ptr - buf));
 }
 
 /******************************** Disconnect *********************************/
@@ -608,23 +591,15 @@ size_t rc_broker_pack_disconnect(uint8_t*                   buf,
 
 etcpal_error_t rc_broker_send_disconnect(RCConnection* conn, const BrokerDisconnectMsg* data)
 {
-  AcnRootLayerPdu rlp;
-  rlp.sender_cid = conn->local_cid;
-  rlp.vector = ACN_VECTOR_ROOT_BROKER;
-  rlp.data_len = BROKER_DISCONNECT_MSG_SIZE;
-
-  uint8_t        buf[ACN_RLP_HEADER_SIZE_EXT_LEN];
-  etcpal_error_t res = send_broker_header(conn, &rlp, buf, ACN_RLP_HEADER_SIZE_EXT_LEN, VECTOR_BROKER_DISCONNECT);
-  if (res != kEtcPalErrOk)
-    return res;
-
-  etcpal_pack_u16b(buf, (uint16_t)(data->disconnect_reason));
-  int send_res = rc_send(conn->sock, buf, 2, 0);
-  if (send_res < 0)
-    return (etcpal_error_t)send_res;
+  uint8_t buf[BROKER_DISCONNECT_FULL_MSG_SIZE];
+  size_t  message_size = rc_broker_pack_disconnect(buf, BROKER_DISCONNECT_FULL_MSG_SIZE, &conn->local_cid, data);
+  if (message_size == 0)
+    return kEtcPalErrProtocol;
 
-  etcpal_timer_reset(&conn->send_timer);
-  return kEtcPalErrOk;
+  etcpal_error_t res = rc_conn_send_message(conn, buf, message_size);
+  if (res == kEtcPalErrOk)
+    etcpal_timer_reset(&conn->send_timer);
+  return res;
 }
 
 /*********************************** Null ************************************/
@@ -645,14 +620,12 @@ size_t rc_broker_pack_null(uint8_t* buf, size_t buflen, const EtcPalUuid* local_
 
 etcpal_error_t rc_broker_send_null(RCConnection* conn)
 {
-  AcnRootLayerPdu rlp;
-  rlp.sender_cid = conn->local_cid;
-  rlp.vector = ACN_VECTOR_ROOT_BROKER;
-  rlp.data_len = BROKER_NULL_MSG_SIZE;
-
-  uint8_t        buf[ACN_RLP_HEADER_SIZE_EXT_LEN];
-  etcpal_error_t res = send_broker_header(conn, &rlp, buf, ACN_RLP_HEADER_SIZE_EXT_LEN, VECTOR_BROKER_NULL);
+  uint8_t buf[BROKER_NULL_FULL_MSG_SIZE];
+  size_t  message_size = rc_broker_pack_null(buf, BROKER_NULL_FULL_MSG_SIZE, &conn->local_cid);
+  if (message_size == 0)
+    return kEtcPalErrProtocol;
 
+  etcpal_error_t res = rc_conn_send_message(conn, buf, message_size);
   if (res == kEtcPalErrOk)
     etcpal_timer_reset(&conn->send_timer);
 
@@ -144,6 +144,7 @@ static void                conncb_connect_failed(RCConnection* conn, const RCCon
 static void                conncb_disconnected(RCConnection* conn, const RCDisconnectedInfo* disconn_info);
 static rc_message_action_t conncb_msg_received(RCConnection* conn, const RdmnetMessage* message);
 static void                conncb_destroyed(RCConnection* conn);
+static void                conncb_send_ready(RCConnection* conn);
 
 // clang-format off
 static const RCConnectionCallbacks kConnCallbacks =
@@ -152,7 +153,8 @@ static const RCConnectionCallbacks kConnCallbacks =
   conncb_connect_failed,
   conncb_disconnected,
   conncb_msg_received,
-  conncb_destroyed
+  conncb_destroyed,
+  conncb_send_ready
 };
 // clang-format on
 
@@ -1221,6 +1223,15 @@ void conncb_destroyed(RCConnection* conn)
     client->callbacks.destroyed(client);
 }
 
+void conncb_send_ready(RCConnection* conn)
+{
+  RCClientScope* scope = GET_CLIENT_SCOPE_FROM_CONN(conn);
+  RCClient*      client = scope->client;
+
+  if (client->callbacks.send_ready)
+    client->callbacks.send_ready(client, scope->handle);
+}
+
 bool parse_rpt_message(const RCClientScope* scope, const RptMessage* rmsg, RptClientMessage* msg_out)
 {
   switch (rmsg->vector)
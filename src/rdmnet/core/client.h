@@ -169,6 +169,10 @@ typedef void (*RCClientEptMsgReceivedCb)(RCClient*               client,
 // been cleaned up. It is safe to deallocate the client from this callback.
 typedef void (*RCClientDestroyedCb)(RCClient* client);
 
+// A message that was previously refused with kEtcPalErrWouldBlock on the given scope can now be
+// retried. This is called from the background thread.
+typedef void (*RCClientSendReadyCb)(RCClient* client, rdmnet_client_scope_t scope_handle);
+
 // The set of callbacks shared between RPT and EPT clients.
 typedef struct RCClientCommonCallbacks
 {
@@ -177,6 +181,7 @@ typedef struct RCClientCommonCallbacks
   RCClientDisconnectedCb      disconnected;
   RCClientBrokerMsgReceivedCb broker_msg_received;
   RCClientDestroyedCb         destroyed;
+  RCClientSendReadyCb         send_ready;  // Optional
 } RCClientCommonCallbacks;
 
 // The set of possible callbacks that are delivered to an RPT client.
@@ -253,9 +253,16 @@ void rc_tick(void)
   etcpal_error_t  poll_res = etcpal_poll_wait(&core_state.poll_context, &event, RDMNET_POLL_TIMEOUT);
   if (poll_res == kEtcPalErrOk)
   {
-    RCPolledSocketInfo* info = (RCPolledSocketInfo*)event.user_data;
-    if (info)
-      info->callback(&event, info->data);
+    // Handle everything that is already ready before going back to the timers, up to a limit so
+    // that a busy socket can't starve the periodic module updates.
+    int num_events = 0;
+    do
+    {
+      RCPolledSocketInfo* info = (RCPolledSocketInfo*)event.user_data;
+      if (info)
+        info->callback(&event, info->data);
+    } while (++num_events < RDMNET_TICK_MAX_EVENTS_PER_WAKEUP &&
+             etcpal_poll_wait(&core_state.poll_context, &event, 0) == kEtcPalErrOk);
   }
   else if (poll_res != kEtcPalErrTimedOut)
   {
@@ -20,6 +20,7 @@
 #include "rdmnet/core/connection.h"
 
 #include <stdint.h>
+#include <string.h>
 #include "etcpal/common.h"
 #include "etcpal/mutex.h"
 #include "etcpal/rbtree.h"
@@ -99,6 +100,15 @@ static void     cleanup_connection_resources(RCConnection* conn);
 
 static void destroy_connection(RCConnection* conn, const void* context);
 
+// Outgoing data
+static etcpal_error_t send_blocking(etcpal_socket_t sock, const uint8_t* data, size_t data_size);
+#if RDMNET_CONN_SEND_QUEUE_SIZE
+static void           reset_send_queue(RCConnection* conn);
+static etcpal_error_t queue_send_data(RCConnection* conn, const uint8_t* data, size_t data_size);
+static etcpal_error_t flush_send_queue(RCConnection* conn, bool block);
+static void           send_queued_data(RCConnection* conn);
+#endif
+
 // Incoming message handling
 static void                socket_activity_callback(const EtcPalPollEvent* event, RCPolledSocketOpaqueData data);
 static void                receive_and_process_messages(RCConnection* conn);
@@ -160,6 +170,11 @@ etcpal_error_t rc_conn_register(RCConnection* conn)
   rc_msg_buf_init(&conn->recv_buf);
   conn->retry_current_message = false;
 
+#if RDMNET_CONN_SEND_QUEUE_SIZE
+  conn->send_queue_enabled = true;
+  reset_send_queue(conn);
+#endif
+
   return kEtcPalErrOk;
 }
 
@@ -255,6 +270,89 @@ etcpal_error_t rc_conn_disconnect(RCConnection* conn, rdmnet_disconnect_reason_t
   return kEtcPalErrOk;
 }
 
+/*
+ * Get a buffer in which to pack an outgoing message of message_size bytes, including the TCP
+ * preamble. Messages which fit are packed in the connection's scratch buffer; larger ones get a
+ * temporary heap buffer if dynamic memory is enabled. Returns NULL if no buffer is large enough.
+ * The buffer must be released with rc_conn_release_send_buf().
+ *
+ * Needs lock on the connection.
+ */
+uint8_t* rc_conn_get_send_buf(RCConnection* conn, size_t message_size)
+{
+  RDMNET_ASSERT(conn);
+
+  if (message_size <= RC_CONN_SEND_BUF_SIZE)
+    return conn->send_buf;
+#if RDMNET_DYNAMIC_MEM
+  return (uint8_t*)malloc(message_size);
+#else
+  return NULL;
+#endif
+}
+
+/*
+ * Release a buffer obtained from rc_conn_get_send_buf().
+ */
+void rc_conn_release_send_buf(RCConnection* conn, uint8_t* buf)
+{
+  RDMNET_ASSERT(conn);
+
+#if RDMNET_DYNAMIC_MEM
+  if (buf != conn->send_buf)
+    free(buf);
+#else
+  ETCPAL_UNUSED_ARG(buf);
+#endif
+}
+
+/*
+ * Send a complete, packed message on a connection with as few socket calls as possible.
+ *
+ * If the connection has a send queue, this never blocks: data that the socket can't accept
+ * immediately is queued behind any data already waiting and sent from the background thread. If
+ * the queue is too full to take the whole message, nothing is sent and kEtcPalErrWouldBlock is
+ * returned; the send_ready callback will be called when the queue has drained. Otherwise, this
+ * blocks until the socket has accepted all of the data.
+ *
+ * Needs lock on the connection.
+ */
+etcpal_error_t rc_conn_send_message(RCConnection* conn, const uint8_t* data, size_t data_size)
+{
+  RDMNET_ASSERT(conn);
+  RDMNET_ASSERT(data);
+
+#if RDMNET_CONN_SEND_QUEUE_SIZE
+  if (conn->send_queue_enabled)
+  {
+    // Data can only go straight to the socket if nothing is waiting ahead of it.
+    if (conn->send_queue_size > 0)
+    {
+      if (conn->send_queue_size >= RDMNET_CONN_SEND_QUEUE_HIGH_WATERMARK ||
+          data_size > RDMNET_CONN_SEND_QUEUE_SIZE - conn->send_queue_size)
+      {
+        conn->send_queue_blocked = true;
+        return kEtcPalErrWouldBlock;
+      }
+      return queue_send_data(conn, data, data_size);
+    }
+
+    size_t size_sent = 0;
+    int    send_res = etcpal_send(conn->sock, data, data_size, 0);
+    if (send_res >= 0)
+      size_sent = (size_t)send_res;
+    else if ((etcpal_error_t)send_res != kEtcPalErrWouldBlock)
+      return (etcpal_error_t)send_res;
+
+    if (size_sent < data_size)
+      return queue_send_data(conn, &data[size_sent], data_size - size_sent);
+    return kEtcPalErrOk;
+  }
+#endif
+
+  return send_blocking(conn->sock, data, data_size);
+}
+
 /*
  * Handle periodic RDMnet connection functionality.
  */
@@ -331,7 +429,7 @@ void process_connection_state(RCConnection* conn, const void* context)
         break;
       case kRCConnStateReconnectPending:
         cleanup_connection_resources(conn);
-        rc_msg_buf_init(&conn->recv_buf);
+        rc_msg_buf_reset(&conn->recv_buf);
         conn->retry_current_message = false;
         if (conn->sent_connected_notification)
         {
@@ -450,7 +548,7 @@ void start_rdmnet_connection(RCConnection* conn)
 void reset_connection(RCConnection* conn)
 {
   cleanup_connection_resources(conn);
-  rc_msg_buf_init(&conn->recv_buf);
+  rc_msg_buf_reset(&conn->recv_buf);
   conn->retry_current_message = false;
   conn->state = kRCConnStateNotStarted;
 }
@@ -458,7 +556,7 @@ void reset_connection(RCConnection* conn)
 void retry_connection(RCConnection* conn)
 {
   cleanup_connection_resources(conn);
-  rc_msg_buf_init(&conn->recv_buf);
+  rc_msg_buf_reset(&conn->recv_buf);
   conn->retry_current_message = false;
   conn->state = kRCConnStateConnectPending;
 }
@@ -467,6 +565,7 @@ void destroy_connection(RCConnection* conn, const void* context)
 {
   ETCPAL_UNUSED_ARG(context);
   cleanup_connection_resources(conn);
+  rc_msg_buf_deinit(&conn->recv_buf);
   if (conn->callbacks.destroyed)
     conn->callbacks.destroyed(conn);
 }
@@ -488,15 +587,139 @@ void cleanup_connection_resources(RCConnection* conn)
     // won't happen now, so free the resources.
     rc_free_message_resources(&conn->recv_buf.msg);
   }
+
+#if RDMNET_CONN_SEND_QUEUE_SIZE
+  reset_send_queue(conn);
+#endif
+}
+
+// Send data on a socket, waiting until all of it has been accepted.
+etcpal_error_t send_blocking(etcpal_socket_t sock, const uint8_t* data, size_t data_size)
+{
+  size_t size_sent = 0;
+  while (size_sent < data_size)
+  {
+    int send_res = rc_send(sock, &data[size_sent], data_size - size_sent, 0);
+    if (send_res < 0)
+      return (etcpal_error_t)send_res;
+    if (send_res == 0)
+      return kEtcPalErrSys;
+    size_sent += (size_t)send_res;
+  }
+  return kEtcPalErrOk;
+}
+
+#if RDMNET_CONN_SEND_QUEUE_SIZE
+
+void reset_send_queue(RCConnection* conn)
+{
+  conn->send_queue_head = 0;
+  conn->send_queue_size = 0;
+  conn->send_queue_blocked = false;
+}
+
+// Append data to the tail of the send queue, and start polling for writability if the queue was
+// empty. Part of a message may already have been sent, so the rest must be sent no matter what; if
+// the queue has no room for it, fall back to a blocking send.
+etcpal_error_t queue_send_data(RCConnection* conn, const uint8_t* data, size_t data_size)
+{
+  if (data_size > RDMNET_CONN_SEND_QUEUE_SIZE - conn->send_queue_size)
+  {
+    etcpal_error_t flush_res = flush_send_queue(conn, true);
+    if (flush_res != kEtcPalErrOk)
+      return flush_res;
+    return send_blocking(conn->sock, data, data_size);
+  }
+
+  if (conn->send_queue_size == 0)
+  {
+    etcpal_error_t modify_res =
+        rc_modify_polled_socket(conn->sock, ETCPAL_POLL_IN | ETCPAL_POLL_OUT, &conn->poll_info);
+    if (modify_res != kEtcPalErrOk)
+      return modify_res;
+  }
+
+  size_t tail = (conn->send_queue_head + conn->send_queue_size) % RDMNET_CONN_SEND_QUEUE_SIZE;
+  size_t first_chunk = RDMNET_CONN_SEND_QUEUE_SIZE - tail;
+  if (first_chunk > data_size)
+    first_chunk = data_size;
+
+  memcpy(&conn->send_queue[tail], data, first_chunk);
+  if (first_chunk < data_size)
+    memcpy(conn->send_queue, &data[first_chunk], data_size - first_chunk);
+  conn->send_queue_size += data_size;
+  return kEtcPalErrOk;
 }
 
+// Send as much queued data as the socket will accept. If block is true, wait until the queue is
+// empty. Stops polling for writability once the queue drains.
+etcpal_error_t flush_send_queue(RCConnection* conn, bool block)
+{
+  while (conn->send_queue_size > 0)
+  {
+    size_t chunk_size = RDMNET_CONN_SEND_QUEUE_SIZE - conn->send_queue_head;
+    if (chunk_size > conn->send_queue_size)
+      chunk_size = conn->send_queue_size;
+
+    int send_res = block ? rc_send(conn->sock, &conn->send_queue[conn->send_queue_head], chunk_size, 0)
+                         : etcpal_send(conn->sock, &conn->send_queue[conn->send_queue_head], chunk_size, 0);
+    if (send_res < 0)
+      return ((etcpal_error_t)send_res == kEtcPalErrWouldBlock ? kEtcPalErrOk : (etcpal_error_t)send_res);
+    if (send_res == 0)
+      return (block ? kEtcPalErrSys : kEtcPalErrOk);
+
+    conn->send_queue_head = (conn->send_queue_head + (size_t)send_res) % RDMNET_CONN_SEND_QUEUE_SIZE;
+    conn->send_queue_size -= (size_t)send_res;
+  }
+
+  conn->send_queue_head = 0;
+  return rc_modify_polled_socket(conn->sock, ETCPAL_POLL_IN, &conn->poll_info);
+}
+
+// Called from the background thread when a connection's socket becomes writable.
+void send_queued_data(RCConnection* conn)
+{
+  etcpal_error_t flush_res = kEtcPalErrOk;
+  bool           notify_ready = false;
+
+  if (RC_CONN_LOCK(conn))
+  {
+    if (conn->sock != ETCPAL_SOCKET_INVALID && conn->send_queue_size > 0)
+      flush_res = flush_send_queue(conn, false);
+
+    if (flush_res == kEtcPalErrOk && conn->send_queue_blocked &&
+        conn->send_queue_size <= RDMNET_CONN_SEND_QUEUE_LOW_WATERMARK)
+    {
+      conn->send_queue_blocked = false;
+      notify_ready = true;
+    }
+    RC_CONN_UNLOCK(conn);
+  }
+
+  if (flush_res != kEtcPalErrOk)
+    handle_socket_error(conn, flush_res);
+  else if (notify_ready && conn->callbacks.send_ready)
+    conn->callbacks.send_ready(conn);
+}
+
+#endif  // RDMNET_CONN_SEND_QUEUE_SIZE
+
 void socket_activity_callback(const EtcPalPollEvent* event, RCPolledSocketOpaqueData data)
 {
   RCConnection* conn = (RCConnection*)data.ptr;
 
   if (event->events & ETCPAL_POLL_ERR)
+  {
     handle_socket_error(conn, event->err);
-  else if (event->events & ETCPAL_POLL_IN)
+    return;
+  }
+
+#if RDMNET_CONN_SEND_QUEUE_SIZE
+  if (event->events & ETCPAL_POLL_OUT)
+    send_queued_data(conn);
+#endif
+
+  if (event->events & ETCPAL_POLL_IN)
     receive_and_process_messages(conn);
   else if (event->events & ETCPAL_POLL_CONNECT)
     handle_tcp_connection_established(conn);
@@ -564,7 +787,8 @@ void handle_tcp_connection_established(RCConnection* conn)
   if (RC_CONN_LOCK(conn))
   {
     // connected successfully!
-    start_rdmnet_connection(conn);
+    if (conn->state == kRCConnStateTCPConnPending)
+      start_rdmnet_connection(conn);
     RC_CONN_UNLOCK(conn);
   }
 }
@@ -24,8 +24,9 @@
  *
  * Add a connection using rc_connection_register(). Start a connection to a broker using
  * rc_connection_connect(). The status of the connection will be communicated via the callbacks.
- * Send data over the broker connection using rc_connection_send(). Data received over the broker
- * connection will be forwarded via the RCMessageReceivedCallback.
+ * Pack outgoing messages into the buffer returned by rc_conn_get_send_buf() and send them over the
+ * broker connection using rc_conn_send_message(). Data received over the broker connection will be
+ * forwarded via the RCMessageReceivedCallback.
  *
  * All connection functions in this module should only be called after having the connection lock.
  */
@@ -44,6 +45,22 @@
 #include "rdmnet/core/common.h"
 #include "rdmnet/core/message.h"
 #include "rdmnet/core/msg_buf.h"
+#include "rdmnet/core/opts.h"
+
+/*
+ * The size of each connection's scratch buffer for packing outgoing messages. It fits the
+ * encapsulating headers of any message (TCP preamble, Root Layer PDU header, RPT PDU header and
+ * Request/Notification header, rounded up) followed by the larger of a maximum-length RPT Status
+ * string or the RDM commands of the largest notification the client module builds in static memory
+ * mode.
+ */
+#define RC_CONN_SEND_BUF_HEADERS_SIZE 80
+#define RC_CONN_SEND_BUF_RDM_CMDS_SIZE ((RDMNET_MAX_SENT_ACK_OVERFLOW_RESPONSES + 2) * (RDM_MAX_BYTES + 3))
+#if RC_CONN_SEND_BUF_RDM_CMDS_SIZE > RPT_STATUS_STRING_MAXLEN
+#define RC_CONN_SEND_BUF_SIZE (RC_CONN_SEND_BUF_HEADERS_SIZE + RC_CONN_SEND_BUF_RDM_CMDS_SIZE)
+#else
+#define RC_CONN_SEND_BUF_SIZE (RC_CONN_SEND_BUF_HEADERS_SIZE + RPT_STATUS_STRING_MAXLEN)
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -124,6 +141,11 @@ typedef rc_message_action_t (*RCConnMessageReceivedCallback)(RCConnection* conn,
 // It is safe to deallocate the connection from this callback.
 typedef void (*RCConnDestroyedCallback)(RCConnection* conn);
 
+// A message was previously refused with kEtcPalErrWouldBlock because the connection's send queue
+// was full, and the queue has since drained below its low watermark. Called from the background
+// thread.
+typedef void (*RCConnSendReadyCallback)(RCConnection* conn);
+
 // The set of callbacks which are called with notifications about RDMnet connections.
 typedef struct RCConnectionCallbacks
 {
@@ -132,6 +154,7 @@ typedef struct RCConnectionCallbacks
   RCConnDisconnectedCallback    disconnected;
   RCConnMessageReceivedCallback message_received;
   RCConnDestroyedCallback       destroyed;
+  RCConnSendReadyCallback       send_ready;  // Optional
 } RCConnectionCallbacks;
 
 // The connection state machine.
@@ -177,6 +200,18 @@ struct RCConnection
   // Send and receive tracking
   RCMsgBuf recv_buf;
   bool     retry_current_message;  // recv_buf.msg couldn't be processed - retry processing it at a later time.
+  uint8_t  send_buf[RC_CONN_SEND_BUF_SIZE];  // Scratch space for packing outgoing messages.
+
+#if RDMNET_CONN_SEND_QUEUE_SIZE
+  // A ring buffer of outbound data which the socket couldn't accept immediately, sent from the
+  // background thread when the socket becomes writable. Only registered connections use the queue;
+  // others always send synchronously.
+  bool    send_queue_enabled;
+  bool    send_queue_blocked;  // A message was refused because the queue was full.
+  size_t  send_queue_head;
+  size_t  send_queue_size;
+  uint8_t send_queue[RDMNET_CONN_SEND_QUEUE_SIZE];
+#endif
 };
 
 etcpal_error_t rc_conn_module_init(void);
@@ -194,6 +229,10 @@ etcpal_error_t rc_conn_reconnect(RCConnection*                 conn,
                                  rdmnet_disconnect_reason_t    disconnect_reason);
 etcpal_error_t rc_conn_disconnect(RCConnection* conn, rdmnet_disconnect_reason_t disconnect_reason);
 
+uint8_t*       rc_conn_get_send_buf(RCConnection* conn, size_t message_size);
+void           rc_conn_release_send_buf(RCConnection* conn, uint8_t* buf);
+etcpal_error_t rc_conn_send_message(RCConnection* conn, const uint8_t* data, size_t data_size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -19,6 +19,7 @@
 
 #include "rdmnet/core/llrp_manager.h"
 
+#include <string.h>
 #include "etcpal/common.h"
 #include "etcpal/inet.h"
 #include "rdm/uid.h"
@@ -35,6 +36,7 @@ struct DiscoveredTargetInternal
 {
   RdmUid                    uid;
   EtcPalUuid                cid;
+  EtcPalMcastNetintId       netint;
   DiscoveredTargetInternal* next;
 };
 
@@ -46,6 +48,12 @@ typedef enum
   kRCLlrpManagerEventRdmRespReceived
 } rc_llrp_manager_event_t;
 
+typedef struct TimedOutCommand
+{
+  LlrpDestinationAddr destination;
+  uint32_t            seq_num;
+} TimedOutCommand;
+
 typedef struct RCLlrpManagerEvent
 {
   rc_llrp_manager_event_t which;
@@ -73,6 +81,36 @@ typedef struct RCLlrpManagerKeys
 #define MANAGER_LOCK(mgr_ptr) etcpal_mutex_lock((mgr_ptr)->lock)
 #define MANAGER_UNLOCK(mgr_ptr) etcpal_mutex_unlock((mgr_ptr)->lock)
 
+#define INITIAL_PROBE_RANGES_CAPACITY 8
+
+#define INIT_MANAGER_NETINTS(mgr_ptr, initial_capacity) \
+  RC_INIT_BUF(mgr_ptr, RCLlrpManagerNetintInfo, netints, initial_capacity, RDMNET_MAX_MCAST_NETINTS)
+#define DEINIT_MANAGER_NETINTS(mgr_ptr) RC_DEINIT_BUF(mgr_ptr, netints)
+
+#define INIT_PROBE_RANGES(mgr_ptr)                                                           \
+  RC_INIT_BUF(mgr_ptr, RCLlrpManagerProbeRange, probe_ranges, INITIAL_PROBE_RANGES_CAPACITY, \
+              RC_LLRP_MANAGER_MAX_PROBE_RANGES)
+#define DEINIT_PROBE_RANGES(mgr_ptr) RC_DEINIT_BUF(mgr_ptr, probe_ranges)
+#define CHECK_PROBE_RANGES_CAPACITY(mgr_ptr, num_additional)                                              \
+  RC_CHECK_BUF_CAPACITY(mgr_ptr, RCLlrpManagerProbeRange, probe_ranges, RC_LLRP_MANAGER_MAX_PROBE_RANGES, \
+                        num_additional)
+
+#define INITIAL_TRANSACTIONS_CAPACITY 8
+
+#define INIT_TRANSACTIONS(mgr_ptr)                                                            \
+  RC_INIT_BUF(mgr_ptr, RCLlrpManagerTransaction, transactions, INITIAL_TRANSACTIONS_CAPACITY, \
+              RC_LLRP_MANAGER_MAX_TRANSACTIONS)
+#define DEINIT_TRANSACTIONS(mgr_ptr) RC_DEINIT_BUF(mgr_ptr, transactions)
+#define CHECK_TRANSACTIONS_CAPACITY(mgr_ptr, num_additional)                                               \
+  RC_CHECK_BUF_CAPACITY(mgr_ptr, RCLlrpManagerTransaction, transactions, RC_LLRP_MANAGER_MAX_TRANSACTIONS, \
+                        num_additional)
+
+// The most RDM command timeouts delivered each tick; any more are delivered on the next one.
+#define MAX_TIMEOUTS_PER_TICK 16
+
+#define NETINT_IDS_EQUAL(id1ptr, id2ptr) \
+  ((id1ptr)->ip_type == (id2ptr)->ip_type && (id1ptr)->index == (id2ptr)->index)
+
 /**************************** Private variables ******************************/
 
 RC_DECLARE_REF_LISTS(managers, 1);
@@ -80,24 +118,48 @@ RC_DECLARE_REF_LISTS(managers, 1);
 /*********************** Private function prototypes *************************/
 
 // Manager setup and cleanup
-static etcpal_error_t get_manager_sockets(RCLlrpManager* manager);
-static void           release_manager_sockets(RCLlrpManager* manager);
+static etcpal_error_t setup_manager_netints(RCLlrpManager* manager);
+static etcpal_error_t setup_manager_netint(const EtcPalMcastNetintId* netint_id, RCLlrpManagerNetintInfo* netint);
+static void           cleanup_manager_netints(RCLlrpManager* manager);
 static void           cleanup_manager_resources(RCLlrpManager* manager, const void* context);
 
+// RDM command transactions
+static etcpal_error_t send_transaction(RCLlrpManager* manager, const RCLlrpManagerTransaction* transaction);
+static bool           next_transaction_netint(RCLlrpManager* manager, RCLlrpManagerTransaction* transaction);
+static size_t         process_transactions(RCLlrpManager* manager, TimedOutCommand* timed_out);
+static size_t         count_transactions_to_target(const RCLlrpManager* manager, const EtcPalUuid* target_cid);
+static RCLlrpManagerTransaction* find_transaction(RCLlrpManager*    manager,
+                                                  uint32_t          transaction_number,
+                                                  const EtcPalUuid* target_cid);
+static void                      remove_transaction(RCLlrpManager* manager, RCLlrpManagerTransaction* transaction);
+
 // Periodic state processing
 static void process_manager_state(RCLlrpManager* manager, const void* context);
-static bool send_next_probe(RCLlrpManager* manager);
-static bool update_probe_range(RCLlrpManager* manager);
+static bool update_probe_range(RCLlrpManagerProbeRange* range);
+static bool send_range_probe(RCLlrpManager* manager, size_t range_index);
+static void update_known_uids(RCLlrpManager* manager, size_t range_index);
+static bool add_probe_range(RCLlrpManager* manager, const RdmUid* low, const RdmUid* end);
+static void remove_probe_range(RCLlrpManager* manager, size_t range_index);
+static void end_discovery(RCLlrpManager* manager);
 
 // Incoming message handling
-static void handle_llrp_message(RCLlrpManager* manager, const LlrpMessage* msg, RCLlrpManagerEvent* event);
+static void handle_llrp_message(RCLlrpManager*             manager,
+                                const LlrpMessage*         msg,
+                                const EtcPalMcastNetintId* netint,
+                                RCLlrpManagerEvent*        event);
 static void deliver_event_callback(RCLlrpManager* manager, RCLlrpManagerEvent* event);
 
 // Utilities
-static EtcPalRbNode*  discovered_target_node_alloc(void);
-static void           discovered_target_node_dealloc(EtcPalRbNode* node);
-static int            discovered_target_compare(const EtcPalRbTree* self, const void* value_a, const void* value_b);
-static void           discovered_target_clear_cb(const EtcPalRbTree* self, EtcPalRbNode* node);
+static RCLlrpManagerNetintInfo*  get_manager_netint(RCLlrpManager* manager, const EtcPalMcastNetintId* id);
+static RCLlrpManagerProbeRange*  find_probe_range(RCLlrpManager* manager, const RdmUid* uid);
+static DiscoveredTargetInternal* find_discovered_target(RCLlrpManager*    manager,
+                                                        const RdmUid*     uid,
+                                                        const EtcPalUuid* cid);
+static RdmUid                    uid_after(const RdmUid* uid);
+static EtcPalRbNode*             discovered_target_node_alloc(void);
+static void                      discovered_target_node_dealloc(EtcPalRbNode* node);
+static int  discovered_target_compare(const EtcPalRbTree* self, const void* value_a, const void* value_b);
+static void discovered_target_clear_cb(const EtcPalRbTree* self, EtcPalRbNode* node);
 static RCLlrpManager* find_manager_by_message_keys(const RCRefList* list, const RCLlrpManagerKeys* keys);
 
 /*************************** Function definitions ****************************/
@@ -125,18 +187,32 @@ etcpal_error_t rc_llrp_manager_register(RCLlrpManager* manager)
   if (!rc_ref_list_add_ref(&managers.pending, manager))
     return kEtcPalErrNoMem;
 
-  etcpal_error_t res = get_manager_sockets(manager);
+  if (!INIT_PROBE_RANGES(manager))
+  {
+    rc_ref_list_remove_ref(&managers.pending, manager);
+    return kEtcPalErrNoMem;
+  }
+
+  if (!INIT_TRANSACTIONS(manager))
+  {
+    DEINIT_PROBE_RANGES(manager);
+    rc_ref_list_remove_ref(&managers.pending, manager);
+    return kEtcPalErrNoMem;
+  }
+
+  etcpal_error_t res = setup_manager_netints(manager);
   if (res != kEtcPalErrOk)
   {
+    DEINIT_TRANSACTIONS(manager);
+    DEINIT_PROBE_RANGES(manager);
     rc_ref_list_remove_ref(&managers.pending, manager);
     return res;
   }
 
   manager->transaction_number = 0;
   manager->discovery_active = false;
-  manager->response_received_since_last_probe = false;
-  manager->num_clean_sends = 0;
   manager->disc_filter = 0;
+  manager->num_outstanding_probes = 0;
   manager->num_known_uids = 0;
   etcpal_rbtree_init(&manager->discovered_targets, discovered_target_compare, discovered_target_node_alloc,
                      discovered_target_node_dealloc);
@@ -156,21 +232,26 @@ etcpal_error_t rc_llrp_manager_start_discovery(RCLlrpManager* manager, uint16_t
 
   if (!manager->discovery_active)
   {
-    manager->cur_range_low.manu = 0;
-    manager->cur_range_low.id = 0;
-    manager->cur_range_high = kRdmBroadcastUid;
-    manager->response_received_since_last_probe = false;
-    manager->num_clean_sends = 0;
-    manager->discovery_active = true;
+    // Forget the results of the previous discovery.
+    etcpal_rbtree_clear_with_cb(&manager->discovered_targets, discovered_target_clear_cb);
+    manager->num_probe_ranges = 0;
+    manager->num_outstanding_probes = 0;
     manager->disc_filter = filter;
 
-    if (send_next_probe(manager))
+    // Discovery starts with a single range covering the whole UID space, which is split up as
+    // targets are discovered in it.
+    RdmUid range_low = {0, 0};
+    if (!add_probe_range(manager, &range_low, &kRdmBroadcastUid))
+      return kEtcPalErrNoMem;
+
+    manager->discovery_active = true;
+    if (send_range_probe(manager, 0))
     {
       return kEtcPalErrOk;
     }
     else
     {
-      manager->discovery_active = false;
+      end_discovery(manager);
       return kEtcPalErrSys;
     }
   }
@@ -186,8 +267,7 @@ etcpal_error_t rc_llrp_manager_stop_discovery(RCLlrpManager* manager)
 
   if (manager->discovery_active)
   {
-    etcpal_rbtree_clear_with_cb(&manager->discovered_targets, discovered_target_clear_cb);
-    manager->discovery_active = false;
+    end_discovery(manager);
     return kEtcPalErrOk;
   }
   else
@@ -204,6 +284,13 @@ etcpal_error_t rc_llrp_manager_send_rdm_command(RCLlrpManager*             manag
                                                 uint8_t                    data_len,
                                                 uint32_t*                  seq_num)
 {
+  if (count_transactions_to_target(manager, &destination->dest_cid) >= RDMNET_LLRP_MANAGER_MAX_COMMANDS_PER_TARGET)
+    return kEtcPalErrBusy;
+  if (!CHECK_TRANSACTIONS_CAPACITY(manager, 1))
+    return kEtcPalErrNoMem;
+
+  RCLlrpManagerTransaction* transaction = &manager->transactions[manager->num_transactions];
+
   RdmCommandHeader rdm_header;
   rdm_header.source_uid = manager->uid;
   rdm_header.dest_uid = destination->dest_uid;
@@ -213,19 +300,26 @@ etcpal_error_t rc_llrp_manager_send_rdm_command(RCLlrpManager*             manag
   rdm_header.command_class = (rdm_command_class_t)command_class;
   rdm_header.param_id = param_id;
 
-  RdmBuffer      cmd_buf;
-  etcpal_error_t res = rdm_pack_command(&rdm_header, data, data_len, &cmd_buf);
+  etcpal_error_t res = rdm_pack_command(&rdm_header, data, data_len, &transaction->command);
   if (res == kEtcPalErrOk)
   {
-    LlrpHeader header;
-    header.dest_cid = destination->dest_cid;
-    header.sender_cid = manager->cid;
-    header.transaction_number = manager->transaction_number;
-
-    res = rc_send_llrp_rdm_command(manager->send_sock, manager->send_buf, (manager->netint.ip_type == kEtcPalIpTypeV6),
-                                   &header, &cmd_buf);
-    if (res == kEtcPalErrOk && seq_num)
-      *seq_num = manager->transaction_number++;
+    transaction->destination = *destination;
+    transaction->transaction_number = manager->transaction_number;
+    transaction->num_retries = 0;
+    transaction->netint_index = 0;
+
+    res = send_transaction(manager, transaction);
+    while (res != kEtcPalErrOk && next_transaction_netint(manager, transaction))
+      res = send_transaction(manager, transaction);
+    if (res == kEtcPalErrOk)
+    {
+      // The command is tracked until a response is received or it times out.
+      etcpal_timer_start(&transaction->timer, LLRP_TIMEOUT_MS);
+      ++manager->num_transactions;
+      if (seq_num)
+        *seq_num = manager->transaction_number;
+      ++manager->transaction_number;
+    }
   }
   return res;
 }
@@ -266,7 +360,7 @@ void rc_llrp_manager_data_received(const uint8_t* data, size_t data_len, const E
 
       if (rc_parse_llrp_message(data, data_len, &interest, &msg))
       {
-        handle_llrp_message(manager, &msg, &event);
+        handle_llrp_message(manager, &msg, netint, &event);
         deliver_event_callback(manager, &event);
       }
     }
@@ -280,22 +374,77 @@ void rc_llrp_manager_data_received(const uint8_t* data, size_t data_len, const E
   }
 }
 
-etcpal_error_t get_manager_sockets(RCLlrpManager* manager)
+etcpal_error_t setup_manager_netints(RCLlrpManager* manager)
+{
+  if (manager->netint.ip_type != kEtcPalIpTypeInvalid)
+  {
+    if (!INIT_MANAGER_NETINTS(manager, 1))
+      return kEtcPalErrNoMem;
+
+    etcpal_error_t res = setup_manager_netint(&manager->netint, &manager->netints[0]);
+    if (res == kEtcPalErrOk)
+      manager->num_netints = 1;
+    else
+      DEINIT_MANAGER_NETINTS(manager);
+    return res;
+  }
+
+  // The manager operates on all of the multicast network interfaces.
+  const EtcPalMcastNetintId* mcast_netint_arr;
+  size_t                     mcast_netint_arr_size = rc_mcast_get_netint_array(&mcast_netint_arr);
+  if (mcast_netint_arr_size == 0)
+    return kEtcPalErrNoNetints;
+  if (!INIT_MANAGER_NETINTS(manager, mcast_netint_arr_size))
+    return kEtcPalErrNoMem;
+
+  for (const EtcPalMcastNetintId* netint_id = mcast_netint_arr; netint_id < mcast_netint_arr + mcast_netint_arr_size;
+       ++netint_id)
+  {
+    // Failing to initialize on one network interface is non-fatal; we will log it.
+    etcpal_error_t res = setup_manager_netint(netint_id, &manager->netints[manager->num_netints]);
+    if (res == kEtcPalErrOk)
+    {
+      ++manager->num_netints;
+    }
+    else
+    {
+      RDMNET_LOG_WARNING("Failed to initialize LLRP manager on network interface index %u: '%s'", netint_id->index,
+                         etcpal_strerror(res));
+    }
+  }
+
+  if (manager->num_netints == 0)
+  {
+    DEINIT_MANAGER_NETINTS(manager);
+    return kEtcPalErrNoNetints;
+  }
+  return kEtcPalErrOk;
+}
+
+etcpal_error_t setup_manager_netint(const EtcPalMcastNetintId* netint_id, RCLlrpManagerNetintInfo* netint)
 {
-  etcpal_error_t res = rc_mcast_get_send_socket(&manager->netint, 0, &manager->send_sock);
+  netint->id = *netint_id;
+
+  etcpal_error_t res = rc_mcast_get_send_socket(netint_id, 0, &netint->send_sock);
   if (res == kEtcPalErrOk)
   {
-    res = rc_llrp_recv_netint_add(&manager->netint, kLlrpSocketTypeManager);
+    res = rc_llrp_recv_netint_add(netint_id, kLlrpSocketTypeManager);
     if (res != kEtcPalErrOk)
-      rc_mcast_release_send_socket(&manager->netint, 0);
+      rc_mcast_release_send_socket(netint_id, 0);
   }
   return res;
 }
 
-void release_manager_sockets(RCLlrpManager* manager)
+void cleanup_manager_netints(RCLlrpManager* manager)
 {
-  rc_llrp_recv_netint_remove(&manager->netint, kLlrpSocketTypeManager);
-  rc_mcast_release_send_socket(&manager->netint, 0);
+  for (const RCLlrpManagerNetintInfo* netint = manager->netints; netint < manager->netints + manager->num_netints;
+       ++netint)
+  {
+    rc_llrp_recv_netint_remove(&netint->id, kLlrpSocketTypeManager);
+    rc_mcast_release_send_socket(&netint->id, 0);
+  }
+  manager->num_netints = 0;
+  DEINIT_MANAGER_NETINTS(manager);
 }
 
 void cleanup_manager_resources(RCLlrpManager* manager, const void* context)
@@ -303,11 +452,10 @@ void cleanup_manager_resources(RCLlrpManager* manager, const void* context)
   ETCPAL_UNUSED_ARG(context);
   RDMNET_ASSERT(manager);
 
-  release_manager_sockets(manager);
-  if (manager->discovery_active)
-  {
-    etcpal_rbtree_clear_with_cb(&manager->discovered_targets, discovered_target_clear_cb);
-  }
+  cleanup_manager_netints(manager);
+  etcpal_rbtree_clear_with_cb(&manager->discovered_targets, discovered_target_clear_cb);
+  DEINIT_PROBE_RANGES(manager);
+  DEINIT_TRANSACTIONS(manager);
   if (manager->callbacks.destroyed)
     manager->callbacks.destroyed(manager);
 }
@@ -318,131 +466,326 @@ void process_manager_state(RCLlrpManager* manager, const void* context)
   if (MANAGER_LOCK(manager))
   {
     RCLlrpManagerEvent event = RC_LLRP_MANAGER_EVENT_INIT;
+    TimedOutCommand    timed_out[MAX_TIMEOUTS_PER_TICK];
+    size_t             num_timed_out = process_transactions(manager, timed_out);
 
     if (manager->discovery_active)
     {
-      if (etcpal_timer_is_expired(&manager->disc_timer))
+      // Update the ranges whose probe requests have timed out.
+      size_t i = 0;
+      while (i < manager->num_probe_ranges)
       {
-        if (manager->response_received_since_last_probe)
+        RCLlrpManagerProbeRange* range = &manager->probe_ranges[i];
+        if (range->probe_outstanding && etcpal_timer_is_expired(&range->probe_timer))
         {
-          manager->response_received_since_last_probe = false;
-          manager->num_clean_sends = 0;
-        }
-        else
-        {
-          ++manager->num_clean_sends;
+          range->probe_outstanding = false;
+          --manager->num_outstanding_probes;
+          if (!update_probe_range(range))
+          {
+            remove_probe_range(manager, i);
+            continue;
+          }
         }
+        ++i;
+      }
 
-        if (!send_next_probe(manager))
-        {
-          event.which = kRCLlrpManagerEventDiscoveryFinished;
-          etcpal_rbtree_clear_with_cb(&manager->discovered_targets, discovered_target_clear_cb);
-          manager->discovery_active = false;
-        }
+      // Probe as many of the waiting ranges as the limit on outstanding probe requests allows.
+      // Ranges split off while sending are added to the end, so this loop picks them up too.
+      bool send_ok = true;
+      for (i = 0; send_ok && i < manager->num_probe_ranges &&
+                  manager->num_outstanding_probes < RDMNET_LLRP_MANAGER_MAX_OUTSTANDING_PROBES;
+           ++i)
+      {
+        if (!manager->probe_ranges[i].probe_outstanding)
+          send_ok = send_range_probe(manager, i);
+      }
+
+      if (!send_ok || manager->num_probe_ranges == 0)
+      {
+        // We are done with discovery.
+        event.which = kRCLlrpManagerEventDiscoveryFinished;
+        end_discovery(manager);
       }
     }
     MANAGER_UNLOCK(manager);
+
     deliver_event_callback(manager, &event);
+    if (manager->callbacks.rdm_command_timed_out)
+    {
+      for (const TimedOutCommand* command = timed_out; command < timed_out + num_timed_out; ++command)
+        manager->callbacks.rdm_command_timed_out(manager, &command->destination, command->seq_num);
+    }
   }
 }
 
-bool send_next_probe(RCLlrpManager* manager)
+// Update a range after its probe request has timed out. Returns false if the range has been
+// completely discovered.
+bool update_probe_range(RCLlrpManagerProbeRange* range)
 {
-  if (update_probe_range(manager))
+  if (range->response_received_since_last_probe)
+  {
+    range->response_received_since_last_probe = false;
+    range->num_clean_sends = 0;
+  }
+  else
+  {
+    ++range->num_clean_sends;
+  }
+
+  if (range->num_clean_sends >= 3)
   {
-    LlrpHeader header;
-    header.sender_cid = manager->cid;
-    header.dest_cid = *kLlrpBroadcastCid;
-    header.transaction_number = manager->transaction_number++;
+    // We are finished with the current probe range.
+    if (RDM_UID_EQUAL(&range->high, &range->end))
+      return false;
 
-    LocalProbeRequest request;
-    request.filter = manager->disc_filter;
-    request.lower_uid = manager->cur_range_low;
-    request.upper_uid = manager->cur_range_high;
-    request.known_uids = manager->known_uids;
-    request.num_known_uids = manager->num_known_uids;
+    // The new probe range starts at the old upper limit + 1, and ends at the end of the range.
+    range->low = uid_after(&range->high);
+    range->high = range->end;
+    range->num_clean_sends = 0;
+  }
+  return true;
+}
 
-    etcpal_error_t send_res = rc_send_llrp_probe_request(
-        manager->send_sock, manager->send_buf, (manager->netint.ip_type == kEtcPalIpTypeV6), &header, &request);
+bool send_range_probe(RCLlrpManager* manager, size_t range_index)
+{
+  // This can add ranges, so the range is looked up afterwards.
+  update_known_uids(manager, range_index);
+  RCLlrpManagerProbeRange* range = &manager->probe_ranges[range_index];
+
+  LlrpHeader header;
+  header.sender_cid = manager->cid;
+  header.dest_cid = *kLlrpBroadcastCid;
+  header.transaction_number = manager->transaction_number++;
+
+  LocalProbeRequest request;
+  request.filter = manager->disc_filter;
+  request.lower_uid = range->low;
+  request.upper_uid = range->high;
+  request.known_uids = manager->known_uids;
+  request.num_known_uids = manager->num_known_uids;
+
+  bool sent = false;
+  for (const RCLlrpManagerNetintInfo* netint = manager->netints; netint < manager->netints + manager->num_netints;
+       ++netint)
+  {
+    etcpal_error_t send_res = rc_send_llrp_probe_request(netint->send_sock, manager->send_buf,
+                                                         (netint->id.ip_type == kEtcPalIpTypeV6), &header, &request);
     if (send_res == kEtcPalErrOk)
     {
-      etcpal_timer_start(&manager->disc_timer, LLRP_TIMEOUT_MS);
-      return true;
+      sent = true;
     }
     else
     {
-      RDMNET_LOG_WARNING("Sending LLRP probe request failed with error: '%s'", etcpal_strerror(send_res));
-      return false;
+      RDMNET_LOG_WARNING("Sending LLRP probe request on network interface index %u failed with error: '%s'",
+                         netint->id.index, etcpal_strerror(send_res));
     }
   }
-  else
+
+  if (sent)
   {
-    // We are done with discovery.
-    return false;
+    range->probe_outstanding = true;
+    ++manager->num_outstanding_probes;
+    etcpal_timer_start(&range->probe_timer, LLRP_TIMEOUT_MS);
   }
+  return sent;
 }
 
-bool update_probe_range(RCLlrpManager* manager)
+// Determine which known UIDs are in a range's next probe request. If there are too many, the range
+// is split where they are densest.
+void update_known_uids(RCLlrpManager* manager, size_t range_index)
 {
-  if (manager->num_clean_sends >= 3)
+  RCLlrpManagerProbeRange* range = &manager->probe_ranges[range_index];
+  manager->num_known_uids = 0;
+
+  // Start at the first target in the range rather than walking every target below it.
+  DiscoveredTargetInternal range_low;
+  range_low.uid = range->low;
+
+  EtcPalRbIter iter;
+  etcpal_rbiter_init(&iter);
+  DiscoveredTargetInternal* cur_target =
+      (DiscoveredTargetInternal*)etcpal_rbiter_lower_bound(&iter, &manager->discovered_targets, &range_low);
+  while (cur_target && (rdm_uid_compare(&cur_target->uid, &range->high) <= 0))
   {
-    // We are finished with a range; move on to the next range.
-    if (RDM_UID_IS_BROADCAST(&manager->cur_range_high))
+    if (manager->num_known_uids < LLRP_KNOWN_UID_SIZE)
     {
-      // We're done with discovery.
-      return false;
+      manager->known_uids[manager->num_known_uids++] = cur_target->uid;
     }
     else
     {
-      // The new range starts at the old upper limit + 1, and ends at the top of the UID space.
-      if (manager->cur_range_high.id == 0xffffffffu)
-      {
-        manager->cur_range_low.manu = (uint16_t)(manager->cur_range_high.manu + 1u);
-        manager->cur_range_low.id = 0;
-      }
-      else
+      // Put the high point of the probe range in the middle of the list of Known UIDs. The rest
+      // of the range is split off to be discovered alongside this one if there is room;
+      // otherwise, this range moves on to it once the current probe range is finished.
+      RdmUid new_high = manager->known_uids[(LLRP_KNOWN_UID_SIZE / 2) - 1];
+      RdmUid rest_low = uid_after(&new_high);
+      RdmUid rest_end = range->end;
+      if (add_probe_range(manager, &rest_low, &rest_end))
       {
-        manager->cur_range_low.manu = manager->cur_range_high.manu;
-        manager->cur_range_low.id = (uint32_t)(manager->cur_range_high.id + 1u);
+        range = &manager->probe_ranges[range_index];
+        range->end = new_high;
       }
-      manager->cur_range_high = kRdmBroadcastUid;
-      manager->num_clean_sends = 0;
+      range->high = new_high;
+      manager->num_known_uids = LLRP_KNOWN_UID_SIZE / 2;
+      break;
     }
+    cur_target = (DiscoveredTargetInternal*)etcpal_rbiter_next(&iter);
   }
+}
 
-  // Determine how many known UIDs are in the current range
-  manager->num_known_uids = 0;
+bool add_probe_range(RCLlrpManager* manager, const RdmUid* low, const RdmUid* end)
+{
+  if (!CHECK_PROBE_RANGES_CAPACITY(manager, 1))
+    return false;
 
-  EtcPalRbIter iter;
-  etcpal_rbiter_init(&iter);
-  DiscoveredTargetInternal* cur_target =
-      (DiscoveredTargetInternal*)etcpal_rbiter_first(&iter, &manager->discovered_targets);
-  while (cur_target && (rdm_uid_compare(&cur_target->uid, &manager->cur_range_high) <= 0))
+  RCLlrpManagerProbeRange* range = &manager->probe_ranges[manager->num_probe_ranges++];
+  range->low = *low;
+  range->high = *end;
+  range->end = *end;
+  range->probe_outstanding = false;
+  range->response_received_since_last_probe = false;
+  range->num_clean_sends = 0;
+  return true;
+}
+
+void remove_probe_range(RCLlrpManager* manager, size_t range_index)
+{
+  if (manager->probe_ranges[range_index].probe_outstanding)
+    --manager->num_outstanding_probes;
+
+  // Keep the ranges in order, so that the ones which have been waiting longest are probed first.
+  memmove(&manager->probe_ranges[range_index], &manager->probe_ranges[range_index + 1],
+          (manager->num_probe_ranges - range_index - 1) * sizeof(RCLlrpManagerProbeRange));
+  --manager->num_probe_ranges;
+}
+
+// The discovered targets are kept until the next discovery starts, so that RDM commands can be
+// sent on the network interface each target was discovered on.
+void end_discovery(RCLlrpManager* manager)
+{
+  manager->discovery_active = false;
+  manager->num_probe_ranges = 0;
+  manager->num_outstanding_probes = 0;
+}
+
+etcpal_error_t send_transaction(RCLlrpManager* manager, const RCLlrpManagerTransaction* transaction)
+{
+  LlrpHeader header;
+  header.dest_cid = transaction->destination.dest_cid;
+  header.sender_cid = manager->cid;
+  header.transaction_number = transaction->transaction_number;
+
+  // Send the command on the network interface the target was discovered on. If it hasn't been
+  // discovered, send it on one network interface at a time, so that a target reachable on more than
+  // one of them doesn't execute the command more than once.
+  const DiscoveredTargetInternal* target =
+      find_discovered_target(manager, &transaction->destination.dest_uid, &transaction->destination.dest_cid);
+
+  const RCLlrpManagerNetintInfo* netint = NULL;
+  if (target)
+    netint = get_manager_netint(manager, &target->netint);
+  else if (transaction->netint_index < manager->num_netints)
+    netint = &manager->netints[transaction->netint_index];
+
+  if (!netint)
+    return kEtcPalErrNotFound;
+
+  return rc_send_llrp_rdm_command(netint->send_sock, manager->send_buf, (netint->id.ip_type == kEtcPalIpTypeV6),
+                                  &header, &transaction->command);
+}
+
+// Move a command to a target which hasn't been discovered on to the next network interface.
+// Returns false if the target has been discovered or there are no network interfaces left to try.
+bool next_transaction_netint(RCLlrpManager* manager, RCLlrpManagerTransaction* transaction)
+{
+  if (find_discovered_target(manager, &transaction->destination.dest_uid, &transaction->destination.dest_cid))
+    return false;
+  if (transaction->netint_index + 1 >= manager->num_netints)
+    return false;
+
+  ++transaction->netint_index;
+  return true;
+}
+
+// Retransmit the RDM commands whose responses are overdue, and remove the ones which have run out
+// of retries. Returns the number of commands copied to timed_out, which must have room for
+// MAX_TIMEOUTS_PER_TICK commands.
+size_t process_transactions(RCLlrpManager* manager, TimedOutCommand* timed_out)
+{
+  size_t                    num_timed_out = 0;
+  RCLlrpManagerTransaction* transaction = manager->transactions;
+  while (transaction < manager->transactions + manager->num_transactions)
   {
-    if (manager->num_known_uids != 0)
+    if (etcpal_timer_is_expired(&transaction->timer))
     {
-      if (manager->num_known_uids + 1 <= LLRP_KNOWN_UID_SIZE)
+      if (transaction->num_retries < RDMNET_LLRP_MANAGER_RDM_COMMAND_RETRIES)
       {
-        manager->known_uids[manager->num_known_uids++] = cur_target->uid;
+        // A failed retransmission counts against the retries like a lost one.
+        ++transaction->num_retries;
+        send_transaction(manager, transaction);
+        etcpal_timer_start(&transaction->timer, LLRP_TIMEOUT_MS);
       }
-      else
+      else if (next_transaction_netint(manager, transaction))
       {
-        // Put the high point of the current range in the middle of the list of Known UIDs.
-        manager->cur_range_high = manager->known_uids[(LLRP_KNOWN_UID_SIZE / 2) - 1];
-        manager->num_known_uids = LLRP_KNOWN_UID_SIZE / 2;
-        break;
+        // The target hasn't been discovered and didn't answer on this network interface; start over
+        // on the next one.
+        transaction->num_retries = 0;
+        send_transaction(manager, transaction);
+        etcpal_timer_start(&transaction->timer, LLRP_TIMEOUT_MS);
+      }
+      else if (num_timed_out < MAX_TIMEOUTS_PER_TICK)
+      {
+        timed_out[num_timed_out].destination = transaction->destination;
+        timed_out[num_timed_out].seq_num = transaction->transaction_number;
+        ++num_timed_out;
+        remove_transaction(manager, transaction);
+        continue;
       }
     }
-    else if (rdm_uid_compare(&cur_target->uid, &manager->cur_range_low) >= 0)
+    ++transaction;
+  }
+  return num_timed_out;
+}
+
+size_t count_transactions_to_target(const RCLlrpManager* manager, const EtcPalUuid* target_cid)
+{
+  size_t count = 0;
+  for (const RCLlrpManagerTransaction* transaction = manager->transactions;
+       transaction < manager->transactions + manager->num_transactions; ++transaction)
+  {
+    if (ETCPAL_UUID_CMP(&transaction->destination.dest_cid, target_cid) == 0)
+      ++count;
+  }
+  return count;
+}
+
+RCLlrpManagerTransaction* find_transaction(RCLlrpManager*    manager,
+                                           uint32_t          transaction_number,
+                                           const EtcPalUuid* target_cid)
+{
+  for (RCLlrpManagerTransaction* transaction = manager->transactions;
+       transaction < manager->transactions + manager->num_transactions; ++transaction)
+  {
+    if (transaction->transaction_number == transaction_number &&
+        ETCPAL_UUID_CMP(&transaction->destination.dest_cid, target_cid) == 0)
     {
-      manager->known_uids[manager->num_known_uids++] = cur_target->uid;
+      return transaction;
     }
-    cur_target = (DiscoveredTargetInternal*)etcpal_rbiter_next(&iter);
   }
-  return true;
+  return NULL;
+}
+
+void remove_transaction(RCLlrpManager* manager, RCLlrpManagerTransaction* transaction)
+{
+  // Keep the transactions in the order they were sent, so that they time out in that order.
+  size_t index = (size_t)(transaction - manager->transactions);
+  memmove(transaction, transaction + 1, (manager->num_transactions - index - 1) * sizeof(RCLlrpManagerTransaction));
+  --manager->num_transactions;
 }
 
-void handle_llrp_message(RCLlrpManager* manager, const LlrpMessage* msg, RCLlrpManagerEvent* event)
+void handle_llrp_message(RCLlrpManager*             manager,
+                         const LlrpMessage*         msg,
+                         const EtcPalMcastNetintId* netint,
+                         RCLlrpManagerEvent*        event)
 {
   if (MANAGER_LOCK(manager))
   {
@@ -453,13 +796,16 @@ void handle_llrp_message(RCLlrpManager* manager, const LlrpMessage* msg, RCLlrpM
 
         if (manager->discovery_active && (ETCPAL_UUID_CMP(&msg->header.dest_cid, &manager->cid) == 0))
         {
-          manager->response_received_since_last_probe = true;
+          RCLlrpManagerProbeRange* range = find_probe_range(manager, &target->uid);
+          if (range)
+            range->response_received_since_last_probe = true;
 
           DiscoveredTargetInternal* new_target = (DiscoveredTargetInternal*)malloc(sizeof(DiscoveredTargetInternal));
           if (new_target)
           {
             new_target->uid = target->uid;
             new_target->cid = msg->header.sender_cid;
+            new_target->netint = *netint;
             new_target->next = NULL;
 
             DiscoveredTargetInternal* found =
@@ -503,10 +849,22 @@ void handle_llrp_message(RCLlrpManager* manager, const LlrpMessage* msg, RCLlrpM
         break;
       }
       case VECTOR_LLRP_RDM_CMD: {
+        // Responses which don't match a command in flight are duplicates, or arrived after the
+        // command timed out.
+        RCLlrpManagerTransaction* transaction =
+            find_transaction(manager, msg->header.transaction_number, &msg->header.sender_cid);
+        if (!transaction)
+        {
+          RDMNET_LOG_DEBUG("Ignoring LLRP RDM response with unknown transaction number %u",
+                           (unsigned int)msg->header.transaction_number);
+          break;
+        }
+
         LlrpRdmResponse* resp = &event->args.rdm_response;
         if (kEtcPalErrOk ==
             rdm_unpack_response(LLRP_MSG_GET_RDM(msg), &resp->rdm_header, &resp->rdm_data, &resp->rdm_data_len))
         {
+          remove_transaction(manager, transaction);
           resp->seq_num = msg->header.transaction_number;
           resp->source_cid = msg->header.sender_cid;
           event->which = kRCLlrpManagerEventRdmRespReceived;
@@ -540,6 +898,60 @@ void deliver_event_callback(RCLlrpManager* manager, RCLlrpManagerEvent* event)
   }
 }
 
+RCLlrpManagerNetintInfo* get_manager_netint(RCLlrpManager* manager, const EtcPalMcastNetintId* id)
+{
+  RDMNET_ASSERT(manager);
+  RDMNET_ASSERT(id);
+
+  for (RCLlrpManagerNetintInfo* netint = manager->netints; netint < manager->netints + manager->num_netints; ++netint)
+  {
+    if (NETINT_IDS_EQUAL(&netint->id, id))
+      return netint;
+  }
+  return NULL;
+}
+
+// Find the range whose current probe request covers a UID.
+RCLlrpManagerProbeRange* find_probe_range(RCLlrpManager* manager, const RdmUid* uid)
+{
+  for (RCLlrpManagerProbeRange* range = manager->probe_ranges;
+       range < manager->probe_ranges + manager->num_probe_ranges; ++range)
+  {
+    if (rdm_uid_compare(uid, &range->low) >= 0 && rdm_uid_compare(uid, &range->high) <= 0)
+      return range;
+  }
+  return NULL;
+}
+
+DiscoveredTargetInternal* find_discovered_target(RCLlrpManager* manager, const RdmUid* uid, const EtcPalUuid* cid)
+{
+  DiscoveredTargetInternal to_find;
+  to_find.uid = *uid;
+
+  DiscoveredTargetInternal* found =
+      (DiscoveredTargetInternal*)etcpal_rbtree_find(&manager->discovered_targets, &to_find);
+  while (found && ETCPAL_UUID_CMP(&found->cid, cid) != 0)
+    found = found->next;
+  return found;
+}
+
+// The UID which follows uid, which must not be the highest UID.
+RdmUid uid_after(const RdmUid* uid)
+{
+  RdmUid next;
+  if (uid->id == 0xffffffffu)
+  {
+    next.manu = (uint16_t)(uid->manu + 1u);
+    next.id = 0;
+  }
+  else
+  {
+    next.manu = uid->manu;
+    next.id = (uint32_t)(uid->id + 1u);
+  }
+  return next;
+}
+
 EtcPalRbNode* discovered_target_node_alloc(void)
 {
 #if RDMNET_DYNAMIC_MEM
@@ -587,8 +999,7 @@ static bool cid_and_netint_equal_predicate(void* ref, const void* context)
   RCLlrpManager*           manager = (RCLlrpManager*)ref;
   const RCLlrpManagerKeys* keys = (const RCLlrpManagerKeys*)context;
 
-  return ((manager->netint.ip_type == keys->netint->ip_type) && (manager->netint.index == keys->netint->index) &&
-          (ETCPAL_UUID_CMP(&manager->cid, &keys->cid) == 0));
+  return ((ETCPAL_UUID_CMP(&manager->cid, &keys->cid) == 0) && get_manager_netint(manager, keys->netint));
 }
 
 RCLlrpManager* find_manager_by_message_keys(const RCRefList* list, const RCLlrpManagerKeys* keys)
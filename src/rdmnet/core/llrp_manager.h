@@ -29,6 +29,7 @@
 #include "rdmnet/llrp.h"
 #include "rdmnet/message.h"
 #include "rdmnet/core/llrp_prot.h"
+#include "rdmnet/core/util.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -45,6 +46,11 @@ typedef void (*RCLlrpManagerRdmResponseReceivedCallback)(RCLlrpManager* manager,
 // The previously-started LLRP discovery process has finished.
 typedef void (*RCLlrpManagerDiscoveryFinishedCallback)(RCLlrpManager* manager);
 
+// No response was received to an RDM command, including its retransmissions.
+typedef void (*RCLlrpManagerRdmCommandTimedOutCallback)(RCLlrpManager*             manager,
+                                                        const LlrpDestinationAddr* destination,
+                                                        uint32_t                   seq_num);
+
 // An LLRP manager has been destroyed and unregistered. This is called from the background thread,
 // after the resources associated with the LLRP manager (e.g. sockets) have been cleaned up.
 typedef void (*RCLlrpManagerDestroyedCallback)(RCLlrpManager* manager);
@@ -54,35 +60,76 @@ typedef struct RCLlrpManagerCallbacks
   RCLlrpManagerTargetDiscoveredCallback    target_discovered;
   RCLlrpManagerRdmResponseReceivedCallback rdm_response_received;
   RCLlrpManagerDiscoveryFinishedCallback   discovery_finished;
+  RCLlrpManagerRdmCommandTimedOutCallback  rdm_command_timed_out;
   RCLlrpManagerDestroyedCallback           destroyed;
 } RCLlrpManagerCallbacks;
 
+typedef struct RCLlrpManagerNetintInfo
+{
+  EtcPalMcastNetintId id;
+  etcpal_socket_t     send_sock;
+} RCLlrpManagerNetintInfo;
+
+// A part of the UID space which is being discovered independently of the others.
+typedef struct RCLlrpManagerProbeRange
+{
+  // The range of the current probe request.
+  RdmUid low;
+  RdmUid high;
+  // The last UID this range is responsible for. high is lowered below end when there are too many
+  // known UIDs to probe the whole range at once and it can't be split.
+  RdmUid end;
+
+  bool         probe_outstanding;
+  bool         response_received_since_last_probe;
+  unsigned int num_clean_sends;
+  EtcPalTimer  probe_timer;
+} RCLlrpManagerProbeRange;
+
+#define RC_LLRP_MANAGER_MAX_PROBE_RANGES (RDMNET_LLRP_MANAGER_MAX_OUTSTANDING_PROBES * 2)
+
+// An RDM command which has been sent and is waiting for a response.
+typedef struct RCLlrpManagerTransaction
+{
+  LlrpDestinationAddr destination;
+  uint32_t            transaction_number;
+  // Kept to be retransmitted if no response is received in time.
+  RdmBuffer    command;
+  unsigned int num_retries;
+  EtcPalTimer  timer;
+  // If the target hasn't been discovered, the index in netints of the one network interface the
+  // command is being tried on.
+  size_t netint_index;
+} RCLlrpManagerTransaction;
+
+#define RC_LLRP_MANAGER_MAX_TRANSACTIONS (RDMNET_LLRP_MANAGER_MAX_COMMANDS_PER_TARGET * 8)
+
 struct RCLlrpManager
 {
   /////////////////////////////////////////////////////////////////////////////
   // Fill this in before initialization.
-  EtcPalUuid             cid;
-  RdmUid                 uid;
+  EtcPalUuid cid;
+  RdmUid     uid;
+  // The network interface to operate on. If ip_type is kEtcPalIpTypeInvalid, the manager operates
+  // on all of the network interfaces that RDMnet is using for multicast.
   EtcPalMcastNetintId    netint;
   RCLlrpManagerCallbacks callbacks;
   etcpal_mutex_t*        lock;
 
   // Underlying networking info
-  etcpal_socket_t send_sock;
+  RC_DECLARE_BUF(RCLlrpManagerNetintInfo, netints, RDMNET_MAX_MCAST_NETINTS);
 
   // Send tracking
   uint8_t  send_buf[LLRP_MANAGER_MAX_MESSAGE_SIZE];
   uint32_t transaction_number;
+  RC_DECLARE_BUF(RCLlrpManagerTransaction, transactions, RC_LLRP_MANAGER_MAX_TRANSACTIONS);
 
   // Discovery tracking
   bool         discovery_active;
-  bool         response_received_since_last_probe;
-  unsigned int num_clean_sends;
-  EtcPalTimer  disc_timer;
   uint16_t     disc_filter;
   EtcPalRbTree discovered_targets;
-  RdmUid       cur_range_low;
-  RdmUid       cur_range_high;
+  RC_DECLARE_BUF(RCLlrpManagerProbeRange, probe_ranges, RC_LLRP_MANAGER_MAX_PROBE_RANGES);
+  size_t       num_outstanding_probes;
   RdmUid       known_uids[LLRP_KNOWN_UID_SIZE];
   size_t       num_known_uids;
 };
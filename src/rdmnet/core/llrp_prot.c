@@ -35,17 +35,23 @@
 #define LLRP_MIN_PDU_SIZE (LLRP_HEADER_SIZE + PROBE_REPLY_PDU_SIZE)
 #define LLRP_MIN_TOTAL_MESSAGE_SIZE (ACN_UDP_PREAMBLE_SIZE + ACN_RLP_HEADER_SIZE_EXT_LEN + LLRP_MIN_PDU_SIZE)
 #define LLRP_RDM_CMD_PDU_MIN_SIZE (3 /* Flags + Length */ + RDM_MIN_BYTES)
+#define PACKED_UID_SIZE 6
 
 /*********************** Private function prototypes *************************/
 
+static bool parse_llrp_message(const uint8_t*             buf,
+                               size_t                     buflen,
+                               const LlrpMessageInterest* interest,
+                               LlrpMessage*               msg);
 static bool parse_llrp_pdu(const uint8_t* buf, size_t buflen, const LlrpMessageInterest* interest, LlrpMessage* msg);
-static bool parse_llrp_probe_request(const uint8_t*             buf,
-                                     size_t                     buflen,
-                                     const LlrpMessageInterest* interest,
-                                     RemoteProbeRequest*        request);
+static bool parse_llrp_probe_request(const uint8_t* buf, size_t buflen, RemoteProbeRequest* request);
 static bool parse_llrp_probe_reply(const uint8_t* buf, size_t buflen, LlrpDiscoveredTarget* reply);
 static bool parse_llrp_rdm_command(const uint8_t* buf, size_t buflen, RdmBuffer* cmd);
 
+static bool packed_uids_are_sorted(const uint8_t* uids, size_t num_uids);
+static bool sorted_packed_uids_contain(const uint8_t* uids, size_t num_uids, const uint8_t* packed_uid);
+static bool packed_uids_contain(const uint8_t* uids, size_t num_uids, const uint8_t* packed_uid);
+
 static size_t pack_llrp_header(uint8_t* buf, size_t pdu_len, uint32_t vector, const LlrpHeader* header);
 
 static etcpal_error_t send_llrp_rdm(etcpal_socket_t       sock,
@@ -85,6 +91,84 @@ bool rc_get_llrp_destination_cid(const uint8_t* buf, size_t buflen, EtcPalUuid*
 }
 
 bool rc_parse_llrp_message(const uint8_t* buf, size_t buflen, const LlrpMessageInterest* interest, LlrpMessage* msg)
+{
+  if (!interest)
+    return false;
+  return parse_llrp_message(buf, buflen, interest, msg);
+}
+
+/*
+ * Parse an LLRP message without regard to which local component it is for, so that it can be
+ * parsed once and delivered to any number of components. The destination CID is not checked, and
+ * probe requests are not checked against a UID; use rc_llrp_probe_request_contains_uid() for each
+ * component's UID. msg references buf, which must remain valid for as long as msg is used.
+ */
+bool rc_parse_llrp_message_view(const uint8_t* buf, size_t buflen, LlrpMessage* msg)
+{
+  return parse_llrp_message(buf, buflen, NULL, msg);
+}
+
+/*
+ * Whether a UID is in the range of a received probe request and is not suppressed by its Known UID
+ * list.
+ */
+bool rc_llrp_probe_request_contains_uid(const RemoteProbeRequest* request, const RdmUid* uid)
+{
+  if (!request || !uid)
+    return false;
+
+  // If the UID is not in the range, there is no need to check the Known UIDs.
+  if (rdm_uid_compare(uid, &request->lower_uid) < 0 || rdm_uid_compare(uid, &request->upper_uid) > 0)
+    return false;
+
+  // Packed UIDs are big-endian, so their byte order is the same as their UID order.
+  uint8_t packed_uid[PACKED_UID_SIZE];
+  etcpal_pack_u16b(packed_uid, uid->manu);
+  etcpal_pack_u32b(&packed_uid[2], uid->id);
+
+  if (request->known_uids_sorted)
+    return !sorted_packed_uids_contain(request->known_uids, request->num_known_uids, packed_uid);
+  else
+    return !packed_uids_contain(request->known_uids, request->num_known_uids, packed_uid);
+}
+
+/*
+ * The same as rc_llrp_probe_request_contains_uid(), for checking many UIDs in ascending order
+ * against the same probe request. Rather than searching the Known UID list for each UID, this
+ * walks it alongside the UIDs in a single pass, keeping its position in known_uid_pos, which must
+ * be initialized to 0 before the first UID is checked.
+ */
+bool rc_llrp_probe_request_contains_uid_in_order(const RemoteProbeRequest* request,
+                                                 const RdmUid*             uid,
+                                                 size_t*                   known_uid_pos)
+{
+  if (!request || !uid || !known_uid_pos)
+    return false;
+
+  if (!request->known_uids_sorted)
+    return rc_llrp_probe_request_contains_uid(request, uid);
+
+  if (rdm_uid_compare(uid, &request->lower_uid) < 0 || rdm_uid_compare(uid, &request->upper_uid) > 0)
+    return false;
+
+  uint8_t packed_uid[PACKED_UID_SIZE];
+  etcpal_pack_u16b(packed_uid, uid->manu);
+  etcpal_pack_u32b(&packed_uid[2], uid->id);
+
+  // Skip the Known UIDs which are lower than this one; they are lower than any UID still to come.
+  size_t pos = *known_uid_pos;
+  int    cmp = -1;
+  while (pos < request->num_known_uids &&
+         (cmp = memcmp(&request->known_uids[pos * PACKED_UID_SIZE], packed_uid, PACKED_UID_SIZE)) < 0)
+  {
+    ++pos;
+  }
+  *known_uid_pos = pos;
+  return (pos == request->num_known_uids || cmp != 0);
+}
+
+// If interest is NULL, the message is parsed in full regardless of its destination.
+bool parse_llrp_message(const uint8_t* buf, size_t buflen, const LlrpMessageInterest* interest, LlrpMessage* msg)
 {
   if (!buf || !msg || buflen < LLRP_MIN_TOTAL_MESSAGE_SIZE)
     return false;
@@ -125,44 +209,50 @@ bool parse_llrp_pdu(const uint8_t* buf, size_t buflen, const LlrpMessageInterest
   msg->header.transaction_number = etcpal_unpack_u32b(cur_ptr);
   cur_ptr += 4;
 
+  // Don't parse any further if the message isn't for the caller.
+  if (interest && 0 != ETCPAL_UUID_CMP(&msg->header.dest_cid, kLlrpBroadcastCid) &&
+      0 != ETCPAL_UUID_CMP(&msg->header.dest_cid, &interest->my_cid))
+  {
+    return false;
+  }
+
   // Parse the next layer, based on the vector value and what the caller has registered interest in
-  if (0 == ETCPAL_UUID_CMP(&msg->header.dest_cid, kLlrpBroadcastCid) ||
-      0 == ETCPAL_UUID_CMP(&msg->header.dest_cid, &interest->my_cid))
+  switch (msg->vector)
   {
-    switch (msg->vector)
-    {
-      case VECTOR_LLRP_PROBE_REQUEST:
-        if (interest->interested_in_probe_request)
-        {
-          return parse_llrp_probe_request(cur_ptr, llrp_pdu_len - LLRP_HEADER_SIZE, interest, &msg->data.probe_request);
-        }
-        else
-        {
-          return false;
-        }
-      case VECTOR_LLRP_PROBE_REPLY:
-        if (interest->interested_in_probe_reply)
-        {
-          msg->data.probe_reply.cid = msg->header.sender_cid;
-          return parse_llrp_probe_reply(cur_ptr, llrp_pdu_len - LLRP_HEADER_SIZE, &msg->data.probe_reply);
-        }
-        else
-        {
-          return false;
-        }
-      case VECTOR_LLRP_RDM_CMD:
-        return parse_llrp_rdm_command(cur_ptr, llrp_pdu_len - LLRP_HEADER_SIZE, &msg->data.rdm);
-      default:
+    case VECTOR_LLRP_PROBE_REQUEST:
+      if (!interest)
+      {
+        return parse_llrp_probe_request(cur_ptr, llrp_pdu_len - LLRP_HEADER_SIZE, &msg->data.probe_request);
+      }
+      else if (interest->interested_in_probe_request &&
+               parse_llrp_probe_request(cur_ptr, llrp_pdu_len - LLRP_HEADER_SIZE, &msg->data.probe_request))
+      {
+        msg->data.probe_request.contains_my_uid =
+            rc_llrp_probe_request_contains_uid(&msg->data.probe_request, &interest->my_uid);
+        return true;
+      }
+      else
+      {
         return false;
-    }
+      }
+    case VECTOR_LLRP_PROBE_REPLY:
+      if (!interest || interest->interested_in_probe_reply)
+      {
+        msg->data.probe_reply.cid = msg->header.sender_cid;
+        return parse_llrp_probe_reply(cur_ptr, llrp_pdu_len - LLRP_HEADER_SIZE, &msg->data.probe_reply);
+      }
+      else
+      {
+        return false;
+      }
+    case VECTOR_LLRP_RDM_CMD:
+      return parse_llrp_rdm_command(cur_ptr, llrp_pdu_len - LLRP_HEADER_SIZE, &msg->data.rdm);
+    default:
+      return false;
   }
-  return false;
 }
 
-bool parse_llrp_probe_request(const uint8_t*             buf,
-                              size_t                     buflen,
-                              const LlrpMessageInterest* interest,
-                              RemoteProbeRequest*        request)
+bool parse_llrp_probe_request(const uint8_t* buf, size_t buflen, RemoteProbeRequest* request)
 {
   if (buflen < PROBE_REQUEST_PDU_MIN_SIZE)
     return false;
@@ -172,7 +262,6 @@ bool parse_llrp_probe_request(const uint8_t*             buf,
   size_t         pdu_len = ACN_PDU_LENGTH(cur_ptr);
   if (pdu_len > buflen || pdu_len < PROBE_REQUEST_PDU_MIN_SIZE)
     return false;
-  const uint8_t* buf_end = cur_ptr + pdu_len;
 
   // Fill in the rest of the Probe Request data
   cur_ptr += 3;
@@ -180,48 +269,22 @@ bool parse_llrp_probe_request(const uint8_t*             buf,
   if (vector != VECTOR_PROBE_REQUEST_DATA)
     return false;
 
-  RdmUid lower_uid_bound;
-  lower_uid_bound.manu = etcpal_unpack_u16b(cur_ptr);
+  request->lower_uid.manu = etcpal_unpack_u16b(cur_ptr);
   cur_ptr += 2;
-  lower_uid_bound.id = etcpal_unpack_u32b(cur_ptr);
+  request->lower_uid.id = etcpal_unpack_u32b(cur_ptr);
   cur_ptr += 4;
-
-  RdmUid upper_uid_bound;
-  upper_uid_bound.manu = etcpal_unpack_u16b(cur_ptr);
+  request->upper_uid.manu = etcpal_unpack_u16b(cur_ptr);
   cur_ptr += 2;
-  upper_uid_bound.id = etcpal_unpack_u32b(cur_ptr);
+  request->upper_uid.id = etcpal_unpack_u32b(cur_ptr);
   cur_ptr += 4;
   request->filter = etcpal_unpack_u16b(cur_ptr);
   cur_ptr += 2;
 
-  // If our UID is not in the range, there is no need to check the Known UIDs.
-  if (rdm_uid_compare(&interest->my_uid, &lower_uid_bound) >= 0 &&
-      rdm_uid_compare(&interest->my_uid, &upper_uid_bound) <= 0)
-  {
-    request->contains_my_uid = true;
-
-    // Check the Known UIDs to see if the registered UID is in it.
-    while (cur_ptr + 6 <= buf_end)
-    {
-      RdmUid cur_uid;
-      cur_uid.manu = etcpal_unpack_u16b(cur_ptr);
-      cur_ptr += 2;
-      cur_uid.id = etcpal_unpack_u32b(cur_ptr);
-      cur_ptr += 4;
-
-      if (RDM_UID_EQUAL(&interest->my_uid, &cur_uid))
-      {
-        // The registered uid is suppressed.
-        request->contains_my_uid = false;
-        break;
-      }
-    }
-  }
-  else
-  {
-    request->contains_my_uid = false;
-  }
-
+  // The rest of the PDU is the Known UID list. A partial UID at the end is ignored.
+  request->known_uids = cur_ptr;
+  request->num_known_uids = (pdu_len - PROBE_REQUEST_PDU_MIN_SIZE) / PACKED_UID_SIZE;
+  request->known_uids_sorted = packed_uids_are_sorted(request->known_uids, request->num_known_uids);
+  request->contains_my_uid = false;
   return true;
 }
 
@@ -269,6 +332,44 @@ bool parse_llrp_rdm_command(const uint8_t* buf, size_t buflen, RdmBuffer* cmd)
   return true;
 }
 
+bool packed_uids_are_sorted(const uint8_t* uids, size_t num_uids)
+{
+  for (size_t i = 1; i < num_uids; ++i)
+  {
+    if (memcmp(&uids[(i - 1) * PACKED_UID_SIZE], &uids[i * PACKED_UID_SIZE], PACKED_UID_SIZE) > 0)
+      return false;
+  }
+  return true;
+}
+
+bool sorted_packed_uids_contain(const uint8_t* uids, size_t num_uids, const uint8_t* packed_uid)
+{
+  size_t low = 0;
+  size_t high = num_uids;
+  while (low < high)
+  {
+    size_t mid = low + (high - low) / 2;
+    int    cmp = memcmp(&uids[mid * PACKED_UID_SIZE], packed_uid, PACKED_UID_SIZE);
+    if (cmp == 0)
+      return true;
+    else if (cmp < 0)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  return false;
+}
+
+bool packed_uids_contain(const uint8_t* uids, size_t num_uids, const uint8_t* packed_uid)
+{
+  for (size_t i = 0; i < num_uids; ++i)
+  {
+    if (memcmp(&uids[i * PACKED_UID_SIZE], packed_uid, PACKED_UID_SIZE) == 0)
+      return true;
+  }
+  return false;
+}
+
 size_t pack_llrp_header(uint8_t* buf, size_t pdu_len, uint32_t vector, const LlrpHeader* header)
 {
   uint8_t* cur_ptr = buf;
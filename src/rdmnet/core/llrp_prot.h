@@ -88,9 +88,17 @@ typedef struct LlrpMessageInterest
 typedef struct RemoteProbeRequest
 {
   /* True if this probe request contains my UID as registered in the LlrpMessageInterest struct, and
-   * it is not suppressed by the Known UID list. */
+   * it is not suppressed by the Known UID list. Not filled in by rc_parse_llrp_message_view(). */
   bool     contains_my_uid;
   uint16_t filter;
+  RdmUid   lower_uid;
+  RdmUid   upper_uid;
+  /* The Known UID list, packed as it was received. Points into the buffer that was parsed. */
+  const uint8_t* known_uids;
+  size_t         num_known_uids;
+  /* True if the Known UID list is in ascending order, which allows it to be searched rather than
+   * scanned. Managers are not required to sort it, though this library's manager does. */
+  bool known_uids_sorted;
 } RemoteProbeRequest;
 
 typedef struct LocalProbeRequest
@@ -126,6 +134,11 @@ extern const EtcPalUuid* kLlrpBroadcastCid;
 
 bool rc_get_llrp_destination_cid(const uint8_t* buf, size_t buflen, EtcPalUuid* dest_cid);
 bool rc_parse_llrp_message(const uint8_t* buf, size_t buflen, const LlrpMessageInterest* interest, LlrpMessage* msg);
+bool rc_parse_llrp_message_view(const uint8_t* buf, size_t buflen, LlrpMessage* msg);
+bool rc_llrp_probe_request_contains_uid(const RemoteProbeRequest* request, const RdmUid* uid);
+bool rc_llrp_probe_request_contains_uid_in_order(const RemoteProbeRequest* request,
+                                                 const RdmUid*             uid,
+                                                 size_t*                   known_uid_pos);
 
 etcpal_error_t rc_send_llrp_probe_request(etcpal_socket_t          sock,
                                           uint8_t*                 buf,
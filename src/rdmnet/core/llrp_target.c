@@ -19,7 +19,10 @@
 
 #include "rdmnet/core/llrp_target.h"
 
+#include <stdlib.h>
+#include <string.h>
 #include "etcpal/inet.h"
+#include "etcpal/pack.h"
 #include "rdm/responder.h"
 #include "rdmnet/core/common.h"
 #include "rdmnet/core/mcast.h"
@@ -46,9 +49,11 @@ typedef struct RCLlrpTargetEvent
 
 typedef struct LlrpTargetIncomingMessage
 {
-  const uint8_t*             data;
-  size_t                     data_len;
+  const LlrpMessage*         msg;
   const EtcPalMcastNetintId* netint;
+  // True if the recipient's UID has already been checked against the probe request's range and
+  // Known UIDs.
+  bool probe_uid_checked;
 } LlrpTargetIncomingMessage;
 
 /***************************** Private macros ********************************/
@@ -56,10 +61,30 @@ typedef struct LlrpTargetIncomingMessage
 #define TARGET_LOCK(target_ptr) etcpal_mutex_lock((target_ptr)->lock)
 #define TARGET_UNLOCK(target_ptr) etcpal_mutex_unlock((target_ptr)->lock)
 
+// The CID index is an open-addressed hash table which is kept at most half full.
+#define TARGET_CID_INDEX_SIZE(num_targets) ((num_targets)*2 + 1)
+
 /**************************** Private variables ******************************/
 
 RC_DECLARE_REF_LISTS(targets, RC_MAX_LLRP_TARGETS);
 
+// Indexes of the active targets, rebuilt whenever targets are added or removed. Broadcast probe
+// requests use the UID index to visit only the targets in the requested range, and unicast
+// messages use the CID index to find their target.
+#if RDMNET_DYNAMIC_MEM
+static RCLlrpTarget** targets_by_uid;
+static size_t         targets_by_uid_capacity;
+static RCLlrpTarget** targets_by_cid;
+static size_t         targets_by_cid_capacity;
+#else
+static RCLlrpTarget* targets_by_uid[RC_MAX_LLRP_TARGETS];
+static RCLlrpTarget* targets_by_cid[TARGET_CID_INDEX_SIZE(RC_MAX_LLRP_TARGETS)];
+#endif
+static size_t num_targets_by_uid;
+static size_t targets_by_cid_size;
+// False if the indexes couldn't be allocated; lookups fall back to searching the active list.
+static bool target_indexes_valid;
+
 /*********************** Private function prototypes *************************/
 
 // Target setup and cleanup
@@ -69,12 +94,14 @@ static etcpal_error_t setup_target_netints(RCLlrpTarget*              target,
 static etcpal_error_t setup_target_netint(const EtcPalMcastNetintId* netint_id, RCLlrpTargetNetintInfo* netint);
 static void           cleanup_target_netints(RCLlrpTarget* target);
 static RCLlrpTargetNetintInfo* get_target_netint(RCLlrpTarget* target, const EtcPalMcastNetintId* id);
+static bool                    probe_reply_pending(const RCLlrpTargetNetintInfo* netint, const EtcPalUuid* manager_cid);
 static void                    cleanup_target_resources(RCLlrpTarget* target, const void* context);
 
 // Periodic state processing
 static void process_target_state(RCLlrpTarget* target, const void* context);
 
 // Incoming message handling
+static void           handle_broadcast_probe_request(const LlrpTargetIncomingMessage* message);
 static void           target_handle_llrp_message(RCLlrpTarget* target, const LlrpTargetIncomingMessage* message);
 static void           deliver_event_callback(RCLlrpTarget* target, RCLlrpTargetEvent* event);
 static void           send_response_if_requested(RCLlrpTarget*                target,
@@ -94,8 +121,14 @@ static etcpal_error_t target_send_nack_internal(RCLlrpTarget*              targe
                                                 const EtcPalMcastNetintId* received_netint_id,
                                                 rdm_nack_reason_t          nack_reason);
 
-// Utilities
-static RCLlrpTarget* find_target_by_cid(const RCRefList* list, const EtcPalUuid* cid);
+// Target indexes
+static void          rebuild_target_indexes(void);
+static bool          reserve_target_indexes(size_t num_targets);
+static void          cleanup_target_indexes(void);
+static size_t        cid_index_slot(const EtcPalUuid* cid);
+static int           target_uid_compare(const void* a, const void* b);
+static size_t        first_target_uid_at_or_above(const RdmUid* uid);
+static RCLlrpTarget* find_target_by_cid(const EtcPalUuid* cid);
 
 /*************************** Function definitions ****************************/
 
@@ -119,6 +152,7 @@ void rc_llrp_target_module_deinit(void)
 {
   rc_ref_lists_remove_all(&targets, (RCRefFunction)cleanup_target_resources, NULL);
   rc_ref_lists_cleanup(&targets);
+  cleanup_target_indexes();
 }
 
 /*
@@ -197,8 +231,11 @@ void rc_llrp_target_module_tick(void)
 {
   if (rdmnet_writelock())
   {
+    bool targets_changed = (targets.to_remove.num_refs > 0 || targets.pending.num_refs > 0);
     rc_ref_lists_remove_marked(&targets, (RCRefFunction)cleanup_target_resources, NULL);
     rc_ref_lists_add_pending(&targets);
+    if (targets_changed)
+      rebuild_target_indexes();
     rdmnet_writeunlock();
   }
 
@@ -208,37 +245,43 @@ void rc_llrp_target_module_tick(void)
 void rc_llrp_target_data_received(const uint8_t* data, size_t data_len, const EtcPalMcastNetintId* netint)
 {
   EtcPalUuid dest_cid;
-  if (rc_get_llrp_destination_cid(data, data_len, &dest_cid))
-  {
-    bool                      target_found = false;
-    LlrpTargetIncomingMessage msg;
-    msg.data = data;
-    msg.data_len = data_len;
-    msg.netint = netint;
+  if (!rc_get_llrp_destination_cid(data, data_len, &dest_cid))
+    return;
 
-    if (0 == ETCPAL_UUID_CMP(&dest_cid, kLlrpBroadcastCid))
-    {
-      // Broadcast LLRP message - handle with all targets
-      target_found = true;
-      rc_ref_list_for_each(&targets.active, (RCRefFunction)target_handle_llrp_message, &msg);
-    }
-    else
+  bool          broadcast = (0 == ETCPAL_UUID_CMP(&dest_cid, kLlrpBroadcastCid));
+  RCLlrpTarget* target = NULL;
+  if (!broadcast)
+  {
+    target = find_target_by_cid(&dest_cid);
+    if (!target)
     {
-      RCLlrpTarget* target = find_target_by_cid(&targets.active, &dest_cid);
-      if (target)
+      if (RDMNET_CAN_LOG(ETCPAL_LOG_DEBUG))
       {
-        target_found = true;
-        target_handle_llrp_message(target, &msg);
+        char cid_str[ETCPAL_UUID_STRING_BYTES];
+        etcpal_uuid_to_string(&dest_cid, cid_str);
+        RDMNET_LOG_DEBUG("Ignoring LLRP message addressed to unknown LLRP Target %s", cid_str);
       }
-    }
-
-    if (!target_found && RDMNET_CAN_LOG(ETCPAL_LOG_DEBUG))
-    {
-      char cid_str[ETCPAL_UUID_STRING_BYTES];
-      etcpal_uuid_to_string(&dest_cid, cid_str);
-      RDMNET_LOG_DEBUG("Ignoring LLRP message addressed to unknown LLRP Target %s", cid_str);
+      return;
     }
   }
+
+  // The message is parsed once and shared by every target it is delivered to. msg being static is
+  // a stack-saving optimization; this is only called from the tick thread.
+  static LlrpMessage msg;
+  if (!rc_parse_llrp_message_view(data, data_len, &msg))
+    return;
+
+  LlrpTargetIncomingMessage incoming;
+  incoming.msg = &msg;
+  incoming.netint = netint;
+  incoming.probe_uid_checked = false;
+
+  if (target)
+    target_handle_llrp_message(target, &incoming);
+  else if (msg.vector == VECTOR_LLRP_PROBE_REQUEST)
+    handle_broadcast_probe_request(&incoming);
+  else
+    rc_ref_list_for_each(&targets.active, (RCRefFunction)target_handle_llrp_message, &incoming);
 }
 
 etcpal_error_t setup_target_netints(RCLlrpTarget* target, const EtcPalMcastNetintId* netints, size_t num_netints)
@@ -323,7 +366,7 @@ etcpal_error_t setup_target_netint(const EtcPalMcastNetintId* netint_id, RCLlrpT
   }
 
   // Remaining initialization
-  netint->reply_pending = false;
+  netint->num_pending_replies = 0;
   return res;
 }
 
@@ -353,6 +396,17 @@ RCLlrpTargetNetintInfo* get_target_netint(RCLlrpTarget* target, const EtcPalMcas
   return NULL;
 }
 
+bool probe_reply_pending(const RCLlrpTargetNetintInfo* netint, const EtcPalUuid* manager_cid)
+{
+  for (const RCLlrpTargetPendingReply* reply = netint->pending_replies;
+       reply < netint->pending_replies + netint->num_pending_replies; ++reply)
+  {
+    if (ETCPAL_UUID_CMP(&reply->manager_cid, manager_cid) == 0)
+      return true;
+  }
+  return false;
+}
+
 void cleanup_target_resources(RCLlrpTarget* target, const void* context)
 {
   ETCPAL_UNUSED_ARG(context);
@@ -370,20 +424,22 @@ void process_target_state(RCLlrpTarget* target, const void* context)
   {
     for (RCLlrpTargetNetintInfo* netint = target->netints; netint < target->netints + target->num_netints; ++netint)
     {
-      if (netint->reply_pending)
+      if (netint->num_pending_replies > 0 && etcpal_timer_is_expired(&netint->reply_backoff))
       {
-        if (etcpal_timer_is_expired(&netint->reply_backoff))
+        LlrpDiscoveredTarget target_info;
+        target_info.cid = target->cid;
+        target_info.uid = target->uid;
+        target_info.hardware_address = *(rc_mcast_get_lowest_mac_addr());
+        target_info.component_type = target->component_type;
+
+        // Send the replies to every manager which probed during the backoff period in one burst.
+        for (const RCLlrpTargetPendingReply* reply = netint->pending_replies;
+             reply < netint->pending_replies + netint->num_pending_replies; ++reply)
         {
           LlrpHeader header;
           header.sender_cid = target->cid;
-          header.dest_cid = netint->pending_reply_cid;
-          header.transaction_number = netint->pending_reply_trans_num;
-
-          LlrpDiscoveredTarget target_info;
-          target_info.cid = target->cid;
-          target_info.uid = target->uid;
-          target_info.hardware_address = *(rc_mcast_get_lowest_mac_addr());
-          target_info.component_type = target->component_type;
+          header.dest_cid = reply->manager_cid;
+          header.transaction_number = reply->trans_num;
 
           etcpal_error_t send_res = rc_send_llrp_probe_reply(
               netint->send_sock, netint->send_buf, (netint->id.ip_type == kEtcPalIpTypeV6), &header, &target_info);
@@ -394,17 +450,45 @@ void process_target_state(RCLlrpTarget* target, const void* context)
             RDMNET_LOG_WARNING("Error sending probe reply to manager CID %s on interface index %u", cid_str,
                                netint->id.index);
           }
-
-          netint->reply_pending = false;
         }
+
+        netint->num_pending_replies = 0;
       }
     }
     TARGET_UNLOCK(target);
   }
 }
 
+// Deliver a broadcast probe request to only the targets in its UID range.
+void handle_broadcast_probe_request(const LlrpTargetIncomingMessage* message)
+{
+  if (!target_indexes_valid)
+  {
+    rc_ref_list_for_each(&targets.active, (RCRefFunction)target_handle_llrp_message, message);
+    return;
+  }
+
+  // The targets are visited in UID order, so they can be checked against the Known UID list in a
+  // single pass over it.
+  const RemoteProbeRequest* request = LLRP_MSG_GET_PROBE_REQUEST(message->msg);
+  LlrpTargetIncomingMessage checked_message = *message;
+  checked_message.probe_uid_checked = true;
+  size_t known_uid_pos = 0;
+
+  for (size_t i = first_target_uid_at_or_above(&request->lower_uid); i < num_targets_by_uid; ++i)
+  {
+    RCLlrpTarget* target = targets_by_uid[i];
+    if (rdm_uid_compare(&target->uid, &request->upper_uid) > 0)
+      break;
+    if (rc_llrp_probe_request_contains_uid_in_order(request, &target->uid, &known_uid_pos))
+      target_handle_llrp_message(target, &checked_message);
+  }
+}
+
 void target_handle_llrp_message(RCLlrpTarget* target, const LlrpTargetIncomingMessage* message)
 {
+  const LlrpMessage* msg = message->msg;
+
   if (TARGET_LOCK(target))
   {
     RCLlrpTargetEvent event = RC_LLRP_TARGET_EVENT_INIT;
@@ -412,57 +496,47 @@ void target_handle_llrp_message(RCLlrpTarget* target, const LlrpTargetIncomingMe
     RCLlrpTargetNetintInfo* target_netint = get_target_netint(target, message->netint);
     if (target_netint)
     {
-      // msg being static is a stack-saving optimization. It's unlikely that the LLRP target code
-      // will become multithreaded, but if it does this will need to be revisited.
-      static LlrpMessage msg;
-
-      LlrpMessageInterest interest;
-      interest.my_cid = target->cid;
-      interest.interested_in_probe_reply = false;
-      interest.interested_in_probe_request = true;
-      interest.my_uid = target->uid;
-
-      if (rc_parse_llrp_message(message->data, message->data_len, &interest, &msg))
+      switch (msg->vector)
       {
-        switch (msg.vector)
-        {
-          case VECTOR_LLRP_PROBE_REQUEST: {
-            const RemoteProbeRequest* request = LLRP_MSG_GET_PROBE_REQUEST(&msg);
-            // TODO allow multiple probe replies to be queued
-            if (request->contains_my_uid && !target_netint->reply_pending)
+        case VECTOR_LLRP_PROBE_REQUEST: {
+          const RemoteProbeRequest* request = LLRP_MSG_GET_PROBE_REQUEST(msg);
+          if (!probe_reply_pending(target_netint, &msg->header.sender_cid) &&
+              target_netint->num_pending_replies < RDMNET_LLRP_TARGET_MAX_QUEUED_PROBE_REPLIES &&
+              (message->probe_uid_checked || rc_llrp_probe_request_contains_uid(request, &target->uid)))
+          {
+            // Check the filter values.
+            if (!((request->filter & LLRP_FILTERVAL_BROKERS_ONLY) && target->component_type != kLlrpCompBroker) &&
+                !(request->filter & LLRP_FILTERVAL_CLIENT_CONN_INACTIVE && target->connected_to_broker))
             {
-              uint32_t backoff_ms;
+              RCLlrpTargetPendingReply* reply = &target_netint->pending_replies[target_netint->num_pending_replies++];
+              reply->manager_cid = msg->header.sender_cid;
+              reply->trans_num = msg->header.transaction_number;
 
-              // Check the filter values.
-              if (!((request->filter & LLRP_FILTERVAL_BROKERS_ONLY) && target->component_type != kLlrpCompBroker) &&
-                  !(request->filter & LLRP_FILTERVAL_CLIENT_CONN_INACTIVE && target->connected_to_broker))
+              // A reply queued while the backoff timer is running is sent when it expires.
+              if (target_netint->num_pending_replies == 1)
               {
-                target_netint->reply_pending = true;
-                target_netint->pending_reply_cid = msg.header.sender_cid;
-                target_netint->pending_reply_trans_num = msg.header.transaction_number;
-                backoff_ms = (uint32_t)(rand() * LLRP_MAX_BACKOFF_MS / RAND_MAX);
+                uint32_t backoff_ms = (uint32_t)(rand() % (LLRP_MAX_BACKOFF_MS + 1));
                 etcpal_timer_start(&target_netint->reply_backoff, backoff_ms);
               }
             }
-            // Even if we got a valid probe request, we are starting a backoff timer, so there's nothing
-            // else to do at this time.
-            break;
           }
-          case VECTOR_LLRP_RDM_CMD: {
-            LlrpRdmCommand* cmd = &event.rdm_cmd;
-            if (kEtcPalErrOk ==
-                rdm_unpack_command(LLRP_MSG_GET_RDM(&msg), &cmd->rdm_header, &cmd->data, &cmd->data_len))
-            {
-              cmd->source_cid = msg.header.sender_cid;
-              cmd->seq_num = msg.header.transaction_number;
-              cmd->netint_id = target_netint->id;
+          // Even if we got a valid probe request, we are starting a backoff timer, so there's nothing
+          // else to do at this time.
+          break;
+        }
+        case VECTOR_LLRP_RDM_CMD: {
+          LlrpRdmCommand* cmd = &event.rdm_cmd;
+          if (kEtcPalErrOk == rdm_unpack_command(LLRP_MSG_GET_RDM(msg), &cmd->rdm_header, &cmd->data, &cmd->data_len))
+          {
+            cmd->source_cid = msg->header.sender_cid;
+            cmd->seq_num = msg->header.transaction_number;
+            cmd->netint_id = target_netint->id;
 
-              event.which = kRCLlrpTargetEventRdmCmdReceived;
-            }
+            event.which = kRCLlrpTargetEventRdmCmdReceived;
           }
-          default:
-            break;
         }
+        default:
+          break;
       }
     }
     TARGET_UNLOCK(target);
@@ -626,7 +700,128 @@ static bool cid_is_equal_predicate(void* ref, const void* context)
   return (ETCPAL_UUID_CMP(&target->cid, cid) == 0);
 }
 
-RCLlrpTarget* find_target_by_cid(const RCRefList* list, const EtcPalUuid* cid)
+void rebuild_target_indexes(void)
 {
-  return (RCLlrpTarget*)rc_ref_list_find_ref(list, cid_is_equal_predicate, cid);
+  size_t num_targets = targets.active.num_refs;
+  if (num_targets == 0)
+  {
+    // Nothing to index; searching the empty active list is just as fast.
+    num_targets_by_uid = 0;
+    target_indexes_valid = false;
+    return;
+  }
+
+  target_indexes_valid = reserve_target_indexes(num_targets);
+  if (!target_indexes_valid)
+  {
+    RDMNET_LOG_WARNING("Couldn't allocate LLRP target lookup indexes; LLRP message handling will be slower.");
+    return;
+  }
+
+  num_targets_by_uid = num_targets;
+  targets_by_cid_size = TARGET_CID_INDEX_SIZE(num_targets);
+  memset(targets_by_cid, 0, targets_by_cid_size * sizeof(RCLlrpTarget*));
+
+  for (size_t i = 0; i < num_targets; ++i)
+  {
+    RCLlrpTarget* target = (RCLlrpTarget*)targets.active.refs[i];
+    targets_by_uid[i] = target;
+
+    size_t slot = cid_index_slot(&target->cid);
+    while (targets_by_cid[slot])
+      slot = (slot + 1) % targets_by_cid_size;
+    targets_by_cid[slot] = target;
+  }
+
+  qsort(targets_by_uid, num_targets_by_uid, sizeof(RCLlrpTarget*), target_uid_compare);
+}
+
+bool reserve_target_indexes(size_t num_targets)
+{
+#if RDMNET_DYNAMIC_MEM
+  // Grow in steps so that registering targets one at a time doesn't reallocate every time.
+  size_t new_capacity = 8;
+  while (new_capacity < num_targets)
+    new_capacity *= 2;
+
+  if (num_targets > targets_by_uid_capacity)
+  {
+    RCLlrpTarget** new_by_uid = (RCLlrpTarget**)realloc(targets_by_uid, new_capacity * sizeof(RCLlrpTarget*));
+    if (!new_by_uid)
+      return false;
+    targets_by_uid = new_by_uid;
+    targets_by_uid_capacity = new_capacity;
+  }
+  if (TARGET_CID_INDEX_SIZE(num_targets) > targets_by_cid_capacity)
+  {
+    RCLlrpTarget** new_by_cid =
+        (RCLlrpTarget**)realloc(targets_by_cid, TARGET_CID_INDEX_SIZE(new_capacity) * sizeof(RCLlrpTarget*));
+    if (!new_by_cid)
+      return false;
+    targets_by_cid = new_by_cid;
+    targets_by_cid_capacity = TARGET_CID_INDEX_SIZE(new_capacity);
+  }
+  return true;
+#else
+  return (num_targets <= RC_MAX_LLRP_TARGETS);
+#endif
+}
+
+void cleanup_target_indexes(void)
+{
+#if RDMNET_DYNAMIC_MEM
+  free(targets_by_uid);
+  targets_by_uid = NULL;
+  targets_by_uid_capacity = 0;
+  free(targets_by_cid);
+  targets_by_cid = NULL;
+  targets_by_cid_capacity = 0;
+#endif
+  num_targets_by_uid = 0;
+  targets_by_cid_size = 0;
+  target_indexes_valid = false;
+}
+
+size_t cid_index_slot(const EtcPalUuid* cid)
+{
+  // CIDs are random or hash-generated, so mixing a few of their bytes is enough to spread them.
+  uint32_t hash = etcpal_unpack_u32b(&cid->data[0]) ^ etcpal_unpack_u32b(&cid->data[4]) ^
+                  etcpal_unpack_u32b(&cid->data[8]) ^ etcpal_unpack_u32b(&cid->data[12]);
+  return (size_t)(hash % targets_by_cid_size);
+}
+
+int target_uid_compare(const void* a, const void* b)
+{
+  const RCLlrpTarget* target_a = *(const RCLlrpTarget* const*)a;
+  const RCLlrpTarget* target_b = *(const RCLlrpTarget* const*)b;
+  return rdm_uid_compare(&target_a->uid, &target_b->uid);
+}
+
+// Returns the index in targets_by_uid of the first target with a UID greater than or equal to uid.
+size_t first_target_uid_at_or_above(const RdmUid* uid)
+{
+  size_t low = 0;
+  size_t high = num_targets_by_uid;
+  while (low < high)
+  {
+    size_t mid = low + (high - low) / 2;
+    if (rdm_uid_compare(&targets_by_uid[mid]->uid, uid) < 0)
+      low = mid + 1;
+    else
+      high = mid;
+  }
+  return low;
+}
+
+RCLlrpTarget* find_target_by_cid(const EtcPalUuid* cid)
+{
+  if (!target_indexes_valid)
+    return (RCLlrpTarget*)rc_ref_list_find_ref(&targets.active, cid_is_equal_predicate, cid);
+
+  for (size_t slot = cid_index_slot(cid); targets_by_cid[slot]; slot = (slot + 1) % targets_by_cid_size)
+  {
+    if (ETCPAL_UUID_CMP(&targets_by_cid[slot]->cid, cid) == 0)
+      return targets_by_cid[slot];
+  }
+  return NULL;
 }
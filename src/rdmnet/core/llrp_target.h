@@ -62,16 +62,24 @@ typedef struct RCLlrpTargetCallbacks
   RCLlrpTargetDestroyedCallback          destroyed;
 } RCLlrpTargetCallbacks;
 
+// A probe reply waiting to be sent to a manager.
+typedef struct RCLlrpTargetPendingReply
+{
+  EtcPalUuid manager_cid;
+  uint32_t   trans_num;
+} RCLlrpTargetPendingReply;
+
 typedef struct RCLlrpTargetNetintInfo
 {
   EtcPalMcastNetintId id;
   etcpal_socket_t     send_sock;
   uint8_t             send_buf[LLRP_TARGET_MAX_MESSAGE_SIZE];
 
-  bool        reply_pending;
-  EtcPalUuid  pending_reply_cid;
-  uint32_t    pending_reply_trans_num;
-  EtcPalTimer reply_backoff;
+  // Replies to probe requests from different managers share one backoff timer and are sent
+  // together when it expires.
+  RCLlrpTargetPendingReply pending_replies[RDMNET_LLRP_TARGET_MAX_QUEUED_PROBE_REPLIES];
+  size_t                   num_pending_replies;
+  EtcPalTimer              reply_backoff;
 } RCLlrpTargetNetintInfo;
 
 typedef struct RCLlrpTarget
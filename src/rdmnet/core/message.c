@@ -111,10 +111,7 @@ void free_rpt_message(RptMessage* rmsg)
 {
   switch (rmsg->vector)
   {
-    case VECTOR_RPT_REQUEST:
-    case VECTOR_RPT_NOTIFICATION:
-      free(RPT_GET_RDM_BUF_LIST(rmsg)->rdm_buffers);
-      break;
+    // The RDM buffers of Requests and Notifications are owned by the RCMsgBuf that parsed them.
     case VECTOR_RPT_STATUS: {
       RptStatusMsg* status = RPT_GET_STATUS_MSG(rmsg);
       if (status->status_string)
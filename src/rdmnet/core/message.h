@@ -122,14 +122,12 @@ extern char                rpt_status_string_buffer[RPT_STATUS_STRING_MAXLEN + 1
 #define ALLOC_DYNAMIC_UID_REQUEST_ENTRY() malloc(sizeof(BrokerDynamicUidRequest))
 #define ALLOC_DYNAMIC_UID_MAPPING() malloc(sizeof(RdmnetDynamicUidMapping))
 #define ALLOC_FETCH_UID_ASSIGNMENT() malloc(sizeof(RdmUid))
-#define ALLOC_RDM_BUFFER() malloc(sizeof(RdmBuffer))
 
 #define REALLOC_RPT_CLIENT_ENTRY(ptr, new_size) realloc((ptr), ((new_size) * sizeof(RdmnetRptClientEntry)))
 #define REALLOC_EPT_CLIENT_ENTRY(ptr, new_size) realloc((ptr), ((new_size) * sizeof(RdmnetEptClientEntry)))
 #define REALLOC_DYNAMIC_UID_REQUEST_ENTRY(ptr, new_size) realloc((ptr), ((new_size) * sizeof(BrokerDynamicUidRequest)))
 #define REALLOC_DYNAMIC_UID_MAPPING(ptr, new_size) realloc((ptr), ((new_size) * sizeof(RdmnetDynamicUidMapping)))
 #define REALLOC_FETCH_UID_ASSIGNMENT(ptr, new_size) realloc((ptr), ((new_size) * sizeof(RdmUid)))
-#define REALLOC_RDM_BUFFER(ptr, new_size) realloc((ptr), ((new_size) * sizeof(RdmBuffer)))
 
 #define ALLOC_EPT_SUBPROT_LIST() malloc(sizeof(RdmnetEptSubProtocol))
 #define REALLOC_EPT_SUBPROT_LIST(ptr, new_size) realloc((ptr), ((new_size) * sizeof(RdmnetEptSubProtocol)))
@@ -152,7 +150,6 @@ extern char                rpt_status_string_buffer[RPT_STATUS_STRING_MAXLEN + 1
 #define ALLOC_DYNAMIC_UID_REQUEST_ENTRY() ALLOC_FROM_ARRAY(dynamic_uid_requests, DYNAMIC_UID_REQUESTS_MAX_SIZE)
 #define ALLOC_DYNAMIC_UID_MAPPING() ALLOC_FROM_ARRAY(dynamic_uid_mappings, DYNAMIC_UID_MAPPINGS_MAX_SIZE)
 #define ALLOC_FETCH_UID_ASSIGNMENT() ALLOC_FROM_ARRAY(fetch_uid_assignments, FETCH_UID_ASSIGNMENTS_MAX_SIZE)
-#define ALLOC_RDM_BUFFER() ALLOC_FROM_ARRAY(rdm_buffers, RDM_BUFFERS_MAX_SIZE)
 
 #define REALLOC_RPT_CLIENT_ENTRY(ptr, new_size) \
   REALLOC_FROM_ARRAY(ptr, new_size, rpt_client_entries, RPT_CLIENT_ENTRIES_MAX_SIZE)
@@ -164,7 +161,6 @@ extern char                rpt_status_string_buffer[RPT_STATUS_STRING_MAXLEN + 1
   REALLOC_FROM_ARRAY(ptr, new_size, dynamic_uid_mappings, DYNAMIC_UID_MAPPINGS_MAX_SIZE)
 #define REALLOC_FETCH_UID_ASSIGNMENT(ptr, new_size) \
   REALLOC_FROM_ARRAY(ptr, new_size, fetch_uid_assignments, FETCH_UID_ASSIGNMENTS_MAX_SIZE)
-#define REALLOC_RDM_BUFFER(ptr, new_size) REALLOC_FROM_ARRAY(ptr, new_size, rdm_buffers, RDM_BUFFERS_MAX_SIZE)
 
 #define ALLOC_RPT_STATUS_STR(size) rpt_status_string_buffer
 
@@ -21,6 +21,7 @@
 
 #include <assert.h>
 #include <inttypes.h>
+#include <string.h>
 #include "etcpal/acn_rlp.h"
 #include "etcpal/common.h"
 #include "etcpal/pack.h"
@@ -30,8 +31,14 @@
 #include "rdmnet/core/message.h"
 #include "rdmnet/core/opts.h"
 
+/**************************** Private constants ******************************/
+
+// The ACN Packet Identifier, which begins every TCP preamble.
+static const uint8_t kAcnPacketIdent[] = {0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00};
+
 /*********************** Private function prototypes *************************/
 
+static void              consume_data(RCMsgBuf* msg_buf, size_t size);
 static size_t            locate_tcp_preamble(RCMsgBuf* msg_buf);
 static size_t            consume_bad_block(PduBlockState* block, size_t data_len, rc_parse_result_t* parse_res);
 static rc_parse_result_t check_for_full_parse(rc_parse_result_t prev_res, PduBlockState* block);
@@ -44,6 +51,7 @@ static size_t parse_rlp_block(RlpState*          rlpstate,
                               const uint8_t*     data,
                               size_t             data_size,
                               RdmnetMessage*     msg,
+                              RdmBufArena*       arena,
                               rc_parse_result_t* result);
 
 // RDMnet layer
@@ -57,6 +65,7 @@ static size_t parse_rpt_block(RptState*          rstate,
                               const uint8_t*     data,
                               size_t             data_len,
                               RptMessage*        rmsg,
+                              RdmBufArena*       arena,
                               rc_parse_result_t* result);
 
 // RPT layer
@@ -65,7 +74,9 @@ static size_t parse_rdm_list(RdmListState*      rlstate,
                              const uint8_t*     data,
                              size_t             data_len,
                              RptRdmBufList*     cmd_list,
+                             RdmBufArena*       arena,
                              rc_parse_result_t* result);
+static RdmBuffer* alloc_next_rdm_buffer(RdmBufArena* arena, RptRdmBufList* cmd_list);
 static size_t parse_rpt_status(RptStatusState*    rsstate,
                                const uint8_t*     data,
                                size_t             data_len,
@@ -128,28 +139,84 @@ static RdmnetEptClientEntry* alloc_next_ept_client_entry(RdmnetEptClientList* cl
 void rc_msg_buf_init(RCMsgBuf* msg_buf)
 {
   RDMNET_ASSERT(msg_buf);
+#if RDMNET_DYNAMIC_MEM
+  msg_buf->rdm_buf_arena.buffers = NULL;
+  msg_buf->rdm_buf_arena.capacity = 0;
+#else
+  msg_buf->rdm_buf_arena.buffers = rdmnet_static_msg_buf.rdm_buffers;
+  msg_buf->rdm_buf_arena.capacity = RDM_BUFFERS_MAX_SIZE;
+#endif
+  rc_msg_buf_reset(msg_buf);
+}
+
+// Discard any buffered data and parse state. Storage retained for parsing is kept.
+void rc_msg_buf_reset(RCMsgBuf* msg_buf)
+{
+  RDMNET_ASSERT(msg_buf);
+  msg_buf->cur_data_start = 0;
   msg_buf->cur_data_size = 0;
   msg_buf->have_preamble = false;
 }
 
+// Release storage retained for parsing. The RCMsgBuf must be initialized again before reuse.
+void rc_msg_buf_deinit(RCMsgBuf* msg_buf)
+{
+  RDMNET_ASSERT(msg_buf);
+#if RDMNET_DYNAMIC_MEM
+  free(msg_buf->rdm_buf_arena.buffers);
+#endif
+  msg_buf->rdm_buf_arena.buffers = NULL;
+  msg_buf->rdm_buf_arena.capacity = 0;
+}
+
+// Get the location at which new data should be received, and the amount of space available there.
+// If the space after the unparsed data is running short, the unparsed data is first moved to the
+// start of the buffer.
+uint8_t* rc_msg_buf_get_recv_space(RCMsgBuf* msg_buf, size_t* space)
+{
+  RDMNET_ASSERT(msg_buf);
+  RDMNET_ASSERT(space);
+  RDMNET_ASSERT(msg_buf->cur_data_start + msg_buf->cur_data_size <= RC_MSG_BUF_SIZE);
+
+  if (msg_buf->cur_data_start > 0 &&
+      RC_MSG_BUF_SIZE - (msg_buf->cur_data_start + msg_buf->cur_data_size) < RDMNET_RECV_DATA_MAX_SIZE)
+  {
+    memmove(msg_buf->buf, &msg_buf->buf[msg_buf->cur_data_start], msg_buf->cur_data_size);
+    msg_buf->cur_data_start = 0;
+  }
+
+  *space = RC_MSG_BUF_SIZE - (msg_buf->cur_data_start + msg_buf->cur_data_size);
+  return &msg_buf->buf[msg_buf->cur_data_start + msg_buf->cur_data_size];
+}
+
+// Record that size_received bytes have been written to the location returned by
+// rc_msg_buf_get_recv_space().
+void rc_msg_buf_commit_recv(RCMsgBuf* msg_buf, size_t size_received)
+{
+  RDMNET_ASSERT(msg_buf);
+  RDMNET_ASSERT(msg_buf->cur_data_start + msg_buf->cur_data_size + size_received <= RC_MSG_BUF_SIZE);
+  msg_buf->cur_data_size += size_received;
+}
+
 etcpal_error_t rc_msg_buf_recv(RCMsgBuf* msg_buf, etcpal_socket_t socket)
 {
   RDMNET_ASSERT(msg_buf);
-  RDMNET_ASSERT(msg_buf->cur_data_size <= RC_MSG_BUF_SIZE);
+  RDMNET_ASSERT(msg_buf->cur_data_start + msg_buf->cur_data_size <= RC_MSG_BUF_SIZE);
 
   size_t original_data_size = msg_buf->cur_data_size;
 
   int recv_res = 0;
   do
   {
-    size_t remaining_length = RC_MSG_BUF_SIZE - msg_buf->cur_data_size;
+    size_t   remaining_length = 0;
+    uint8_t* recv_space = rc_msg_buf_get_recv_space(msg_buf, &remaining_length);
     if (remaining_length > 0)
-      recv_res = etcpal_recv(socket, &msg_buf->buf[msg_buf->cur_data_size], remaining_length, 0);
+      recv_res = etcpal_recv(socket, recv_space, remaining_length, 0);
     else
       recv_res = kEtcPalErrWouldBlock;
 
     if (recv_res > 0)
-      msg_buf->cur_data_size += recv_res;
+      rc_msg_buf_commit_recv(msg_buf, (size_t)recv_res);
   } while (recv_res > 0);
 
   if (recv_res < 0)
@@ -196,7 +263,8 @@ etcpal_error_t rc_msg_buf_parse_data(RCMsgBuf* msg_buf)
     if (msg_buf->have_preamble)
     {
       rc_parse_result_t parse_res;
-      consumed = parse_rlp_block(&msg_buf->rlp_state, msg_buf->buf, msg_buf->cur_data_size, &msg_buf->msg, &parse_res);
+      consumed = parse_rlp_block(&msg_buf->rlp_state, &msg_buf->buf[msg_buf->cur_data_start], msg_buf->cur_data_size,
+                                 &msg_buf->msg, &msg_buf->rdm_buf_arena, &parse_res);
       switch (parse_res)
       {
         case kRCParseResFullBlockParseOk:
@@ -216,15 +284,7 @@ etcpal_error_t rc_msg_buf_parse_data(RCMsgBuf* msg_buf)
     }
 
     if (consumed > 0)
-    {
-      // Roll the buffer to discard the data we have already parsed.
-      RDMNET_ASSERT(msg_buf->cur_data_size >= consumed);
-      if (msg_buf->cur_data_size > consumed)
-      {
-        memmove(msg_buf->buf, &msg_buf->buf[consumed], msg_buf->cur_data_size - consumed);
-      }
-      msg_buf->cur_data_size -= consumed;
-    }
+      consume_data(msg_buf, consumed);
   } while (res == kEtcPalErrProtocol);
 
   return res;
@@ -251,6 +311,7 @@ size_t parse_rlp_block(RlpState*          rlpstate,
                        const uint8_t*     data,
                        size_t             data_len,
                        RdmnetMessage*     msg,
+                       RdmBufArena*       arena,
                        rc_parse_result_t* result)
 {
   rc_parse_result_t res = kRCParseResNoData;
@@ -322,7 +383,7 @@ size_t parse_rlp_block(RlpState*          rlpstate,
         break;
       case ACN_VECTOR_ROOT_RPT:
         next_layer_bytes_parsed = parse_rpt_block(&rlpstate->data.rpt, &data[bytes_parsed], data_len - bytes_parsed,
-                                                  RDMNET_GET_RPT_MSG(msg), &res);
+                                                  RDMNET_GET_RPT_MSG(msg), arena, &res);
         break;
       default:
         next_layer_bytes_parsed = consume_bad_block(&rlpstate->data.unknown, data_len - bytes_parsed, &res);
@@ -1206,6 +1267,7 @@ size_t parse_rpt_block(RptState*          rstate,
                        const uint8_t*     data,
                        size_t             data_len,
                        RptMessage*        rmsg,
+                       RdmBufArena*       arena,
                        rc_parse_result_t* result)
 {
   size_t            bytes_parsed = 0;
@@ -1279,7 +1341,7 @@ size_t parse_rpt_block(RptState*          rstate,
       case VECTOR_RPT_REQUEST:
       case VECTOR_RPT_NOTIFICATION:
         next_layer_bytes_parsed = parse_rdm_list(&rstate->data.rdm_list, &data[bytes_parsed], remaining_len,
-                                                 RPT_GET_RDM_BUF_LIST(rmsg), &res);
+                                                 RPT_GET_RDM_BUF_LIST(rmsg), arena, &res);
         break;
       case VECTOR_RPT_STATUS:
         next_layer_bytes_parsed =
@@ -1303,6 +1365,7 @@ size_t parse_rdm_list(RdmListState*      rlstate,
                       const uint8_t*     data,
                       size_t             data_len,
                       RptRdmBufList*     cmd_list,
+                      RdmBufArena*       arena,
                       rc_parse_result_t* result)
 {
   rc_parse_result_t res = kRCParseResNoData;
@@ -1354,33 +1417,23 @@ size_t parse_rdm_list(RdmListState*      rlstate,
           {
             // We are starting at the beginning of a new RDM Command PDU.
             // Make room for a new struct at the end of the current array.
-            if (cmd_list->rdm_buffers)
+            RdmBuffer* rdm_buf = alloc_next_rdm_buffer(arena, cmd_list);
+            if (!rdm_buf)
             {
-              RdmBuffer* new_arr = REALLOC_RDM_BUFFER(cmd_list->rdm_buffers, cmd_list->num_rdm_buffers + 1);
-              if (new_arr)
-              {
-                cmd_list->rdm_buffers = new_arr;
-              }
-              else
+              if (cmd_list->num_rdm_buffers > 0)
               {
                 // We've run out of space for RDM buffers - send back up what we have now
                 cmd_list->more_coming = true;
                 res = kRCParseResPartialBlockParseOk;
-                break;
               }
-            }
-            else
-            {
-              cmd_list->rdm_buffers = ALLOC_RDM_BUFFER();
-              if (!cmd_list->rdm_buffers)
+              else
               {
                 res = kRCParseResNoData;
-                break;
               }
+              break;
             }
 
             // Gotten here - unpack the RDM command PDU
-            RdmBuffer* rdm_buf = &cmd_list->rdm_buffers[cmd_list->num_rdm_buffers++];
             cur_ptr += 3;
             memcpy(rdm_buf->data, cur_ptr, rdm_cmd_pdu_len - 3);
             rdm_buf->data_len = rdm_cmd_pdu_len - 3;
@@ -1405,6 +1458,30 @@ size_t parse_rdm_list(RdmListState*      rlstate,
   return bytes_parsed;
 }
 
+// Get the next RdmBuffer in an RDM command list, which is stored in the arena. With dynamic memory
+// the arena's capacity is doubled when it is exhausted, so it reaches a steady-state size after a
+// few messages and no further allocations are needed. Returns NULL if no more room is available.
+RdmBuffer* alloc_next_rdm_buffer(RdmBufArena* arena, RptRdmBufList* cmd_list)
+{
+  if (cmd_list->num_rdm_buffers >= arena->capacity)
+  {
+#if RDMNET_DYNAMIC_MEM
+    size_t     new_capacity = (arena->capacity ? arena->capacity * 2 : RC_RDM_BUF_ARENA_INITIAL_CAPACITY);
+    RdmBuffer* new_arr = (RdmBuffer*)realloc(arena->buffers, new_capacity * sizeof(RdmBuffer));
+    if (!new_arr)
+      return NULL;
+
+    arena->buffers = new_arr;
+    arena->capacity = new_capacity;
+#else
+    return NULL;
+#endif
+  }
+
+  cmd_list->rdm_buffers = arena->buffers;
+  return &arena->buffers[cmd_list->num_rdm_buffers++];
+}
+
 size_t parse_rpt_status(RptStatusState*    rsstate,
                         const uint8_t*     data,
                         size_t             data_len,
@@ -1524,33 +1601,54 @@ size_t parse_rpt_status(RptStatusState*    rsstate,
   return bytes_parsed;
 }
 
+// Discard data from the front of the buffer which has been parsed.
+void consume_data(RCMsgBuf* msg_buf, size_t size)
+{
+  RDMNET_ASSERT(msg_buf->cur_data_size >= size);
+  msg_buf->cur_data_size -= size;
+  if (msg_buf->cur_data_size == 0)
+    msg_buf->cur_data_start = 0;
+  else
+    msg_buf->cur_data_start += size;
+}
+
 size_t locate_tcp_preamble(RCMsgBuf* msg_buf)
 {
   if (msg_buf->cur_data_size < ACN_TCP_PREAMBLE_SIZE)
     return 0;
 
+  const uint8_t* data = &msg_buf->buf[msg_buf->cur_data_start];
+  size_t         search_end = msg_buf->cur_data_size - ACN_TCP_PREAMBLE_SIZE;
+
+  // Only offsets holding the first byte of the packet identifier can start a preamble. memchr() and
+  // memcmp() are vectorized by most C libraries, so skipping junk after a desync is cheap; on
+  // platforms where they aren't, this is no slower than checking every offset.
   size_t i = 0;
-  for (; i < (msg_buf->cur_data_size - ACN_TCP_PREAMBLE_SIZE); ++i)
+  while (i < search_end)
   {
+    const uint8_t* candidate = (const uint8_t*)memchr(&data[i], kAcnPacketIdent[0], search_end - i);
+    if (!candidate)
+    {
+      i = search_end;
+      break;
+    }
+
+    i = (size_t)(candidate - data);
     AcnTcpPreamble preamble;
-    if (acn_parse_tcp_preamble(&msg_buf->buf[i], msg_buf->cur_data_size - i, &preamble))
+    if (memcmp(candidate, kAcnPacketIdent, sizeof kAcnPacketIdent) == 0 &&
+        acn_parse_tcp_preamble(candidate, msg_buf->cur_data_size - i, &preamble))
     {
       // Discard the data before and including the TCP preamble.
-      if (msg_buf->cur_data_size > i + ACN_TCP_PREAMBLE_SIZE)
-      {
-        memmove(msg_buf->buf, &msg_buf->buf[i + ACN_TCP_PREAMBLE_SIZE],
-                msg_buf->cur_data_size - (i + ACN_TCP_PREAMBLE_SIZE));
-      }
-      msg_buf->cur_data_size -= (i + ACN_TCP_PREAMBLE_SIZE);
+      consume_data(msg_buf, i + ACN_TCP_PREAMBLE_SIZE);
       return preamble.rlp_block_len;
     }
+    ++i;
   }
   if (i > 0)
   {
     // Discard data from the range that has been determined definitively to not contain a TCP
     // preamble.
-    memmove(msg_buf->buf, &msg_buf->buf[i], msg_buf->cur_data_size - i);
-    msg_buf->cur_data_size -= i;
+    consume_data(msg_buf, i);
   }
   return 0;
 }
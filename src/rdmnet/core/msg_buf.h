@@ -215,14 +215,33 @@ typedef struct RlpState
 
 #define RC_MSG_BUF_SIZE (RDMNET_RECV_DATA_MAX_SIZE * 2)
 
+// The number of RdmBuffers allocated the first time an RDM command list is parsed into an arena.
+#define RC_RDM_BUF_ARENA_INITIAL_CAPACITY 4
+
+// Storage for the RDM commands of parsed RPT Request and Notification messages. The rdm_buffers of a
+// parsed message point into this array, which is kept across messages; with dynamic memory it grows
+// geometrically as needed and is only released by rc_msg_buf_deinit(). Without dynamic memory it
+// refers to the fixed-size static message buffer.
+typedef struct RdmBufArena
+{
+  RdmBuffer* buffers;
+  size_t     capacity;
+} RdmBufArena;
+
+// Received data occupies buf[cur_data_start] through buf[cur_data_start + cur_data_size - 1]. Parsed
+// data is consumed by advancing cur_data_start; the unparsed data is only moved back to the start of
+// buf when there is not enough room after it to receive into. Receive into an RCMsgBuf using
+// rc_msg_buf_get_recv_space() and rc_msg_buf_commit_recv(), or rc_msg_buf_recv().
 typedef struct RCMsgBuf
 {
   uint8_t       buf[RC_MSG_BUF_SIZE];
+  size_t        cur_data_start;
   size_t        cur_data_size;
   RdmnetMessage msg;
 
-  bool     have_preamble;
-  RlpState rlp_state;
+  bool        have_preamble;
+  RlpState    rlp_state;
+  RdmBufArena rdm_buf_arena;
 
   const EtcPalLogParams* lparams;
 } RCMsgBuf;
@@ -232,6 +251,10 @@ extern "C" {
 #endif
 
 void           rc_msg_buf_init(RCMsgBuf* msg_buf);
+void           rc_msg_buf_reset(RCMsgBuf* msg_buf);
+void           rc_msg_buf_deinit(RCMsgBuf* msg_buf);
+uint8_t*       rc_msg_buf_get_recv_space(RCMsgBuf* msg_buf, size_t* space);
+void           rc_msg_buf_commit_recv(RCMsgBuf* msg_buf, size_t size_received);
 etcpal_error_t rc_msg_buf_recv(RCMsgBuf* buf, etcpal_socket_t socket);
 etcpal_error_t rc_msg_buf_parse_data(RCMsgBuf* msg_buf);
 
@@ -344,6 +344,61 @@
 #define RDMNET_BIND_MCAST_SOCKETS_TO_MCAST_ADDRESS !RDMNET_WINDOWS_HINT
 #endif
 
+/**
+ * @brief The size in bytes of the outbound queue on each connection to a broker.
+ *
+ * If nonzero, sending on a broker connection never blocks. Data which the socket can't accept
+ * immediately is held in a per-connection queue of this size, and sent from the tick thread when
+ * the socket becomes writable. While the queue is above #RDMNET_CONN_SEND_QUEUE_HIGH_WATERMARK,
+ * new messages are refused with #kEtcPalErrWouldBlock.
+ *
+ * If 0, sends block until the socket has accepted all of the data.
+ */
+#ifndef RDMNET_CONN_SEND_QUEUE_SIZE
+#if RDMNET_FULL_OS_AVAILABLE_HINT
+#define RDMNET_CONN_SEND_QUEUE_SIZE 32768
+#else
+#define RDMNET_CONN_SEND_QUEUE_SIZE 0
+#endif
+#endif
+
+/**
+ * @brief The number of queued bytes at which a broker connection stops accepting new messages.
+ *
+ * Meaningful only if #RDMNET_CONN_SEND_QUEUE_SIZE is nonzero. A message is also refused if it would
+ * not fit in the remaining space in the queue.
+ */
+#ifndef RDMNET_CONN_SEND_QUEUE_HIGH_WATERMARK
+#define RDMNET_CONN_SEND_QUEUE_HIGH_WATERMARK ((RDMNET_CONN_SEND_QUEUE_SIZE / 4) * 3)
+#endif
+
+/**
+ * @brief The number of queued bytes below which a broker connection which has refused a message
+ *        notifies that it is ready to send again.
+ *
+ * Meaningful only if #RDMNET_CONN_SEND_QUEUE_SIZE is nonzero.
+ */
+#ifndef RDMNET_CONN_SEND_QUEUE_LOW_WATERMARK
+#define RDMNET_CONN_SEND_QUEUE_LOW_WATERMARK (RDMNET_CONN_SEND_QUEUE_SIZE / 4)
+#endif
+
+/**
+ * @brief The maximum number of ready socket events handled in one pass of the tick thread.
+ *
+ * After waking for a socket event, the tick thread keeps dispatching events that are already ready
+ * until none remain or this many have been handled, then goes back to its periodic timers. Higher
+ * values improve receive throughput with many broker connections or LLRP sockets; lower values
+ * bound the time between periodic updates.
+ */
+#ifndef RDMNET_TICK_MAX_EVENTS_PER_WAKEUP
+#define RDMNET_TICK_MAX_EVENTS_PER_WAKEUP 32
+#endif
+
+#if RDMNET_TICK_MAX_EVENTS_PER_WAKEUP < 1
+#undef RDMNET_TICK_MAX_EVENTS_PER_WAKEUP
+#define RDMNET_TICK_MAX_EVENTS_PER_WAKEUP 1
+#endif
+
 /**
  * @brief The priority of the tick thread.
  *
@@ -443,6 +498,49 @@
 #define RDMNET_MAX_LLRP_TARGETS RDMNET_MAX_CLIENTS
 #endif
 
+/**
+ * @brief The maximum number of probe replies that an LLRP target queues on each network interface.
+ *
+ * Probe requests from different managers which arrive during the same backoff period are replied
+ * to together when it ends. Probe requests from further managers are ignored until then.
+ */
+#ifndef RDMNET_LLRP_TARGET_MAX_QUEUED_PROBE_REPLIES
+#define RDMNET_LLRP_TARGET_MAX_QUEUED_PROBE_REPLIES 4
+#endif
+
+/**
+ * @brief The maximum number of probe requests that an LLRP manager keeps outstanding at once.
+ *
+ * LLRP managers split the UID space into ranges as they discover targets in it, and discover the
+ * ranges concurrently. Each outstanding probe request draws replies from the undiscovered targets
+ * in its range, so this limits the reply traffic on the network during discovery at the expense
+ * of slower discovery of very large networks.
+ */
+#ifndef RDMNET_LLRP_MANAGER_MAX_OUTSTANDING_PROBES
+#define RDMNET_LLRP_MANAGER_MAX_OUTSTANDING_PROBES 32
+#endif
+
+/**
+ * @brief The maximum number of RDM commands that an LLRP manager keeps in flight to each target.
+ *
+ * Commands are tracked until a response is received or they time out. Sending another command to
+ * a target which already has this many in flight fails with #kEtcPalErrBusy.
+ */
+#ifndef RDMNET_LLRP_MANAGER_MAX_COMMANDS_PER_TARGET
+#define RDMNET_LLRP_MANAGER_MAX_COMMANDS_PER_TARGET 4
+#endif
+
+/**
+ * @brief The number of times an LLRP manager retransmits an RDM command which has not received a
+ *        response.
+ *
+ * Each transmission waits LLRP_TIMEOUT_MS for a response. The command times out once the last
+ * retransmission has not received a response either.
+ */
+#ifndef RDMNET_LLRP_MANAGER_RDM_COMMAND_RETRIES
+#define RDMNET_LLRP_MANAGER_RDM_COMMAND_RETRIES 2
+#endif
+
 /** @cond internal definition */
 
 #if RDMNET_MAX_LLRP_TARGETS
@@ -63,12 +63,7 @@
 /*********************** Private function prototypes *************************/
 
 static void           pack_rpt_header(size_t length, uint32_t vector, const RptHeader* header, uint8_t* buf);
-static etcpal_error_t send_rpt_header(RCConnection*          conn,
-                                      const AcnRootLayerPdu* rlp,
-                                      uint32_t               rc_rpt_vector,
-                                      const RptHeader*       header,
-                                      uint8_t*               buf,
-                                      size_t                 buflen);
+static etcpal_error_t send_rpt_message(RCConnection* conn, uint8_t* buf, size_t message_size);
 static size_t         calc_request_pdu_size(const RdmBuffer* cmd);
 static size_t         calc_status_pdu_size(const RptStatusMsg* status);
 static size_t         calc_notification_pdu_size(const RdmBuffer* cmd_arr, size_t num_cmds);
@@ -119,42 +114,12 @@ size_t pack_rpt_header_with_rlp(const AcnRootLayerPdu* rlp,
   return (size_t)(cur_ptr - buf);
 }
 
-etcpal_error_t send_rpt_header(RCConnection*          conn,
-                               const AcnRootLayerPdu* rlp,
-                               uint32_t               rc_rpt_vector,
-                               const RptHeader*       header,
-                               uint8_t*               buf,
-                               size_t                 buflen)
+// Send a message packed into a buffer from rc_conn_get_send_buf(), then release the buffer.
+etcpal_error_t send_rpt_message(RCConnection* conn, uint8_t* buf, size_t message_size)
 {
-  size_t data_size = acn_root_layer_buf_size(rlp, 1);
-  if (data_size == 0)
-    return kEtcPalErrProtocol;
-
-  // Pack and send the TCP preamble.
-  data_size = acn_pack_tcp_preamble(buf, buflen, data_size);
-  if (data_size == 0)
-    return kEtcPalErrProtocol;
-
-  int send_res = rc_send(conn->sock, buf, data_size, 0);
-  if (send_res < 0)
-    return (etcpal_error_t)send_res;
-
-  // Pack and send the Root Layer PDU header
-  data_size = acn_pack_root_layer_header(buf, buflen, rlp);
-  if (data_size == 0)
-    return kEtcPalErrProtocol;
-
-  send_res = rc_send(conn->sock, buf, data_size, 0);
-  if (send_res < 0)
-    return (etcpal_error_t)send_res;
-
-  // Pack and send the RPT PDU header
-  pack_rpt_header(rlp->data_len, rc_rpt_vector, header, buf);
-  send_res = rc_send(conn->sock, buf, RPT_PDU_HEADER_SIZE, 0);
-  if (send_res < 0)
-    return (etcpal_error_t)send_res;
-
-  return kEtcPalErrOk;
+  etcpal_error_t res = (message_size != 0 ? rc_conn_send_message(conn, buf, message_size) : kEtcPalErrProtocol);
+  rc_conn_release_send_buf(conn, buf);
+  return res;
 }
 
 size_t calc_request_pdu_size(const RdmBuffer* cmd)
@@ -229,27 +194,12 @@ etcpal_error_t rc_rpt_send_request(RCConnection*     conn,
   if (!local_cid || !header || !cmd)
     return kEtcPalErrInvalid;
 
-  AcnRootLayerPdu rlp;
-  rlp.sender_cid = *local_cid;
-  rlp.vector = ACN_VECTOR_ROOT_RPT;
-  rlp.data_len = RPT_PDU_HEADER_SIZE + calc_request_pdu_size(cmd);
-
-  uint8_t        buf[RDM_CMD_PDU_MAX_SIZE];
-  etcpal_error_t res = send_rpt_header(conn, &rlp, VECTOR_RPT_REQUEST, header, buf, RDM_CMD_PDU_MAX_SIZE);
-  if (res != kEtcPalErrOk)
-    return res;
-
-  PACK_REQUEST_HEADER(rlp.data_len - RPT_PDU_HEADER_SIZE, buf);
-  int send_res = rc_send(conn->sock, buf, REQUEST_NOTIF_PDU_HEADER_SIZE, 0);
-  if (send_res < 0)
-    return (etcpal_error_t)send_res;
+  size_t   message_size = rc_rpt_get_request_buffer_size(cmd);
+  uint8_t* buf = rc_conn_get_send_buf(conn, message_size);
+  if (!buf)
+    return kEtcPalErrMsgSize;
 
-  PACK_RDM_CMD_PDU(cmd, buf);
-  send_res = rc_send(conn->sock, buf, RDM_CMD_PDU_LEN(cmd), 0);
-  if (send_res < 0)
-    return (etcpal_error_t)send_res;
-
-  return kEtcPalErrOk;
+  return send_rpt_message(conn, buf, rc_rpt_pack_request(buf, message_size, local_cid, header, cmd));
 }
 
 size_t calc_status_pdu_size(const RptStatusMsg* status)
@@ -326,31 +276,12 @@ etcpal_error_t rc_rpt_send_status(RCConnection*       conn,
   if (!local_cid || !header || !status)
     return kEtcPalErrInvalid;
 
-  size_t status_pdu_size = calc_status_pdu_size(status);
-
-  AcnRootLayerPdu rlp;
-  rlp.sender_cid = *local_cid;
-  rlp.vector = ACN_VECTOR_ROOT_RPT;
-  rlp.data_len = RPT_PDU_HEADER_SIZE + status_pdu_size;
-
-  uint8_t        buf[RPT_PDU_HEADER_SIZE];
-  etcpal_error_t res = send_rpt_header(conn, &rlp, VECTOR_RPT_STATUS, header, buf, RPT_PDU_HEADER_SIZE);
-  if (res != kEtcPalErrOk)
-    return res;
-
-  PACK_STATUS_HEADER(status_pdu_size, (uint16_t)(status->status_code), buf);
-  int send_res = rc_send(conn->sock, buf, RPT_STATUS_HEADER_SIZE, 0);
-  if (send_res < 0)
-    return (etcpal_error_t)send_res;
-
-  if (status_pdu_size > RPT_STATUS_HEADER_SIZE)
-  {
-    send_res = rc_send(conn->sock, (uint8_t*)status->status_string, status_pdu_size - RPT_STATUS_HEADER_SIZE, 0);
-    if (send_res < 0)
-      return (etcpal_error_t)send_res;
-  }
+  size_t   message_size = rc_rpt_get_status_buffer_size(status);
+  uint8_t* buf = rc_conn_get_send_buf(conn, message_size);
+  if (!buf)
+    return kEtcPalErrMsgSize;
 
-  return kEtcPalErrOk;
+  return send_rpt_message(conn, buf, rc_rpt_pack_status(buf, message_size, local_cid, header, status));
 }
 
 size_t calc_notification_pdu_size(const RdmBuffer* cmd_arr, size_t cmd_arr_size)
@@ -440,30 +371,11 @@ etcpal_error_t rc_rpt_send_notification(RCConnection*     conn,
   if (!local_cid || !header || !cmd_arr || cmd_arr_size == 0)
     return kEtcPalErrInvalid;
 
-  size_t notif_pdu_size = calc_notification_pdu_size(cmd_arr, cmd_arr_size);
-
-  AcnRootLayerPdu rlp;
-  rlp.sender_cid = *local_cid;
-  rlp.vector = ACN_VECTOR_ROOT_RPT;
-  rlp.data_len = RPT_PDU_HEADER_SIZE + notif_pdu_size;
-
-  uint8_t        buf[RDM_CMD_PDU_MAX_SIZE];
-  etcpal_error_t res = send_rpt_header(conn, &rlp, VECTOR_RPT_NOTIFICATION, header, buf, RDM_CMD_PDU_MAX_SIZE);
-  if (res != kEtcPalErrOk)
-    return res;
-
-  PACK_NOTIFICATION_HEADER(notif_pdu_size, buf);
-  int send_res = rc_send(conn->sock, buf, REQUEST_NOTIF_PDU_HEADER_SIZE, 0);
-  if (send_res < 0)
-    return (etcpal_error_t)send_res;
-
-  for (const RdmBuffer* cur_cmd = cmd_arr; cur_cmd < cmd_arr + cmd_arr_size; ++cur_cmd)
-  {
-    PACK_RDM_CMD_PDU(cur_cmd, buf);
-    send_res = rc_send(conn->sock, buf, RDM_CMD_PDU_LEN(cur_cmd), 0);
-    if (send_res < 0)
-      return (etcpal_error_t)send_res;
-  }
+  size_t   message_size = rc_rpt_get_notification_buffer_size(cmd_arr, cmd_arr_size);
+  uint8_t* buf = rc_conn_get_send_buf(conn, message_size);
+  if (!buf)
+    return kEtcPalErrMsgSize;
 
-  return kEtcPalErrOk;
+  return send_rpt_message(
+      conn, buf, rc_rpt_pack_notification(buf, message_size, local_cid, header, cmd_arr, cmd_arr_size));
 }
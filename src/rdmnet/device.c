@@ -83,6 +83,7 @@ static void client_disconnected(RCClient*                           client,
                                 const RdmnetClientDisconnectedInfo* info);
 static void client_broker_msg_received(RCClient* client, rdmnet_client_scope_t scope_handle, const BrokerMessage* msg);
 static void client_destroyed(RCClient* client);
+static void client_send_ready(RCClient* client, rdmnet_client_scope_t scope_handle);
 static void client_llrp_msg_received(RCClient*              client,
                                      const LlrpRdmCommand*  cmd,
                                      RdmnetSyncRdmResponse* response,
@@ -129,7 +130,8 @@ static void handle_binding_control_fields(RdmnetDevice*           device,
   client_connect_failed,
   client_disconnected,
   client_broker_msg_received,
-  client_destroyed
+  client_destroyed,
+  client_send_ready
 };
 
  static const RCRptClientCallbacks rpt_client_callbacks =
@@ -204,6 +206,24 @@ void rdmnet_device_set_callbacks(RdmnetDeviceConfig*                        conf
   }
 }
 
+/**
+ * @brief Set the optional send-ready callback in an RDMnet device configuration structure.
+ *
+ * The callback is passed the same context pointer as the callbacks set by
+ * rdmnet_device_set_callbacks().
+ *
+ * @param[out] config Config struct in which to set the callback.
+ * @param[in] send_ready Callback called when a device which refused a send with
+ *                       #kEtcPalErrWouldBlock can accept data again.
+ */
+void rdmnet_device_set_send_ready_callback(RdmnetDeviceConfig* config, RdmnetDeviceSendReadyCallback send_ready)
+{
+  if (config)
+  {
+    config->callbacks.send_ready = send_ready;
+  }
+}
+
 /**
  * @brief Create a new instance of RDMnet device functionality.
  *
@@ -285,6 +305,8 @@ etcpal_error_t rdmnet_device_destroy(rdmnet_device_t handle, rdmnet_disconnect_r
  * @return #kEtcPalErrInvalid: Invalid argument.
  * @return #kEtcPalErrNotInit: Module not initialized.
  * @return #kEtcPalErrNotFound: Handle is not associated with a valid device instance.
+ * @return #kEtcPalErrWouldBlock: The connection to the broker has too much data waiting to be
+ *                               sent; try again after the send_ready callback.
  * @return #kEtcPalErrSys: An internal library or system call error occurred.
  */
 etcpal_error_t rdmnet_device_send_rdm_ack(rdmnet_device_t              handle,
@@ -315,6 +337,8 @@ etcpal_error_t rdmnet_device_send_rdm_ack(rdmnet_device_t              handle,
  * @return #kEtcPalErrInvalid: Invalid argument.
  * @return #kEtcPalErrNotInit: Module not initialized.
  * @return #kEtcPalErrNotFound: Handle is not associated with a valid device instance.
+ * @return #kEtcPalErrWouldBlock: The connection to the broker has too much data waiting to be
+ *                               sent; try again after the send_ready callback.
  * @return #kEtcPalErrSys: An internal library or system call error occurred.
  */
 etcpal_error_t rdmnet_device_send_rdm_nack(rdmnet_device_t              handle,
@@ -351,6 +375,8 @@ etcpal_error_t rdmnet_device_send_rdm_nack(rdmnet_device_t              handle,
  * @return #kEtcPalErrInvalid: Invalid argument.
  * @return #kEtcPalErrNotInit: Module not initialized.
  * @return #kEtcPalErrNotFound: Handle is not associated with a valid device instance.
+ * @return #kEtcPalErrWouldBlock: The connection to the broker has too much data waiting to be
+ *                               sent; try again after the send_ready callback.
  * @return #kEtcPalErrSys: An internal library or system call error occurred.
  */
 etcpal_error_t rdmnet_device_send_rdm_update(rdmnet_device_t handle,
@@ -385,6 +411,8 @@ etcpal_error_t rdmnet_device_send_rdm_update(rdmnet_device_t handle,
  * @return #kEtcPalErrInvalid: Invalid argument.
  * @return #kEtcPalErrNotInit: Module not initialized.
  * @return #kEtcPalErrNotFound: Handle is not associated with a valid device instance.
+ * @return #kEtcPalErrWouldBlock: The connection to the broker has too much data waiting to be
+ *                               sent; try again after the send_ready callback.
  * @return #kEtcPalErrSys: An internal library or system call error occurred.
  */
 etcpal_error_t rdmnet_device_send_rdm_update_from_responder(rdmnet_device_t         handle,
@@ -421,6 +449,8 @@ etcpal_error_t rdmnet_device_send_rdm_update_from_responder(rdmnet_device_t
  * @return #kEtcPalErrInvalid: Invalid argument.
  * @return #kEtcPalErrNotInit: Module not initialized.
  * @return #kEtcPalErrNotFound: Handle is not associated with a valid device instance.
+ * @return #kEtcPalErrWouldBlock: The connection to the broker has too much data waiting to be
+ *                               sent; try again after the send_ready callback.
  * @return #kEtcPalErrSys: An internal library or system call error occurred.
  */
 etcpal_error_t rdmnet_device_send_status(rdmnet_device_t              handle,
@@ -1541,6 +1571,15 @@ void client_destroyed(RCClient* client)
   rdmnet_free_struct_instance(device);
 }
 
+void client_send_ready(RCClient* client, rdmnet_client_scope_t scope_handle)
+{
+  ETCPAL_UNUSED_ARG(scope_handle);
+  RDMNET_ASSERT(client);
+  RdmnetDevice* device = GET_DEVICE_FROM_CLIENT(client);
+  if (device->callbacks.send_ready)
+    device->callbacks.send_ready(device->id.handle, device->callbacks.context);
+}
+
 void client_llrp_msg_received(RCClient*              client,
                               const LlrpRdmCommand*  cmd,
                               RdmnetSyncRdmResponse* response,
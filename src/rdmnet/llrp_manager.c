@@ -44,6 +44,9 @@ static void           release_manager(LlrpManager* manager);
 static void handle_target_discovered(RCLlrpManager* rc_manager, const LlrpDiscoveredTarget* target);
 static void handle_rdm_response_received(RCLlrpManager* rc_manager, const LlrpRdmResponse* resp);
 static void handle_discovery_finished(RCLlrpManager* rc_manager);
+static void handle_rdm_command_timed_out(RCLlrpManager*             rc_manager,
+                                         const LlrpDestinationAddr* destination,
+                                         uint32_t                   seq_num);
 static void handle_manager_destroyed(RCLlrpManager* rc_manager);
 
 // clang-format off
@@ -52,6 +55,7 @@ static const RCLlrpManagerCallbacks kManagerCallbacks =
   handle_target_discovered,
   handle_rdm_response_received,
   handle_discovery_finished,
+  handle_rdm_command_timed_out,
   handle_manager_destroyed
 };
 // clang-format on
@@ -110,6 +114,25 @@ void llrp_manager_config_set_callbacks(LlrpManagerConfig*                     co
   }
 }
 
+/**
+ * @brief Set the optional RDM command timeout callback in an LLRP manager configuration structure.
+ *
+ * The callback is passed the same context pointer as the callbacks set by
+ * llrp_manager_config_set_callbacks().
+ *
+ * @param[out] config Config struct in which to set the callback.
+ * @param[in] rdm_command_timed_out Callback called when an RDM command sent by the manager has not
+ *                                  received a response after all retries.
+ */
+void llrp_manager_config_set_rdm_command_timed_out_callback(
+    LlrpManagerConfig* config, LlrpManagerRdmCommandTimedOutCallback rdm_command_timed_out)
+{
+  if (config)
+  {
+    config->callbacks.rdm_command_timed_out = rdm_command_timed_out;
+  }
+}
+
 /**
  * @brief Create a new LLRP manager instance.
  *
@@ -227,7 +250,13 @@ etcpal_error_t llrp_manager_stop_discovery(llrp_manager_t handle)
 /**
  * @brief Send an RDM command from an LLRP manager.
  *
- * On success, provides the sequence number to correlate with a response.
+ * On success, provides the sequence number to correlate with a response. The command is
+ * retransmitted if no response is received in time; if none of the retransmissions receive a
+ * response either, the rdm_command_timed_out callback is called with the sequence number.
+ *
+ * If the manager operates on more than one network interface and the target has not been
+ * discovered, the command is tried on each network interface in turn, with its retransmissions,
+ * before it times out.
  *
  * @param[in] handle Handle to LLRP manager from which to send the RDM command.
  * @param[in] destination Addressing information for LLRP target to which to send the command.
@@ -240,6 +269,9 @@ etcpal_error_t llrp_manager_stop_discovery(llrp_manager_t handle)
  * @return #kEtcPalErrInvalid: Invalid argument provided.
  * @return #kEtcPalErrNotInit: Module not initialized.
  * @return #kEtcPalErrNotFound: Handle is not associated with a valid LLRP manager instance.
+ * @return #kEtcPalErrBusy: #RDMNET_LLRP_MANAGER_MAX_COMMANDS_PER_TARGET commands are already
+ *         waiting for responses from the target.
+ * @return #kEtcPalErrNoMem: No room to track the command.
  * @return Note: Other error codes might be propagated from underlying socket calls.
  */
 etcpal_error_t llrp_manager_send_rdm_command(llrp_manager_t             handle,
@@ -333,7 +365,8 @@ etcpal_error_t llrp_manager_send_set_command(llrp_manager_t             handle,
 
 etcpal_error_t validate_llrp_manager_config(const LlrpManagerConfig* config)
 {
-  if ((config->netint.ip_type != kEtcPalIpTypeV4 && config->netint.ip_type != kEtcPalIpTypeV6) ||
+  if ((config->netint.ip_type != kEtcPalIpTypeInvalid && config->netint.ip_type != kEtcPalIpTypeV4 &&
+       config->netint.ip_type != kEtcPalIpTypeV6) ||
       ETCPAL_UUID_IS_NULL(&config->cid) || config->manu_id == 0 || !config->callbacks.target_discovered ||
       !config->callbacks.rdm_response_received || !config->callbacks.discovery_finished)
   {
@@ -423,6 +456,16 @@ void handle_discovery_finished(RCLlrpManager* rc_manager)
   manager->callbacks.discovery_finished(manager->id.handle, manager->callbacks.context);
 }
 
+void handle_rdm_command_timed_out(RCLlrpManager*             rc_manager,
+                                  const LlrpDestinationAddr* destination,
+                                  uint32_t                   seq_num)
+{
+  RDMNET_ASSERT(rc_manager);
+  LlrpManager* manager = GET_ENCOMPASSING_MANAGER(rc_manager);
+  if (manager->callbacks.rdm_command_timed_out)
+    manager->callbacks.rdm_command_timed_out(manager->id.handle, destination, seq_num, manager->callbacks.context);
+}
+
 void handle_manager_destroyed(RCLlrpManager* rc_manager)
 {
   RDMNET_ASSERT(rc_manager);
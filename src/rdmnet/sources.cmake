@@ -96,6 +96,7 @@ set(RDMNET_BROKER_PRIVATE_HEADERS
   ${RDMNET_SRC}/rdmnet/broker/broker_socket_manager.h
   ${RDMNET_SRC}/rdmnet/broker/broker_threads.h
   ${RDMNET_SRC}/rdmnet/broker/broker_uid_manager.h
+  ${RDMNET_SRC}/rdmnet/broker/broker_uid_store.h
   ${RDMNET_SRC}/rdmnet/broker/broker_util.h
 )
 set(RDMNET_BROKER_SOURCES
@@ -106,6 +107,7 @@ set(RDMNET_BROKER_SOURCES
   ${RDMNET_SRC}/rdmnet/broker/broker_responder.cpp
   ${RDMNET_SRC}/rdmnet/broker/broker_threads.cpp
   ${RDMNET_SRC}/rdmnet/broker/broker_uid_manager.cpp
+  ${RDMNET_SRC}/rdmnet/broker/broker_uid_store.cpp
   ${RDMNET_SRC}/rdmnet/broker/broker_util.cpp
 )
 
@@ -36,6 +36,9 @@ DEFINE_FAKE_VALUE_FUNC(etcpal_error_t,
                        const BrokerClientConnectMsg*,
                        rdmnet_disconnect_reason_t);
 DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, rc_conn_disconnect, RCConnection*, rdmnet_disconnect_reason_t);
+DEFINE_FAKE_VALUE_FUNC(uint8_t*, rc_conn_get_send_buf, RCConnection*, size_t);
+DEFINE_FAKE_VOID_FUNC(rc_conn_release_send_buf, RCConnection*, uint8_t*);
+DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, rc_conn_send_message, RCConnection*, const uint8_t*, size_t);
 
 void rc_connection_reset_all_fakes(void)
 {
@@ -47,4 +50,7 @@ void rc_connection_reset_all_fakes(void)
   RESET_FAKE(rc_conn_connect);
   RESET_FAKE(rc_conn_reconnect);
   RESET_FAKE(rc_conn_disconnect);
+  RESET_FAKE(rc_conn_get_send_buf);
+  RESET_FAKE(rc_conn_release_send_buf);
+  RESET_FAKE(rc_conn_send_message);
 }
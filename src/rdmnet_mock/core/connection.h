@@ -49,6 +49,9 @@ DECLARE_FAKE_VALUE_FUNC(etcpal_error_t,
                         const BrokerClientConnectMsg*,
                         rdmnet_disconnect_reason_t);
 DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, rc_conn_disconnect, RCConnection*, rdmnet_disconnect_reason_t);
+DECLARE_FAKE_VALUE_FUNC(uint8_t*, rc_conn_get_send_buf, RCConnection*, size_t);
+DECLARE_FAKE_VOID_FUNC(rc_conn_release_send_buf, RCConnection*, uint8_t*);
+DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, rc_conn_send_message, RCConnection*, const uint8_t*, size_t);
 
 void rc_connection_reset_all_fakes(void);
 
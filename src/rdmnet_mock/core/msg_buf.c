@@ -20,12 +20,20 @@
 #include "rdmnet_mock/core/msg_buf.h"
 
 DEFINE_FAKE_VOID_FUNC(rc_msg_buf_init, RCMsgBuf*);
+DEFINE_FAKE_VOID_FUNC(rc_msg_buf_reset, RCMsgBuf*);
+DEFINE_FAKE_VOID_FUNC(rc_msg_buf_deinit, RCMsgBuf*);
+DEFINE_FAKE_VALUE_FUNC(uint8_t*, rc_msg_buf_get_recv_space, RCMsgBuf*, size_t*);
+DEFINE_FAKE_VOID_FUNC(rc_msg_buf_commit_recv, RCMsgBuf*, size_t);
 DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, rc_msg_buf_recv, RCMsgBuf*, etcpal_socket_t);
 DEFINE_FAKE_VALUE_FUNC(etcpal_error_t, rc_msg_buf_parse_data, RCMsgBuf*);
 
 void rc_msg_buf_reset_all_fakes(void)
 {
   RESET_FAKE(rc_msg_buf_init);
+  RESET_FAKE(rc_msg_buf_reset);
+  RESET_FAKE(rc_msg_buf_deinit);
+  RESET_FAKE(rc_msg_buf_get_recv_space);
+  RESET_FAKE(rc_msg_buf_commit_recv);
   RESET_FAKE(rc_msg_buf_recv);
   RESET_FAKE(rc_msg_buf_parse_data);
 }
@@ -33,6 +33,10 @@ extern "C" {
 #endif
 
 DECLARE_FAKE_VOID_FUNC(rc_msg_buf_init, RCMsgBuf*);
+DECLARE_FAKE_VOID_FUNC(rc_msg_buf_reset, RCMsgBuf*);
+DECLARE_FAKE_VOID_FUNC(rc_msg_buf_deinit, RCMsgBuf*);
+DECLARE_FAKE_VALUE_FUNC(uint8_t*, rc_msg_buf_get_recv_space, RCMsgBuf*, size_t*);
+DECLARE_FAKE_VOID_FUNC(rc_msg_buf_commit_recv, RCMsgBuf*, size_t);
 DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, rc_msg_buf_recv, RCMsgBuf*, etcpal_socket_t);
 DECLARE_FAKE_VALUE_FUNC(etcpal_error_t, rc_msg_buf_parse_data, RCMsgBuf*);
 
@@ -0,0 +1,43 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+// libFuzzer target for the TCP message parser (RCMsgBuf and the Broker, RPT and EPT parsers).
+//
+// The first input byte selects the simulated receive size, so that the fuzzer also explores
+// messages which are split across receives. 0xff means the whole input is received at once.
+
+#include <cstddef>
+#include <cstdint>
+#include "parser_harness.h"
+
+extern "C" int LLVMFuzzerInitialize(int*, char***)
+{
+  InitParserHarness();
+  return 0;
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+  if (size < 1)
+    return 0;
+
+  size_t chunk_size = (data[0] == 0xff ? size : static_cast<size_t>(data[0]) + 1);
+  ParseTcpStream(&data[1], size - 1, chunk_size);
+  return 0;
+}
@@ -0,0 +1,534 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+// rdmnet_parser_bench: a throughput benchmark for the RDMnet message parsers.
+//
+// Each workload replays one input through the parser harness repeatedly and reports the parse rate
+// in MB/s and messages/s. The TCP workloads are built from the message test vectors in tests/data;
+// the LLRP and mDNS workloads are built with the library's own packing functions or by hand, since
+// there are no test vectors for those protocols.
+//
+// With --write-corpus=DIR, the inputs are instead written out as seed files for the fuzz targets,
+// one subdirectory per target.
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "etcpal/uuid.h"
+#include "etcpal_mock/socket.h"
+#include "rdm/defs.h"
+#include "rdm/message.h"
+#include "rdmnet/core/llrp_prot.h"
+#include "rdmnet/core/message.h"
+#include "rdmnet/core/msg_buf.h"
+#include "rdmnet/core/rpt_prot.h"
+#include "load_test_data.h"
+#include "parser_harness.h"
+#include "test_file_manifest.h"
+
+/*********************************** Inputs ***********************************/
+
+enum class Parser
+{
+  kTcpStream,
+  kLlrp,
+  kMdns
+};
+
+struct Workload
+{
+  std::string          name;
+  Parser               parser;
+  size_t               chunk_size;  // Simulated receive size, TCP only
+  std::vector<uint8_t> input;
+};
+
+struct TestVector
+{
+  std::string          name;
+  std::vector<uint8_t> data;
+};
+
+static constexpr size_t kTcpStreamMinSize = 256 * 1024;
+static constexpr size_t kFragmentedChunkSize = 13;
+static constexpr size_t kAckOverflowResponses = 64;
+static constexpr size_t kResyncJunkSize = 256;
+
+std::vector<TestVector> LoadTestVectors()
+{
+  std::vector<TestVector> vectors;
+  for (const auto& file_pair : kRdmnetTestDataFiles)
+  {
+    std::string name = file_pair.first;
+    auto        slash_pos = name.find_last_of("/\\");
+    if (slash_pos != std::string::npos)
+      name.erase(0, slash_pos + 1);
+    auto ext_pos = name.find(".data.txt");
+    if (ext_pos != std::string::npos)
+      name.erase(ext_pos);
+
+    std::ifstream file(file_pair.first);
+    if (file.is_open())
+      vectors.push_back(TestVector{name, rdmnet::testing::LoadTestData(file)});
+  }
+  return vectors;
+}
+
+const RdmnetMessage* FindValidationMessage(const char* name)
+{
+  for (const auto& file_pair : kRdmnetTestDataFiles)
+  {
+    if (std::strstr(file_pair.first, name))
+      return &file_pair.second;
+  }
+  return nullptr;
+}
+
+// Concatenate the messages, in order, until the stream is at least kTcpStreamMinSize bytes.
+std::vector<uint8_t> BuildTcpStream(const std::vector<const std::vector<uint8_t>*>& messages)
+{
+  std::vector<uint8_t> stream;
+  if (messages.empty())
+    return stream;
+
+  while (stream.size() < kTcpStreamMinSize)
+  {
+    for (const auto* message : messages)
+      stream.insert(stream.end(), message->begin(), message->end());
+  }
+  return stream;
+}
+
+// An RPT Notification carrying a long ACK_OVERFLOW response, made by repeating the responses from
+// the ack_overflow test vector.
+std::vector<uint8_t> BuildAckOverflowNotification()
+{
+  const RdmnetMessage* validation = FindValidationMessage("rdm_get_command_response_ack_overflow");
+  if (!validation)
+    return std::vector<uint8_t>();
+
+  const RptMessage*    rpt = RDMNET_GET_RPT_MSG(validation);
+  const RptRdmBufList* buf_list = RPT_GET_RDM_BUF_LIST(rpt);
+  if (buf_list->num_rdm_buffers < 2)
+    return std::vector<uint8_t>();
+
+  // The first buffer is the original command; the rest are the responses.
+  std::vector<RdmBuffer> rdm_buffers;
+  rdm_buffers.push_back(buf_list->rdm_buffers[0]);
+  for (size_t i = 0; i < kAckOverflowResponses; ++i)
+    rdm_buffers.push_back(buf_list->rdm_buffers[1 + (i % (buf_list->num_rdm_buffers - 1))]);
+
+  std::vector<uint8_t> message(rc_rpt_get_notification_buffer_size(rdm_buffers.data(), rdm_buffers.size()));
+  size_t packed_size = rc_rpt_pack_notification(message.data(), message.size(), &validation->sender_cid, &rpt->header,
+                                                rdm_buffers.data(), rdm_buffers.size());
+  message.resize(packed_size);
+  return message;
+}
+
+// Junk to put in front of a message, as seen after a stream desyncs. Includes near-misses on the
+// ACN packet identifier, which can't be rejected on their first byte.
+std::vector<uint8_t> BuildResyncJunk()
+{
+  static const char kNearMiss[] = "ASC-E1.1";
+
+  std::vector<uint8_t> junk;
+  uint32_t             lcg = 12345;
+  while (junk.size() < kResyncJunkSize)
+  {
+    if (junk.size() % 64 == 0)
+    {
+      junk.insert(junk.end(), kNearMiss, kNearMiss + sizeof(kNearMiss) - 1);
+    }
+    else
+    {
+      lcg = lcg * 1103515245u + 12345u;
+      junk.push_back(static_cast<uint8_t>(lcg >> 24));
+    }
+  }
+  return junk;
+}
+
+// The LLRP send functions pack into a caller buffer and hand it straight to etcpal_sendto(), which
+// is a fake here; capture the length it was given.
+static size_t llrp_sent_size;
+
+std::vector<uint8_t> CaptureLlrpMessage(const uint8_t* buf, etcpal_error_t send_result)
+{
+  if (send_result != kEtcPalErrOk)
+    return std::vector<uint8_t>();
+  return std::vector<uint8_t>(buf, buf + llrp_sent_size);
+}
+
+void BuildLlrpWorkloads(std::vector<Workload>& workloads)
+{
+  etcpal_sendto_fake.custom_fake = [](etcpal_socket_t, const void*, size_t size, int, const EtcPalSockAddr*) {
+    llrp_sent_size = size;
+    return static_cast<int>(size);
+  };
+
+  uint8_t    buf[LLRP_MAX_MESSAGE_SIZE];
+  LlrpHeader header;
+  etcpal_string_to_uuid("d4f14e2e-9e70-4e1e-9f4d-3e7e2c1b6d5a", &header.sender_cid);
+  etcpal_string_to_uuid("fbad822c-bd0c-4d4c-bdc8-7eabebc85aff", &header.dest_cid);
+  header.transaction_number = 0x12345678;
+
+  // A probe request with a full known UID list, which the target must scan for its own UID.
+  std::vector<RdmUid> known_uids;
+  for (uint32_t i = 0; i < LLRP_KNOWN_UID_SIZE; ++i)
+    known_uids.push_back(RdmUid{0x6574, 0x10000000u + i});
+
+  LocalProbeRequest probe_request;
+  probe_request.lower_uid = RdmUid{0, 0};
+  probe_request.upper_uid = RdmUid{0xffff, 0xffffffff};
+  probe_request.filter = 0;
+  probe_request.known_uids = known_uids.data();
+  probe_request.num_known_uids = known_uids.size();
+  workloads.push_back(
+      Workload{"llrp-probe-request", Parser::kLlrp, 0,
+               CaptureLlrpMessage(buf, rc_send_llrp_probe_request(0, buf, false, &header, &probe_request))});
+
+  LlrpDiscoveredTarget target_info;
+  target_info.cid = header.sender_cid;
+  target_info.uid = RdmUid{0x6574, 0x12345678};
+  std::memset(target_info.hardware_address.data, 0x5a, sizeof(target_info.hardware_address.data));
+  target_info.component_type = kLlrpCompRptDevice;
+  workloads.push_back(Workload{"llrp-probe-reply", Parser::kLlrp, 0,
+                               CaptureLlrpMessage(buf, rc_send_llrp_probe_reply(0, buf, false, &header, &target_info))});
+
+  RdmCommandHeader rdm_header;
+  rdm_header.source_uid = RdmUid{0x6574, 0x87654321};
+  rdm_header.dest_uid = RdmUid{0x6574, 0x12345678};
+  rdm_header.transaction_num = 0;
+  rdm_header.port_id = 1;
+  rdm_header.subdevice = 0;
+  rdm_header.command_class = kRdmCCGetCommand;
+  rdm_header.param_id = E120_DEVICE_INFO;
+
+  RdmBuffer rdm_cmd;
+  if (rdm_pack_command(&rdm_header, nullptr, 0, &rdm_cmd) == kEtcPalErrOk)
+  {
+    workloads.push_back(Workload{"llrp-rdm", Parser::kLlrp, 0,
+                                 CaptureLlrpMessage(buf, rc_send_llrp_rdm_command(0, buf, false, &header, &rdm_cmd))});
+  }
+
+  RESET_FAKE(etcpal_sendto);
+}
+
+void PackDnsName(std::vector<uint8_t>& out, const std::vector<std::string>& labels)
+{
+  for (const auto& label : labels)
+  {
+    out.push_back(static_cast<uint8_t>(label.size()));
+    out.insert(out.end(), label.begin(), label.end());
+  }
+  out.push_back(0);
+}
+
+void PackUint16(std::vector<uint8_t>& out, uint16_t val)
+{
+  out.push_back(static_cast<uint8_t>(val >> 8));
+  out.push_back(static_cast<uint8_t>(val & 0xffu));
+}
+
+void PackDnsRecord(std::vector<uint8_t>& out,
+                   const std::vector<std::string>& name,
+                   uint16_t                        type,
+                   const std::vector<uint8_t>&     data)
+{
+  PackDnsName(out, name);
+  PackUint16(out, type);
+  PackUint16(out, 0x8001);  // Class IN, cache flush
+  PackUint16(out, 0);       // TTL
+  PackUint16(out, 120);
+  PackUint16(out, static_cast<uint16_t>(data.size()));
+  out.insert(out.end(), data.begin(), data.end());
+}
+
+// A typical broker advertisement: the PTR, SRV, TXT and A records for one service instance, all in
+// the answer section. Names are uncompressed, which makes this the worst case for the name parser.
+std::vector<uint8_t> BuildMdnsResponse()
+{
+  static const char kTxtRecord[] =
+      "\011TxtVers=1\021E133Scope=default\012E133Vers=1\044CID=da30bf9383174140a7714840483f71d7\020UID="
+      "6574d574a27a\016Model=Test App\011Manuf=ETC";
+
+  const std::vector<std::string> service_name = {"_default", "_sub", "_rdmnet", "_tcp", "local"};
+  const std::vector<std::string> instance_name = {"Bench Broker", "_rdmnet", "_tcp", "local"};
+  const std::vector<std::string> host_name = {"bench-host", "local"};
+
+  std::vector<uint8_t> response;
+  PackUint16(response, 0);       // ID
+  PackUint16(response, 0x8400);  // Response, authoritative
+  PackUint16(response, 0);       // Queries
+  PackUint16(response, 4);       // Answers
+  PackUint16(response, 0);       // Authority records
+  PackUint16(response, 0);       // Additional records
+
+  std::vector<uint8_t> ptr_data;
+  PackDnsName(ptr_data, instance_name);
+  PackDnsRecord(response, service_name, 12, ptr_data);
+
+  std::vector<uint8_t> srv_data;
+  PackUint16(srv_data, 0);  // Priority
+  PackUint16(srv_data, 0);  // Weight
+  PackUint16(srv_data, 8888);
+  PackDnsName(srv_data, host_name);
+  PackDnsRecord(response, instance_name, 33, srv_data);
+
+  PackDnsRecord(response, instance_name, 16, std::vector<uint8_t>(kTxtRecord, kTxtRecord + sizeof(kTxtRecord) - 1));
+  PackDnsRecord(response, host_name, 1, std::vector<uint8_t>{192, 168, 1, 10});
+  return response;
+}
+
+std::vector<Workload> BuildWorkloads(const std::vector<TestVector>& vectors)
+{
+  std::vector<Workload> workloads;
+
+  std::vector<const std::vector<uint8_t>*> all_messages;
+  std::vector<const std::vector<uint8_t>*> small_messages;
+  for (const auto& vector : vectors)
+  {
+    all_messages.push_back(&vector.data);
+    if (vector.name == "broker_null" || vector.name == "rdm_get_command")
+      small_messages.push_back(&vector.data);
+  }
+
+  auto all_vectors_stream = BuildTcpStream(all_messages);
+  workloads.push_back(Workload{"tcp-vectors", Parser::kTcpStream, RDMNET_RECV_DATA_MAX_SIZE, all_vectors_stream});
+  workloads.push_back(Workload{"tcp-fragmented", Parser::kTcpStream, kFragmentedChunkSize, all_vectors_stream});
+  workloads.push_back(
+      Workload{"tcp-small-pdus", Parser::kTcpStream, RDMNET_RECV_DATA_MAX_SIZE, BuildTcpStream(small_messages)});
+
+  auto                                     resync_junk = BuildResyncJunk();
+  std::vector<const std::vector<uint8_t>*> junk_and_messages;
+  for (const auto* message : small_messages)
+  {
+    junk_and_messages.push_back(&resync_junk);
+    junk_and_messages.push_back(message);
+  }
+  workloads.push_back(
+      Workload{"tcp-resync", Parser::kTcpStream, RDMNET_RECV_DATA_MAX_SIZE, BuildTcpStream(junk_and_messages)});
+
+  auto ack_overflow = BuildAckOverflowNotification();
+  workloads.push_back(
+      Workload{"tcp-ack-overflow", Parser::kTcpStream, RDMNET_RECV_DATA_MAX_SIZE, BuildTcpStream({&ack_overflow})});
+
+  BuildLlrpWorkloads(workloads);
+  workloads.push_back(Workload{"mdns-response", Parser::kMdns, 0, BuildMdnsResponse()});
+
+  for (auto it = workloads.begin(); it != workloads.end();)
+  {
+    if (it->input.empty())
+    {
+      std::cout << "Warning: could not build input for workload " << it->name << "; skipping.\n";
+      it = workloads.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+  return workloads;
+}
+
+/********************************** Running ***********************************/
+
+using Clock = std::chrono::steady_clock;
+
+size_t RunParser(const Workload& workload)
+{
+  switch (workload.parser)
+  {
+    case Parser::kTcpStream:
+      return ParseTcpStream(workload.input.data(), workload.input.size(), workload.chunk_size);
+    case Parser::kLlrp:
+      return ParseLlrpDatagram(workload.input.data(), workload.input.size());
+    case Parser::kMdns:
+    default:
+      return ParseMdnsDatagram(workload.input.data(), workload.input.size());
+  }
+}
+
+void RunWorkload(const Workload& workload, double min_time_s)
+{
+  // One untimed pass, to warm caches and to catch inputs that don't parse.
+  if (RunParser(workload) == 0)
+  {
+    std::cout << std::left << std::setw(22) << workload.name << "no messages parsed; input is invalid\n";
+    return;
+  }
+
+  uint64_t num_bytes = 0;
+  uint64_t num_messages = 0;
+  auto     start_time = Clock::now();
+  double   elapsed_s = 0.0;
+  do
+  {
+    // Check the clock every few passes; small datagrams parse faster than the clock can be read.
+    for (int i = 0; i < 64; ++i)
+    {
+      num_messages += RunParser(workload);
+      num_bytes += workload.input.size();
+    }
+    elapsed_s = std::chrono::duration<double>(Clock::now() - start_time).count();
+  } while (elapsed_s < min_time_s);
+
+  std::cout << std::left << std::setw(22) << workload.name << std::right << std::fixed << std::setprecision(1)
+            << std::setw(12) << (static_cast<double>(num_bytes) / 1e6 / elapsed_s) << std::setw(16)
+            << (static_cast<double>(num_messages) / elapsed_s) << "\n";
+}
+
+/******************************* Corpus writing *******************************/
+
+bool WriteSeed(const std::string& path, const std::vector<uint8_t>& data)
+{
+  std::ofstream file(path, std::ios::binary);
+  if (!file.is_open())
+  {
+    std::cout << "Error: could not open " << path << " for writing. Does the directory exist?\n";
+    return false;
+  }
+  file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+  return file.good();
+}
+
+// fuzz_msg_buf takes a leading byte which selects the simulated receive size; 0xff means the
+// whole input is received at once.
+std::vector<uint8_t> MsgBufSeed(const std::vector<uint8_t>& data, uint8_t chunk_selector = 0xff)
+{
+  std::vector<uint8_t> seed;
+  seed.push_back(chunk_selector);
+  seed.insert(seed.end(), data.begin(), data.end());
+  return seed;
+}
+
+bool WriteCorpus(const std::string& dir, const std::vector<TestVector>& vectors, const std::vector<Workload>& workloads)
+{
+  for (const auto& vector : vectors)
+  {
+    if (!WriteSeed(dir + "/msg_buf/" + vector.name, MsgBufSeed(vector.data)))
+      return false;
+  }
+  if (!WriteSeed(dir + "/msg_buf/ack_overflow_notification", MsgBufSeed(BuildAckOverflowNotification())))
+    return false;
+
+  for (const auto& workload : workloads)
+  {
+    bool ok = true;
+    switch (workload.parser)
+    {
+      case Parser::kTcpStream:
+        // The stream workloads are replicated test vectors, which are already seeded above.
+        break;
+      case Parser::kLlrp:
+        ok = WriteSeed(dir + "/llrp/" + workload.name, workload.input);
+        break;
+      case Parser::kMdns:
+        ok = WriteSeed(dir + "/mdns/" + workload.name, workload.input);
+        break;
+    }
+    if (!ok)
+      return false;
+  }
+  return true;
+}
+
+/************************************ Main ************************************/
+
+void PrintHelp(const char* app_name)
+{
+  std::cout << "Usage: " << app_name << " [OPTION]...\n";
+  std::cout << "\n";
+  std::cout << "Options:\n";
+  std::cout << "  --min-time=SECONDS    Minimum time to run each workload. Default is 1.\n";
+  std::cout << "  --filter=TEXT         Only run workloads whose names contain TEXT.\n";
+  std::cout << "  --write-corpus=DIR    Write fuzzer seed inputs into DIR/msg_buf, DIR/llrp and\n";
+  std::cout << "                        DIR/mdns (which must exist) instead of benchmarking.\n";
+  std::cout << "  --help                Display this help and exit.\n";
+}
+
+int main(int argc, char* argv[])
+{
+  double      min_time_s = 1.0;
+  std::string filter;
+  std::string corpus_dir;
+
+  for (int i = 1; i < argc; ++i)
+  {
+    const char* arg = argv[i];
+    if (std::strncmp(arg, "--min-time=", 11) == 0)
+    {
+      min_time_s = std::strtod(&arg[11], nullptr);
+      if (min_time_s <= 0.0)
+      {
+        std::cout << "Invalid argument: " << arg << "\n\n";
+        PrintHelp(argv[0]);
+        return 1;
+      }
+    }
+    else if (std::strncmp(arg, "--filter=", 9) == 0)
+    {
+      filter = &arg[9];
+    }
+    else if (std::strncmp(arg, "--write-corpus=", 15) == 0)
+    {
+      corpus_dir = &arg[15];
+    }
+    else if (std::strcmp(arg, "--help") == 0)
+    {
+      PrintHelp(argv[0]);
+      return 0;
+    }
+    else
+    {
+      std::cout << "Invalid argument: " << arg << "\n\n";
+      PrintHelp(argv[0]);
+      return 1;
+    }
+  }
+
+  InitParserHarness();
+
+  auto vectors = LoadTestVectors();
+  if (vectors.empty())
+  {
+    std::cout << "Error: no test vectors could be loaded.\n";
+    return 1;
+  }
+  auto workloads = BuildWorkloads(vectors);
+
+  if (!corpus_dir.empty())
+    return WriteCorpus(corpus_dir, vectors, workloads) ? 0 : 1;
+
+  std::cout << std::left << std::setw(22) << "Workload" << std::right << std::setw(12) << "MB/s" << std::setw(16)
+            << "Messages/s"
+            << "\n";
+  for (const auto& workload : workloads)
+  {
+    if (filter.empty() || workload.name.find(filter) != std::string::npos)
+      RunWorkload(workload, min_time_s);
+  }
+  return 0;
+}
@@ -0,0 +1,179 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+#include "parser_harness.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "fff.h"
+#include "rdmnet/core/llrp_prot.h"
+#include "rdmnet/core/message.h"
+#include "rdmnet/core/msg_buf.h"
+#include "rdmnet/disc/discovered_broker.h"
+#include "lwmdns_common.h"
+
+DEFINE_FFF_GLOBALS;
+
+// Library assertions indicate a parser bug; abort so the fuzzer records the input that caused it.
+extern "C" void RdmnetTestingAssertHandler(const char* expression, const char* file, unsigned int line)
+{
+  std::fprintf(stderr, "Assertion failure from inside RDMnet library. Expression: %s File: %s Line: %u\n", expression,
+               file, line);
+  std::abort();
+}
+
+// Large enough that it can't live on the stack; only one input is parsed at a time.
+static RCMsgBuf tcp_buf;
+
+static const uint8_t* ParseMdnsQuery(const uint8_t* buf_begin, const uint8_t* offset, int remaining_length);
+static const uint8_t* ParseMdnsResourceRecord(const uint8_t* buf_begin, const uint8_t* offset, int remaining_length);
+
+void InitParserHarness()
+{
+  rc_msg_buf_init(&tcp_buf);
+  discovered_broker_module_init();
+  lwmdns_common_module_init();
+}
+
+size_t ParseTcpStream(const uint8_t* data, size_t size, size_t max_chunk_size)
+{
+  if (max_chunk_size == 0)
+    max_chunk_size = 1;
+  rc_msg_buf_reset(&tcp_buf);
+
+  size_t num_parsed = 0;
+  size_t offset = 0;
+  while (offset < size)
+  {
+    size_t   space = 0;
+    uint8_t* recv_space = rc_msg_buf_get_recv_space(&tcp_buf, &space);
+    if (space == 0)
+      break;  // Full of data that can't be parsed; a real connection would stall here too.
+
+    size_t chunk_size = std::min(std::min(space, max_chunk_size), size - offset);
+    std::memcpy(recv_space, &data[offset], chunk_size);
+    rc_msg_buf_commit_recv(&tcp_buf, chunk_size);
+    offset += chunk_size;
+
+    while (rc_msg_buf_parse_data(&tcp_buf) == kEtcPalErrOk)
+    {
+      ++num_parsed;
+      rc_free_message_resources(&tcp_buf.msg);
+    }
+  }
+  return num_parsed;
+}
+
+size_t ParseLlrpDatagram(const uint8_t* data, size_t size)
+{
+  // Mirror the target's receive path: filter on the destination CID first, then parse.
+  EtcPalUuid dest_cid;
+  if (!rc_get_llrp_destination_cid(data, size, &dest_cid))
+    return 0;
+
+  LlrpMessageInterest interest;
+  interest.interested_in_probe_request = true;
+  interest.interested_in_probe_reply = true;
+  interest.my_cid = dest_cid;
+  interest.my_uid = RdmUid{0x6574, 0x12345678};
+
+  LlrpMessage msg;
+  return rc_parse_llrp_message(data, size, &interest, &msg) ? 1 : 0;
+}
+
+size_t ParseMdnsDatagram(const uint8_t* data, size_t size)
+{
+  DnsHeader      header;
+  const uint8_t* cur_ptr = lwmdns_parse_dns_header(data, static_cast<int>(size), &header);
+  if (!cur_ptr)
+    return 0;
+
+  size_t num_parsed = 0;
+  int    remaining_length = static_cast<int>(size) - static_cast<int>(cur_ptr - data);
+  for (uint16_t i = 0; i < header.query_count && remaining_length > 0 && cur_ptr; ++i)
+  {
+    const uint8_t* next_ptr = ParseMdnsQuery(data, cur_ptr, remaining_length);
+    if (next_ptr)
+    {
+      remaining_length -= static_cast<int>(next_ptr - cur_ptr);
+      ++num_parsed;
+    }
+    cur_ptr = next_ptr;
+  }
+
+  unsigned int num_records = header.answer_count + header.authority_count + header.additional_count;
+  for (unsigned int i = 0; i < num_records && remaining_length > 0 && cur_ptr; ++i)
+  {
+    const uint8_t* next_ptr = ParseMdnsResourceRecord(data, cur_ptr, remaining_length);
+    if (next_ptr)
+    {
+      remaining_length -= static_cast<int>(next_ptr - cur_ptr);
+      ++num_parsed;
+    }
+    cur_ptr = next_ptr;
+  }
+  return num_parsed;
+}
+
+const uint8_t* ParseMdnsQuery(const uint8_t* buf_begin, const uint8_t* offset, int remaining_length)
+{
+  const uint8_t* cur_ptr = lwmdns_parse_domain_name(buf_begin, offset, remaining_length);
+  if (!cur_ptr || remaining_length - (cur_ptr - offset) < 4)
+    return nullptr;
+  return cur_ptr + 4;
+}
+
+// Parse the record data the same way the querier does for the record types it handles.
+const uint8_t* ParseMdnsResourceRecord(const uint8_t* buf_begin, const uint8_t* offset, int remaining_length)
+{
+  DnsResourceRecord rr;
+  const uint8_t*    next_ptr = lwmdns_parse_resource_record(buf_begin, offset, remaining_length, &rr);
+  if (!next_ptr)
+    return nullptr;
+
+  char label[DNS_DOMAIN_NAME_MAX_LENGTH];
+  switch (rr.record_type)
+  {
+    case kDnsRecordTypePTR:
+      if (lwmdns_parse_domain_name(buf_begin, rr.data_ptr, rr.data_len))
+      {
+        lwmdns_domain_name_matches_service_subtype(buf_begin, rr.name, "default");
+        lwmdns_domain_label_to_string(buf_begin, rr.data_ptr, label);
+      }
+      break;
+    case kDnsRecordTypeSRV:
+      if (rr.data_len > 7)
+        lwmdns_parse_domain_name(buf_begin, &rr.data_ptr[6], rr.data_len - 6);
+      break;
+    case kDnsRecordTypeTXT: {
+      DiscoveredBroker* db = discovered_broker_new((rdmnet_scope_monitor_t)0, "parser harness", "parser harness");
+      if (db)
+      {
+        lwmdns_txt_record_to_broker_info(rr.data_ptr, rr.data_len, db);
+        discovered_broker_delete(db);
+      }
+      break;
+    }
+    default:
+      break;
+  }
+  return next_ptr;
+}
@@ -0,0 +1,44 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+// parser_harness.h
+// Entry points shared by the parser benchmark and the fuzz targets. Each one runs a complete input
+// through one of the library's parsers the same way the library's receive path does, and returns
+// the number of messages (or, for mDNS, resource records) that were parsed successfully.
+
+#ifndef PARSER_HARNESS_H_
+#define PARSER_HARNESS_H_
+
+#include <cstddef>
+#include <cstdint>
+
+// Must be called once before any of the Parse functions.
+void InitParserHarness();
+
+// Feed a TCP byte stream to an RCMsgBuf, at most max_chunk_size bytes per simulated receive, and
+// parse every Broker, RPT and EPT message in it.
+size_t ParseTcpStream(const uint8_t* data, size_t size, size_t max_chunk_size);
+
+// Parse a single LLRP datagram, as received by an LLRP target or manager.
+size_t ParseLlrpDatagram(const uint8_t* data, size_t size);
+
+// Parse a single mDNS response datagram, as received by the lightweight DNS-SD querier.
+size_t ParseMdnsDatagram(const uint8_t* data, size_t size);
+
+#endif  // PARSER_HARNESS_H_
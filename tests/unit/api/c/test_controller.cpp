@@ -63,6 +63,7 @@ FAKE_VOID_FUNC(handle_controller_responder_ids_received,
                rdmnet_client_scope_t,
                const RdmnetDynamicUidAssignmentList*,
                void*);
+FAKE_VOID_FUNC(handle_controller_send_ready, rdmnet_controller_t, rdmnet_client_scope_t, void*);
 
 FAKE_VOID_FUNC(handle_controller_rdm_command_received,
                rdmnet_controller_t,
@@ -105,6 +106,7 @@ protected:
     RESET_FAKE(handle_controller_rdm_response_received);
     RESET_FAKE(handle_controller_status_received);
     RESET_FAKE(handle_controller_responder_ids_received);
+    RESET_FAKE(handle_controller_send_ready);
     RESET_FAKE(handle_controller_rdm_response_received);
     RESET_FAKE(handle_controller_llrp_rdm_command_received);
   }
@@ -161,3 +163,28 @@ TEST_F(TestControllerApi, CreateRegistersClientCorrectly)
   rdmnet_controller_t handle;
   EXPECT_EQ(rdmnet_controller_create(&config, &handle), kEtcPalErrOk);
 }
+
+static RCClient* registered_client{nullptr};
+
+TEST_F(TestControllerApi, ForwardsSendReadyToApp)
+{
+  rc_rpt_client_register_fake.custom_fake = [](RCClient* client, bool, const EtcPalMcastNetintId*, size_t) {
+    registered_client = client;
+    return kEtcPalErrOk;
+  };
+
+  int context = 0;
+  config.callbacks.context = &context;
+  rdmnet_controller_set_send_ready_callback(&config, handle_controller_send_ready);
+  EXPECT_EQ(config.callbacks.responder_ids_received, handle_controller_responder_ids_received);
+
+  rdmnet_controller_t handle;
+  ASSERT_EQ(rdmnet_controller_create(&config, &handle), kEtcPalErrOk);
+  ASSERT_NE(registered_client, nullptr);
+
+  registered_client->callbacks.send_ready(registered_client, 2);
+  EXPECT_EQ(handle_controller_send_ready_fake.call_count, 1u);
+  EXPECT_EQ(handle_controller_send_ready_fake.arg0_val, handle);
+  EXPECT_EQ(handle_controller_send_ready_fake.arg1_val, 2);
+  EXPECT_EQ(handle_controller_send_ready_fake.arg2_val, &context);
+}
@@ -40,6 +40,7 @@ FAKE_VOID_FUNC(handle_device_llrp_rdm_command_received,
                RdmnetSyncRdmResponse*,
                void*);
 FAKE_VOID_FUNC(handle_device_dynamic_uid_status, rdmnet_device_t, const RdmnetDynamicUidAssignmentList*, void*);
+FAKE_VOID_FUNC(handle_device_send_ready, rdmnet_device_t, void*);
 
 class TestDeviceApi;
 
@@ -62,6 +63,7 @@ protected:
     RESET_FAKE(handle_device_rdm_command_received);
     RESET_FAKE(handle_device_llrp_rdm_command_received);
     RESET_FAKE(handle_device_dynamic_uid_status);
+    RESET_FAKE(handle_device_send_ready);
   }
 
   void SetUp() override
@@ -152,6 +154,29 @@ std::array<RdmnetPhysicalEndpointConfig, 2> kTestPhysEndptConfigs = {
 };
 // clang-format on
 
+static RCClient* registered_client{nullptr};
+
+TEST_F(TestDeviceApi, ForwardsSendReadyToApp)
+{
+  rc_rpt_client_register_fake.custom_fake = [](RCClient* client, bool, const EtcPalMcastNetintId*, size_t) {
+    registered_client = client;
+    return kEtcPalErrOk;
+  };
+
+  int context = 0;
+  config.callbacks.context = &context;
+  rdmnet_device_set_send_ready_callback(&config, handle_device_send_ready);
+  EXPECT_EQ(config.callbacks.dynamic_uid_status_received, handle_device_dynamic_uid_status);
+
+  CreateDeviceWithDefaultConfig();
+  ASSERT_NE(registered_client, nullptr);
+
+  registered_client->callbacks.send_ready(registered_client, 0);
+  EXPECT_EQ(handle_device_send_ready_fake.call_count, 1u);
+  EXPECT_EQ(handle_device_send_ready_fake.arg0_val, default_device_handle_);
+  EXPECT_EQ(handle_device_send_ready_fake.arg1_val, &context);
+}
+
 TEST_F(TestDeviceApi, AddValidPhysicalEndpointWorks)
 {
   CreateDeviceWithDefaultConfig();
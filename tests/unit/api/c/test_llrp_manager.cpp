@@ -28,6 +28,7 @@
 FAKE_VOID_FUNC(handle_llrp_manager_target_discovered, llrp_manager_t, const LlrpDiscoveredTarget*, void*);
 FAKE_VOID_FUNC(handle_llrp_manager_rdm_response_received, llrp_manager_t, const LlrpRdmResponse*, void*);
 FAKE_VOID_FUNC(handle_llrp_manager_discovery_finished, llrp_manager_t, void*);
+FAKE_VOID_FUNC(handle_llrp_manager_rdm_command_timed_out, llrp_manager_t, const LlrpDestinationAddr*, uint32_t, void*);
 
 class TestLlrpManagerApi;
 
@@ -46,6 +47,7 @@ protected:
     RESET_FAKE(handle_llrp_manager_target_discovered);
     RESET_FAKE(handle_llrp_manager_rdm_response_received);
     RESET_FAKE(handle_llrp_manager_discovery_finished);
+    RESET_FAKE(handle_llrp_manager_rdm_command_timed_out);
   }
 
   void SetUp() override
@@ -85,6 +87,7 @@ TEST_F(TestLlrpManagerApi, CreateRegistersManagerCorrectly)
     EXPECT_NE(manager->callbacks.discovery_finished, nullptr);
     EXPECT_NE(manager->callbacks.target_discovered, nullptr);
     EXPECT_NE(manager->callbacks.destroyed, nullptr);
+    EXPECT_NE(manager->callbacks.rdm_command_timed_out, nullptr);
 
     return kEtcPalErrOk;
   };
@@ -93,3 +96,19 @@ TEST_F(TestLlrpManagerApi, CreateRegistersManagerCorrectly)
   EXPECT_EQ(llrp_manager_create(&config_, &handle), kEtcPalErrOk);
   EXPECT_EQ(rc_llrp_manager_register_fake.call_count, 1u);
 }
+
+TEST_F(TestLlrpManagerApi, SetRdmCommandTimedOutCallbackLeavesOtherCallbacksAlone)
+{
+  int context = 0;
+  llrp_manager_config_set_callbacks(&config_, handle_llrp_manager_target_discovered,
+                                    handle_llrp_manager_rdm_response_received, handle_llrp_manager_discovery_finished,
+                                    &context);
+  EXPECT_EQ(config_.callbacks.rdm_command_timed_out, nullptr);
+
+  llrp_manager_config_set_rdm_command_timed_out_callback(&config_, handle_llrp_manager_rdm_command_timed_out);
+  EXPECT_EQ(config_.callbacks.rdm_command_timed_out, handle_llrp_manager_rdm_command_timed_out);
+  EXPECT_EQ(config_.callbacks.target_discovered, handle_llrp_manager_target_discovered);
+  EXPECT_EQ(config_.callbacks.rdm_response_received, handle_llrp_manager_rdm_response_received);
+  EXPECT_EQ(config_.callbacks.discovery_finished, handle_llrp_manager_discovery_finished);
+  EXPECT_EQ(config_.callbacks.context, &context);
+}
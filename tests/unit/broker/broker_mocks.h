@@ -36,6 +36,8 @@ public:
   MOCK_METHOD(void, SetNotify, (BrokerSocketNotify * notify), (override));
   MOCK_METHOD(bool, AddSocket, (BrokerClient::Handle conn_handle, etcpal_socket_t sock), (override));
   MOCK_METHOD(void, RemoveSocket, (BrokerClient::Handle conn_handle), (override));
+  MOCK_METHOD(void, ResumeParkedSockets, (), (override));
+  MOCK_METHOD(void, RequestWritableNotification, (BrokerClient::Handle conn_handle), (override));
 };
 
 class MockBrokerThreadManager : public BrokerThreadInterface
@@ -44,6 +46,7 @@ public:
   MOCK_METHOD(void, SetNotify, (BrokerThreadNotify * notify), (override));
   MOCK_METHOD(etcpal::Error, AddListenThread, (etcpal_socket_t listen_sock), (override));
   MOCK_METHOD(etcpal::Error, AddClientServiceThread, (), (override));
+  MOCK_METHOD(void, WakeClientServiceThreads, (), (override));
   MOCK_METHOD(void, StopThreads, (), (override));
 };
 
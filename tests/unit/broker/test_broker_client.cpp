@@ -21,12 +21,14 @@
 
 #include <cstring>
 #include <memory>
+#include <vector>
 #include "gmock/gmock.h"
 #include "etcpal/cpp/uuid.h"
 #include "etcpal/pack.h"
 #include "etcpal_mock/common.h"
 #include "etcpal_mock/timer.h"
 #include "etcpal_mock/socket.h"
+#include "rdmnet/core/broker_prot.h"
 #include "rdmnet_mock/core/common.h"
 #include "rdm/cpp/uid.h"
 
@@ -79,7 +81,28 @@ TEST_F(TestBaseBrokerClient, SendsBrokerMessage)
 
   EXPECT_EQ(client_->Push(broker_cid_, msg), ClientPushResult::Ok);
   EXPECT_TRUE(client_->Send(broker_cid_));
-  EXPECT_EQ(rc_send_fake.call_count, 1u);
+  EXPECT_EQ(etcpal_send_fake.call_count, 1u);
+}
+
+TEST_F(TestBaseBrokerClient, CountsSentMessages)
+{
+  BrokerMessage msg{};
+  msg.vector = VECTOR_BROKER_CONNECT_REPLY;
+  etcpal_send_fake.custom_fake = [](etcpal_socket_t, const void*, size_t size, int) { return static_cast<int>(size); };
+
+  EXPECT_EQ(client_->Push(broker_cid_, msg), ClientPushResult::Ok);
+  EXPECT_EQ(client_->queue_depth(), 1u);
+
+  // The message waits 3 ms before being sent, which falls in the [2, 4) ms bucket.
+  etcpal_getms_fake.return_val += 3;
+  EXPECT_TRUE(client_->Send(broker_cid_));
+
+  const BrokerClientCounters& counters = client_->counters();
+  EXPECT_EQ(client_->queue_depth(), 0u);
+  EXPECT_EQ(counters.queue_high_water_mark, 1u);
+  EXPECT_EQ(counters.messages_sent, 1u);
+  EXPECT_EQ(counters.bytes_sent, static_cast<uint64_t>(BROKER_CONNECT_REPLY_FULL_MSG_SIZE));
+  EXPECT_EQ(counters.send_latency[2], 1u);
 }
 
 // Generic/unknown clients should send periodic heartbeat messages.
@@ -88,14 +111,53 @@ TEST_F(TestBaseBrokerClient, SendsHeartbeat)
   // Advance time so that the heartbeat send interval has passed
   etcpal_getms_fake.return_val = (E133_TCP_HEARTBEAT_INTERVAL_SEC * 1000) + 500;
 
-  rc_send_fake.custom_fake = [](etcpal_socket_t /*socket*/, const void* data, size_t size, int /*flags*/) {
+  etcpal_send_fake.custom_fake = [](etcpal_socket_t /*socket*/, const void* data, size_t size, int /*flags*/) {
     EXPECT_EQ(size, 44u);
     EXPECT_EQ(etcpal_unpack_u16b(&(reinterpret_cast<const uint8_t*>(data))[42]), VECTOR_BROKER_NULL);
     return 44;
   };
 
   EXPECT_TRUE(client_->Send(broker_cid_));
-  EXPECT_EQ(rc_send_fake.call_count, 1u);
+  EXPECT_EQ(etcpal_send_fake.call_count, 1u);
+}
+
+TEST_F(TestBaseBrokerClient, WouldBlockKeepsMessageQueued)
+{
+  BrokerMessage msg{};
+  msg.vector = VECTOR_BROKER_CONNECT_REPLY;
+  EXPECT_EQ(client_->Push(broker_cid_, msg), ClientPushResult::Ok);
+
+  // The socket's send buffer is full. The send returns right away rather than waiting for it to drain.
+  etcpal_send_fake.return_val = kEtcPalErrWouldBlock;
+  EXPECT_FALSE(client_->Send(broker_cid_));
+  EXPECT_EQ(etcpal_send_fake.call_count, 1u);
+  EXPECT_TRUE(client_->SendBlocked());
+  EXPECT_EQ(client_->queue_depth(), 1u);
+
+  etcpal_send_fake.custom_fake = [](etcpal_socket_t, const void*, size_t size, int) { return static_cast<int>(size); };
+  EXPECT_TRUE(client_->Send(broker_cid_));
+  EXPECT_FALSE(client_->SendBlocked());
+  EXPECT_EQ(client_->queue_depth(), 0u);
+}
+
+TEST_F(TestBaseBrokerClient, PartiallySentHeartbeatIsFinishedFirst)
+{
+  etcpal_getms_fake.return_val = (E133_TCP_HEARTBEAT_INTERVAL_SEC * 1000) + 500;
+  etcpal_send_fake.custom_fake = [](etcpal_socket_t, const void*, size_t, int) { return 10; };
+  EXPECT_TRUE(client_->Send(broker_cid_));
+  EXPECT_TRUE(client_->HasDataToSend());
+
+  BrokerMessage msg{};
+  msg.vector = VECTOR_BROKER_CONNECT_REPLY;
+  EXPECT_EQ(client_->Push(broker_cid_, msg), ClientPushResult::Ok);
+
+  // The rest of the heartbeat goes out ahead of the message queued after it.
+  etcpal_send_fake.custom_fake = [](etcpal_socket_t, const void*, size_t size, int) {
+    EXPECT_EQ(size, static_cast<size_t>(BROKER_NULL_FULL_MSG_SIZE - 10));
+    return static_cast<int>(size);
+  };
+  EXPECT_TRUE(client_->Send(broker_cid_));
+  EXPECT_EQ(client_->queue_depth(), 1u);
 }
 
 TEST_F(TestBaseBrokerClient, HandlesHeartbeatTimeout)
@@ -114,6 +176,8 @@ TEST_F(TestBaseBrokerClient, HonorsMaxQSize)
     ASSERT_EQ(client_->Push(broker_cid_, msg.msg), ClientPushResult::Ok) << "Failed on iteration " << i;
   }
   EXPECT_EQ(client_->Push(broker_cid_, msg.msg), ClientPushResult::QueueFull);
+  EXPECT_EQ(client_->counters().queue_full_count, 1u);
+  EXPECT_EQ(client_->counters().queue_high_water_mark, kMaxQSize);
 }
 
 TEST_F(TestBaseBrokerClient, MaxQSizeInfinite)
@@ -181,7 +245,7 @@ TEST_F(TestBaseBrokerClient, MarkForDestructionSendConnectReplyWorks)
   client_->MarkForDestruction(broker_cid_, broker_uid_,
                               ClientDestroyAction::SendConnectReply(kRdmnetConnectCapacityExceeded));
 
-  rc_send_fake.custom_fake = [](etcpal_socket_t /*socket*/, const void* data, size_t size, int /*flags*/) {
+  etcpal_send_fake.custom_fake = [](etcpal_socket_t /*socket*/, const void* data, size_t size, int /*flags*/) {
     EXPECT_EQ(size, 60u);
     const uint8_t* byte_data = reinterpret_cast<const uint8_t*>(data);
     EXPECT_EQ(etcpal_unpack_u16b(&byte_data[42]), VECTOR_BROKER_CONNECT_REPLY);
@@ -190,7 +254,7 @@ TEST_F(TestBaseBrokerClient, MarkForDestructionSendConnectReplyWorks)
   };
 
   EXPECT_TRUE(client_->Send(broker_cid_));
-  EXPECT_EQ(rc_send_fake.call_count, 1u);
+  EXPECT_EQ(etcpal_send_fake.call_count, 1u);
 }
 
 TEST_F(TestBaseBrokerClient, MarkForDestructionSendDisconnectWorks)
@@ -204,7 +268,7 @@ TEST_F(TestBaseBrokerClient, MarkForDestructionSendDisconnectWorks)
   // Mark for destruction should clear out the queue and put in the disconnect.
   client_->MarkForDestruction(broker_cid_, broker_uid_, ClientDestroyAction::SendDisconnect(kRdmnetDisconnectShutdown));
 
-  rc_send_fake.custom_fake = [](etcpal_socket_t /*socket*/, const void* data, size_t size, int /*flags*/) {
+  etcpal_send_fake.custom_fake = [](etcpal_socket_t /*socket*/, const void* data, size_t size, int /*flags*/) {
     EXPECT_EQ(size, 46u);
     const uint8_t* byte_data = reinterpret_cast<const uint8_t*>(data);
     EXPECT_EQ(etcpal_unpack_u16b(&byte_data[42]), VECTOR_BROKER_DISCONNECT);
@@ -213,7 +277,7 @@ TEST_F(TestBaseBrokerClient, MarkForDestructionSendDisconnectWorks)
   };
 
   EXPECT_TRUE(client_->Send(broker_cid_));
-  EXPECT_EQ(rc_send_fake.call_count, 1u);
+  EXPECT_EQ(etcpal_send_fake.call_count, 1u);
 }
 
 TEST_F(TestBaseBrokerClient, MarkForDestructionMarkSocketInvalidWorks)
@@ -228,7 +292,7 @@ TEST_F(TestBaseBrokerClient, MarkForDestructionMarkSocketInvalidWorks)
   // Mark for destruction should clear out the queue and mark the socket invalid.
   client_->MarkForDestruction(broker_cid_, broker_uid_, ClientDestroyAction::MarkSocketInvalid());
   EXPECT_FALSE(client_->Send(broker_cid_));
-  EXPECT_EQ(rc_send_fake.call_count, 0u);
+  EXPECT_EQ(etcpal_send_fake.call_count, 0u);
   EXPECT_EQ(client_->socket_, ETCPAL_SOCKET_INVALID);
 }
 
@@ -271,14 +335,14 @@ TEST_F(TestBrokerClientRptController, SendsHeartbeat)
   // Advance time so that the heartbeat send interval has passed
   etcpal_getms_fake.return_val = (E133_TCP_HEARTBEAT_INTERVAL_SEC * 1000) + 500;
 
-  rc_send_fake.custom_fake = [](etcpal_socket_t /*socket*/, const void* data, size_t size, int /*flags*/) {
+  etcpal_send_fake.custom_fake = [](etcpal_socket_t /*socket*/, const void* data, size_t size, int /*flags*/) {
     EXPECT_EQ(size, 44u);
     EXPECT_EQ(etcpal_unpack_u16b(&(reinterpret_cast<const uint8_t*>(data))[42]), VECTOR_BROKER_NULL);
     return 44;
   };
 
   EXPECT_TRUE(controller_->Send(broker_cid_));
-  EXPECT_EQ(rc_send_fake.call_count, 1u);
+  EXPECT_EQ(etcpal_send_fake.call_count, 1u);
 }
 
 TEST_F(TestBrokerClientRptController, HandlesHeartbeatTimeout)
@@ -338,6 +402,142 @@ TEST_F(TestBrokerClientRptController, InfiniteMaxQSize)
   }
 }
 
+// A message packed once and pushed to multiple clients should be shared rather than copied.
+TEST_F(TestBrokerClientRptController, PushPackedSharesMessageData)
+{
+  MessageRef packed = PackRptMessage(broker_cid_, request_);
+  ASSERT_TRUE(packed.data);
+  ASSERT_GT(packed.size, 0u);
+
+  BrokerClient  bc(static_cast<BrokerClient::Handle>(2), kClientSocket);
+  RPTController other_controller(kMaxQSize, client_entry_, bc);
+
+  EXPECT_EQ(controller_->PushPacked(sending_controller_handle_, VECTOR_RPT_REQUEST, packed), ClientPushResult::Ok);
+  EXPECT_EQ(other_controller.PushPacked(sending_controller_handle_, VECTOR_RPT_REQUEST, packed), ClientPushResult::Ok);
+  EXPECT_EQ(packed.data.use_count(), 3);
+
+  // Each client sends the full message from the shared buffer.
+  static const uint8_t* expected_data;
+  static size_t         expected_size;
+  expected_data = packed.data.get();
+  expected_size = packed.size;
+  etcpal_send_fake.custom_fake = [](etcpal_socket_t /*socket*/, const void* data, size_t size, int /*flags*/) {
+    EXPECT_EQ(data, expected_data);
+    EXPECT_EQ(size, expected_size);
+    return static_cast<int>(size);
+  };
+
+  EXPECT_TRUE(controller_->Send(broker_cid_));
+  EXPECT_TRUE(other_controller.Send(broker_cid_));
+  EXPECT_EQ(etcpal_send_fake.call_count, 2u);
+  EXPECT_EQ(packed.data.use_count(), 1);
+}
+
+// Routed messages are counted against the queue limit from the moment room is reserved for them
+// until they are sent.
+TEST_F(TestBrokerClientRptController, RoutedMessagesShareQueueLimit)
+{
+  MessageRef packed = PackRptMessage(broker_cid_, request_);
+  ASSERT_TRUE(packed.data);
+
+  for (size_t i = 0; i < kMaxQSize; ++i)
+  {
+    ASSERT_EQ(controller_->PushPacked(sending_controller_handle_, VECTOR_RPT_REQUEST, packed), ClientPushResult::Ok)
+        << "Failed on iteration " << i;
+  }
+  EXPECT_FALSE(controller_->HasRoomToPush());
+  EXPECT_FALSE(controller_->ReserveQueueSpace());
+  EXPECT_EQ(controller_->PushPacked(sending_controller_handle_, VECTOR_RPT_REQUEST, packed),
+            ClientPushResult::QueueFull);
+
+  // Sending one message makes room for one more.
+  etcpal_send_fake.custom_fake = [](etcpal_socket_t, const void*, size_t size, int) { return static_cast<int>(size); };
+  EXPECT_TRUE(controller_->Send(broker_cid_));
+  EXPECT_TRUE(controller_->HasRoomToPush());
+
+  // A rejected push gives back the room it reserved.
+  ASSERT_TRUE(controller_->ReserveQueueSpace());
+  EXPECT_EQ(controller_->PushReserved(sending_controller_handle_, VECTOR_RPT_STATUS + 100, packed),
+            ClientPushResult::Error);
+  EXPECT_TRUE(controller_->HasRoomToPush());
+}
+
+// A broadcast which doesn't fit is counted as dropped, not as a message rejected for a full queue.
+TEST_F(TestBrokerClientRptController, DroppedBroadcastsAreNotCountedAsQueueFull)
+{
+  for (size_t i = 0; i < kMaxQSize; ++i)
+    ASSERT_TRUE(controller_->ReserveBroadcastQueueSpace()) << "Failed on iteration " << i;
+
+  EXPECT_FALSE(controller_->ReserveBroadcastQueueSpace());
+  EXPECT_EQ(controller_->counters().broadcasts_dropped, 1u);
+  EXPECT_EQ(controller_->counters().queue_full_count, 0u);
+
+  EXPECT_FALSE(controller_->ReserveQueueSpace());
+  EXPECT_EQ(controller_->counters().broadcasts_dropped, 1u);
+  EXPECT_EQ(controller_->counters().queue_full_count, 1u);
+}
+
+class CountingClientNotify : public BrokerClientNotify
+{
+public:
+  void HandleClientDataQueued(BrokerClient& /*client*/) override { ++num_notifications; }
+
+  unsigned int num_notifications{0};
+};
+
+// The broker is only told a client needs servicing for the first message queued since the client was
+// last serviced.
+TEST_F(TestBrokerClientRptController, NotifiesOnlyWhenServiceIsNeeded)
+{
+  CountingClientNotify notify;
+  controller_->notify_ = &notify;
+
+  MessageRef packed = PackRptMessage(broker_cid_, request_);
+  ASSERT_TRUE(packed.data);
+
+  ASSERT_EQ(controller_->PushPacked(sending_controller_handle_, VECTOR_RPT_REQUEST, packed), ClientPushResult::Ok);
+  ASSERT_EQ(controller_->PushPacked(sending_controller_handle_, VECTOR_RPT_REQUEST, packed), ClientPushResult::Ok);
+  ASSERT_EQ(controller_->Push(broker_cid_, rpt_header_, status_msg_), ClientPushResult::Ok);
+  EXPECT_EQ(notify.num_notifications, 1u);
+
+  controller_->ClearServiceRequest();
+  ASSERT_EQ(controller_->PushPacked(sending_controller_handle_, VECTOR_RPT_REQUEST, packed), ClientPushResult::Ok);
+  ASSERT_EQ(controller_->PushPacked(sending_controller_handle_, VECTOR_RPT_REQUEST, packed), ClientPushResult::Ok);
+  EXPECT_EQ(notify.num_notifications, 2u);
+}
+
+// A client list is packed in chunks as it is sent, and anything queued after it is sent after all of
+// the chunks.
+TEST_F(TestBrokerClientRptController, SendsClientListInChunks)
+{
+  std::vector<RdmnetRptClientEntry> entries(BrokerClient::kClientListChunkSize * 2 + 1, client_entry_);
+  ASSERT_EQ(controller_->PushRptClientList(broker_cid_, std::move(entries)), ClientPushResult::Ok);
+
+  GenericBrokerMessage remove_msg;
+  remove_msg.msg.vector = VECTOR_BROKER_CLIENT_REMOVE;
+  ASSERT_EQ(controller_->Push(broker_cid_, remove_msg.msg), ClientPushResult::Ok);
+
+  static std::vector<uint16_t> sent_vectors;
+  static std::vector<size_t>   sent_sizes;
+  sent_vectors.clear();
+  sent_sizes.clear();
+  etcpal_send_fake.custom_fake = [](etcpal_socket_t /*socket*/, const void* data, size_t size, int /*flags*/) {
+    sent_vectors.push_back(etcpal_unpack_u16b(&(reinterpret_cast<const uint8_t*>(data))[42]));
+    sent_sizes.push_back(size);
+    return static_cast<int>(size);
+  };
+
+  for (int i = 0; i < 4; ++i)
+    EXPECT_TRUE(controller_->Send(broker_cid_));
+  EXPECT_FALSE(controller_->HasDataToSend());
+
+  EXPECT_THAT(sent_vectors, testing::ElementsAre(VECTOR_BROKER_CONNECTED_CLIENT_LIST, VECTOR_BROKER_CLIENT_ADD,
+                                                 VECTOR_BROKER_CLIENT_ADD, VECTOR_BROKER_CLIENT_REMOVE));
+  ASSERT_EQ(sent_sizes.size(), 4u);
+  EXPECT_EQ(sent_sizes[0], rc_broker_get_rpt_client_list_buffer_size(BrokerClient::kClientListChunkSize));
+  EXPECT_EQ(sent_sizes[2], rc_broker_get_rpt_client_list_buffer_size(1));
+}
+
 class TestBrokerClientRptDevice : public testing::Test
 {
 public:
@@ -378,14 +578,14 @@ TEST_F(TestBrokerClientRptDevice, SendsHeartbeat)
   // Advance time so that the heartbeat send interval has passed
   etcpal_getms_fake.return_val = (E133_TCP_HEARTBEAT_INTERVAL_SEC * 1000) + 500;
 
-  rc_send_fake.custom_fake = [](etcpal_socket_t /*socket*/, const void* data, size_t size, int /*flags*/) {
+  etcpal_send_fake.custom_fake = [](etcpal_socket_t /*socket*/, const void* data, size_t size, int /*flags*/) {
     EXPECT_EQ(size, 44u);
     EXPECT_EQ(etcpal_unpack_u16b(&(reinterpret_cast<const uint8_t*>(data))[42]), VECTOR_BROKER_NULL);
     return 44;
   };
 
   EXPECT_TRUE(device_->Send(broker_cid_));
-  EXPECT_EQ(rc_send_fake.call_count, 1u);
+  EXPECT_EQ(etcpal_send_fake.call_count, 1u);
 }
 
 TEST_F(TestBrokerClientRptDevice, HandlesHeartbeatTimeout)
@@ -419,7 +619,7 @@ TEST_F(TestBrokerClientRptDevice, HonorsMaxQSize)
 TEST_F(TestBrokerClientRptDevice, QEmptiesAndFillsCorrectly)
 {
   // Make send return success
-  rc_send_fake.custom_fake = [](etcpal_socket_t socket, const void*, size_t size, int /*flags*/) {
+  etcpal_send_fake.custom_fake = [](etcpal_socket_t socket, const void*, size_t size, int /*flags*/) {
     EXPECT_EQ(socket, TestBrokerClientRptDevice::kClientSocket);
     return (int)size;
   };
@@ -481,6 +681,98 @@ TEST_F(TestBrokerClientRptDevice, InfiniteMaxQSize)
   }
 }
 
+TEST_F(TestBrokerClientRptDevice, BatchedSendCombinesQueuedMessages)
+{
+  device_->max_send_batch_size_ = 65536;
+
+  GenericBrokerMessage broker_msg;
+  static size_t        total_size;
+  total_size = 0;
+  for (size_t i = 0; i < 10; ++i)
+  {
+    if (i % 2 == 0)
+    {
+      ASSERT_EQ(device_->Push(broker_cid_, broker_msg.msg), ClientPushResult::Ok);
+      total_size += rc_broker_get_rpt_client_list_buffer_size(1);
+    }
+    else
+    {
+      ASSERT_EQ(device_->Push(static_cast<BrokerClient::Handle>(kClientHandle + i), broker_cid_, request_),
+                ClientPushResult::Ok);
+      total_size += rc_rpt_get_request_buffer_size(&rdm_buf_);
+    }
+  }
+
+  // The first send only takes half of the data; the rest should go out in the next send.
+  etcpal_send_fake.custom_fake = [](etcpal_socket_t /*socket*/, const void* /*data*/, size_t size, int /*flags*/) {
+    EXPECT_EQ(size, total_size);
+    return static_cast<int>(size / 2);
+  };
+  EXPECT_TRUE(device_->Send(broker_cid_));
+  EXPECT_EQ(etcpal_send_fake.call_count, 1u);
+  EXPECT_TRUE(device_->HasDataToSend());
+
+  total_size -= total_size / 2;
+  etcpal_send_fake.custom_fake = [](etcpal_socket_t /*socket*/, const void* /*data*/, size_t size, int /*flags*/) {
+    EXPECT_EQ(size, total_size);
+    return static_cast<int>(size);
+  };
+  EXPECT_TRUE(device_->Send(broker_cid_));
+  EXPECT_EQ(etcpal_send_fake.call_count, 2u);
+  EXPECT_FALSE(device_->HasDataToSend());
+}
+
+TEST_F(TestBrokerClientRptDevice, BatchedMessagesHoldQueueSpaceUntilSent)
+{
+  device_->max_send_batch_size_ = 65536;
+
+  for (size_t i = 0; i < kMaxQSize; ++i)
+  {
+    ASSERT_EQ(device_->Push(static_cast<BrokerClient::Handle>(kClientHandle + 1), broker_cid_, request_),
+              ClientPushResult::Ok);
+  }
+
+  // Everything is moved into the batch, but the socket takes none of it.
+  etcpal_send_fake.return_val = kEtcPalErrWouldBlock;
+  EXPECT_FALSE(device_->Send(broker_cid_));
+  EXPECT_EQ(device_->queue_depth(), kMaxQSize);
+  EXPECT_EQ(device_->Push(kClientHandle + 1, broker_cid_, request_), ClientPushResult::QueueFull);
+
+  etcpal_send_fake.custom_fake = [](etcpal_socket_t /*socket*/, const void* /*data*/, size_t size, int /*flags*/) {
+    return static_cast<int>(size);
+  };
+  EXPECT_TRUE(device_->Send(broker_cid_));
+  EXPECT_EQ(device_->queue_depth(), 0u);
+  EXPECT_EQ(device_->Push(kClientHandle + 1, broker_cid_, request_), ClientPushResult::Ok);
+}
+
+TEST_F(TestBrokerClientRptDevice, BatchedSendErrorRemovesController)
+{
+  device_->max_send_batch_size_ = 65536;
+
+  const auto controller_1_handle = kClientHandle + 1;
+  const auto controller_2_handle = kClientHandle + 2;
+  for (size_t i = 0; i < 3; ++i)
+    ASSERT_EQ(device_->Push(controller_1_handle, broker_cid_, request_), ClientPushResult::Ok);
+  for (size_t i = 0; i < 2; ++i)
+    ASSERT_EQ(device_->Push(controller_2_handle, broker_cid_, request_), ClientPushResult::Ok);
+
+  // A send error with controller 1's message at the front of the batch drops all of controller 1's
+  // messages, as the unbatched Send() would.
+  etcpal_send_fake.return_val = kEtcPalErrConnReset;
+  EXPECT_FALSE(device_->Send(broker_cid_));
+  EXPECT_EQ(device_->queue_depth(), 2u);
+
+  static size_t expected_size;
+  expected_size = 2 * rc_rpt_get_request_buffer_size(&rdm_buf_);
+  etcpal_send_fake.custom_fake = [](etcpal_socket_t /*socket*/, const void* /*data*/, size_t size, int /*flags*/) {
+    EXPECT_EQ(size, expected_size);
+    return static_cast<int>(size);
+  };
+  EXPECT_TRUE(device_->Send(broker_cid_));
+  EXPECT_FALSE(device_->HasDataToSend());
+}
+
 // Helper function and data for the FairScheduler test.
 
 static const etcpal::Uuid kController1Cid({1, 2, 3, 4, 5, 6, 7, 8});
@@ -488,7 +780,7 @@ static const etcpal::Uuid kController2Cid({1, 2, 3, 4, 255, 254, 253, 252});
 static const etcpal::Uuid kController3Cid({255, 254, 253, 252, 251, 250, 249, 248});
 
 // Sends the next queue message from an RPTDevice and verifies that the buffer given to
-// rc_send() contains a given controller's CID. The CIDs are predefined globally because
+// etcpal_send() contains a given controller's CID. The CIDs are predefined globally because
 // the fake function pointer must be stateless.
 template <size_t Controller>
 void SendAndVerify(RPTDevice* device, const etcpal::Uuid& broker_cid)
@@ -498,14 +790,14 @@ void SendAndVerify(RPTDevice* device, const etcpal::Uuid& broker_cid)
 
   SCOPED_TRACE(std::string("While verifying CID for controller ") + std::to_string(Controller));
 
-  RESET_FAKE(rc_send);
-  rc_send_fake.custom_fake = [](etcpal_socket_t socket, const void* data, size_t size, int /*flags*/) {
+  RESET_FAKE(etcpal_send);
+  etcpal_send_fake.custom_fake = [](etcpal_socket_t socket, const void* data, size_t size, int /*flags*/) {
     EXPECT_EQ(socket, TestBrokerClientRptDevice::kClientSocket);
     EXPECT_EQ(std::memcmp(&(reinterpret_cast<const uint8_t*>(data))[23], controllers[Controller - 1]->data(), 16), 0);
     return (int)size;
   };
   EXPECT_TRUE(device->Send(broker_cid));
-  EXPECT_EQ(rc_send_fake.call_count, 1u);
+  EXPECT_EQ(etcpal_send_fake.call_count, 1u);
 }
 
 TEST_F(TestBrokerClientRptDevice, FairScheduler)
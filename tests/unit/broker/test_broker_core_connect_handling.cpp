@@ -74,7 +74,7 @@ TEST_F(TestBrokerCoreConnectHandling, HandlesConnect)
   BrokerClient::Handle conn_handle = AddTcpConn();
   RdmnetMessage        connect_msg = testmsgs::ClientConnect(client_cid);
 
-  rc_send_fake.custom_fake = [](etcpal_socket_t, const void* data, size_t data_size, int) -> int {
+  etcpal_send_fake.custom_fake = [](etcpal_socket_t, const void* data, size_t data_size, int) -> int {
     EXPECT_EQ(data_size, static_cast<size_t>(BROKER_CONNECT_REPLY_FULL_MSG_SIZE));
     EXPECT_NE(data, nullptr);
 
@@ -86,10 +86,10 @@ TEST_F(TestBrokerCoreConnectHandling, HandlesConnect)
   };
   mocks_.broker_callbacks->HandleSocketMessageReceived(conn_handle, connect_msg);
   EXPECT_TRUE(mocks_.broker_callbacks->ServiceClients());
-  EXPECT_EQ(rc_send_fake.call_count, 1u);
+  EXPECT_EQ(etcpal_send_fake.call_count, 1u);
   EXPECT_EQ(broker_.GetNumClients(), 1u);
 
-  RESET_FAKE(rc_send);
+  RESET_FAKE(etcpal_send);
 }
 
 TEST_F(TestBrokerCoreConnectHandling, RejectsScopeMismatch)
@@ -98,7 +98,7 @@ TEST_F(TestBrokerCoreConnectHandling, RejectsScopeMismatch)
   BrokerClient::Handle conn_handle = AddTcpConn();
   RdmnetMessage        connect_msg = testmsgs::ClientConnect(client_cid, "Not Default Scope");
 
-  rc_send_fake.custom_fake = [](etcpal_socket_t, const void* data, size_t data_size, int) -> int {
+  etcpal_send_fake.custom_fake = [](etcpal_socket_t, const void* data, size_t data_size, int) -> int {
     EXPECT_EQ(data_size, static_cast<size_t>(BROKER_CONNECT_REPLY_FULL_MSG_SIZE));
     EXPECT_NE(data, nullptr);
 
@@ -111,7 +111,7 @@ TEST_F(TestBrokerCoreConnectHandling, RejectsScopeMismatch)
 
   mocks_.broker_callbacks->HandleSocketMessageReceived(conn_handle, connect_msg);
   EXPECT_TRUE(mocks_.broker_callbacks->ServiceClients());
-  EXPECT_EQ(rc_send_fake.call_count, 1u);
+  EXPECT_EQ(etcpal_send_fake.call_count, 1u);
 
   // Rejected client should be cleaned up
   etcpal_getms_fake.return_val += 1000;
@@ -133,3 +133,120 @@ TEST_F(TestBrokerCoreConnectHandling, HandlesRemoveUidOnDisconnect)
   mocks_.broker_callbacks->HandleSocketMessageReceived(conn_handle, disconnect_msg);
   EXPECT_FALSE(broker_.IsValidControllerDestinationUID(rdm::Uid(0xe574, 0x00000002).get()));
 }
+
+TEST_F(TestBrokerCoreConnectHandling, QueuedReplyWakesClientServiceThreads)
+{
+  auto                 client_cid = etcpal::Uuid::OsPreferred();
+  BrokerClient::Handle conn_handle = AddTcpConn();
+  RdmnetMessage        connect_msg = testmsgs::ClientConnect(client_cid);
+
+  EXPECT_CALL(*mocks_.threads, WakeClientServiceThreads()).Times(testing::AtLeast(1));
+  mocks_.broker_callbacks->HandleSocketMessageReceived(conn_handle, connect_msg);
+  testing::Mock::VerifyAndClearExpectations(mocks_.threads);
+
+  // Once the reply has been sent, there is nothing left to service until the next heartbeat.
+  EXPECT_TRUE(mocks_.broker_callbacks->ServiceClients());
+  EXPECT_FALSE(mocks_.broker_callbacks->ServiceClients());
+  EXPECT_EQ(etcpal_send_fake.call_count, 1u);
+}
+
+class TestBrokerCoreClientListUpdates : public TestBrokerCoreConnectHandling
+{
+protected:
+  static constexpr unsigned int kUpdateWindowMs{50u};
+
+  static unsigned int num_client_add_msgs_;
+  static unsigned int num_client_remove_msgs_;
+
+  void SetUp() override
+  {
+    etcpal_reset_all_fakes();
+    rdmnet_mock_core_reset_and_init();
+
+    num_client_add_msgs_ = 0;
+    num_client_remove_msgs_ = 0;
+    etcpal_send_fake.custom_fake = [](etcpal_socket_t, const void* data, size_t data_size, int) -> int {
+      const uint8_t* byte_data = reinterpret_cast<const uint8_t*>(data);
+      if (etcpal_unpack_u32b(&byte_data[kRootVectorOffset]) == ACN_VECTOR_ROOT_BROKER)
+      {
+        uint16_t vector = etcpal_unpack_u16b(&byte_data[kBrokerVectorOffset]);
+        if (vector == VECTOR_BROKER_CLIENT_ADD)
+          ++num_client_add_msgs_;
+        else if (vector == VECTOR_BROKER_CLIENT_REMOVE)
+          ++num_client_remove_msgs_;
+      }
+      return static_cast<int>(data_size);
+    };
+
+    auto settings = DefaultBrokerSettings();
+    settings.client_list_update_window_ms = kUpdateWindowMs;
+    ASSERT_TRUE(StartBroker(broker_, settings, mocks_));
+  }
+
+  BrokerClient::Handle Connect(const etcpal::Uuid& cid, rpt_client_type_t type)
+  {
+    BrokerClient::Handle conn_handle = AddTcpConn();
+    mocks_.broker_callbacks->HandleSocketMessageReceived(conn_handle,
+                                                         testmsgs::ClientConnect(cid, E133_DEFAULT_SCOPE, type));
+    return conn_handle;
+  }
+};
+
+unsigned int TestBrokerCoreClientListUpdates::num_client_add_msgs_;
+unsigned int TestBrokerCoreClientListUpdates::num_client_remove_msgs_;
+
+TEST_F(TestBrokerCoreClientListUpdates, CombinesAddsWithinWindow)
+{
+  Connect(etcpal::Uuid::OsPreferred(), kRPTClientTypeController);
+  for (int i = 0; i < 3; ++i)
+    Connect(etcpal::Uuid::OsPreferred(), kRPTClientTypeDevice);
+
+  // Nothing is reported until the window has elapsed.
+  mocks_.broker_callbacks->ServiceClients();
+  EXPECT_EQ(num_client_add_msgs_, 0u);
+
+  etcpal_getms_fake.return_val += kUpdateWindowMs;
+  EXPECT_TRUE(mocks_.broker_callbacks->ServiceClients());
+  EXPECT_EQ(num_client_add_msgs_, 1u);
+}
+
+TEST_F(TestBrokerCoreClientListUpdates, ClientRemovedWithinWindowIsNotReported)
+{
+  Connect(etcpal::Uuid::OsPreferred(), kRPTClientTypeController);
+
+  // Let the controller's own connection go by, which it is not told about.
+  etcpal_getms_fake.return_val += kUpdateWindowMs;
+  mocks_.broker_callbacks->ServiceClients();
+
+  auto                 device_cid = etcpal::Uuid::OsPreferred();
+  BrokerClient::Handle device_handle = Connect(device_cid, kRPTClientTypeDevice);
+  mocks_.broker_callbacks->HandleSocketMessageReceived(
+      device_handle, testmsgs::ClientDisconnect(device_cid, kRdmnetDisconnectShutdown));
+
+  etcpal_getms_fake.return_val += kUpdateWindowMs;
+  mocks_.broker_callbacks->ServiceClients();
+  EXPECT_EQ(num_client_add_msgs_, 0u);
+  EXPECT_EQ(num_client_remove_msgs_, 0u);
+}
+
+// A controller which fetches the client list while a client's add is pending gets that client in the
+// list, so it must be told when the client goes away, even within the same window.
+TEST_F(TestBrokerCoreClientListUpdates, ClientRemovedAfterClientListFetchIsReported)
+{
+  auto                 controller_cid = etcpal::Uuid::OsPreferred();
+  BrokerClient::Handle controller_handle = Connect(controller_cid, kRPTClientTypeController);
+  etcpal_getms_fake.return_val += kUpdateWindowMs;
+  mocks_.broker_callbacks->ServiceClients();
+
+  auto                 device_cid = etcpal::Uuid::OsPreferred();
+  BrokerClient::Handle device_handle = Connect(device_cid, kRPTClientTypeDevice);
+  mocks_.broker_callbacks->HandleSocketMessageReceived(controller_handle, testmsgs::FetchClientList(controller_cid));
+  mocks_.broker_callbacks->HandleSocketMessageReceived(
+      device_handle, testmsgs::ClientDisconnect(device_cid, kRdmnetDisconnectShutdown));
+
+  // The client list goes out first, then the remove.
+  etcpal_getms_fake.return_val += kUpdateWindowMs;
+  mocks_.broker_callbacks->ServiceClients();
+  mocks_.broker_callbacks->ServiceClients();
+  EXPECT_EQ(num_client_remove_msgs_, 1u);
+}
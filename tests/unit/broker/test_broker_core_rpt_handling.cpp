@@ -21,6 +21,8 @@
 
 #include "broker_core.h"
 
+#include <algorithm>
+#include <vector>
 #include "gmock/gmock.h"
 #include "etcpal_mock/common.h"
 #include "etcpal_mock/socket.h"
@@ -49,19 +51,21 @@ protected:
   static constexpr uint16_t     kTestManu2{0x7465};
   static constexpr unsigned int kMaxControllerMessages{10u};
   static constexpr unsigned int kMaxDeviceMessages{20u};
+  static constexpr unsigned int kSlowClientDisconnectMs{2000u};
 
   void SetUp() override
   {
     etcpal_reset_all_fakes();
     rdmnet_mock_core_reset_and_init();
 
-    rc_send_fake.custom_fake = [](etcpal_socket_t, const void*, size_t data_size, int) -> int {
+    etcpal_send_fake.custom_fake = [](etcpal_socket_t, const void*, size_t data_size, int) -> int {
       return (int)data_size;
     };
 
     auto settings = DefaultBrokerSettings();
     settings.limits.controller_messages = kMaxControllerMessages;
     settings.limits.device_messages = kMaxDeviceMessages;
+    settings.slow_client_disconnect_ms = kSlowClientDisconnectMs;
     ASSERT_TRUE(StartBroker(broker_, settings, mocks_));
   }
 
@@ -72,6 +76,8 @@ protected:
   void                 TestMessageLimitWithHarvest(BrokerClient::Handle sender_handle,
                                                    const RdmnetMessage& msg,
                                                    unsigned int         num_remaining_messages_allowed);
+  void                 SendBroadcasts(BrokerClient::Handle sender_handle, const RdmnetMessage& msg, unsigned int count);
+  rdmnet::Broker::ClientStatistics GetClientStats(BrokerClient::Handle handle);
 };
 
 BrokerClient::Handle TestBrokerCoreRptHandling::AddClient(const etcpal::Uuid& cid,
@@ -120,63 +126,385 @@ void TestBrokerCoreRptHandling::TestMessageLimitWithHarvest(BrokerClient::Handle
   TestMessageLimit(sender_handle, msg, 1u);
 }
 
-TEST_F(TestBrokerCoreRptHandling, DeviceBroadcastThrottlesAtMaxLimit)
+// Broadcasts are never held back, whether or not every destination has room for them.
+void TestBrokerCoreRptHandling::SendBroadcasts(BrokerClient::Handle sender_handle,
+                                               const RdmnetMessage& msg,
+                                               unsigned int         count)
+{
+  for (unsigned int i = 0u; i < count; ++i)
+  {
+    EXPECT_EQ(mocks_.broker_callbacks->HandleSocketMessageReceived(sender_handle, msg),
+              HandleMessageResult::kGetNextMessage);
+  }
+}
+
+rdmnet::Broker::ClientStatistics TestBrokerCoreRptHandling::GetClientStats(BrokerClient::Handle handle)
+{
+  auto stats = broker_.GetStatistics();
+  auto client = std::find_if(stats.clients.begin(), stats.clients.end(),
+                             [&](const rdmnet::Broker::ClientStatistics& client) { return client.handle == handle; });
+  EXPECT_NE(client, stats.clients.end());
+  return (client == stats.clients.end() ? rdmnet::Broker::ClientStatistics{} : *client);
+}
+
+TEST_F(TestBrokerCoreRptHandling, DeviceBroadcastSkipsFullDestinations)
 {
   static constexpr int kNumDestinations = 3u;
 
+  std::vector<BrokerClient::Handle> device_handles;
   for (int i = 0u; i < kNumDestinations; ++i)
-    AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeDevice, kTestManu1);
+    device_handles.push_back(AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeDevice, kTestManu1));
 
   auto sender_handle = AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeController, kTestManu1);
 
+  // Fill every device's queue; the last three broadcasts are dropped for all of them.
   auto test_cmd = TestRdmCommand::GetBroadcast(E120_DEVICE_INFO);
-  TestMessageLimitWithHarvest(sender_handle, test_cmd.msg, kMaxDeviceMessages);
+  SendBroadcasts(sender_handle, test_cmd.msg, kMaxDeviceMessages + 3u);
+  for (auto handle : device_handles)
+  {
+    auto device_stats = GetClientStats(handle);
+    EXPECT_EQ(device_stats.queue_depth, kMaxDeviceMessages);
+    EXPECT_EQ(device_stats.broadcast_drop_count, 3u);
+  }
+
+  // Harvesting a message from each queue makes room for one more broadcast.
+  EXPECT_TRUE(mocks_.broker_callbacks->ServiceClients());
+  SendBroadcasts(sender_handle, test_cmd.msg, 1u);
+  for (auto handle : device_handles)
+  {
+    auto device_stats = GetClientStats(handle);
+    EXPECT_EQ(device_stats.queue_depth, kMaxDeviceMessages);
+    EXPECT_EQ(device_stats.broadcast_drop_count, 3u);
+  }
 
   testing::Mock::VerifyAndClearExpectations(mocks_.socket_mgr);
 }
 
-TEST_F(TestBrokerCoreRptHandling, ControllerBroadcastThrottlesAtMaxLimit)
+TEST_F(TestBrokerCoreRptHandling, ControllerBroadcastSkipsFullDestinations)
 {
   static constexpr int kNumDestinations = 3u;
 
+  std::vector<BrokerClient::Handle> controller_handles;
   for (int i = 0u; i < kNumDestinations; ++i)
-    AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeController, kTestManu1);
+    controller_handles.push_back(AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeController, kTestManu1));
 
   auto sender_handle = AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeDevice, kTestManu1);
 
   auto test_response = TestRdmResponse::GetResponseBroadcast(kTestControllerUid, E120_DEVICE_INFO);
-  TestMessageLimitWithHarvest(sender_handle, test_response.msg, kMaxControllerMessages);
+  SendBroadcasts(sender_handle, test_response.msg, kMaxControllerMessages + 3u);
+  for (auto handle : controller_handles)
+  {
+    auto controller_stats = GetClientStats(handle);
+    EXPECT_EQ(controller_stats.queue_depth, kMaxControllerMessages);
+    EXPECT_EQ(controller_stats.broadcast_drop_count, 3u);
+  }
 
   testing::Mock::VerifyAndClearExpectations(mocks_.socket_mgr);
 }
 
-TEST_F(TestBrokerCoreRptHandling, DeviceManuBroadcastThrottlesAtMaxLimit)
+TEST_F(TestBrokerCoreRptHandling, DeviceManuBroadcastSkipsFullDestinations)
 {
   static constexpr int kNumDestinationsForManu1 = 5u;
   static constexpr int kNumDestinationsForManu2 = 2u;
 
+  std::vector<BrokerClient::Handle> manu1_handles;
+  std::vector<BrokerClient::Handle> manu2_handles;
   for (int i = 0u; i < kNumDestinationsForManu1; ++i)
-    AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeDevice, kTestManu1);
+    manu1_handles.push_back(AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeDevice, kTestManu1));
   for (int i = 0u; i < kNumDestinationsForManu2; ++i)
-    AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeDevice, kTestManu2);
+    manu2_handles.push_back(AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeDevice, kTestManu2));
 
   auto sender_handle = AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeController, kTestManu1);
 
-  // Test manu2 message limit
+  // Fill the manu2 devices' queues
   auto test_manu2_cmd = TestRdmCommand::GetManuBroadcast(kTestManu2, E120_DEVICE_INFO);
-  TestMessageLimitWithHarvest(sender_handle, test_manu2_cmd.msg, kMaxDeviceMessages);
+  SendBroadcasts(sender_handle, test_manu2_cmd.msg, kMaxDeviceMessages);
 
-  // Verify no all-device broadcasts can be sent due to manu2 limit
+  // An all-device broadcast still reaches the manu1 devices, and is dropped for the manu2 devices.
   auto test_all_manu_cmd = TestRdmCommand::GetBroadcast(E120_DEVICE_INFO);
-  TestMessageLimit(sender_handle, test_all_manu_cmd.msg, 0u);
+  SendBroadcasts(sender_handle, test_all_manu_cmd.msg, 1u);
+  for (auto handle : manu1_handles)
+  {
+    auto device_stats = GetClientStats(handle);
+    EXPECT_EQ(device_stats.queue_depth, 1u);
+    EXPECT_EQ(device_stats.broadcast_drop_count, 0u);
+  }
+  for (auto handle : manu2_handles)
+  {
+    auto device_stats = GetClientStats(handle);
+    EXPECT_EQ(device_stats.queue_depth, kMaxDeviceMessages);
+    EXPECT_EQ(device_stats.broadcast_drop_count, 1u);
+  }
+
+  testing::Mock::VerifyAndClearExpectations(mocks_.socket_mgr);
+}
+
+TEST_F(TestBrokerCoreRptHandling, FullDestinationDoesNotBlockOtherDestinations)
+{
+  auto manu1_device_handle = AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeDevice, kTestManu1);
+  auto manu2_device_handle = AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeDevice, kTestManu2);
+
+  auto blocked_sender_handle = AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeController, kTestManu1);
+  auto other_sender_handle = AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeController, kTestManu1);
+
+  // Fill the manu2 device's queue. From here on, the first sender's socket is parked.
+  auto test_manu2_cmd = TestRdmCommand::Get(GetClientStats(manu2_device_handle).uid.get(), E120_DEVICE_INFO);
+  TestMessageLimit(blocked_sender_handle, test_manu2_cmd.msg, kMaxDeviceMessages);
+
+  // Messages to other destinations are still routed immediately.
+  auto test_manu1_cmd = TestRdmCommand::Get(GetClientStats(manu1_device_handle).uid.get(), E120_DEVICE_INFO);
+  TestMessageLimit(other_sender_handle, test_manu1_cmd.msg, kMaxDeviceMessages);
+
+  testing::Mock::VerifyAndClearExpectations(mocks_.socket_mgr);
+}
+
+TEST_F(TestBrokerCoreRptHandling, DrainingFullQueueResumesParkedSockets)
+{
+  auto device_handle = AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeDevice, kTestManu1);
+  auto sender_handle = AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeController, kTestManu1);
+
+  auto test_cmd = TestRdmCommand::Get(GetClientStats(device_handle).uid.get(), E120_DEVICE_INFO);
+
+  // Nothing is parked, so sending shouldn't resume anything.
+  EXPECT_CALL(*mocks_.socket_mgr, ResumeParkedSockets()).Times(0);
+  EXPECT_EQ(mocks_.broker_callbacks->HandleSocketMessageReceived(sender_handle, test_cmd.msg),
+            HandleMessageResult::kGetNextMessage);
+  EXPECT_TRUE(mocks_.broker_callbacks->ServiceClients());
+  testing::Mock::VerifyAndClearExpectations(mocks_.socket_mgr);
+
+  // Once a message has been rejected, the next pass that drains a queue should resume parked sockets exactly once.
+  TestMessageLimit(sender_handle, test_cmd.msg, kMaxDeviceMessages);
+  EXPECT_CALL(*mocks_.socket_mgr, ResumeParkedSockets()).Times(1);
+  EXPECT_TRUE(mocks_.broker_callbacks->ServiceClients());
+  EXPECT_TRUE(mocks_.broker_callbacks->ServiceClients());
+
+  // The parked message can now be routed.
+  EXPECT_EQ(mocks_.broker_callbacks->HandleSocketMessageReceived(sender_handle, test_cmd.msg),
+            HandleMessageResult::kGetNextMessage);
+
+  testing::Mock::VerifyAndClearExpectations(mocks_.socket_mgr);
+}
+
+// A reader thread can reject a message just before a pass makes room, but only flag the rejection
+// after that pass has finished. The room made must not be forgotten.
+TEST_F(TestBrokerCoreRptHandling, RoomMadeBeforeRejectionStillResumesParkedSockets)
+{
+  auto device_handle = AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeDevice, kTestManu1);
+  auto sender_handle = AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeController, kTestManu1);
 
-  // Test manu1 message limit
-  auto test_manu1_cmd = TestRdmCommand::GetManuBroadcast(kTestManu1, E120_DEVICE_INFO);
-  TestMessageLimit(sender_handle, test_manu1_cmd.msg, kMaxDeviceMessages);
+  auto test_cmd = TestRdmCommand::Get(GetClientStats(device_handle).uid.get(), E120_DEVICE_INFO);
 
-  // Harvesting a message from each queue should allow one all-device broadcast
+  EXPECT_CALL(*mocks_.socket_mgr, ResumeParkedSockets()).Times(0);
+  EXPECT_EQ(mocks_.broker_callbacks->HandleSocketMessageReceived(sender_handle, test_cmd.msg),
+            HandleMessageResult::kGetNextMessage);
   EXPECT_TRUE(mocks_.broker_callbacks->ServiceClients());
-  TestMessageLimit(sender_handle, test_all_manu_cmd.msg, 1u);
+  TestMessageLimit(sender_handle, test_cmd.msg, kMaxDeviceMessages);
+  testing::Mock::VerifyAndClearExpectations(mocks_.socket_mgr);
+
+  // The next pass can't send anything, but still resumes the parked socket, once.
+  etcpal_send_fake.custom_fake = nullptr;
+  etcpal_send_fake.return_val = kEtcPalErrWouldBlock;
+  EXPECT_CALL(*mocks_.socket_mgr, ResumeParkedSockets()).Times(1);
+  EXPECT_FALSE(mocks_.broker_callbacks->ServiceClients());
+  EXPECT_FALSE(mocks_.broker_callbacks->ServiceClients());
+
+  testing::Mock::VerifyAndClearExpectations(mocks_.socket_mgr);
+}
+
+TEST_F(TestBrokerCoreRptHandling, FullSocketIsServicedWhenWritable)
+{
+  auto device_handle = AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeDevice, kTestManu1);
+  auto sender_handle = AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeController, kTestManu1);
 
+  auto test_cmd = TestRdmCommand::Get(GetClientStats(device_handle).uid.get(), E120_DEVICE_INFO);
+
+  // The device's socket can't take any more data, so the broker waits for it to become writable.
+  etcpal_send_fake.custom_fake = nullptr;
+  etcpal_send_fake.return_val = kEtcPalErrWouldBlock;
+  EXPECT_CALL(*mocks_.socket_mgr, RequestWritableNotification(_)).Times(testing::AnyNumber());
+  EXPECT_CALL(*mocks_.socket_mgr, RequestWritableNotification(device_handle)).Times(1);
+  EXPECT_EQ(mocks_.broker_callbacks->HandleSocketMessageReceived(sender_handle, test_cmd.msg),
+            HandleMessageResult::kGetNextMessage);
+  mocks_.broker_callbacks->ServiceClients();
   testing::Mock::VerifyAndClearExpectations(mocks_.socket_mgr);
+
+  // The device isn't tried again until then.
+  auto send_count = etcpal_send_fake.call_count;
+  mocks_.broker_callbacks->ServiceClients();
+  EXPECT_EQ(etcpal_send_fake.call_count, send_count);
+  EXPECT_EQ(GetClientStats(device_handle).queue_depth, 1u);
+
+  etcpal_send_fake.custom_fake = [](etcpal_socket_t, const void*, size_t data_size, int) -> int {
+    return (int)data_size;
+  };
+  mocks_.broker_callbacks->HandleSocketWritable(device_handle);
+  EXPECT_TRUE(mocks_.broker_callbacks->ServiceClients());
+  EXPECT_EQ(GetClientStats(device_handle).queue_depth, 0u);
+}
+
+// Broadcasts never fill a queue past its limit, so they don't park the sender's socket.
+TEST_F(TestBrokerCoreRptHandling, FullBroadcastDestinationDoesNotParkSender)
+{
+  AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeDevice, kTestManu1);
+  auto sender_handle = AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeController, kTestManu1);
+
+  auto test_cmd = TestRdmCommand::GetBroadcast(E120_DEVICE_INFO);
+  SendBroadcasts(sender_handle, test_cmd.msg, kMaxDeviceMessages + 3u);
+
+  EXPECT_CALL(*mocks_.socket_mgr, ResumeParkedSockets()).Times(0);
+  EXPECT_TRUE(mocks_.broker_callbacks->ServiceClients());
+
+  testing::Mock::VerifyAndClearExpectations(mocks_.socket_mgr);
+}
+
+TEST_F(TestBrokerCoreRptHandling, ManuBroadcastSkipsDestroyedDevices)
+{
+  auto device_handle = AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeDevice, kTestManu2);
+  auto sender_handle = AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeController, kTestManu1);
+
+  mocks_.broker_callbacks->HandleSocketClosed(device_handle, false);
+  etcpal_getms_fake.return_val += 1000;
+  mocks_.broker_callbacks->ServiceClients();
+  ASSERT_EQ(broker_.GetNumClients(), 1u);
+
+  // With no devices left for the manufacturer, the broadcast has no destinations and never fills a queue.
+  auto test_manu2_cmd = TestRdmCommand::GetManuBroadcast(kTestManu2, E120_DEVICE_INFO);
+  for (unsigned int i = 0u; i < kMaxDeviceMessages + 1u; ++i)
+  {
+    EXPECT_EQ(mocks_.broker_callbacks->HandleSocketMessageReceived(sender_handle, test_manu2_cmd.msg),
+              HandleMessageResult::kGetNextMessage);
+  }
+
+  testing::Mock::VerifyAndClearExpectations(mocks_.socket_mgr);
+}
+
+// A device which reconnects before its old connection is cleaned up gets its UID back. Until the old
+// connection is destroyed, both are indexed under the manufacturer, but broadcasts only go to the new one.
+TEST_F(TestBrokerCoreRptHandling, ManuBroadcastReachesOnlyReconnectedDevice)
+{
+  auto device_cid = etcpal::Uuid::OsPreferred();
+  auto old_device_handle = AddClient(device_cid, kRPTClientTypeDevice, kTestManu2);
+  auto sender_handle = AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeController, kTestManu1);
+
+  mocks_.broker_callbacks->HandleSocketClosed(old_device_handle, false);
+  auto new_device_handle = AddClient(device_cid, kRPTClientTypeDevice, kTestManu2);
+  ASSERT_EQ(GetClientStats(new_device_handle).uid, GetClientStats(old_device_handle).uid);
+  ASSERT_EQ(broker_.GetNumClients(), 3u);
+
+  auto test_manu2_cmd = TestRdmCommand::GetManuBroadcast(kTestManu2, E120_DEVICE_INFO);
+  SendBroadcasts(sender_handle, test_manu2_cmd.msg, 1u);
+  EXPECT_EQ(GetClientStats(old_device_handle).queue_depth, 0u);
+  EXPECT_EQ(GetClientStats(new_device_handle).queue_depth, 1u);
+  EXPECT_EQ(broker_.GetStatistics().rpt_requests_routed, 1u);
+
+  // Destroying the old connection leaves the new one indexed.
+  etcpal_getms_fake.return_val += 1000;
+  mocks_.broker_callbacks->ServiceClients();
+  ASSERT_EQ(broker_.GetNumClients(), 2u);
+
+  SendBroadcasts(sender_handle, test_manu2_cmd.msg, 1u);
+  EXPECT_EQ(GetClientStats(new_device_handle).queue_depth, 1u);
+  EXPECT_EQ(broker_.GetStatistics().rpt_requests_routed, 2u);
+
+  testing::Mock::VerifyAndClearExpectations(mocks_.socket_mgr);
+}
+
+TEST_F(TestBrokerCoreRptHandling, SlowClientDisconnectedAfterTimeout)
+{
+  auto device_handle = AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeDevice, kTestManu1);
+  auto sender_handle = AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeController, kTestManu1);
+
+  // The device stops reading from its socket, and falls behind on broadcasts.
+  etcpal_send_fake.custom_fake = [](etcpal_socket_t, const void*, size_t, int) -> int { return 0; };
+  auto test_cmd = TestRdmCommand::GetBroadcast(E120_DEVICE_INFO);
+  SendBroadcasts(sender_handle, test_cmd.msg, kMaxDeviceMessages + 1u);
+
+  etcpal_getms_fake.return_val += kSlowClientDisconnectMs - 1;
+  mocks_.broker_callbacks->ServiceClients();
+  EXPECT_EQ(GetClientStats(device_handle).handle, device_handle);
+
+  etcpal_getms_fake.return_val += 1;
+  mocks_.broker_callbacks->ServiceClients();
+  etcpal_getms_fake.return_val += 1000;
+  mocks_.broker_callbacks->ServiceClients();
+  EXPECT_EQ(broker_.GetNumClients(), 1u);
+}
+
+TEST_F(TestBrokerCoreRptHandling, SlowClientWhichCatchesUpIsNotDisconnected)
+{
+  auto device_handle = AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeDevice, kTestManu1);
+  auto sender_handle = AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeController, kTestManu1);
+
+  auto test_cmd = TestRdmCommand::GetBroadcast(E120_DEVICE_INFO);
+  SendBroadcasts(sender_handle, test_cmd.msg, kMaxDeviceMessages + 1u);
+
+  // Sending a message makes room in the device's queue, so it is no longer behind.
+  EXPECT_TRUE(mocks_.broker_callbacks->ServiceClients());
+  etcpal_getms_fake.return_val += kSlowClientDisconnectMs;
+  mocks_.broker_callbacks->ServiceClients();
+  etcpal_getms_fake.return_val += 1000;
+  mocks_.broker_callbacks->ServiceClients();
+  EXPECT_EQ(broker_.GetNumClients(), 2u);
+  EXPECT_EQ(GetClientStats(device_handle).broadcast_drop_count, 1u);
+}
+
+TEST_F(TestBrokerCoreRptHandling, StatisticsCountEachReceivedMessageOnce)
+{
+  static constexpr unsigned int kNumMessages = 5u;
+
+  auto device_handle = AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeDevice, kTestManu1);
+  auto sender_handle = AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeController, kTestManu1);
+
+  // Each client's connect message has been counted.
+  EXPECT_EQ(GetClientStats(sender_handle).messages_received, 1u);
+
+  auto test_cmd = TestRdmCommand::Get(GetClientStats(device_handle).uid.get(), E120_DEVICE_INFO);
+  for (unsigned int i = 0u; i < kNumMessages; ++i)
+  {
+    EXPECT_EQ(mocks_.broker_callbacks->HandleSocketMessageReceived(sender_handle, test_cmd.msg),
+              HandleMessageResult::kGetNextMessage);
+  }
+  EXPECT_EQ(GetClientStats(sender_handle).messages_received, 1u + kNumMessages);
+
+  // Messages which are rejected to be retried later aren't counted.
+  TestMessageLimit(sender_handle, test_cmd.msg, kMaxDeviceMessages - kNumMessages);
+  EXPECT_EQ(GetClientStats(sender_handle).messages_received, 1u + kMaxDeviceMessages);
+  EXPECT_EQ(broker_.GetStatistics().messages_received, 2u + kMaxDeviceMessages);
+}
+
+TEST_F(TestBrokerCoreRptHandling, StatisticsCountRoutedAndRejectedMessages)
+{
+  auto device_handle = AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeDevice, kTestManu1);
+  auto sender_handle = AddClient(etcpal::Uuid::OsPreferred(), kRPTClientTypeController, kTestManu1);
+
+  // Fill the device's queue, then have three more messages rejected.
+  auto test_cmd = TestRdmCommand::Get(GetClientStats(device_handle).uid.get(), E120_DEVICE_INFO);
+  TestMessageLimit(sender_handle, test_cmd.msg, kMaxDeviceMessages);
+
+  // And one broadcast dropped. A broadcast which isn't queued to anyone isn't counted as routed, and
+  // a broadcast dropped for a full queue is counted only as a dropped broadcast.
+  auto test_broadcast_cmd = TestRdmCommand::GetBroadcast(E120_DEVICE_INFO);
+  SendBroadcasts(sender_handle, test_broadcast_cmd.msg, 1u);
+
+  // Nor is a broadcast to a manufacturer with no devices.
+  auto test_manu_broadcast_cmd = TestRdmCommand::GetManuBroadcast(kTestManu2, E120_DEVICE_INFO);
+  SendBroadcasts(sender_handle, test_manu_broadcast_cmd.msg, 1u);
+
+  auto stats = broker_.GetStatistics();
+  EXPECT_EQ(stats.num_controllers, 1u);
+  EXPECT_EQ(stats.num_devices, 1u);
+  EXPECT_EQ(stats.rpt_requests_routed, kMaxDeviceMessages);
+  EXPECT_EQ(stats.queue_full_count, 3u);
+  EXPECT_EQ(stats.broadcast_drop_count, 1u);
+
+  auto device_stats = std::find_if(stats.clients.begin(), stats.clients.end(),
+                                   [&](const rdmnet::Broker::ClientStatistics& client) {
+                                     return client.handle == device_handle;
+                                   });
+  ASSERT_NE(device_stats, stats.clients.end());
+  EXPECT_EQ(device_stats->rpt_type, kRPTClientTypeDevice);
+  EXPECT_EQ(device_stats->queue_depth, kMaxDeviceMessages);
+  EXPECT_EQ(device_stats->queue_high_water_mark, kMaxDeviceMessages);
+  EXPECT_EQ(device_stats->queue_full_count, 3u);
+  EXPECT_EQ(device_stats->broadcast_drop_count, 1u);
 }
@@ -96,6 +96,14 @@ TEST_F(TestBrokerCoreStartup, DoesNotStartWhenClientServiceThreadFails)
   EXPECT_FALSE(StartBroker(DefaultBrokerSettings()));
 }
 
+// The broker should not start if it is given a dynamic UID reservation file that can't be created.
+TEST_F(TestBrokerCoreStartup, DoesNotStartWhenUidReservationFileFails)
+{
+  auto settings = DefaultBrokerSettings();
+  settings.uid_reservation_file = "nonexistent_directory/uid_reservations.bin";
+  EXPECT_FALSE(StartBroker(settings));
+}
+
 // When no explicit listen interfaces are specified, the broker should create a single IPv6 socket
 // and bind it to in6addr_any with the V6ONLY option disabled.
 TEST_F(TestBrokerCoreStartup, SingleSocketWhenListeningOnAllInterfaces)
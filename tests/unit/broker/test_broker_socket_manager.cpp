@@ -0,0 +1,206 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+// Test the platform socket manager's parking of sockets whose messages can't be handled yet, and its
+// notifications of sockets becoming writable, using a real connected socket pair.
+
+#include "broker_socket_manager.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include "gtest/gtest.h"
+#include "etcpal/cpp/uuid.h"
+#include "rdmnet/core/broker_prot.h"
+#include "rdmnet_mock/core/common.h"
+
+class TestSocketNotify : public BrokerSocketNotify
+{
+public:
+  HandleMessageResult HandleSocketMessageReceived(BrokerClient::Handle /*handle*/,
+                                                  const RdmnetMessage& /*message*/) override
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++messages_handled_;
+    HandleMessageResult result = HandleMessageResult::kGetNextMessage;
+    if (messages_handled_ <= messages_to_retry)
+      result = HandleMessageResult::kRetryLater;
+    if (result == HandleMessageResult::kRetryLater && resume_while_handling)
+      sock_mgr->ResumeParkedSockets();
+    cv_.notify_all();
+    return result;
+  }
+
+  void HandleSocketDataReceived(BrokerClient::Handle /*handle*/, size_t /*size*/) override {}
+
+  void HandleSocketClosed(BrokerClient::Handle /*handle*/, bool /*graceful*/) override
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    socket_closed_ = true;
+    cv_.notify_all();
+  }
+
+  void HandleSocketWritable(BrokerClient::Handle /*handle*/) override
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++writable_count_;
+    cv_.notify_all();
+  }
+
+  bool WaitForSocketWritable(unsigned int count)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cv_.wait_for(lock, kWaitTimeout, [&]() { return writable_count_ >= count; });
+  }
+
+  unsigned int WritableCount()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return writable_count_;
+  }
+
+  // A shorter timeout is used to check that a message is not handled.
+  bool WaitForMessagesHandled(unsigned int count, std::chrono::milliseconds timeout = kWaitTimeout)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cv_.wait_for(lock, timeout, [&]() { return messages_handled_ >= count; });
+  }
+
+  bool WaitForSocketClosed()
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cv_.wait_for(lock, kWaitTimeout, [&]() { return socket_closed_; });
+  }
+
+  BrokerSocketManager* sock_mgr{nullptr};
+  unsigned int         messages_to_retry{0};
+  bool                 resume_while_handling{false};
+
+private:
+  static constexpr std::chrono::milliseconds kWaitTimeout{5000};
+
+  std::mutex              mutex_;
+  std::condition_variable cv_;
+  unsigned int            messages_handled_{0};
+  bool                    socket_closed_{false};
+  unsigned int            writable_count_{0};
+};
+
+constexpr std::chrono::milliseconds TestSocketNotify::kWaitTimeout;
+
+class TestBrokerSocketManager : public testing::Test
+{
+protected:
+  static constexpr BrokerClient::Handle kClientHandle = 1;
+
+  std::unique_ptr<BrokerSocketManager> sock_mgr_;
+  TestSocketNotify                     notify_;
+  // The first socket is managed by the socket manager; the second is the client's end.
+  int sockets_[2]{-1, -1};
+
+  void SetUp() override
+  {
+    rdmnet_mock_core_reset_and_init();
+
+    sock_mgr_ = CreateBrokerSocketManager();
+    notify_.sock_mgr = sock_mgr_.get();
+    sock_mgr_->SetNotify(&notify_);
+    ASSERT_TRUE(sock_mgr_->Startup());
+
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets_), 0);
+    ASSERT_TRUE(sock_mgr_->AddSocket(kClientHandle, sockets_[0]));
+  }
+
+  void TearDown() override
+  {
+    // Shutdown() closes the managed socket.
+    sock_mgr_->Shutdown();
+    close(sockets_[1]);
+  }
+
+  void SendNullMessage()
+  {
+    uint8_t      buf[BROKER_NULL_FULL_MSG_SIZE];
+    etcpal::Uuid cid = etcpal::Uuid::OsPreferred();
+    size_t       size = rc_broker_pack_null(buf, BROKER_NULL_FULL_MSG_SIZE, &cid.get());
+    ASSERT_EQ(write(sockets_[1], buf, size), static_cast<ssize_t>(size));
+  }
+};
+
+TEST_F(TestBrokerSocketManager, ParkedMessageIsRetriedAfterResume)
+{
+  notify_.messages_to_retry = 1;
+  SendNullMessage();
+  ASSERT_TRUE(notify_.WaitForMessagesHandled(1u));
+
+  // The socket stays parked until it is resumed, so neither the parked message nor one sent after it
+  // is handled.
+  SendNullMessage();
+  EXPECT_FALSE(notify_.WaitForMessagesHandled(2u, std::chrono::milliseconds(100)));
+
+  sock_mgr_->ResumeParkedSockets();
+  EXPECT_TRUE(notify_.WaitForMessagesHandled(3u));
+
+  // The socket is read from again once its parked message has been handled.
+  SendNullMessage();
+  EXPECT_TRUE(notify_.WaitForMessagesHandled(4u));
+}
+
+TEST_F(TestBrokerSocketManager, ResumeWhileParkingIsNotLost)
+{
+  // Queues drain while the message is being handled, just before it is rejected.
+  notify_.messages_to_retry = 1;
+  notify_.resume_while_handling = true;
+  SendNullMessage();
+  EXPECT_TRUE(notify_.WaitForMessagesHandled(2u));
+}
+
+TEST_F(TestBrokerSocketManager, ClosingParkedSocketIsReported)
+{
+  notify_.messages_to_retry = 1;
+  SendNullMessage();
+  ASSERT_TRUE(notify_.WaitForMessagesHandled(1u));
+
+  // Like a TCP FIN, this only ends the client's side of the stream.
+  ASSERT_EQ(shutdown(sockets_[1], SHUT_WR), 0);
+  EXPECT_TRUE(notify_.WaitForSocketClosed());
+}
+
+TEST_F(TestBrokerSocketManager, FullSocketIsReportedWritableOnceDrained)
+{
+  // Fill the managed socket's send buffer.
+  ASSERT_EQ(fcntl(sockets_[0], F_SETFL, fcntl(sockets_[0], F_GETFL) | O_NONBLOCK), 0);
+  uint8_t fill[1024] = {};
+  while (write(sockets_[0], fill, sizeof(fill)) > 0)
+    ;
+
+  sock_mgr_->RequestWritableNotification(kClientHandle);
+  EXPECT_EQ(notify_.WritableCount(), 0u);
+
+  // The client reads everything that was sent.
+  ASSERT_EQ(fcntl(sockets_[1], F_SETFL, fcntl(sockets_[1], F_GETFL) | O_NONBLOCK), 0);
+  while (read(sockets_[1], fill, sizeof(fill)) > 0)
+    ;
+  EXPECT_TRUE(notify_.WaitForSocketWritable(1u));
+}
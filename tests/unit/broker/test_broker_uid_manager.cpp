@@ -19,6 +19,11 @@
 #include "gtest/gtest.h"
 #include "broker_uid_manager.h"
 
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
 class TestBrokerUidManager : public testing::Test
 {
 protected:
@@ -161,3 +166,262 @@ TEST_F(TestBrokerUidManager, HandlesWraparound)
   ASSERT_EQ(res, BrokerUidManager::AddResult::kOk);
   ASSERT_EQ(test_uid.id, 4u);
 }
+
+class TestBrokerUidReservationFile : public testing::Test
+{
+protected:
+  static constexpr const char* kFileName = "test_broker_uid_reservations.bin";
+  static uint32_t              now;
+
+  TestBrokerUidReservationFile()
+  {
+    std::remove(kFileName);
+    now = 1000000;
+  }
+  ~TestBrokerUidReservationFile() override { std::remove(kFileName); }
+
+  // Create a manager which reads its reservations from the file and which uses the test clock.
+  static std::unique_ptr<BrokerUidManager> OpenManager(uint32_t max_age_s = 0)
+  {
+    std::unique_ptr<BrokerUidManager> manager(new BrokerUidManager);
+    manager->SetClock([]() { return now; });
+    manager->SetReservationMaxAge(max_age_s);
+    manager->SetNextDeviceId(2);
+    EXPECT_TRUE(manager->OpenReservationFile(kFileName));
+    return manager;
+  }
+
+  static etcpal::Uuid TestCid(uint32_t index)
+  {
+    EtcPalUuid cid = {0x12, 0x34, 0x56, 0x78};
+    cid.data[12] = static_cast<uint8_t>(index >> 24);
+    cid.data[13] = static_cast<uint8_t>(index >> 16);
+    cid.data[14] = static_cast<uint8_t>(index >> 8);
+    cid.data[15] = static_cast<uint8_t>(index);
+    return cid;
+  }
+
+  // Connect and then disconnect a component with a dynamic UID, returning the UID it was assigned.
+  static RdmUid ConnectAndDisconnect(BrokerUidManager& manager, const etcpal::Uuid& cid)
+  {
+    RdmUid uid = {0xe574, 0};
+    EXPECT_EQ(manager.AddDynamicUid(1, cid, uid), BrokerUidManager::AddResult::kOk);
+    manager.RemoveUid(uid);
+    return uid;
+  }
+
+  static size_t FileSize()
+  {
+    std::ifstream file(kFileName, std::ios::binary | std::ios::ate);
+    return file ? static_cast<size_t>(file.tellg()) : 0;
+  }
+};
+
+uint32_t TestBrokerUidReservationFile::now;
+
+TEST_F(TestBrokerUidReservationFile, ReservationsSurviveReopening)
+{
+  auto   manager = OpenManager();
+  RdmUid uid_1 = ConnectAndDisconnect(*manager, TestCid(1));
+  RdmUid uid_2 = {0xe574, 0};
+  ASSERT_EQ(manager->AddDynamicUid(2, TestCid(2), uid_2), BrokerUidManager::AddResult::kOk);
+  manager.reset();
+
+  // Components get the same UIDs back, whether or not they disconnected cleanly.
+  manager = OpenManager();
+  EXPECT_EQ(manager->GetNumReservations(), 2u);
+
+  RdmUid uid = {0xe574, 0};
+  ASSERT_EQ(manager->AddDynamicUid(3, TestCid(2), uid), BrokerUidManager::AddResult::kOk);
+  EXPECT_EQ(uid, uid_2);
+  uid = {0xe574, 0};
+  ASSERT_EQ(manager->AddDynamicUid(4, TestCid(1), uid), BrokerUidManager::AddResult::kOk);
+  EXPECT_EQ(uid, uid_1);
+
+  // New components don't get any of the reserved UIDs.
+  uid = {0xe574, 0};
+  ASSERT_EQ(manager->AddDynamicUid(5, TestCid(3), uid), BrokerUidManager::AddResult::kOk);
+  EXPECT_GT(uid.id, uid_1.id);
+  EXPECT_GT(uid.id, uid_2.id);
+}
+
+TEST_F(TestBrokerUidReservationFile, SameFileCanBeOpenedTwice)
+{
+  auto   manager = OpenManager();
+  RdmUid uid_1 = ConnectAndDisconnect(*manager, TestCid(1));
+  manager->CloseReservationFile();
+
+  // The file has records in it now, so it is read before being reopened for appending.
+  ASSERT_TRUE(manager->OpenReservationFile(kFileName));
+  RdmUid uid_2 = ConnectAndDisconnect(*manager, TestCid(2));
+  manager->FlushReservationFile();
+  manager.reset();
+
+  manager = OpenManager();
+  EXPECT_EQ(manager->GetNumReservations(), 2u);
+  RdmUid uid = {0xe574, 0};
+  ASSERT_EQ(manager->AddDynamicUid(3, TestCid(1), uid), BrokerUidManager::AddResult::kOk);
+  EXPECT_EQ(uid, uid_1);
+  uid = {0xe574, 0};
+  ASSERT_EQ(manager->AddDynamicUid(4, TestCid(2), uid), BrokerUidManager::AddResult::kOk);
+  EXPECT_EQ(uid, uid_2);
+}
+
+TEST_F(TestBrokerUidReservationFile, StaleReservationsAreEvicted)
+{
+  constexpr uint32_t kMaxAge = 3600;
+
+  auto   manager = OpenManager(kMaxAge);
+  RdmUid stale_uid = ConnectAndDisconnect(*manager, TestCid(1));
+  RdmUid connected_uid = {0xe574, 0};
+  ASSERT_EQ(manager->AddDynamicUid(2, TestCid(2), connected_uid), BrokerUidManager::AddResult::kOk);
+
+  // Reservations are checked for expiry when new ones are made.
+  now += kMaxAge + BrokerUidManager::kEvictionIntervalS;
+  ConnectAndDisconnect(*manager, TestCid(3));
+  EXPECT_EQ(manager->GetNumReservations(), 2u);
+  manager.reset();
+
+  // The eviction was saved to the file.
+  manager = OpenManager();
+  EXPECT_EQ(manager->GetNumReservations(), 2u);
+  RdmUid uid = {0xe574, 0};
+  ASSERT_EQ(manager->AddDynamicUid(4, TestCid(1), uid), BrokerUidManager::AddResult::kOk);
+  EXPECT_NE(uid, stale_uid);
+}
+
+TEST_F(TestBrokerUidReservationFile, StaleReservationsAreEvictedOnOpen)
+{
+  constexpr uint32_t kMaxAge = 3600;
+
+  auto manager = OpenManager(kMaxAge);
+  ConnectAndDisconnect(*manager, TestCid(1));
+  manager.reset();
+
+  now += kMaxAge + 1;
+  manager = OpenManager(kMaxAge);
+  EXPECT_EQ(manager->GetNumReservations(), 0u);
+}
+
+TEST_F(TestBrokerUidReservationFile, ConnectedReservationsSurviveCrash)
+{
+  constexpr uint32_t kMaxAge = 3600;
+
+  auto   manager = OpenManager(kMaxAge);
+  RdmUid reconnected_uid = ConnectAndDisconnect(*manager, TestCid(1));
+  RdmUid connected_uid = {0xe574, 0};
+  ASSERT_EQ(manager->AddDynamicUid(2, TestCid(2), connected_uid), BrokerUidManager::AddResult::kOk);
+
+  // TestCid(1) reconnects shortly before its reservation would have expired.
+  now += kMaxAge - 1;
+  RdmUid uid = {0xe574, 0};
+  ASSERT_EQ(manager->AddDynamicUid(3, TestCid(1), uid), BrokerUidManager::AddResult::kOk);
+  EXPECT_EQ(uid, reconnected_uid);
+
+  // The broker stops without recording any disconnects, and restarts much later than the maximum
+  // reservation age after either component last connected.
+  now += kMaxAge + BrokerUidManager::kEvictionIntervalS;
+  manager.reset();
+  manager = OpenManager(kMaxAge);
+  EXPECT_EQ(manager->GetNumReservations(), 2u);
+
+  uid = {0xe574, 0};
+  ASSERT_EQ(manager->AddDynamicUid(4, TestCid(1), uid), BrokerUidManager::AddResult::kOk);
+  EXPECT_EQ(uid, reconnected_uid);
+  uid = {0xe574, 0};
+  ASSERT_EQ(manager->AddDynamicUid(5, TestCid(2), uid), BrokerUidManager::AddResult::kOk);
+  EXPECT_EQ(uid, connected_uid);
+}
+
+TEST_F(TestBrokerUidReservationFile, FileIsCompacted)
+{
+  const size_t kMaxRecords = 2 * BrokerUidManager::kMinCompactionRecords;
+
+  auto manager = OpenManager();
+  for (size_t i = 0; i < kMaxRecords; ++i)
+    ConnectAndDisconnect(*manager, TestCid(1));
+  EXPECT_EQ(manager->GetNumReservations(), 1u);
+  manager->FlushReservationFile();
+  EXPECT_LE(FileSize(), BrokerUidStore::kHeaderSize + kMaxRecords * BrokerUidStore::kRecordSize / 2);
+}
+
+TEST_F(TestBrokerUidReservationFile, PartialRecordIsDiscarded)
+{
+  auto   manager = OpenManager();
+  RdmUid uid_1 = ConnectAndDisconnect(*manager, TestCid(1));
+  manager.reset();
+
+  // Simulate a record that was interrupted partway through being written.
+  {
+    std::ofstream file(kFileName, std::ios::binary | std::ios::app);
+    file.write("\x12\x34\x56\x78\x00\x00", 6);
+  }
+
+  manager = OpenManager();
+  EXPECT_EQ((FileSize() - BrokerUidStore::kHeaderSize) % BrokerUidStore::kRecordSize, 0u);
+  ConnectAndDisconnect(*manager, TestCid(2));
+  manager.reset();
+
+  manager = OpenManager();
+  EXPECT_EQ(manager->GetNumReservations(), 2u);
+  RdmUid uid = {0xe574, 0};
+  ASSERT_EQ(manager->AddDynamicUid(3, TestCid(1), uid), BrokerUidManager::AddResult::kOk);
+  EXPECT_EQ(uid, uid_1);
+}
+
+TEST_F(TestBrokerUidReservationFile, DamagedRecordIsSkipped)
+{
+  auto   manager = OpenManager();
+  RdmUid uid_1 = ConnectAndDisconnect(*manager, TestCid(1));
+  RdmUid uid_2 = ConnectAndDisconnect(*manager, TestCid(2));
+  manager.reset();
+
+  // Damage the first record for TestCid(1). The records after it must still be loaded.
+  {
+    std::fstream file(kFileName, std::ios::binary | std::ios::in | std::ios::out);
+    file.seekp(BrokerUidStore::kHeaderSize + 20);
+    file.write("\xff", 1);
+  }
+
+  manager = OpenManager();
+  EXPECT_EQ(manager->GetNumReservations(), 2u);
+  RdmUid uid = {0xe574, 0};
+  ASSERT_EQ(manager->AddDynamicUid(3, TestCid(1), uid), BrokerUidManager::AddResult::kOk);
+  EXPECT_EQ(uid, uid_1);
+  uid = {0xe574, 0};
+  ASSERT_EQ(manager->AddDynamicUid(4, TestCid(2), uid), BrokerUidManager::AddResult::kOk);
+  EXPECT_EQ(uid, uid_2);
+
+  // The damaged record was removed when the file was rewritten.
+  EXPECT_EQ((FileSize() - BrokerUidStore::kHeaderSize) % BrokerUidStore::kRecordSize, 0u);
+}
+
+TEST_F(TestBrokerUidReservationFile, ChangesAreWrittenOnFlush)
+{
+  auto   manager = OpenManager();
+  size_t empty_size = FileSize();
+
+  ConnectAndDisconnect(*manager, TestCid(1));
+  EXPECT_EQ(FileSize(), empty_size);
+
+  manager->FlushReservationFile();
+  EXPECT_EQ(FileSize(), empty_size + 2 * BrokerUidStore::kRecordSize);
+}
+
+TEST_F(TestBrokerUidReservationFile, DoesNotOverwriteOtherFiles)
+{
+  const std::vector<char> contents = {'N', 'o', 't', ' ', 'a', ' ', 'r', 'e', 's', 'e', 'r', 'v', 'a', 't', 'i', 'o',
+                                      'n', ' ', 'f', 'i', 'l', 'e'};
+  {
+    std::ofstream file(kFileName, std::ios::binary);
+    file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+  }
+
+  BrokerUidManager manager;
+  EXPECT_FALSE(manager.OpenReservationFile(kFileName));
+  EXPECT_EQ(manager.GetNumReservations(), 0u);
+
+  std::ifstream     file(kFileName, std::ios::binary);
+  std::vector<char> read_contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  EXPECT_EQ(read_contents, contents);
+}
@@ -66,6 +66,73 @@ TEST(TestClientHandleGenerator, SkipsHandlesInUse)
   EXPECT_EQ(generator.GetClientHandle(), 1);
 }
 
+static RdmnetRptClientEntry TestClientEntry(const etcpal::Uuid& cid, uint32_t device_id)
+{
+  RdmnetRptClientEntry entry{};
+  entry.cid = cid.get();
+  entry.uid = rdm::Uid(0x6574, device_id).get();
+  entry.type = kRPTClientTypeDevice;
+  return entry;
+}
+
+TEST(TestClientListDeltas, AddThenRemoveCancels)
+{
+  ClientListDeltas deltas;
+  auto             entry = TestClientEntry(etcpal::Uuid::OsPreferred(), 1);
+
+  deltas.AddClient(0, entry);
+  deltas.AddClient(1, TestClientEntry(etcpal::Uuid::OsPreferred(), 2));
+  deltas.RemoveClient(entry);
+  EXPECT_EQ(deltas.adds().size(), 1u);
+  EXPECT_TRUE(deltas.removes().empty());
+}
+
+TEST(TestClientListDeltas, RemoveThenIdenticalAddCancels)
+{
+  ClientListDeltas deltas;
+  auto             entry = TestClientEntry(etcpal::Uuid::OsPreferred(), 1);
+
+  deltas.RemoveClient(entry);
+  deltas.AddClient(0, entry);
+  EXPECT_TRUE(deltas.empty());
+}
+
+TEST(TestClientListDeltas, RemoveThenChangedAddKeepsBoth)
+{
+  ClientListDeltas deltas;
+  auto             cid = etcpal::Uuid::OsPreferred();
+
+  deltas.RemoveClient(TestClientEntry(cid, 1));
+  deltas.AddClient(0, TestClientEntry(cid, 2));
+  ASSERT_EQ(deltas.size(), 2u);
+  EXPECT_EQ(deltas.removes().at(cid).entry.uid.id, 1u);
+  EXPECT_EQ(deltas.adds().at(cid).entry.uid.id, 2u);
+}
+
+TEST(TestClientListDeltas, AddInSnapshotThenRemoveIsKept)
+{
+  ClientListDeltas deltas;
+  auto             entry = TestClientEntry(etcpal::Uuid::OsPreferred(), 1);
+
+  deltas.AddClient(0, entry);
+  deltas.SnapshotTaken();
+  deltas.RemoveClient(entry);
+  EXPECT_TRUE(deltas.adds().empty());
+  EXPECT_EQ(deltas.removes().size(), 1u);
+}
+
+TEST(TestClientListDeltas, RemoveInSnapshotThenIdenticalAddKeepsBoth)
+{
+  ClientListDeltas deltas;
+  auto             entry = TestClientEntry(etcpal::Uuid::OsPreferred(), 1);
+
+  deltas.RemoveClient(entry);
+  deltas.SnapshotTaken();
+  deltas.AddClient(0, entry);
+  EXPECT_EQ(deltas.removes().size(), 1u);
+  EXPECT_EQ(deltas.adds().size(), 1u);
+}
+
 // class MockBrokerClient : public BrokerClient
 // {
 // public:
@@ -58,7 +58,8 @@ constexpr RCClientCommonCallbacks kClientFakeCommonCallbacks = {
   rc_client_connect_failed,
   rc_client_disconnected,
   rc_client_broker_msg_received,
-  rc_client_destroyed
+  rc_client_destroyed,
+  rc_client_send_ready
 };
 
 constexpr RCRptClientCallbacks kClientFakeRptCallbacks = {
@@ -552,6 +552,17 @@ TEST_F(TestStaticRptClientConnectionHandling, ReportsSuccessfulConnection)
   ConnectAndVerify();
 }
 
+TEST_F(TestStaticRptClientConnectionHandling, ForwardsSendReadyForScope)
+{
+  ConnectAndVerify();
+
+  conns_registered[0]->callbacks.send_ready(conns_registered[0]);
+
+  EXPECT_EQ(rc_client_send_ready_fake.call_count, 1u);
+  EXPECT_EQ(rc_client_send_ready_fake.arg0_val, &client_);
+  EXPECT_EQ(rc_client_send_ready_fake.arg1_val, static_scope_handle_);
+}
+
 TEST_F(TestStaticRptClientConnectionHandling, ClientRetriesOnDisconnect)
 {
   ConnectAndVerify();
@@ -24,6 +24,7 @@
 #include <string>
 #include <vector>
 #include "etcpal_mock/common.h"
+#include "etcpal_mock/socket.h"
 #include "rdmnet_mock/core/client.h"
 #include "rdmnet_mock/core/connection.h"
 #include "rdmnet_mock/core/llrp.h"
@@ -146,3 +147,48 @@ TEST_F(TestCoreCommon, InitFailsGracefullyAndCleansUp)
     }
   }
 }
+
+static unsigned int       num_ready_events;
+static unsigned int       num_events_handled;
+static RCPolledSocketInfo ready_socket_info;
+
+static void SetUpReadyEvents(unsigned int num_events)
+{
+  num_ready_events = num_events;
+  num_events_handled = 0;
+  ready_socket_info.callback = [](const EtcPalPollEvent*, RCPolledSocketOpaqueData) { ++num_events_handled; };
+  etcpal_poll_wait_fake.custom_fake = [](EtcPalPollContext*, EtcPalPollEvent* event, int) {
+    if (num_ready_events == 0)
+      return kEtcPalErrTimedOut;
+    --num_ready_events;
+    event->events = ETCPAL_POLL_IN;
+    event->user_data = &ready_socket_info;
+    return kEtcPalErrOk;
+  };
+}
+
+TEST_F(TestCoreCommon, TickHandlesAllReadyEvents)
+{
+  ASSERT_EQ(rc_init(nullptr, nullptr), kEtcPalErrOk);
+
+  SetUpReadyEvents(5);
+  rc_tick();
+  EXPECT_EQ(num_events_handled, 5u);
+  EXPECT_EQ(etcpal_poll_wait_fake.call_count, 6u);
+
+  rc_deinit();
+}
+
+TEST_F(TestCoreCommon, TickLimitsEventsPerWakeup)
+{
+  ASSERT_EQ(rc_init(nullptr, nullptr), kEtcPalErrOk);
+
+  SetUpReadyEvents(RDMNET_TICK_MAX_EVENTS_PER_WAKEUP + 5);
+  rc_tick();
+  EXPECT_EQ(num_events_handled, static_cast<unsigned int>(RDMNET_TICK_MAX_EVENTS_PER_WAKEUP));
+
+  rc_tick();
+  EXPECT_EQ(num_events_handled, static_cast<unsigned int>(RDMNET_TICK_MAX_EVENTS_PER_WAKEUP + 5));
+
+  rc_deinit();
+}
@@ -45,6 +45,7 @@ FAKE_VOID_FUNC(conncb_connect_failed, RCConnection*, const RCConnectFailedInfo*)
 FAKE_VOID_FUNC(conncb_disconnected, RCConnection*, const RCDisconnectedInfo*);
 FAKE_VALUE_FUNC(rc_message_action_t, conncb_msg_received, RCConnection*, const RdmnetMessage*);
 FAKE_VOID_FUNC(conncb_destroyed, RCConnection*);
+FAKE_VOID_FUNC(conncb_send_ready, RCConnection*);
 }
 
 static RCPolledSocketInfo conn_poll_info;
@@ -79,6 +80,7 @@ protected:
     conn_.callbacks.disconnected = conncb_disconnected;
     conn_.callbacks.message_received = conncb_msg_received;
     conn_.callbacks.destroyed = conncb_destroyed;
+    conn_.callbacks.send_ready = conncb_send_ready;
 
     // Fill in the connect message
     std::strcpy(connect_msg_.scope, kTestScope);
@@ -151,6 +153,7 @@ protected:
     RESET_FAKE(conncb_disconnected);
     RESET_FAKE(conncb_msg_received);
     RESET_FAKE(conncb_destroyed);
+    RESET_FAKE(conncb_send_ready);
 
     rdmnet_mock_core_reset_and_init();
     rc_broker_prot_reset_all_fakes();
@@ -362,7 +365,7 @@ TEST_F(TestConnectionAlreadyConnected, DisconnectsOnSocketError)
 
 TEST_F(TestConnectionAlreadyConnected, MsgBufResetOnDisconnect)
 {
-  RESET_FAKE(rc_msg_buf_init);
+  RESET_FAKE(rc_msg_buf_reset);
 
   EtcPalPollEvent event;
   event.err = kEtcPalErrConnReset;
@@ -372,8 +375,8 @@ TEST_F(TestConnectionAlreadyConnected, MsgBufResetOnDisconnect)
   conn_.poll_info.callback(&event, conn_.poll_info.data);
   ASSERT_EQ(conncb_disconnected_fake.call_count, 1u);
 
-  EXPECT_EQ(rc_msg_buf_init_fake.call_count, 1u);
-  EXPECT_EQ(rc_msg_buf_init_fake.arg0_val, &conn_.recv_buf);
+  EXPECT_EQ(rc_msg_buf_reset_fake.call_count, 1u);
+  EXPECT_EQ(rc_msg_buf_reset_fake.arg0_val, &conn_.recv_buf);
 }
 
 TEST_F(TestConnectionAlreadyConnected, ProcessesMultipleMessagesInOneReceive)
@@ -476,3 +479,42 @@ TEST_F(TestConnectionAlreadyConnected, RetriesWhileParsingMultipleMessages)
   EXPECT_EQ(rc_msg_buf_parse_data_fake.call_count, kTotalNumMessages + 1u);  // Parse each message + "NoData" parse
   EXPECT_EQ(conncb_msg_received_fake.call_count, kTotalNumMessages + 1u);    // Called for each message + the retry
 }
+
+#if RDMNET_CONN_SEND_QUEUE_SIZE
+TEST_F(TestConnectionAlreadyConnected, QueuesDataSocketCannotAccept)
+{
+  std::array<uint8_t, 100> data{};
+
+  // The socket takes only part of the first message, and nothing after that.
+  etcpal_send_fake.return_val = 40;
+  EXPECT_EQ(kEtcPalErrOk, rc_conn_send_message(&conn_, data.data(), data.size()));
+  EXPECT_EQ(conn_.send_queue_size, data.size() - 40u);
+  EXPECT_EQ(rc_modify_polled_socket_fake.call_count, 1u);
+  EXPECT_EQ(rc_modify_polled_socket_fake.arg1_val, ETCPAL_POLL_IN | ETCPAL_POLL_OUT);
+
+  // Once data is queued, later messages go behind it without touching the socket.
+  EXPECT_EQ(kEtcPalErrOk, rc_conn_send_message(&conn_, data.data(), data.size()));
+  EXPECT_EQ(etcpal_send_fake.call_count, 1u);
+  EXPECT_EQ(conn_.send_queue_size, data.size() * 2 - 40u);
+  EXPECT_EQ(rc_modify_polled_socket_fake.call_count, 1u);
+
+  // A message that doesn't fit is refused rather than blocking.
+  static std::array<uint8_t, RDMNET_CONN_SEND_QUEUE_SIZE> big_data{};
+  EXPECT_EQ(kEtcPalErrWouldBlock, rc_conn_send_message(&conn_, big_data.data(), big_data.size()));
+  EXPECT_EQ(conn_.send_queue_size, data.size() * 2 - 40u);
+
+  // The queue drains when the socket becomes writable, and the refused sender is notified.
+  etcpal_send_fake.custom_fake = [](etcpal_socket_t, const void*, size_t length, int) {
+    return static_cast<int>(length);
+  };
+  EtcPalPollEvent event;
+  event.events = ETCPAL_POLL_OUT;
+  event.socket = kFakeSocket;
+  conn_poll_info.callback(&event, conn_poll_info.data);
+
+  EXPECT_EQ(conn_.send_queue_size, 0u);
+  EXPECT_EQ(rc_modify_polled_socket_fake.call_count, 2u);
+  EXPECT_EQ(rc_modify_polled_socket_fake.arg1_val, ETCPAL_POLL_IN);
+  EXPECT_EQ(conncb_send_ready_fake.call_count, 1u);
+}
+#endif
@@ -0,0 +1,266 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+// rdmnet_llrp_target_bench: a micro-benchmark for LLRP probe request handling with many targets.
+//
+// Registers a large number of simulated LLRP targets in one process and measures:
+//
+// - lookup: checking each target's UID against a full Known UID list, one UID at a time, with the
+//   list in ascending order (searched) and in descending order (scanned).
+// - in-order: the same check, walking the UIDs and the sorted Known UID list together.
+// - dispatch: delivering a whole probe request datagram to the target module, which parses it once
+//   and hands it to every target in range. Replies are flushed between iterations and are not
+//   included in the time.
+//
+// Usage: rdmnet_llrp_target_bench [num_targets] [iterations]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+#include "fff.h"
+#include "etcpal/cpp/mutex.h"
+#include "etcpal/cpp/uuid.h"
+#include "etcpal_mock/common.h"
+#include "etcpal_mock/socket.h"
+#include "etcpal_mock/timer.h"
+#include "rdm/cpp/uid.h"
+#include "rdmnet/core/llrp_prot.h"
+#include "rdmnet/core/llrp_target.h"
+#include "rdmnet_mock/core/common.h"
+#include "fake_mcast.h"
+
+DEFINE_FFF_GLOBALS;
+
+extern "C" void RdmnetTestingAssertHandler(const char* expression, const char* file, unsigned int line)
+{
+  std::cerr << "Assertion failure from inside RDMnet library. Expression: " << expression << " File: " << file
+            << " Line: " << line << '\n';
+  std::abort();
+}
+
+static constexpr uint16_t kTargetManu = 0x6574;
+static constexpr size_t   kDefaultNumTargets = 4000;
+static constexpr size_t   kDefaultIterations = 200;
+
+static const etcpal::Uuid kManagerCid = etcpal::Uuid::FromString("9a4ab9b6-2ec0-4c7a-b2d1-3f1ac8b2e3a0");
+
+static std::vector<uint8_t> last_sent;
+
+/*********************************** Setup ************************************/
+
+class SimulatedTargets
+{
+public:
+  explicit SimulatedTargets(size_t num_targets) : targets_(num_targets)
+  {
+    // Spread the UIDs out, as they would be on a real network.
+    uint32_t id = 0;
+    for (auto& target : targets_)
+    {
+      id += 1 + static_cast<uint32_t>(std::rand() % 64);
+      target.cid = etcpal::Uuid::V4().get();
+      target.uid = rdm::Uid(kTargetManu, id).get();
+      target.lock = &lock_.get();
+      target.component_type = kLlrpCompRptDevice;
+      target.callbacks.rdm_command_received = nullptr;
+      target.callbacks.destroyed = nullptr;
+      if (rc_llrp_target_register(&target, nullptr, 0) != kEtcPalErrOk)
+      {
+        std::cerr << "Failed to register LLRP target.\n";
+        std::exit(1);
+      }
+    }
+    rc_llrp_target_module_tick();
+  }
+
+  ~SimulatedTargets()
+  {
+    for (auto& target : targets_)
+      rc_llrp_target_unregister(&target);
+    rc_llrp_target_module_tick();
+  }
+
+  std::vector<RdmUid> SortedUids() const
+  {
+    std::vector<RdmUid> uids;
+    for (const auto& target : targets_)
+      uids.push_back(target.uid);
+    return uids;
+  }
+
+private:
+  std::vector<RCLlrpTarget> targets_;
+  etcpal::Mutex             lock_;
+};
+
+// Suppress every other target in the first part of the range with a full Known UID list, as a
+// manager does partway through discovery.
+std::vector<RdmUid> MakeKnownUids(const std::vector<RdmUid>& target_uids)
+{
+  std::vector<RdmUid> known_uids;
+  for (size_t i = 0; i < target_uids.size() && known_uids.size() < LLRP_KNOWN_UID_SIZE; i += 2)
+    known_uids.push_back(target_uids[i]);
+  return known_uids;
+}
+
+std::vector<uint8_t> BuildProbeRequest(const std::vector<RdmUid>& known_uids)
+{
+  LlrpHeader header;
+  header.sender_cid = kManagerCid.get();
+  header.dest_cid = *kLlrpBroadcastCid;
+  header.transaction_number = 1;
+
+  LocalProbeRequest request;
+  request.lower_uid = rdm::Uid(kTargetManu, 0).get();
+  request.upper_uid = rdm::Uid(kTargetManu, 0xffffffff).get();
+  request.filter = 0;
+  request.known_uids = known_uids.data();
+  request.num_known_uids = known_uids.size();
+
+  uint8_t buf[LLRP_MAX_MESSAGE_SIZE];
+  last_sent.clear();
+  rc_send_llrp_probe_request(0, buf, false, &header, &request);
+  return last_sent;
+}
+
+/********************************* Measuring **********************************/
+
+template <typename Func>
+double NanosecondsPerOp(size_t iterations, size_t ops_per_iteration, Func&& func)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; ++i)
+    func();
+  auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start);
+  return elapsed.count() / static_cast<double>(iterations * ops_per_iteration);
+}
+
+void PrintResult(const char* name, double ns_per_op, const char* unit)
+{
+  std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(1)
+            << std::setw(12) << ns_per_op << " ns/" << unit << '\n';
+}
+
+// Keeps the results of the lookups from being optimized away.
+static volatile size_t g_sink;
+
+void BenchLookup(const char*                 name,
+                 const std::vector<uint8_t>& datagram,
+                 const std::vector<RdmUid>&  uids,
+                 size_t                      iterations)
+{
+  LlrpMessage msg;
+  if (!rc_parse_llrp_message_view(datagram.data(), datagram.size(), &msg))
+  {
+    std::cerr << "Failed to parse probe request.\n";
+    std::exit(1);
+  }
+  const RemoteProbeRequest* request = LLRP_MSG_GET_PROBE_REQUEST(&msg);
+
+  double ns = NanosecondsPerOp(iterations, uids.size(), [&]() {
+    for (const auto& uid : uids)
+      g_sink = g_sink + rc_llrp_probe_request_contains_uid(request, &uid);
+  });
+  PrintResult(name, ns, "target");
+}
+
+void BenchInOrder(const std::vector<uint8_t>& datagram, const std::vector<RdmUid>& uids, size_t iterations)
+{
+  LlrpMessage msg;
+  rc_parse_llrp_message_view(datagram.data(), datagram.size(), &msg);
+  const RemoteProbeRequest* request = LLRP_MSG_GET_PROBE_REQUEST(&msg);
+
+  double ns = NanosecondsPerOp(iterations, uids.size(), [&]() {
+    size_t known_uid_pos = 0;
+    for (const auto& uid : uids)
+      g_sink = g_sink + rc_llrp_probe_request_contains_uid_in_order(request, &uid, &known_uid_pos);
+  });
+  PrintResult("in-order, sorted", ns, "target");
+}
+
+void BenchDispatch(const char* name, const std::vector<uint8_t>& datagram, size_t iterations)
+{
+  std::chrono::duration<double, std::nano> total{0};
+  for (size_t i = 0; i < iterations; ++i)
+  {
+    auto start = std::chrono::steady_clock::now();
+    rc_llrp_target_data_received(datagram.data(), datagram.size(), &kFakeNetints[0]);
+    total += std::chrono::steady_clock::now() - start;
+
+    // Send the replies so that every target handles the next probe request the same way.
+    etcpal_getms_fake.return_val += LLRP_MAX_BACKOFF_MS + 1;
+    rc_llrp_target_module_tick();
+  }
+  PrintResult(name, total.count() / static_cast<double>(iterations), "probe");
+}
+
+/*********************************** Main *************************************/
+
+int main(int argc, char* argv[])
+{
+  size_t num_targets = (argc > 1 ? std::strtoul(argv[1], nullptr, 10) : kDefaultNumTargets);
+  size_t iterations = (argc > 2 ? std::strtoul(argv[2], nullptr, 10) : kDefaultIterations);
+  if (num_targets == 0 || iterations == 0)
+  {
+    std::cerr << "Usage: " << argv[0] << " [num_targets] [iterations]\n";
+    return 1;
+  }
+
+  rdmnet_mock_core_reset_and_init();
+  etcpal_reset_all_fakes();
+  SetUpFakeMcastEnvironment();
+  etcpal_sendto_fake.custom_fake = [](etcpal_socket_t, const void* message, size_t length, int,
+                                      const EtcPalSockAddr*) {
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(message);
+    last_sent.assign(data, data + length);
+    return static_cast<int>(length);
+  };
+
+  if (rc_llrp_module_init() != kEtcPalErrOk || rc_llrp_target_module_init() != kEtcPalErrOk)
+  {
+    std::cerr << "Failed to initialize the LLRP modules.\n";
+    return 1;
+  }
+
+  {
+    SimulatedTargets targets(num_targets);
+
+    auto uids = targets.SortedUids();
+    auto known_uids = MakeKnownUids(uids);
+    auto sorted_request = BuildProbeRequest(known_uids);
+    std::reverse(known_uids.begin(), known_uids.end());
+    auto unsorted_request = BuildProbeRequest(known_uids);
+
+    std::cout << num_targets << " targets, " << known_uids.size() << " Known UIDs, " << iterations
+              << " iterations\n";
+    BenchLookup("lookup, sorted", sorted_request, uids, iterations);
+    BenchLookup("lookup, unsorted", unsorted_request, uids, iterations);
+    BenchInOrder(sorted_request, uids, iterations);
+    BenchDispatch("dispatch, sorted", sorted_request, iterations);
+    BenchDispatch("dispatch, unsorted", unsorted_request, iterations);
+  }
+
+  rc_llrp_target_module_deinit();
+  rc_llrp_module_deinit();
+  return 0;
+}
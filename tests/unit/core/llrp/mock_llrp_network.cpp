@@ -24,6 +24,7 @@
 #include "etcpal/pack.h"
 #include "etcpal_mock/socket.h"
 #include "etcpal_mock/timer.h"
+#include "rdm/message.h"
 #include "rdmnet/core/llrp_manager.h"
 #include "rdmnet/core/opts.h"
 #include "rdmnet/defs.h"
@@ -115,6 +116,11 @@ void MockLlrpNetwork::AdvanceTimeAndTick(int time_to_advance_ms)
     }
   }
 
+  std::vector<std::vector<uint8_t>> rdm_responses;
+  rdm_responses.swap(pending_rdm_responses_);
+  for (const auto& rdm_response : rdm_responses)
+    rc_llrp_manager_data_received(rdm_response.data(), rdm_response.size(), &netint_);
+
   rc_llrp_manager_module_tick();
 }
 
@@ -130,6 +136,12 @@ void MockLlrpNetwork::AddTarget(const rdm::Uid& uid, const etcpal::Uuid& cid)
 
 void MockLlrpNetwork::HandleMessageSent(const uint8_t* message, size_t length, const etcpal::SockAddr& dest_addr)
 {
+  if (capturing_rdm_response_)
+  {
+    pending_rdm_responses_.emplace_back(message, message + length);
+    return;
+  }
+
   if (dest_addr.IsV4())
   {
     EXPECT_EQ(dest_addr.v4_data(), 0xeffffa85);
@@ -144,6 +156,12 @@ void MockLlrpNetwork::HandleMessageSent(const uint8_t* message, size_t length, c
   {
     ++probe_requests_;
   }
+  else if (etcpal_unpack_u32b(&message[kLlrpVectorOffset]) == VECTOR_LLRP_RDM_CMD)
+  {
+    rdm_command_dest_addrs_.push_back(dest_addr);
+    HandleRdmCommandSent(message, length);
+    return;
+  }
 
   if (dont_respond_count_ > 0)
   {
@@ -202,3 +220,35 @@ void MockLlrpNetwork::HandleMessageSent(const uint8_t* message, size_t length, c
   else
     consec_clean_probe_requests_ = 0;
 }
+
+// Respond to an RDM command with an empty ACK from whichever target it was addressed to.
+void MockLlrpNetwork::HandleRdmCommandSent(const uint8_t* message, size_t length)
+{
+  ++rdm_commands_;
+  if (rdm_dont_respond_count_ > 0)
+  {
+    --rdm_dont_respond_count_;
+    return;
+  }
+
+  LlrpMessage msg;
+  ASSERT_TRUE(rc_parse_llrp_message_view(message, length, &msg));
+
+  RdmCommandHeader cmd_header;
+  const uint8_t*   cmd_data;
+  uint8_t          cmd_data_len;
+  ASSERT_EQ(rdm_unpack_command(LLRP_MSG_GET_RDM(&msg), &cmd_header, &cmd_data, &cmd_data_len), kEtcPalErrOk);
+
+  RdmBuffer resp;
+  ASSERT_EQ(rdm_pack_response(&cmd_header, 0, nullptr, 0, &resp), kEtcPalErrOk);
+
+  LlrpHeader header;
+  header.dest_cid = msg.header.sender_cid;
+  header.sender_cid = msg.header.dest_cid;
+  header.transaction_number = msg.header.transaction_number;
+
+  uint8_t buf[LLRP_MAX_MESSAGE_SIZE];
+  capturing_rdm_response_ = true;
+  rc_send_llrp_rdm_response(0, buf, false, &header, &resp);
+  capturing_rdm_response_ = false;
+}
@@ -65,13 +65,19 @@ public:
   void SetNetint(const EtcPalMcastNetintId& netint) { netint_ = netint; }
   void SetLossiness(int lossiness) { lossiness_ = lossiness; }
   void DontRespondToProbeRequests(int num_probe_requests) { dont_respond_count_ = num_probe_requests; }
+  void DontRespondToRdmCommands(int num_rdm_commands) { rdm_dont_respond_count_ = num_rdm_commands; }
   int  num_probe_requests_received() const { return probe_requests_; }
   int  num_consecutive_clean_probe_requests() const { return consec_clean_probe_requests_; }
   int  elapsed_time_ms() const { return elapsed_time_ms_; }
+  int  num_rdm_commands_received() const { return rdm_commands_; }
+
+  const std::vector<etcpal::SockAddr>& rdm_command_dest_addrs() const { return rdm_command_dest_addrs_; }
 
 private:
   static constexpr int kMinimumTargetsToRespond = 10;
 
+  void HandleRdmCommandSent(const uint8_t* message, size_t length);
+
   std::random_device         r_;
   std::default_random_engine rand_engine_{r_()};
 
@@ -82,6 +88,13 @@ private:
   int                         consec_clean_probe_requests_{0};
   int                         elapsed_time_ms_{0};
   std::vector<MockLlrpTarget> targets_;
+
+  // RDM responses are delivered on the next tick after the command is sent.
+  bool                              capturing_rdm_response_{false};
+  std::vector<std::vector<uint8_t>> pending_rdm_responses_;
+  int                               rdm_dont_respond_count_{0};
+  int                               rdm_commands_{0};
+  std::vector<etcpal::SockAddr>     rdm_command_dest_addrs_;
 };
 
 #endif  // MOCK_LLRP_NETWORK_H_
@@ -30,6 +30,7 @@
 #include "etcpal_mock/common.h"
 #include "etcpal_mock/socket.h"
 #include "rdm/cpp/uid.h"
+#include "rdm/defs.h"
 #include "rdmnet_mock/core/common.h"
 #include "rdmnet/core/mcast.h"
 #include "rdmnet/core/opts.h"
@@ -40,6 +41,7 @@ extern "C" {
 FAKE_VOID_FUNC(managercb_target_discovered, RCLlrpManager*, const LlrpDiscoveredTarget*);
 FAKE_VOID_FUNC(managercb_rdm_response_received, RCLlrpManager*, const LlrpRdmResponse*);
 FAKE_VOID_FUNC(managercb_discovery_finished, RCLlrpManager*);
+FAKE_VOID_FUNC(managercb_rdm_command_timed_out, RCLlrpManager*, const LlrpDestinationAddr*, uint32_t);
 FAKE_VOID_FUNC(managercb_destroyed, RCLlrpManager*);
 }
 
@@ -71,6 +73,7 @@ protected:
     RESET_FAKE(managercb_target_discovered);
     RESET_FAKE(managercb_rdm_response_received);
     RESET_FAKE(managercb_discovery_finished);
+    RESET_FAKE(managercb_rdm_command_timed_out);
     RESET_FAKE(managercb_destroyed);
 
     rdmnet_mock_core_reset_and_init();
@@ -86,6 +89,7 @@ protected:
     manager_.callbacks.target_discovered = managercb_target_discovered;
     manager_.callbacks.rdm_response_received = managercb_rdm_response_received;
     manager_.callbacks.discovery_finished = managercb_discovery_finished;
+    manager_.callbacks.rdm_command_timed_out = managercb_rdm_command_timed_out;
     manager_.callbacks.destroyed = managercb_destroyed;
     manager_.lock = &manager_lock_.get();
 
@@ -233,6 +237,149 @@ TEST_F(TestLlrpManager, DiscoversResponderThatDoesntRespondAtFirst)
   EXPECT_EQ(managercb_discovery_finished_fake.call_count, 1u);
 }
 
+TEST_F(TestLlrpManager, OperatesOnAllNetintsWhenNoneSpecified)
+{
+  RCLlrpManager all_netints_manager = manager_;
+  all_netints_manager.cid = etcpal::Uuid::FromString("2b2b6a5c-1f7e-4d1e-9e0c-8cbe2a3b9f41").get();
+  all_netints_manager.netint.ip_type = kEtcPalIpTypeInvalid;
+  ASSERT_EQ(kEtcPalErrOk, rc_llrp_manager_register(&all_netints_manager));
+  EXPECT_EQ(all_netints_manager.num_netints, kFakeNetints.size());
+
+  // The first probe request goes out on every network interface.
+  ASSERT_EQ(kEtcPalErrOk, rc_llrp_manager_start_discovery(&all_netints_manager, 0));
+  EXPECT_EQ(llrp_network.num_probe_requests_received(), static_cast<int>(kFakeNetints.size()));
+
+  rc_llrp_manager_unregister(&all_netints_manager);
+  rc_llrp_manager_module_tick();
+  EXPECT_EQ(managercb_destroyed_fake.call_count, 1u);
+}
+
+TEST_F(TestLlrpManager, DiscoversRangesConcurrently)
+{
+  std::set<rdm::Uid>                      responders;
+  std::uniform_int_distribution<uint32_t> device_id_distribution(0);
+  while (responders.size() < 5000)
+    responders.insert({0x6574, device_id_distribution(rand_engine_)});
+  for (const rdm::Uid& responder_uid : responders)
+    llrp_network.AddTarget(responder_uid);
+
+  rc_llrp_manager_start_discovery(&manager_, 0);
+  while (managercb_discovery_finished_fake.call_count == 0 && llrp_network.elapsed_time_ms() < 120000)
+    llrp_network.AdvanceTimeAndTick();
+
+  // Discovering one range of 100 targets at a time would take 50 ranges * 4 probe requests * 2
+  // seconds. The ranges are split off and discovered concurrently instead.
+  EXPECT_EQ(managercb_discovery_finished_fake.call_count, 1u);
+  EXPECT_LT(llrp_network.elapsed_time_ms(), 30000);
+  EXPECT_EQ(managercb_target_discovered_fake.call_count, 5000u);
+}
+
+TEST_F(TestLlrpManager, CorrelatesRdmResponseWithCommand)
+{
+  const LlrpDestinationAddr destination = {etcpal::Uuid::V4().get(), {0x6574, 0x12345678}, 0};
+
+  uint32_t seq_num = 0;
+  ASSERT_EQ(kEtcPalErrOk, rc_llrp_manager_send_rdm_command(&manager_, &destination, kRdmnetCCGetCommand,
+                                                           E120_DEVICE_LABEL, nullptr, 0, &seq_num));
+
+  rdm_response_received_cb = [&](RCLlrpManager*, const LlrpRdmResponse* resp) {
+    EXPECT_EQ(resp->seq_num, seq_num);
+    EXPECT_EQ(etcpal::Uuid(resp->source_cid), etcpal::Uuid(destination.dest_cid));
+  };
+  llrp_network.AdvanceTimeAndTick();
+  EXPECT_EQ(managercb_rdm_response_received_fake.call_count, 1u);
+
+  // The command is complete, so it is neither retransmitted nor timed out.
+  for (int i = 0; i < 100; ++i)
+    llrp_network.AdvanceTimeAndTick();
+  EXPECT_EQ(llrp_network.num_rdm_commands_received(), 1);
+  EXPECT_EQ(managercb_rdm_command_timed_out_fake.call_count, 0u);
+}
+
+TEST_F(TestLlrpManager, RetransmitsRdmCommandUntilResponse)
+{
+  const LlrpDestinationAddr destination = {etcpal::Uuid::V4().get(), {0x6574, 0x12345678}, 0};
+
+  llrp_network.DontRespondToRdmCommands(1);
+  ASSERT_EQ(kEtcPalErrOk, rc_llrp_manager_send_rdm_command(&manager_, &destination, kRdmnetCCGetCommand,
+                                                           E120_DEVICE_LABEL, nullptr, 0, nullptr));
+
+  // Tick forward 25 * 100ms = 2.5 seconds (1x LLRP_TIMEOUT plus some extra padding).
+  for (int i = 0; i < 25; ++i)
+    llrp_network.AdvanceTimeAndTick();
+
+  EXPECT_EQ(llrp_network.num_rdm_commands_received(), 2);
+  EXPECT_EQ(managercb_rdm_response_received_fake.call_count, 1u);
+  EXPECT_EQ(managercb_rdm_command_timed_out_fake.call_count, 0u);
+}
+
+TEST_F(TestLlrpManager, TimesOutRdmCommandAfterRetries)
+{
+  const LlrpDestinationAddr destination = {etcpal::Uuid::V4().get(), {0x6574, 0x12345678}, 0};
+
+  llrp_network.DontRespondToRdmCommands(RDMNET_LLRP_MANAGER_RDM_COMMAND_RETRIES + 1);
+  uint32_t seq_num = 0;
+  ASSERT_EQ(kEtcPalErrOk, rc_llrp_manager_send_rdm_command(&manager_, &destination, kRdmnetCCGetCommand,
+                                                           E120_DEVICE_LABEL, nullptr, 0, &seq_num));
+
+  for (int i = 0; i < (RDMNET_LLRP_MANAGER_RDM_COMMAND_RETRIES + 1) * 20 + 5; ++i)
+    llrp_network.AdvanceTimeAndTick();
+
+  EXPECT_EQ(llrp_network.num_rdm_commands_received(), RDMNET_LLRP_MANAGER_RDM_COMMAND_RETRIES + 1);
+  EXPECT_EQ(managercb_rdm_response_received_fake.call_count, 0u);
+  ASSERT_EQ(managercb_rdm_command_timed_out_fake.call_count, 1u);
+  EXPECT_EQ(managercb_rdm_command_timed_out_fake.arg2_val, seq_num);
+}
+
+TEST_F(TestLlrpManager, LimitsRdmCommandsInFlightPerTarget)
+{
+  const LlrpDestinationAddr destination = {etcpal::Uuid::V4().get(), {0x6574, 0x12345678}, 0};
+  const LlrpDestinationAddr other_destination = {etcpal::Uuid::V4().get(), {0x6574, 0x87654321}, 0};
+
+  llrp_network.DontRespondToRdmCommands(RDMNET_LLRP_MANAGER_MAX_COMMANDS_PER_TARGET + 1);
+  for (int i = 0; i < RDMNET_LLRP_MANAGER_MAX_COMMANDS_PER_TARGET; ++i)
+  {
+    EXPECT_EQ(kEtcPalErrOk, rc_llrp_manager_send_rdm_command(&manager_, &destination, kRdmnetCCGetCommand,
+                                                             E120_DEVICE_LABEL, nullptr, 0, nullptr));
+  }
+  EXPECT_EQ(kEtcPalErrBusy, rc_llrp_manager_send_rdm_command(&manager_, &destination, kRdmnetCCGetCommand,
+                                                             E120_DEVICE_LABEL, nullptr, 0, nullptr));
+  EXPECT_EQ(kEtcPalErrOk, rc_llrp_manager_send_rdm_command(&manager_, &other_destination, kRdmnetCCGetCommand,
+                                                           E120_DEVICE_LABEL, nullptr, 0, nullptr));
+}
+
+TEST_F(TestLlrpManager, TriesUndiscoveredTargetOnOneNetintAtATime)
+{
+  RCLlrpManager all_netints_manager = manager_;
+  all_netints_manager.cid = etcpal::Uuid::FromString("2b2b6a5c-1f7e-4d1e-9e0c-8cbe2a3b9f41").get();
+  all_netints_manager.netint.ip_type = kEtcPalIpTypeInvalid;
+  ASSERT_EQ(kEtcPalErrOk, rc_llrp_manager_register(&all_netints_manager));
+  ASSERT_GT(all_netints_manager.num_netints, 1u);
+
+  const LlrpDestinationAddr destination = {etcpal::Uuid::V4().get(), {0x6574, 0x12345678}, 0};
+
+  // The command is sent once, on the first (IPv4) network interface only.
+  llrp_network.DontRespondToRdmCommands(RDMNET_LLRP_MANAGER_RDM_COMMAND_RETRIES + 1);
+  ASSERT_EQ(kEtcPalErrOk, rc_llrp_manager_send_rdm_command(&all_netints_manager, &destination, kRdmnetCCSetCommand,
+                                                           E120_IDENTIFY_DEVICE, nullptr, 0, nullptr));
+  EXPECT_EQ(llrp_network.num_rdm_commands_received(), 1);
+
+  // Once it times out there, it moves on to the next (IPv6) network interface, where it is answered.
+  for (int i = 0; i < (RDMNET_LLRP_MANAGER_RDM_COMMAND_RETRIES + 1) * 20 + 5; ++i)
+    llrp_network.AdvanceTimeAndTick();
+
+  const auto& dest_addrs = llrp_network.rdm_command_dest_addrs();
+  ASSERT_EQ(dest_addrs.size(), static_cast<size_t>(RDMNET_LLRP_MANAGER_RDM_COMMAND_RETRIES + 2));
+  for (size_t i = 0; i < dest_addrs.size() - 1; ++i)
+    EXPECT_TRUE(dest_addrs[i].IsV4());
+  EXPECT_TRUE(dest_addrs.back().IsV6());
+  EXPECT_EQ(managercb_rdm_response_received_fake.call_count, 1u);
+  EXPECT_EQ(managercb_rdm_command_timed_out_fake.call_count, 0u);
+
+  rc_llrp_manager_unregister(&all_netints_manager);
+  rc_llrp_manager_module_tick();
+}
+
 class TestLlrpManagerAtScale : public TestLlrpManager, public testing::WithParamInterface<int>
 {
 };
@@ -19,13 +19,23 @@
 
 #include "rdmnet/core/llrp_target.h"
 
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <set>
+#include <vector>
 #include "gtest/gtest.h"
 #include "fff.h"
 #include "etcpal/cpp/mutex.h"
 #include "etcpal/cpp/uuid.h"
 #include "etcpal_mock/common.h"
+#include "etcpal_mock/socket.h"
+#include "etcpal_mock/timer.h"
+#include "rdm/defs.h"
 #include "rdm/cpp/uid.h"
+#include "rdmnet/core/llrp_prot.h"
 #include "rdmnet/core/mcast.h"
+#include "rdmnet/core/opts.h"
 #include "rdmnet_mock/core/common.h"
 #include "fake_mcast.h"
 
@@ -34,20 +44,38 @@ FAKE_VOID_FUNC(targetcb_rdm_cmd_received, RCLlrpTarget*, const LlrpRdmCommand*,
 FAKE_VOID_FUNC(targetcb_destroyed, RCLlrpTarget*);
 }
 
+static std::vector<std::vector<uint8_t>> sent_messages;
+
 class TestLlrpTarget : public testing::Test
 {
 protected:
+  static constexpr size_t kNumExtraTargets = 8;
+
+  const etcpal::Uuid kManagerCid = etcpal::Uuid::FromString("9a4ab9b6-2ec0-4c7a-b2d1-3f1ac8b2e3a0");
+
   RCLlrpTarget  target_;
   etcpal::Mutex target_lock_;
 
+  std::array<RCLlrpTarget, kNumExtraTargets> extra_targets_;
+  etcpal::Mutex                              extra_target_lock_;
+
   void SetUp() override
   {
     RESET_FAKE(targetcb_rdm_cmd_received);
+    RESET_FAKE(targetcb_destroyed);
 
     rdmnet_mock_core_reset_and_init();
     etcpal_reset_all_fakes();
     SetUpFakeMcastEnvironment();
 
+    sent_messages.clear();
+    etcpal_sendto_fake.custom_fake = [](etcpal_socket_t, const void* message, size_t length, int,
+                                        const EtcPalSockAddr*) {
+      const uint8_t* data = reinterpret_cast<const uint8_t*>(message);
+      sent_messages.emplace_back(data, data + length);
+      return static_cast<int>(length);
+    };
+
     target_.cid = etcpal::Uuid::FromString("28e04e4a-9eda-44d1-b4f8-56af772ca4c9").get();
     target_.uid = rdm::Uid::FromString("6574:60313950").get();
     target_.lock = &target_lock_.get();
@@ -60,6 +88,113 @@ protected:
     ASSERT_EQ(kEtcPalErrOk, rc_llrp_target_register(&target_, nullptr, 0));
   }
 
+  // Registers extra targets with UIDs 6574:00000001 through 6574:00000008 and makes them active.
+  void RegisterExtraTargets()
+  {
+    for (size_t i = 0; i < kNumExtraTargets; ++i)
+    {
+      RCLlrpTarget& target = extra_targets_[i];
+      target.cid = etcpal::Uuid::V4().get();
+      target.uid = rdm::Uid(0x6574, static_cast<uint32_t>(i + 1)).get();
+      target.lock = &extra_target_lock_.get();
+      target.component_type = kLlrpCompRptDevice;
+      target.callbacks = target_.callbacks;
+      ASSERT_EQ(kEtcPalErrOk, rc_llrp_target_register(&target, nullptr, 0));
+    }
+    rc_llrp_target_module_tick();
+  }
+
+  void UnregisterExtraTargets()
+  {
+    for (auto& target : extra_targets_)
+      rc_llrp_target_unregister(&target);
+  }
+
+  // Builds a probe request as a manager would send it.
+  std::vector<uint8_t> BuildProbeRequest(const rdm::Uid&            lower,
+                                         const rdm::Uid&            upper,
+                                         const std::vector<RdmUid>& known_uids = {})
+  {
+    return BuildProbeRequestFrom(kManagerCid, lower, upper, known_uids);
+  }
+
+  std::vector<uint8_t> BuildProbeRequestFrom(const etcpal::Uuid&        manager_cid,
+                                             const rdm::Uid&            lower,
+                                             const rdm::Uid&            upper,
+                                             const std::vector<RdmUid>& known_uids = {})
+  {
+    LlrpHeader header;
+    header.sender_cid = manager_cid.get();
+    header.dest_cid = *kLlrpBroadcastCid;
+    header.transaction_number = 1;
+
+    LocalProbeRequest request;
+    request.lower_uid = lower.get();
+    request.upper_uid = upper.get();
+    request.filter = 0;
+    request.known_uids = known_uids.data();
+    request.num_known_uids = known_uids.size();
+
+    return CaptureSent([&](uint8_t* buf) { rc_send_llrp_probe_request(0, buf, false, &header, &request); });
+  }
+
+  // Builds an RDM GET command from the manager to the target with the given CID and UID.
+  std::vector<uint8_t> BuildRdmCommand(const RCLlrpTarget& dest_target)
+  {
+    LlrpHeader header;
+    header.sender_cid = kManagerCid.get();
+    header.dest_cid = dest_target.cid;
+    header.transaction_number = 2;
+
+    RdmCommandHeader cmd_header{};
+    cmd_header.source_uid = rdm::Uid(0xe574, 0x1234).get();
+    cmd_header.dest_uid = dest_target.uid;
+    cmd_header.port_id = 1;
+    cmd_header.command_class = kRdmCCGetCommand;
+    cmd_header.param_id = E120_DEVICE_INFO;
+
+    RdmBuffer cmd;
+    EXPECT_EQ(kEtcPalErrOk, rdm_pack_command(&cmd_header, nullptr, 0, &cmd));
+    return CaptureSent([&](uint8_t* buf) { rc_send_llrp_rdm_command(0, buf, false, &header, &cmd); });
+  }
+
+  template <typename SendFunc>
+  std::vector<uint8_t> CaptureSent(SendFunc send)
+  {
+    uint8_t buf[LLRP_MAX_MESSAGE_SIZE];
+    sent_messages.clear();
+    send(buf);
+    EXPECT_EQ(sent_messages.size(), 1u);
+    std::vector<uint8_t> message = sent_messages.empty() ? std::vector<uint8_t>{} : sent_messages.front();
+    sent_messages.clear();
+    return message;
+  }
+
+  // Waits out the probe reply backoff and returns the UIDs of the targets which replied.
+  std::set<rdm::Uid> CollectProbeReplies()
+  {
+    etcpal_getms_fake.return_val += LLRP_MAX_BACKOFF_MS + 1;
+    rc_llrp_target_module_tick();
+
+    LlrpMessageInterest interest;
+    interest.interested_in_probe_reply = true;
+    interest.interested_in_probe_request = false;
+    interest.my_cid = kManagerCid.get();
+
+    std::set<rdm::Uid> replied;
+    for (const auto& message : sent_messages)
+    {
+      LlrpMessage msg;
+      if (rc_parse_llrp_message(message.data(), message.size(), &interest, &msg) &&
+          msg.vector == VECTOR_LLRP_PROBE_REPLY)
+      {
+        replied.insert(LLRP_MSG_GET_PROBE_REPLY(&msg)->uid);
+      }
+    }
+    sent_messages.clear();
+    return replied;
+  }
+
   void TearDown() override
   {
     rc_llrp_target_unregister(&target_);
@@ -76,3 +211,166 @@ TEST_F(TestLlrpTarget, DestroyedCalledOnUnregister)
   EXPECT_EQ(targetcb_destroyed_fake.call_count, 1u);
   EXPECT_EQ(targetcb_destroyed_fake.arg0_val, &target_);
 }
+
+TEST_F(TestLlrpTarget, BroadcastProbeRequestReachesOnlyTargetsInRange)
+{
+  RegisterExtraTargets();
+
+  auto request = BuildProbeRequest(rdm::Uid(0x6574, 3), rdm::Uid(0x6574, 6));
+  rc_llrp_target_data_received(request.data(), request.size(), &kFakeNetints[0]);
+
+  std::set<rdm::Uid> expected = {rdm::Uid(0x6574, 3), rdm::Uid(0x6574, 4), rdm::Uid(0x6574, 5),
+                                 rdm::Uid(0x6574, 6)};
+  EXPECT_EQ(CollectProbeReplies(), expected);
+
+  UnregisterExtraTargets();
+}
+
+TEST_F(TestLlrpTarget, BroadcastProbeRequestHonorsKnownUids)
+{
+  RegisterExtraTargets();
+
+  auto request = BuildProbeRequest(rdm::Uid(0x6574, 0), rdm::Uid(0x6574, 0xffffffff),
+                                   {rdm::Uid(0x6574, 2).get(), rdm::Uid(0x6574, 5).get(), target_.uid});
+  rc_llrp_target_data_received(request.data(), request.size(), &kFakeNetints[0]);
+
+  std::set<rdm::Uid> expected = {rdm::Uid(0x6574, 1), rdm::Uid(0x6574, 3), rdm::Uid(0x6574, 4),
+                                 rdm::Uid(0x6574, 6), rdm::Uid(0x6574, 7), rdm::Uid(0x6574, 8)};
+  EXPECT_EQ(CollectProbeReplies(), expected);
+
+  UnregisterExtraTargets();
+}
+
+// Managers aren't required to sort the Known UID list, so an unsorted one must still be honored.
+TEST_F(TestLlrpTarget, BroadcastProbeRequestHonorsUnsortedKnownUids)
+{
+  RegisterExtraTargets();
+
+  auto request = BuildProbeRequest(rdm::Uid(0x6574, 0), rdm::Uid(0x6574, 0xffffffff),
+                                   {target_.uid, rdm::Uid(0x6574, 7).get(), rdm::Uid(0x6574, 2).get()});
+  rc_llrp_target_data_received(request.data(), request.size(), &kFakeNetints[0]);
+
+  std::set<rdm::Uid> expected = {rdm::Uid(0x6574, 1), rdm::Uid(0x6574, 3), rdm::Uid(0x6574, 4),
+                                 rdm::Uid(0x6574, 5), rdm::Uid(0x6574, 6), rdm::Uid(0x6574, 8)};
+  EXPECT_EQ(CollectProbeReplies(), expected);
+
+  UnregisterExtraTargets();
+}
+
+// Probe requests from several managers during one backoff period are all replied to when it ends.
+TEST_F(TestLlrpTarget, ProbeRepliesToMultipleManagersSentTogether)
+{
+  rc_llrp_target_module_tick();
+
+  // One more manager than the target can queue replies for.
+  std::vector<etcpal::Uuid>         manager_cids;
+  std::vector<std::vector<uint8_t>> requests;
+  for (uint8_t i = 0; i <= RDMNET_LLRP_TARGET_MAX_QUEUED_PROBE_REPLIES; ++i)
+  {
+    EtcPalUuid cid = kManagerCid.get();
+    cid.data[15] = i;
+    manager_cids.push_back(cid);
+    requests.push_back(BuildProbeRequestFrom(cid, rdm::Uid(0x6574, 0), rdm::Uid(0x6574, 0xffffffff)));
+  }
+
+  // Seed rand() so that the backoff the target picks is known, and long enough to queue replies in.
+  unsigned int seed = 1;
+  uint32_t     backoff_ms = 0;
+  for (; backoff_ms < 2; ++seed)
+  {
+    srand(seed);
+    backoff_ms = static_cast<uint32_t>(rand() % (LLRP_MAX_BACKOFF_MS + 1));
+  }
+  srand(seed - 1);
+
+  // The first request starts the backoff timer; the rest arrive while it is running.
+  rc_llrp_target_data_received(requests[0].data(), requests[0].size(), &kFakeNetints[0]);
+  etcpal_getms_fake.return_val += backoff_ms / 2;
+  for (size_t i = 1; i < requests.size(); ++i)
+    rc_llrp_target_data_received(requests[i].data(), requests[i].size(), &kFakeNetints[0]);
+  // A repeated probe request from the same manager does not queue another reply.
+  rc_llrp_target_data_received(requests[0].data(), requests[0].size(), &kFakeNetints[0]);
+
+  // Nothing is sent until the timer started by the first request expires.
+  rc_llrp_target_module_tick();
+  EXPECT_TRUE(sent_messages.empty());
+  etcpal_getms_fake.return_val += (backoff_ms - (backoff_ms / 2)) - 1;
+  rc_llrp_target_module_tick();
+  EXPECT_TRUE(sent_messages.empty());
+
+  // Then all of the queued replies go out in the same tick.
+  etcpal_getms_fake.return_val += 2;
+  rc_llrp_target_module_tick();
+
+  std::multiset<etcpal::Uuid> reply_dests;
+  for (const auto& message : sent_messages)
+  {
+    LlrpMessage msg;
+    if (rc_parse_llrp_message_view(message.data(), message.size(), &msg) && msg.vector == VECTOR_LLRP_PROBE_REPLY)
+    {
+      EXPECT_EQ(rdm::Uid(LLRP_MSG_GET_PROBE_REPLY(&msg)->uid), rdm::Uid(target_.uid));
+      reply_dests.insert(msg.header.dest_cid);
+    }
+  }
+  // The manager which probed once the queue was full gets no reply.
+  std::multiset<etcpal::Uuid> expected(manager_cids.begin(), manager_cids.end() - 1);
+  EXPECT_EQ(reply_dests, expected);
+
+  sent_messages.clear();
+  etcpal_getms_fake.return_val += LLRP_MAX_BACKOFF_MS + 1;
+  rc_llrp_target_module_tick();
+  EXPECT_TRUE(sent_messages.empty());
+}
+
+TEST_F(TestLlrpTarget, ProbeRequestKnownUidsCheckedInOrder)
+{
+  auto request = BuildProbeRequest(rdm::Uid(0x6574, 1), rdm::Uid(0x6574, 10),
+                                   {rdm::Uid(0x6574, 2).get(), rdm::Uid(0x6574, 3).get(), rdm::Uid(0x6574, 9).get()});
+
+  LlrpMessage msg;
+  ASSERT_TRUE(rc_parse_llrp_message_view(request.data(), request.size(), &msg));
+  ASSERT_EQ(msg.vector, VECTOR_LLRP_PROBE_REQUEST);
+  const RemoteProbeRequest* probe_request = LLRP_MSG_GET_PROBE_REQUEST(&msg);
+  EXPECT_TRUE(probe_request->known_uids_sorted);
+
+  size_t known_uid_pos = 0;
+  for (uint32_t id = 0; id <= 11; ++id)
+  {
+    RdmUid uid = rdm::Uid(0x6574, id).get();
+    bool   expected = (id >= 1 && id <= 10 && id != 2 && id != 3 && id != 9);
+    EXPECT_EQ(rc_llrp_probe_request_contains_uid_in_order(probe_request, &uid, &known_uid_pos), expected) << id;
+    EXPECT_EQ(rc_llrp_probe_request_contains_uid(probe_request, &uid), expected) << id;
+  }
+}
+
+TEST_F(TestLlrpTarget, RdmCommandReachesOnlyAddressedTarget)
+{
+  RegisterExtraTargets();
+
+  auto command = BuildRdmCommand(extra_targets_[4]);
+  rc_llrp_target_data_received(command.data(), command.size(), &kFakeNetints[0]);
+
+  ASSERT_EQ(targetcb_rdm_cmd_received_fake.call_count, 1u);
+  EXPECT_EQ(targetcb_rdm_cmd_received_fake.arg0_val, &extra_targets_[4]);
+  EXPECT_EQ(targetcb_rdm_cmd_received_fake.arg1_val->rdm_header.param_id, E120_DEVICE_INFO);
+
+  UnregisterExtraTargets();
+}
+
+TEST_F(TestLlrpTarget, RdmCommandNotDeliveredAfterUnregister)
+{
+  RegisterExtraTargets();
+
+  auto command = BuildRdmCommand(extra_targets_[4]);
+  rc_llrp_target_unregister(&extra_targets_[4]);
+  rc_llrp_target_module_tick();
+
+  rc_llrp_target_data_received(command.data(), command.size(), &kFakeNetints[0]);
+  EXPECT_EQ(targetcb_rdm_cmd_received_fake.call_count, 0u);
+
+  for (size_t i = 0; i < kNumExtraTargets; ++i)
+  {
+    if (i != 4)
+      rc_llrp_target_unregister(&extra_targets_[i]);
+  }
+}
@@ -59,11 +59,22 @@ const std::unordered_map<std::string, const std::vector<size_t>> kFixedChunkSize
 // clang-format on
 #endif
 
+// Simulate receiving data into an RCMsgBuf.
+static void AppendData(RCMsgBuf& buf, const uint8_t* data, size_t size)
+{
+  size_t   space = 0;
+  uint8_t* recv_space = rc_msg_buf_get_recv_space(&buf, &space);
+  ASSERT_GE(space, size);
+  std::memcpy(recv_space, data, size);
+  rc_msg_buf_commit_recv(&buf, size);
+}
+
 // This test fixture is run on each file in the data file manifest; see tests/data
 class TestMsgBufParsing : public testing::Test, public testing::WithParamInterface<DataValidationPair>
 {
 protected:
   TestMsgBufParsing() { rc_msg_buf_init(&buf_); }
+  ~TestMsgBufParsing() { rc_msg_buf_deinit(&buf_); }
 
   std::vector<std::vector<uint8_t>> DivideIntoRandomChunks(const std::vector<uint8_t>& original, size_t num_chunks);
   std::vector<std::vector<uint8_t>> DivideIntoFixedChunks(const std::vector<uint8_t>& original,
@@ -138,8 +149,7 @@ TEST_P(TestMsgBufParsing, ParseMessageInFull)
   auto          test_data = rdmnet::testing::LoadTestData(test_data_file);
   ASSERT_LE(test_data.size(), static_cast<size_t>(RDMNET_RECV_DATA_MAX_SIZE));
 
-  std::memcpy(&buf_.buf[buf_.cur_data_size], test_data.data(), test_data.size());
-  buf_.cur_data_size += test_data.size();
+  AppendData(buf_, test_data.data(), test_data.size());
   ASSERT_EQ(kEtcPalErrOk, rc_msg_buf_parse_data(&buf_));
   ExpectMessagesEqual(buf_.msg, GetParam().second);
   rc_free_message_resources(&buf_.msg);
@@ -189,13 +199,11 @@ TEST_P(TestMsgBufParsing, ParseMessageInRandomChunks)
     // Do the chunked parsing
     for (size_t j = 0; j < kNumChunksPerMessage - 1; ++j)
     {
-      std::memcpy(&buf_.buf[buf_.cur_data_size], chunks[j].data(), chunks[j].size());
-      buf_.cur_data_size += chunks[j].size();
+      AppendData(buf_, chunks[j].data(), chunks[j].size());
       ASSERT_EQ(kEtcPalErrNoData, rc_msg_buf_parse_data(&buf_))
           << "While parsing chunk " << j + 1 << " of " << kNumChunksPerMessage;
     }
-    std::memcpy(&buf_.buf[buf_.cur_data_size], chunks.back().data(), chunks.back().size());
-    buf_.cur_data_size += chunks.back().size();
+    AppendData(buf_, chunks.back().data(), chunks.back().size());
     ASSERT_EQ(kEtcPalErrOk, rc_msg_buf_parse_data(&buf_))
         << "While parsing chunk " << kNumChunksPerMessage << " of " << kNumChunksPerMessage;
 
@@ -210,6 +218,136 @@ TEST_P(TestMsgBufParsing, ParseMessageInRandomChunks)
 
 INSTANTIATE_TEST_SUITE_P(TestValidInputData, TestMsgBufParsing, testing::ValuesIn(kRdmnetTestDataFiles));
 
+// The RDM buffers of parsed Notifications should be kept and reused from one message to the next,
+// so that parsing a steady stream of RDM traffic does not allocate.
+TEST(TestMsgBufRdmBufArena, ReusesRdmBuffersAcrossMessages)
+{
+  std::vector<uint8_t> test_data;
+  RdmnetMessage        expected_msg;
+  ASSERT_TRUE(GetTestFileByBasename("rdm_get_command_response_ack_overflow", test_data, expected_msg));
+
+  RCMsgBuf buf;
+  rc_msg_buf_init(&buf);
+
+  const RdmBuffer* first_rdm_buffers = nullptr;
+  size_t           first_capacity = 0;
+  for (int i = 0; i < 3; ++i)
+  {
+    SCOPED_TRACE("While parsing message " + std::to_string(i + 1));
+    AppendData(buf, test_data.data(), test_data.size());
+    ASSERT_EQ(kEtcPalErrOk, rc_msg_buf_parse_data(&buf));
+    ExpectMessagesEqual(buf.msg, expected_msg);
+
+    const RptRdmBufList* list = RPT_GET_RDM_BUF_LIST(RDMNET_GET_RPT_MSG(&buf.msg));
+    EXPECT_GE(buf.rdm_buf_arena.capacity, list->num_rdm_buffers);
+    if (i == 0)
+    {
+      first_rdm_buffers = list->rdm_buffers;
+      first_capacity = buf.rdm_buf_arena.capacity;
+    }
+    else
+    {
+      EXPECT_EQ(list->rdm_buffers, first_rdm_buffers);
+      EXPECT_EQ(buf.rdm_buf_arena.capacity, first_capacity);
+    }
+    rc_free_message_resources(&buf.msg);
+  }
+
+  rc_msg_buf_deinit(&buf);
+}
+
+// Parsing many small messages from one receive should consume them in place rather than shifting
+// the remaining data down after each message.
+TEST(TestMsgBufReadCursor, ParsesMessagesInPlace)
+{
+  std::vector<uint8_t> test_data;
+  RdmnetMessage        expected_msg;
+  ASSERT_TRUE(GetTestFileByBasename("broker_null", test_data, expected_msg));
+
+  constexpr size_t kNumMessages = 10;
+  RCMsgBuf         buf;
+  rc_msg_buf_init(&buf);
+  for (size_t i = 0; i < kNumMessages; ++i)
+    AppendData(buf, test_data.data(), test_data.size());
+
+  for (size_t i = 0; i < kNumMessages; ++i)
+  {
+    SCOPED_TRACE("While parsing message " + std::to_string(i + 1));
+    ASSERT_EQ(kEtcPalErrOk, rc_msg_buf_parse_data(&buf));
+    ExpectMessagesEqual(buf.msg, expected_msg);
+    rc_free_message_resources(&buf.msg);
+
+    if (i < kNumMessages - 1)
+    {
+      // The remaining data has not been moved.
+      EXPECT_EQ(buf.cur_data_start, (i + 1) * test_data.size());
+    }
+  }
+  EXPECT_EQ(buf.cur_data_size, 0u);
+  EXPECT_EQ(kEtcPalErrNoData, rc_msg_buf_parse_data(&buf));
+
+  rc_msg_buf_deinit(&buf);
+}
+
+// Unparsed data is moved to the front of the buffer only when there isn't enough room after it to
+// receive into.
+TEST(TestMsgBufReadCursor, CompactsWhenReceiveSpaceRunsShort)
+{
+  RCMsgBuf buf;
+  rc_msg_buf_init(&buf);
+
+  const uint8_t kLeftover[] = {0x01, 0x02, 0x03};
+  buf.cur_data_start = RC_MSG_BUF_SIZE - RDMNET_RECV_DATA_MAX_SIZE;
+  buf.cur_data_size = sizeof(kLeftover);
+  std::memcpy(&buf.buf[buf.cur_data_start], kLeftover, sizeof(kLeftover));
+
+  size_t   space = 0;
+  uint8_t* recv_space = rc_msg_buf_get_recv_space(&buf, &space);
+  EXPECT_EQ(buf.cur_data_start, 0u);
+  EXPECT_EQ(std::memcmp(buf.buf, kLeftover, sizeof(kLeftover)), 0);
+  EXPECT_EQ(recv_space, &buf.buf[sizeof(kLeftover)]);
+  EXPECT_EQ(space, RC_MSG_BUF_SIZE - sizeof(kLeftover));
+
+  rc_msg_buf_deinit(&buf);
+}
+
+// After a desync, junk before the next TCP preamble should be skipped, including near-misses on the
+// ACN packet identifier.
+TEST(TestMsgBufPreamble, ResyncsAfterJunk)
+{
+  std::vector<uint8_t> test_data;
+  RdmnetMessage        expected_msg;
+  ASSERT_TRUE(GetTestFileByBasename("broker_null", test_data, expected_msg));
+
+  const std::string    kNearMisses = "AAASC-E1.1ASC-E1.17\x01\x02\x03xyzA";
+  std::vector<uint8_t> stream(kNearMisses.begin(), kNearMisses.end());
+  stream.insert(stream.end(), 200, 0x41);
+  stream.insert(stream.end(), test_data.begin(), test_data.end());
+
+  RCMsgBuf buf;
+  rc_msg_buf_init(&buf);
+  AppendData(buf, stream.data(), stream.size());
+  ASSERT_EQ(kEtcPalErrOk, rc_msg_buf_parse_data(&buf));
+  ExpectMessagesEqual(buf.msg, expected_msg);
+  rc_free_message_resources(&buf.msg);
+  EXPECT_EQ(buf.cur_data_size, 0u);
+  rc_msg_buf_deinit(&buf);
+}
+
+// Junk with no preamble is discarded, except for a tail which could still be the start of one.
+TEST(TestMsgBufPreamble, DiscardsJunkWithoutPreamble)
+{
+  std::vector<uint8_t> junk(500, 0x41);
+  junk.insert(junk.end(), 100, 0x00);
+
+  RCMsgBuf buf;
+  rc_msg_buf_init(&buf);
+  AppendData(buf, junk.data(), junk.size());
+  EXPECT_EQ(kEtcPalErrNoData, rc_msg_buf_parse_data(&buf));
+  EXPECT_EQ(buf.cur_data_size, static_cast<size_t>(ACN_TCP_PREAMBLE_SIZE));
+  rc_msg_buf_deinit(&buf);
+}
+
 class TestMsgBufReceiving : public testing::Test
 {
 protected:
@@ -223,6 +361,7 @@ protected:
     etcpal_reset_all_fakes();
     rc_msg_buf_init(&buf_);
   }
+  ~TestMsgBufReceiving() { rc_msg_buf_deinit(&buf_); }
 
   RCMsgBuf buf_;
 };
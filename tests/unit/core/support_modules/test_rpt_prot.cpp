@@ -20,6 +20,7 @@
 #include "rdmnet/core/rpt_prot.h"
 
 #include <algorithm>
+#include <array>
 #include <memory>
 #include "etcpal_mock/socket.h"
 #include "rdmnet_mock/core/common.h"
@@ -63,6 +64,7 @@ void TestSendStatus(const std::string& file_name)
   };
   RCConnection conn{};
   EXPECT_EQ(rc_rpt_send_status(&conn, &msg.sender_cid, &RDMNET_GET_RPT_MSG(&msg)->header, status), kEtcPalErrOk);
+  EXPECT_EQ(rc_send_fake.call_count, 1u);
   EXPECT_EQ(msg_bytes, packed_msg);
 }
 
@@ -105,3 +107,22 @@ TEST(TestRptProt, SendRptStatusMaxLengthString)
 {
   TestSendStatus("rpt_status_max_length_string");
 }
+
+// An ACK_OVERFLOW response used to take one socket call per header plus one per RDM command PDU;
+// the whole notification should now be written at once.
+TEST(TestRptProt, SendRptNotificationUsesOneSocketCall)
+{
+  std::array<RdmBuffer, RDMNET_MAX_SENT_ACK_OVERFLOW_RESPONSES + 2> cmds{};
+  for (auto& cmd : cmds)
+    cmd.data_len = RDM_MAX_BYTES;
+
+  RESET_FAKE(rc_send);
+  rc_send_fake.custom_fake = [](etcpal_socket_t, const void*, size_t length, int) { return (int)length; };
+
+  RCConnection conn{};
+  EtcPalUuid   cid{};
+  RptHeader    header{};
+  EXPECT_EQ(rc_rpt_send_notification(&conn, &cid, &header, cmds.data(), cmds.size()), kEtcPalErrOk);
+  EXPECT_EQ(rc_send_fake.call_count, 1u);
+  EXPECT_EQ(rc_send_fake.arg2_val, rc_rpt_get_notification_buffer_size(cmds.data(), cmds.size()));
+}
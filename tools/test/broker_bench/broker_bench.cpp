@@ -0,0 +1,721 @@
+/******************************************************************************
+ * Copyright 2020 ETC Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ ******************************************************************************
+ * This file is a part of RDMnet. For more information, go to:
+ * https://github.com/ETCLabs/RDMnet
+ *****************************************************************************/
+
+// rdmnet_broker_bench: an in-process load generator for the RDMnet broker.
+//
+// Starts a real rdmnet::Broker listening on loopback, connects a set of synthetic controllers and
+// devices to it through the RDMnet client library, and drives one of the following workloads:
+//
+//   rdm    - Each controller keeps a window of RDM GET commands outstanding to the devices, which
+//            respond immediately. Measures request throughput and round-trip latency.
+//   notify - Devices send unsolicited RDM updates at a fixed total rate, which the broker fans out
+//            to every controller. Measures delivered notifications and one-way latency.
+//   storm  - Devices repeatedly disconnect and reconnect, keeping a window of connections in
+//            progress. Measures connect throughput and latency, and the client list updates
+//            delivered to controllers.
+//
+// The clients share the process with the broker, so the CPU time and peak RSS reported include the
+// load generator itself. Latencies also include time spent in the client library's own thread.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include "etcpal/cpp/inet.h"
+#include "etcpal/cpp/signal.h"
+#include "etcpal/cpp/thread.h"
+#include "etcpal/cpp/uuid.h"
+#include "rdm/message.h"
+#include "rdmnet/cpp/broker.h"
+#include "rdmnet/cpp/common.h"
+#include "rdmnet/cpp/controller.h"
+#include "rdmnet/cpp/device.h"
+
+/*********************************** Options **********************************/
+
+enum class Workload
+{
+  kRdm,
+  kNotify,
+  kStorm
+};
+
+struct BenchOptions
+{
+  Workload     workload{Workload::kRdm};
+  unsigned int num_devices{100};
+  unsigned int num_controllers{4};
+  unsigned int duration_s{10};
+  unsigned int window{16};
+  unsigned int rate{1000};
+  uint16_t     port{8888};
+};
+
+static constexpr uint16_t kBenchManufacturerId = 0x6574;
+static constexpr uint16_t kBenchParamId = 0x8001;  // Manufacturer-specific, so the library passes it through
+static constexpr int      kConnectTimeoutMs = 10000;
+
+void PrintHelp(const char* app_name)
+{
+  std::cout << "Usage: " << app_name << " [OPTION]...\n";
+  std::cout << "\n";
+  std::cout << "Options:\n";
+  std::cout << "  --workload=WORKLOAD   One of 'rdm', 'notify' or 'storm'. Default is rdm.\n";
+  std::cout << "  --devices=N           Number of synthetic devices. Default is 100.\n";
+  std::cout << "  --controllers=M       Number of synthetic controllers. Default is 4.\n";
+  std::cout << "  --duration=SECONDS    How long to run the workload. Default is 10.\n";
+  std::cout << "  --window=N            RDM commands outstanding per controller (rdm), or\n";
+  std::cout << "                        reconnects in progress (storm). Default is 16.\n";
+  std::cout << "  --rate=N              Total notifications per second (notify). Default is 1000.\n";
+  std::cout << "  --port=PORT           The loopback port for the broker. Default is 8888.\n";
+  std::cout << "  --help                Display this help and exit.\n";
+}
+
+bool ParseUnsigned(const char* str, unsigned int& value)
+{
+  char*         end;
+  unsigned long parsed = strtoul(str, &end, 10);
+  if (end == str || *end != '\0')
+    return false;
+  value = static_cast<unsigned int>(parsed);
+  return true;
+}
+
+// Returns false if the program should exit without running a workload.
+bool ParseArgs(int argc, char* argv[], BenchOptions& options)
+{
+  for (int i = 1; i < argc; ++i)
+  {
+    const char*  arg = argv[i];
+    unsigned int value = 0;
+    bool         ok = true;
+
+    if (strncmp(arg, "--workload=", 11) == 0)
+    {
+      std::string workload = &arg[11];
+      if (workload == "rdm")
+        options.workload = Workload::kRdm;
+      else if (workload == "notify")
+        options.workload = Workload::kNotify;
+      else if (workload == "storm")
+        options.workload = Workload::kStorm;
+      else
+        ok = false;
+    }
+    else if (strncmp(arg, "--devices=", 10) == 0)
+    {
+      ok = ParseUnsigned(&arg[10], options.num_devices) && options.num_devices > 0;
+    }
+    else if (strncmp(arg, "--controllers=", 14) == 0)
+    {
+      ok = ParseUnsigned(&arg[14], options.num_controllers) && options.num_controllers > 0;
+    }
+    else if (strncmp(arg, "--duration=", 11) == 0)
+    {
+      ok = ParseUnsigned(&arg[11], options.duration_s) && options.duration_s > 0;
+    }
+    else if (strncmp(arg, "--window=", 9) == 0)
+    {
+      ok = ParseUnsigned(&arg[9], options.window) && options.window > 0;
+    }
+    else if (strncmp(arg, "--rate=", 7) == 0)
+    {
+      ok = ParseUnsigned(&arg[7], options.rate) && options.rate > 0;
+    }
+    else if (strncmp(arg, "--port=", 7) == 0)
+    {
+      ok = ParseUnsigned(&arg[7], value) && value > 0 && value <= 65535;
+      options.port = static_cast<uint16_t>(value);
+    }
+    else if (strcmp(arg, "--help") == 0)
+    {
+      PrintHelp(argv[0]);
+      return false;
+    }
+    else
+    {
+      ok = false;
+    }
+
+    if (!ok)
+    {
+      std::cout << "Invalid argument: " << arg << "\n\n";
+      PrintHelp(argv[0]);
+      return false;
+    }
+  }
+  return true;
+}
+
+/********************************* Measurement ********************************/
+
+using Clock = std::chrono::steady_clock;
+
+// Timestamps travel in RDM parameter data. Everything runs in one process, so they are copied in
+// native byte order.
+uint64_t TimestampNow()
+{
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count());
+}
+
+class LatencyRecorder
+{
+public:
+  void Add(uint64_t sent_timestamp)
+  {
+    uint64_t now = TimestampNow();
+    uint64_t latency_us = (now > sent_timestamp ? (now - sent_timestamp) / 1000 : 0);
+
+    std::lock_guard<std::mutex> lock(lock_);
+    samples_.push_back(latency_us);
+  }
+
+  void AddFromData(const uint8_t* data, size_t data_len)
+  {
+    if (data && data_len >= sizeof(uint64_t))
+    {
+      uint64_t sent_timestamp;
+      memcpy(&sent_timestamp, data, sizeof(uint64_t));
+      Add(sent_timestamp);
+    }
+  }
+
+  // Not thread-safe; call after the workload has stopped.
+  void Print(const char* name)
+  {
+    std::cout << name << " latency (us): ";
+    if (samples_.empty())
+    {
+      std::cout << "no samples\n";
+      return;
+    }
+
+    std::sort(samples_.begin(), samples_.end());
+    std::cout << "p50 " << Percentile(0.5) << ", p99 " << Percentile(0.99) << ", p999 " << Percentile(0.999)
+              << ", max " << samples_.back() << " (" << samples_.size() << " samples)\n";
+  }
+
+private:
+  uint64_t Percentile(double p) const
+  {
+    size_t index = static_cast<size_t>(p * static_cast<double>(samples_.size()));
+    if (index >= samples_.size())
+      index = samples_.size() - 1;
+    return samples_[index];
+  }
+
+  std::mutex            lock_;
+  std::vector<uint64_t> samples_;
+};
+
+struct BenchResults
+{
+  std::atomic<uint64_t> requests_sent{0};
+  std::atomic<uint64_t> responses_received{0};
+  std::atomic<uint64_t> rpt_status_received{0};
+  std::atomic<uint64_t> notifications_sent{0};
+  std::atomic<uint64_t> notifications_received{0};
+  std::atomic<uint64_t> connects{0};
+  std::atomic<uint64_t> connect_failures{0};
+  std::atomic<uint64_t> client_list_updates{0};
+
+  LatencyRecorder request_latency;
+  LatencyRecorder notification_latency;
+  LatencyRecorder connect_latency;
+};
+
+/****************************** Synthetic clients *****************************/
+
+class BenchDevice : public rdmnet::Device::NotifyHandler
+{
+public:
+  BenchDevice(BenchResults& results, unsigned int index, const etcpal::SockAddr& broker_addr)
+      : results_(results), uid_(kBenchManufacturerId, 0x20000u + index), broker_addr_(broker_addr)
+  {
+  }
+
+  etcpal::Error Startup()
+  {
+    rdmnet::Device::Settings settings(etcpal::Uuid::V4(), uid_);
+    settings.response_buf = response_buf_;
+    connect_start_ = TimestampNow();
+    return device_.StartupWithDefaultScope(*this, settings, broker_addr_);
+  }
+
+  void Shutdown()
+  {
+    connected_ = false;
+    device_.Shutdown();
+  }
+
+  void SendNotification()
+  {
+    uint64_t timestamp = TimestampNow();
+    if (device_.SendRdmUpdate(kBenchParamId, reinterpret_cast<const uint8_t*>(&timestamp), sizeof(timestamp)))
+      ++results_.notifications_sent;
+  }
+
+  bool            connected() const { return connected_; }
+  const rdm::Uid& uid() const { return uid_; }
+
+  void HandleConnectedToBroker(rdmnet::Device::Handle, const rdmnet::ClientConnectedInfo&) override
+  {
+    results_.connect_latency.Add(connect_start_);
+    ++results_.connects;
+    connected_ = true;
+  }
+
+  void HandleBrokerConnectFailed(rdmnet::Device::Handle, const rdmnet::ClientConnectFailedInfo&) override
+  {
+    ++results_.connect_failures;
+  }
+
+  void HandleDisconnectedFromBroker(rdmnet::Device::Handle, const rdmnet::ClientDisconnectedInfo&) override
+  {
+    connected_ = false;
+  }
+
+  // Echo the controller's timestamp back so that it can measure the round trip.
+  rdmnet::RdmResponseAction HandleRdmCommand(rdmnet::Device::Handle, const rdmnet::RdmCommand& cmd) override
+  {
+    if (cmd.param_id() != kBenchParamId)
+      return rdmnet::RdmResponseAction::SendNack(kRdmNRUnknownPid);
+
+    memcpy(response_buf_, cmd.data(), cmd.data_len());
+    return rdmnet::RdmResponseAction::SendAck(cmd.data_len());
+  }
+
+  rdmnet::RdmResponseAction HandleLlrpRdmCommand(rdmnet::Device::Handle, const rdmnet::llrp::RdmCommand&) override
+  {
+    return rdmnet::RdmResponseAction::SendNack(kRdmNRUnknownPid);
+  }
+
+private:
+  BenchResults&          results_;
+  rdm::Uid               uid_;
+  etcpal::SockAddr       broker_addr_;
+  rdmnet::Device         device_;
+  uint8_t                response_buf_[RDM_MAX_PDL];
+  std::atomic<bool>      connected_{false};
+  std::atomic<uint64_t>  connect_start_{0};
+};
+
+class BenchController : public rdmnet::Controller::NotifyHandler
+{
+public:
+  BenchController(BenchResults& results, etcpal::Signal& response_signal, unsigned int index)
+      : results_(results), response_signal_(response_signal), uid_(kBenchManufacturerId, 0x10000u + index)
+  {
+  }
+
+  etcpal::Error Startup(const etcpal::SockAddr& broker_addr)
+  {
+    rdmnet::Controller::Settings settings(etcpal::Uuid::V4(), uid_);
+    rdmnet::Controller::RdmData  rdm_data(1, 1, "ETC", "RDMnet Broker Bench", "1.0", "Bench Controller");
+
+    auto res = controller_.Startup(*this, settings, rdm_data);
+    if (!res)
+      return res;
+
+    auto scope_res = controller_.AddDefaultScope(broker_addr);
+    if (!scope_res)
+      return scope_res.error();
+    scope_handle_ = *scope_res;
+    return kEtcPalErrOk;
+  }
+
+  void Shutdown() { controller_.Shutdown(); }
+
+  void SendRequest(const rdm::Uid& dest)
+  {
+    uint64_t timestamp = TimestampNow();
+    auto     res = controller_.SendGetCommand(scope_handle_, rdmnet::DestinationAddr::ToDefaultResponder(dest),
+                                              kBenchParamId, reinterpret_cast<const uint8_t*>(&timestamp),
+                                              static_cast<uint8_t>(sizeof(timestamp)));
+    if (res)
+    {
+      ++outstanding_;
+      ++results_.requests_sent;
+    }
+  }
+
+  bool         connected() const { return connected_; }
+  unsigned int outstanding() const { return outstanding_; }
+
+  void HandleConnectedToBroker(rdmnet::Controller::Handle,
+                               rdmnet::ScopeHandle,
+                               const rdmnet::ClientConnectedInfo&) override
+  {
+    connected_ = true;
+  }
+
+  void HandleBrokerConnectFailed(rdmnet::Controller::Handle,
+                                 rdmnet::ScopeHandle,
+                                 const rdmnet::ClientConnectFailedInfo&) override
+  {
+    ++results_.connect_failures;
+  }
+
+  void HandleDisconnectedFromBroker(rdmnet::Controller::Handle,
+                                    rdmnet::ScopeHandle,
+                                    const rdmnet::ClientDisconnectedInfo&) override
+  {
+    connected_ = false;
+  }
+
+  void HandleClientListUpdate(rdmnet::Controller::Handle,
+                              rdmnet::ScopeHandle,
+                              client_list_action_t,
+                              const rdmnet::RptClientList&) override
+  {
+    ++results_.client_list_updates;
+  }
+
+  bool HandleRdmResponse(rdmnet::Controller::Handle, rdmnet::ScopeHandle, const rdmnet::RdmResponse& resp) override
+  {
+    if (resp.param_id() != kBenchParamId)
+      return true;
+
+    if (resp.IsResponseToMe())
+    {
+      results_.request_latency.AddFromData(resp.data(), resp.data_len());
+      ++results_.responses_received;
+      CompleteRequest();
+    }
+    else
+    {
+      results_.notification_latency.AddFromData(resp.data(), resp.data_len());
+      ++results_.notifications_received;
+    }
+    return true;
+  }
+
+  void HandleRptStatus(rdmnet::Controller::Handle, rdmnet::ScopeHandle, const rdmnet::RptStatus&) override
+  {
+    ++results_.rpt_status_received;
+    CompleteRequest();
+  }
+
+private:
+  void CompleteRequest()
+  {
+    if (outstanding_ > 0)
+      --outstanding_;
+    response_signal_.Notify();
+  }
+
+  BenchResults&             results_;
+  etcpal::Signal&           response_signal_;
+  rdm::Uid                  uid_;
+  rdmnet::Controller        controller_;
+  rdmnet::ScopeHandle       scope_handle_;
+  std::atomic<bool>         connected_{false};
+  std::atomic<unsigned int> outstanding_{0};
+};
+
+/********************************** Workloads *********************************/
+
+class BrokerBench
+{
+public:
+  explicit BrokerBench(const BenchOptions& options) : options_(options) {}
+
+  int Run();
+
+private:
+  bool StartClients();
+  bool WaitForClients();
+  void StopClients();
+
+  void RunRdmWorkload(Clock::time_point end_time);
+  void RunNotifyWorkload(Clock::time_point end_time);
+  void RunStormWorkload(Clock::time_point end_time);
+
+  void PrintResults(double elapsed_s, const rdmnet::Broker::Statistics& stats);
+
+  const BenchOptions& options_;
+  etcpal::SockAddr    broker_addr_;
+  rdmnet::Broker      broker_;
+  BenchResults        results_;
+  etcpal::Signal      response_signal_;
+
+  std::vector<std::unique_ptr<BenchDevice>>     devices_;
+  std::vector<std::unique_ptr<BenchController>> controllers_;
+};
+
+int BrokerBench::Run()
+{
+  broker_addr_ = etcpal::SockAddr(etcpal::IpAddr::FromString("127.0.0.1"), options_.port);
+
+  rdmnet::Broker::Settings broker_settings(etcpal::Uuid::V4(), kBenchManufacturerId);
+  broker_settings.dns.manufacturer = "ETC";
+  broker_settings.dns.model = "RDMnet Broker Bench";
+  broker_settings.listen_port = options_.port;
+  broker_settings.max_send_batch_size = 32;
+  broker_settings.client_list_update_window_ms = 50;
+
+  auto res = broker_.Startup(broker_settings);
+  if (!res)
+  {
+    std::cout << "Broker failed to start: " << res.ToString() << '\n';
+    return 1;
+  }
+
+  if (!StartClients() || !WaitForClients())
+  {
+    StopClients();
+    broker_.Shutdown();
+    return 1;
+  }
+
+  // Measure only the workload itself, not the connection setup.
+  results_.connects = 0;
+  results_.client_list_updates = 0;
+  broker_.GetStatistics();
+
+  rusage usage_start;
+  getrusage(RUSAGE_SELF, &usage_start);
+  auto start_time = Clock::now();
+  auto end_time = start_time + std::chrono::seconds(options_.duration_s);
+
+  switch (options_.workload)
+  {
+    case Workload::kRdm:
+      RunRdmWorkload(end_time);
+      break;
+    case Workload::kNotify:
+      RunNotifyWorkload(end_time);
+      break;
+    case Workload::kStorm:
+      RunStormWorkload(end_time);
+      break;
+  }
+
+  // Let in-flight messages drain before sampling.
+  etcpal::Thread::Sleep(200);
+  double elapsed_s = std::chrono::duration<double>(Clock::now() - start_time).count();
+  auto   stats = broker_.GetStatistics();
+
+  rusage usage_end;
+  getrusage(RUSAGE_SELF, &usage_end);
+  auto cpu_seconds = [](const timeval& start, const timeval& end) {
+    return static_cast<double>(end.tv_sec - start.tv_sec) + static_cast<double>(end.tv_usec - start.tv_usec) / 1e6;
+  };
+
+  StopClients();
+  broker_.Shutdown();
+
+  PrintResults(elapsed_s, stats);
+  std::cout << "CPU time (s): user " << cpu_seconds(usage_start.ru_utime, usage_end.ru_utime) << ", system "
+            << cpu_seconds(usage_start.ru_stime, usage_end.ru_stime) << '\n';
+#ifdef __APPLE__
+  std::cout << "Peak RSS (KiB): " << usage_end.ru_maxrss / 1024 << '\n';
+#else
+  std::cout << "Peak RSS (KiB): " << usage_end.ru_maxrss << '\n';
+#endif
+  return 0;
+}
+
+bool BrokerBench::StartClients()
+{
+  for (unsigned int i = 0; i < options_.num_controllers; ++i)
+  {
+    controllers_.push_back(std::make_unique<BenchController>(results_, response_signal_, i));
+    auto res = controllers_.back()->Startup(broker_addr_);
+    if (!res)
+    {
+      std::cout << "Controller " << i << " failed to start: " << res.ToString() << '\n';
+      return false;
+    }
+  }
+
+  for (unsigned int i = 0; i < options_.num_devices; ++i)
+  {
+    devices_.push_back(std::make_unique<BenchDevice>(results_, i, broker_addr_));
+    auto res = devices_.back()->Startup();
+    if (!res)
+    {
+      std::cout << "Device " << i << " failed to start: " << res.ToString() << '\n';
+      return false;
+    }
+  }
+  return true;
+}
+
+bool BrokerBench::WaitForClients()
+{
+  for (int waited_ms = 0; waited_ms < kConnectTimeoutMs; waited_ms += 10)
+  {
+    if (std::all_of(controllers_.begin(), controllers_.end(), [](const auto& c) { return c->connected(); }) &&
+        std::all_of(devices_.begin(), devices_.end(), [](const auto& d) { return d->connected(); }))
+    {
+      return true;
+    }
+    etcpal::Thread::Sleep(10);
+  }
+
+  std::cout << "Timed out waiting for clients to connect to the broker.\n";
+  return false;
+}
+
+void BrokerBench::StopClients()
+{
+  for (auto& device : devices_)
+    device->Shutdown();
+  for (auto& controller : controllers_)
+    controller->Shutdown();
+  devices_.clear();
+  controllers_.clear();
+}
+
+// Keep each controller's window of commands full, spreading them round-robin across the devices.
+void BrokerBench::RunRdmWorkload(Clock::time_point end_time)
+{
+  size_t next_device = 0;
+  while (Clock::now() < end_time)
+  {
+    for (auto& controller : controllers_)
+    {
+      while (controller->outstanding() < options_.window)
+      {
+        controller->SendRequest(devices_[next_device]->uid());
+        next_device = (next_device + 1) % devices_.size();
+      }
+    }
+    response_signal_.TryWait(1);
+  }
+}
+
+// Pace unsolicited updates at the requested total rate, spreading them round-robin across devices.
+void BrokerBench::RunNotifyWorkload(Clock::time_point end_time)
+{
+  auto     start_time = Clock::now();
+  uint64_t num_sent = 0;
+  size_t   next_device = 0;
+
+  while (Clock::now() < end_time)
+  {
+    double   elapsed_s = std::chrono::duration<double>(Clock::now() - start_time).count();
+    uint64_t num_due = static_cast<uint64_t>(elapsed_s * options_.rate);
+    for (; num_sent < num_due; ++num_sent)
+    {
+      devices_[next_device]->SendNotification();
+      next_device = (next_device + 1) % devices_.size();
+    }
+    etcpal::Thread::Sleep(1);
+  }
+}
+
+// Cycle devices through disconnect and reconnect, keeping up to a window of connects in progress.
+void BrokerBench::RunStormWorkload(Clock::time_point end_time)
+{
+  size_t next_device = 0;
+  while (Clock::now() < end_time)
+  {
+    auto num_connecting = static_cast<unsigned int>(
+        std::count_if(devices_.begin(), devices_.end(), [](const auto& d) { return !d->connected(); }));
+    for (size_t i = 0; i < devices_.size() && num_connecting < options_.window; ++i)
+    {
+      auto& device = devices_[next_device];
+      next_device = (next_device + 1) % devices_.size();
+      if (device->connected())
+      {
+        device->Shutdown();
+        device->Startup();
+        ++num_connecting;
+      }
+    }
+    etcpal::Thread::Sleep(1);
+  }
+}
+
+void BrokerBench::PrintResults(double elapsed_s, const rdmnet::Broker::Statistics& stats)
+{
+  static const char* kWorkloadNames[] = {"rdm", "notify", "storm"};
+
+  std::cout << std::fixed << std::setprecision(1);
+  std::cout << "Workload: " << kWorkloadNames[static_cast<int>(options_.workload)] << ", "
+            << options_.num_devices << " devices, " << options_.num_controllers << " controllers, " << elapsed_s
+            << " s\n";
+
+  uint64_t responses = results_.responses_received;
+  uint64_t notifications = results_.notifications_received;
+  uint64_t connects = results_.connects;
+
+  switch (options_.workload)
+  {
+    case Workload::kRdm:
+      std::cout << "RDM commands: " << results_.requests_sent.load() << " sent, " << responses << " responses ("
+                << responses / elapsed_s << "/s), " << results_.rpt_status_received.load() << " RPT status\n";
+      results_.request_latency.Print("Round-trip");
+      break;
+    case Workload::kNotify:
+      std::cout << "Notifications: " << results_.notifications_sent.load() << " sent, " << notifications
+                << " delivered (" << notifications / elapsed_s << "/s)\n";
+      results_.notification_latency.Print("Delivery");
+      break;
+    case Workload::kStorm:
+      std::cout << "Connects: " << connects << " (" << connects / elapsed_s << "/s), "
+                << results_.connect_failures.load() << " failed, " << results_.client_list_updates.load()
+                << " client list updates delivered\n";
+      results_.connect_latency.Print("Connect");
+      break;
+  }
+
+  std::cout << "Broker: " << stats.rpt_requests_routed << " requests, " << stats.rpt_notifications_routed
+            << " notifications, " << stats.rpt_status_routed << " status routed; " << stats.queue_full_count
+            << " queue full events, " << stats.broadcast_drop_count << " broadcasts dropped\n";
+  std::cout << "Broker traffic: " << stats.messages_received << " messages (" << stats.bytes_received
+            << " bytes) received, " << stats.messages_sent << " messages (" << stats.bytes_sent << " bytes) sent\n";
+}
+
+/************************************ Main ************************************/
+
+int main(int argc, char* argv[])
+{
+  BenchOptions options;
+  if (!ParseArgs(argc, argv, options))
+    return 1;
+
+  auto res = rdmnet::Init();
+  if (!res)
+  {
+    std::cout << "RDMnet library failed to initialize: " << res.ToString() << '\n';
+    return 1;
+  }
+
+  int exit_code;
+  {
+    BrokerBench bench(options);
+    exit_code = bench.Run();
+  }
+
+  rdmnet::Deinit();
+  return exit_code;
+}